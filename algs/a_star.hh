@@ -1,6 +1,10 @@
 #pragma once
 #include "utility/try.hh"
+#include <Eigen/Dense>
+#include <array>
 #include <deque>
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
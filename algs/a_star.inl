@@ -8,9 +8,11 @@
 
 namespace algs {
 
-std::uint64_t get_hash_key_for_node(const Eigen::Vector2i &node) {
-  return static_cast<uint64_t>(node.x()) +
-         (static_cast<uint64_t>(node.y()) << sizeof(node.y()));
+inline std::uint64_t get_hash_key_for_node(const Eigen::Vector2i &node) {
+  // x and y each get 32 bits, going through uint32_t keeps negative
+  // coordinates from sign extending into the other half
+  return static_cast<uint64_t>(static_cast<uint32_t>(node.x())) |
+         (static_cast<uint64_t>(static_cast<uint32_t>(node.y())) << 32U);
 }
 
 template <typename NodeType, std::size_t max_neighbors>
@@ -61,14 +63,14 @@ a_star(DistanceFunc<NodeType> distance_func,
       const auto hash_key = get_hash_key_for_node(next);
       const auto find_result = cost_so_far.find(hash_key);
       if (find_result == cost_so_far.end() || new_cost < find_result->second) {
-        cost_so_far.emplace(hash_key, new_cost);
+        cost_so_far.insert_or_assign(hash_key, new_cost);
         float hueristic = hueristic_func(next);
         if (hueristic < best_node.first) {
           best_node = std::make_pair(hueristic, next);
         }
         float priority = new_cost + hueristic;
         frontier.emplace(std::make_pair(priority, next));
-        came_from.emplace(hash_key, current);
+        came_from.insert_or_assign(hash_key, current);
       }
     }
     if (frontier.size() > storage_size || cost_so_far.size() > storage_size ||
@@ -0,0 +1,55 @@
+#pragma once
+#include <Eigen/Dense>
+#include <cstdint>
+#include <vector>
+
+namespace algs {
+
+/**
+ * @brief Rectangular grid of bits packed 64 to a word, row by row
+ *
+ * Meant for per cell flags read in hot loops like walkability, a lookup is a
+ * bounds check and a bit read and a whole 30x30 map fits in 15 words.
+ */
+class BitGrid {
+public:
+  /**
+   * @param size number of cells along x and y, every bit starts cleared
+   */
+  explicit BitGrid(const Eigen::Vector2i &size);
+
+  /**
+   * @param cell cell to read
+   * @return the cell's bit, false for cells outside the grid
+   */
+  [[nodiscard]] bool get(const Eigen::Vector2i &cell) const;
+
+  /**
+   * @param cell cell to write, must be inside the grid
+   * @param value new bit
+   * @return true if the bit changed
+   */
+  bool set(const Eigen::Vector2i &cell, const bool value);
+
+  /**
+   * @brief Set every bit to the same value
+   */
+  void fill(const bool value);
+
+  /**
+   * @return number of cells along x and y
+   */
+  [[nodiscard]] const Eigen::Vector2i &get_size() const { return size_; }
+
+private:
+  static constexpr uint32_t bits_per_word{64U};
+
+  [[nodiscard]] bool is_in_grid(const Eigen::Vector2i &cell) const;
+  [[nodiscard]] uint32_t to_bit_index(const Eigen::Vector2i &cell) const;
+
+  Eigen::Vector2i size_;
+  std::vector<uint64_t> words_;
+};
+
+} // namespace algs
+#include "algs/bit_grid.inl"
@@ -0,0 +1,47 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+
+namespace algs {
+
+inline BitGrid::BitGrid(const Eigen::Vector2i &size) : size_(size) {
+  const auto bit_count = static_cast<std::size_t>(size.x()) *
+                         static_cast<std::size_t>(size.y());
+  words_.resize((bit_count + bits_per_word - 1U) / bits_per_word, 0U);
+}
+
+inline bool BitGrid::get(const Eigen::Vector2i &cell) const {
+  if (!is_in_grid(cell)) {
+    return false;
+  }
+  const uint32_t bit_index = to_bit_index(cell);
+  return ((words_[bit_index / bits_per_word] >> (bit_index % bits_per_word)) &
+          1U) != 0U;
+}
+
+inline bool BitGrid::set(const Eigen::Vector2i &cell, const bool value) {
+  const uint32_t bit_index = to_bit_index(cell);
+  uint64_t &word = words_[bit_index / bits_per_word];
+  const uint64_t mask = uint64_t{1U} << (bit_index % bits_per_word);
+  const uint64_t new_word = value ? word | mask : word & ~mask;
+  const bool changed = new_word != word;
+  word = new_word;
+  return changed;
+}
+
+inline void BitGrid::fill(const bool value) {
+  std::fill(words_.begin(), words_.end(),
+            value ? std::numeric_limits<uint64_t>::max() : uint64_t{0U});
+}
+
+inline bool BitGrid::is_in_grid(const Eigen::Vector2i &cell) const {
+  // negative coordinates wrap to large unsigned values
+  return static_cast<uint32_t>(cell.x()) < static_cast<uint32_t>(size_.x()) &&
+         static_cast<uint32_t>(cell.y()) < static_cast<uint32_t>(size_.y());
+}
+
+inline uint32_t BitGrid::to_bit_index(const Eigen::Vector2i &cell) const {
+  return static_cast<uint32_t>(cell.x() + cell.y() * size_.x());
+}
+
+} // namespace algs
@@ -0,0 +1,148 @@
+#pragma once
+#include "algs/grid_a_star.hh"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace algs {
+
+/**
+ * @brief Dijkstra map over a grid leading every cell to one goal
+ *
+ * Built once per goal, after which any number of agents can look up their
+ * next step in O(1) instead of each running a search. Steps follow the same
+ * 8-connected corner cutting rule and costs as GridAStar.
+ *
+ * When cells change walkability the field is repaired in place the way
+ * LPA* repairs a search, only cells whose cost actually changes are
+ * revisited instead of rebuilding the whole grid.
+ *
+ * Cells which can't reach the goal lead to the cell of their connected region
+ * closest to it by OctileHeuristic, which is where A* would send them too.
+ * Cells which aren't walkable lead to their cheapest walkable neighbor so
+ * agents pushed onto a wall find their way back.
+ */
+class FlowField {
+public:
+  /**
+   * @param size number of cells along x and y
+   * @param min_cell coordinates of the cell stored first
+   */
+  explicit FlowField(const Eigen::Vector2i &size,
+                     const Eigen::Vector2i &min_cell = {0, 0});
+
+  /**
+   * @brief Compute the cost and next step of every cell for a goal
+   * @param goal cell to lead to, may be outside the grid or not walkable
+   * @param is_walkable called once per cell as bool(const Eigen::Vector2i &)
+   */
+  template <typename IsWalkableFunctor>
+  void build(const Eigen::Vector2i &goal, const IsWalkableFunctor &is_walkable);
+
+  /**
+   * @brief Repair the field after some cells changed walkability
+   *
+   * Gives the same field as a build with the new walkability.
+   *
+   * @param changed_cells cells which may have changed, duplicates and cells
+   * outside the grid are fine
+   * @param is_walkable called once per changed cell as
+   * bool(const Eigen::Vector2i &)
+   */
+  template <typename IsWalkableFunctor>
+  void update_cells(std::span<const Eigen::Vector2i> changed_cells,
+                    const IsWalkableFunctor &is_walkable);
+
+  /**
+   * @param cell cell to step from
+   * @return next cell toward the goal, nullopt at the goal (or the closest
+   * cell to it) and outside the grid
+   */
+  [[nodiscard]] std::optional<Eigen::Vector2i>
+  get_maybe_next_cell(const Eigen::Vector2i &cell) const;
+
+  /**
+   * @param cell cell to get the cost of
+   * @return cost of the path from cell to where it leads, infinity for cells
+   * outside the grid or which aren't walkable
+   */
+  [[nodiscard]] float get_cost(const Eigen::Vector2i &cell) const;
+
+  /**
+   * @return goal of the last build
+   */
+  [[nodiscard]] const Eigen::Vector2i &get_goal() const { return goal_; }
+
+  /**
+   * @return number of cells taken off the frontier by the last build or
+   * update
+   */
+  [[nodiscard]] std::size_t get_expanded_node_count() const {
+    return expanded_node_count_;
+  }
+
+private:
+  static constexpr float infinity{std::numeric_limits<float>::infinity()};
+
+  /// What a cell leads to, the heuristic of the cell the path ends at is
+  /// compared first so every cell leads to the cell of its region closest to
+  /// the goal, then the cost of getting there
+  struct FieldCost {
+    float target_heuristic{infinity};
+    float path_cost{infinity};
+
+    [[nodiscard]] bool operator<(const FieldCost &other) const {
+      return target_heuristic < other.target_heuristic ||
+             (target_heuristic == other.target_heuristic &&
+              path_cost < other.path_cost);
+    }
+    [[nodiscard]] bool operator==(const FieldCost &other) const = default;
+  };
+
+  struct FrontierEntry {
+    FieldCost key;
+    uint32_t cell_index;
+
+    /// Reversed so the std heap functions keep the cheapest entry on top
+    [[nodiscard]] bool operator<(const FrontierEntry &other) const {
+      return other.key < key;
+    }
+  };
+
+  [[nodiscard]] bool is_in_grid(const Eigen::Vector2i &cell) const;
+  [[nodiscard]] uint32_t to_cell_index(const Eigen::Vector2i &cell) const;
+  [[nodiscard]] Eigen::Vector2i to_cell(const uint32_t cell_index) const;
+
+  /// Walkability looked up from the copy taken by build and update_cells
+  [[nodiscard]] bool is_walkable_cell(const Eigen::Vector2i &cell) const;
+
+  /// Every walkable cell could be where its region leads, which costs
+  /// nothing to reach
+  [[nodiscard]] FieldCost get_seed_cost(const Eigen::Vector2i &cell) const;
+
+  /// Recompute the cost a cell would have from its neighbors, queueing it if
+  /// that differs from its current cost
+  void update_cell(const uint32_t cell_index);
+
+  /// Settle queued cells until every cost agrees with its neighbors
+  void settle_costs();
+
+  Eigen::Vector2i size_;
+  Eigen::Vector2i min_cell_;
+  Eigen::Vector2i goal_{0, 0};
+
+  std::vector<uint8_t> is_walkable_;
+  /// Settled cost of each cell, g in LPA*
+  std::vector<FieldCost> costs_;
+  /// Cost from the cell's neighbors, rhs in LPA*
+  std::vector<FieldCost> lookahead_costs_;
+  std::vector<FrontierEntry> frontier_;
+
+  std::size_t expanded_node_count_{0UL};
+};
+
+} // namespace algs
+#include "algs/flow_field.inl"
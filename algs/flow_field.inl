@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+
+namespace algs {
+
+inline FlowField::FlowField(const Eigen::Vector2i &size,
+                            const Eigen::Vector2i &min_cell)
+    : size_(size), min_cell_(min_cell) {
+  const auto cell_count = static_cast<std::size_t>(size.x()) *
+                          static_cast<std::size_t>(size.y());
+  is_walkable_.resize(cell_count, 0U);
+  costs_.resize(cell_count);
+  lookahead_costs_.resize(cell_count);
+}
+
+template <typename IsWalkableFunctor>
+void FlowField::build(const Eigen::Vector2i &goal,
+                      const IsWalkableFunctor &is_walkable) {
+  goal_ = goal;
+  // walkability may be expensive to look up, so it is read once per cell
+  for (uint32_t cell_index = 0U; cell_index < is_walkable_.size();
+       ++cell_index) {
+    is_walkable_[cell_index] = is_walkable(to_cell(cell_index)) ? 1U : 0U;
+  }
+  std::fill(costs_.begin(), costs_.end(), FieldCost{});
+  frontier_.clear();
+  expanded_node_count_ = 0UL;
+  // with every cost unknown the neighbors add nothing, each walkable cell
+  // starts out leading to itself
+  for (uint32_t cell_index = 0U; cell_index < is_walkable_.size();
+       ++cell_index) {
+    if (is_walkable_[cell_index] == 0U) {
+      lookahead_costs_[cell_index] = FieldCost{};
+      continue;
+    }
+    lookahead_costs_[cell_index] = get_seed_cost(to_cell(cell_index));
+    frontier_.push_back(FrontierEntry{.key = lookahead_costs_[cell_index],
+                                      .cell_index = cell_index});
+  }
+  std::make_heap(frontier_.begin(), frontier_.end());
+  settle_costs();
+}
+
+template <typename IsWalkableFunctor>
+void FlowField::update_cells(std::span<const Eigen::Vector2i> changed_cells,
+                             const IsWalkableFunctor &is_walkable) {
+  expanded_node_count_ = 0UL;
+  for (const Eigen::Vector2i &changed_cell : changed_cells) {
+    if (!is_in_grid(changed_cell)) {
+      continue;
+    }
+    is_walkable_[to_cell_index(changed_cell)] =
+        is_walkable(changed_cell) ? 1U : 0U;
+  }
+  // a cell also decides whether the diagonal moves around it cut a corner,
+  // so every cell touching a changed one may have lost or gained a neighbor
+  for (const Eigen::Vector2i &changed_cell : changed_cells) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const Eigen::Vector2i cell = changed_cell + Eigen::Vector2i{dx, dy};
+        if (is_in_grid(cell)) {
+          update_cell(to_cell_index(cell));
+        }
+      }
+    }
+  }
+  settle_costs();
+}
+
+inline std::optional<Eigen::Vector2i>
+FlowField::get_maybe_next_cell(const Eigen::Vector2i &cell) const {
+  if (!is_in_grid(cell)) {
+    return std::nullopt;
+  }
+  const bool is_walkable = is_walkable_cell(cell);
+  if (is_walkable && costs_[to_cell_index(cell)].path_cost == 0.f) {
+    // the cell is where its region leads
+    return std::nullopt;
+  }
+
+  std::optional<Eigen::Vector2i> maybe_next_cell;
+  FieldCost next_cost;
+  const auto consider = [&](const Eigen::Vector2i &neighbor) {
+    const FieldCost &neighbor_cost = costs_[to_cell_index(neighbor)];
+    const FieldCost cost{
+        neighbor_cost.target_heuristic,
+        neighbor_cost.path_cost + GridStepCost{}(cell, neighbor)};
+    if (cost < next_cost) {
+      next_cost = cost;
+      maybe_next_cell = neighbor;
+    }
+  };
+  if (is_walkable) {
+    const auto neighbors = get_grid_neighbors(
+        cell, [this](const Eigen::Vector2i &neighbor) {
+          return is_walkable_cell(neighbor);
+        });
+    for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+      consider(neighbors.neighbor_array[i]);
+    }
+  } else {
+    // off a wall any walkable neighbor will do, corners don't matter
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const Eigen::Vector2i neighbor = cell + Eigen::Vector2i{dx, dy};
+        if (is_walkable_cell(neighbor)) {
+          consider(neighbor);
+        }
+      }
+    }
+  }
+  return maybe_next_cell;
+}
+
+inline float FlowField::get_cost(const Eigen::Vector2i &cell) const {
+  if (!is_in_grid(cell) || !is_walkable_cell(cell)) {
+    return infinity;
+  }
+  return costs_[to_cell_index(cell)].path_cost;
+}
+
+inline bool FlowField::is_in_grid(const Eigen::Vector2i &cell) const {
+  const Eigen::Vector2i offset = cell - min_cell_;
+  // negative offsets wrap to large unsigned values
+  return static_cast<uint32_t>(offset.x()) <
+             static_cast<uint32_t>(size_.x()) &&
+         static_cast<uint32_t>(offset.y()) < static_cast<uint32_t>(size_.y());
+}
+
+inline uint32_t FlowField::to_cell_index(const Eigen::Vector2i &cell) const {
+  const Eigen::Vector2i offset = cell - min_cell_;
+  return static_cast<uint32_t>(offset.x() + offset.y() * size_.x());
+}
+
+inline Eigen::Vector2i FlowField::to_cell(const uint32_t cell_index) const {
+  const auto width = static_cast<uint32_t>(size_.x());
+  return min_cell_ + Eigen::Vector2i{static_cast<int>(cell_index % width),
+                                     static_cast<int>(cell_index / width)};
+}
+
+inline FlowField::FieldCost
+FlowField::get_seed_cost(const Eigen::Vector2i &cell) const {
+  return FieldCost{OctileHeuristic{goal_}(cell), 0.f};
+}
+
+inline bool FlowField::is_walkable_cell(const Eigen::Vector2i &cell) const {
+  return is_in_grid(cell) && is_walkable_[to_cell_index(cell)] != 0U;
+}
+
+inline void FlowField::update_cell(const uint32_t cell_index) {
+  FieldCost lookahead_cost;
+  if (is_walkable_[cell_index] != 0U) {
+    const Eigen::Vector2i cell = to_cell(cell_index);
+    lookahead_cost = get_seed_cost(cell);
+    const auto neighbors = get_grid_neighbors(
+        cell, [this](const Eigen::Vector2i &neighbor) {
+          return is_walkable_cell(neighbor);
+        });
+    for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+      const Eigen::Vector2i &neighbor = neighbors.neighbor_array[i];
+      const FieldCost &neighbor_cost = costs_[to_cell_index(neighbor)];
+      const FieldCost cost{
+          neighbor_cost.target_heuristic,
+          neighbor_cost.path_cost + GridStepCost{}(cell, neighbor)};
+      lookahead_cost = std::min(lookahead_cost, cost);
+    }
+  }
+  lookahead_costs_[cell_index] = lookahead_cost;
+  if (costs_[cell_index] != lookahead_cost) {
+    frontier_.push_back(FrontierEntry{
+        .key = std::min(costs_[cell_index], lookahead_cost),
+        .cell_index = cell_index});
+    std::push_heap(frontier_.begin(), frontier_.end());
+  }
+}
+
+inline void FlowField::settle_costs() {
+  while (!frontier_.empty()) {
+    std::pop_heap(frontier_.begin(), frontier_.end());
+    const FrontierEntry entry = frontier_.back();
+    frontier_.pop_back();
+    const uint32_t cell_index = entry.cell_index;
+    FieldCost &cost = costs_[cell_index];
+    const FieldCost &lookahead_cost = lookahead_costs_[cell_index];
+    if (cost == lookahead_cost ||
+        entry.key != std::min(cost, lookahead_cost)) {
+      // stale entry, the cell was queued again or already settled
+      continue;
+    }
+    ++expanded_node_count_;
+
+    // moves are symmetric, so the cells this one can reach are the ones
+    // whose cost depends on it
+    const Eigen::Vector2i cell = to_cell(cell_index);
+    const auto neighbors =
+        get_grid_neighbors(cell, [this](const Eigen::Vector2i &neighbor) {
+          return is_walkable_cell(neighbor);
+        });
+    if (lookahead_cost < cost) {
+      // a lower cost can only lower the neighbors' costs, which is the same
+      // relaxation Dijkstra does
+      cost = lookahead_cost;
+      for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+        const Eigen::Vector2i &neighbor = neighbors.neighbor_array[i];
+        const uint32_t neighbor_index = to_cell_index(neighbor);
+        const FieldCost neighbor_cost{
+            cost.target_heuristic,
+            cost.path_cost + GridStepCost{}(cell, neighbor)};
+        if (neighbor_cost < lookahead_costs_[neighbor_index]) {
+          lookahead_costs_[neighbor_index] = neighbor_cost;
+          frontier_.push_back(FrontierEntry{
+              .key = std::min(costs_[neighbor_index], neighbor_cost),
+              .cell_index = neighbor_index});
+          std::push_heap(frontier_.begin(), frontier_.end());
+        }
+      }
+      continue;
+    }
+    // a cost which went up is forgotten and recomputed from the neighbors,
+    // as are the costs of every neighbor which may have depended on it
+    cost = FieldCost{};
+    update_cell(cell_index);
+    for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+      update_cell(to_cell_index(neighbors.neighbor_array[i]));
+    }
+  }
+}
+
+} // namespace algs
@@ -0,0 +1,193 @@
+#pragma once
+#include "algs/a_star.hh"
+#include "utility/try.hh"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace algs {
+
+/**
+ * @brief Cost of a single step between 8-connected neighbors, the same as
+ * their euclidean distance without the square root
+ */
+struct GridStepCost {
+  [[nodiscard]] float operator()(const Eigen::Vector2i &from,
+                                 const Eigen::Vector2i &to) const {
+    return from.x() != to.x() && from.y() != to.y() ? diagonal_step_cost
+                                                    : 1.f;
+  }
+
+  static constexpr float diagonal_step_cost{1.41421356f};
+};
+
+/**
+ * @brief Exact cost to a goal on an 8-connected grid without obstacles
+ *
+ * Never overestimates with GridStepCost and is closer to the true cost than
+ * the euclidean distance, so fewer cells are expanded.
+ */
+struct OctileHeuristic {
+  Eigen::Vector2i goal;
+
+  [[nodiscard]] float operator()(const Eigen::Vector2i &cell) const {
+    const Eigen::Vector2i delta = (cell - goal).cwiseAbs();
+    const int diagonal_steps = std::min(delta.x(), delta.y());
+    const int straight_steps = std::max(delta.x(), delta.y()) - diagonal_steps;
+    return static_cast<float>(straight_steps) +
+           static_cast<float>(diagonal_steps) *
+               GridStepCost::diagonal_step_cost;
+  }
+};
+
+/**
+ * @brief Get the 8-connected neighbors of a cell, diagonal moves may not cut
+ * the corner of a cell which isn't walkable
+ * @param cell cell to get the neighbors of
+ * @param is_walkable called as bool(const Eigen::Vector2i &) for each of the
+ * 8 surrounding cells, must return false for cells off the grid
+ * @return walkable neighbors, straight ones first
+ */
+template <typename IsWalkableFunctor>
+[[nodiscard]] Neighbors<Eigen::Vector2i, 8>
+get_grid_neighbors(const Eigen::Vector2i &cell,
+                   const IsWalkableFunctor &is_walkable);
+
+/**
+ * @brief A* specialised for rectangular grids of cells
+ *
+ * Does the same search as a_star but keeps its per cell state in flat arrays
+ * sized to the grid instead of hash maps, so one instance should be kept and
+ * reused for every search on the same grid. Visited marks are stamped with a
+ * search generation, which makes starting a new search O(1), and the frontier
+ * is a binary heap indexed by cell so improving a frontier cell's cost moves
+ * it rather than adding a duplicate.
+ *
+ * The distance, neighbor and heuristic functors are template parameters so
+ * they can be inlined, they take the same arguments as the ones for a_star.
+ */
+class GridAStar {
+public:
+  /**
+   * @param size number of cells along x and y
+   * @param min_cell coordinates of the cell stored first, cells outside of
+   * [min_cell, min_cell + size) are never visited
+   */
+  explicit GridAStar(const Eigen::Vector2i &size,
+                     const Eigen::Vector2i &min_cell = {0, 0});
+
+  /**
+   * @brief Find the cheapest path from start to end
+   *
+   * If end can't be reached the path leads to the visited cell with the
+   * lowest heuristic instead, the same as a_star.
+   *
+   * @param distance_func cost of moving between two neighboring cells,
+   * called as float(const Eigen::Vector2i &, const Eigen::Vector2i &)
+   * @param get_neighbors cells reachable from a cell, called as
+   * Neighbors<Eigen::Vector2i, N>(const Eigen::Vector2i &)
+   * @param heuristic_func estimated cost from a cell to end, called as
+   * float(const Eigen::Vector2i &)
+   * @param start first cell of the path
+   * @param end cell to find a path to
+   * @param storage_size maximum number of cells to visit
+   * @param[out] path cells from start to end (or the closest cell found),
+   * cleared first so its storage can be reused between searches
+   * @return error if more than storage_size cells were visited or start is
+   * outside the grid
+   */
+  template <typename DistanceFunctor, typename NeighborsFunctor,
+            typename HeuristicFunctor>
+  [[nodiscard]] Result<void, std::string>
+  find_path(const DistanceFunctor &distance_func,
+            const NeighborsFunctor &get_neighbors,
+            const HeuristicFunctor &heuristic_func,
+            const Eigen::Vector2i &start, const Eigen::Vector2i &end,
+            const std::size_t storage_size, std::vector<Eigen::Vector2i> &path);
+
+  /**
+   * @return number of cells taken off the frontier by the last search
+   */
+  [[nodiscard]] std::size_t get_expanded_node_count() const {
+    return expanded_node_count_;
+  }
+
+  /**
+   * @brief Get the cell a cell was reached from in the current or last search
+   *
+   * Neighbor functors may call this for the cell they are asked about, its
+   * parent is final by the time it is expanded.
+   *
+   * @param cell cell to look up
+   * @return parent cell, nullopt for the start and cells which weren't visited
+   */
+  [[nodiscard]] std::optional<Eigen::Vector2i>
+  get_maybe_came_from(const Eigen::Vector2i &cell) const;
+
+  /**
+   * @return number of cells along x and y
+   */
+  [[nodiscard]] const Eigen::Vector2i &get_size() const { return size_; }
+
+  /**
+   * @return coordinates of the first cell
+   */
+  [[nodiscard]] const Eigen::Vector2i &get_min_cell() const {
+    return min_cell_;
+  }
+
+private:
+  static constexpr uint32_t invalid_index{
+      std::numeric_limits<uint32_t>::max()};
+  /// heap_index_ of cells which have been expanded
+  static constexpr uint32_t closed_heap_index{invalid_index - 1U};
+
+  struct HeapEntry {
+    float priority;
+    uint32_t cell_index;
+  };
+
+  /// Everything a search keeps per cell, together so visiting a cell touches
+  /// one cache line
+  struct CellState {
+    /// The rest of the state is only valid if this is the current generation
+    uint32_t generation{0U};
+    float cost_so_far{0.f};
+    uint32_t came_from{0U};
+    /// Position in heap_, or closed_heap_index
+    uint32_t heap_index{0U};
+  };
+
+  [[nodiscard]] bool is_in_grid(const Eigen::Vector2i &cell) const;
+  [[nodiscard]] uint32_t to_cell_index(const Eigen::Vector2i &cell) const;
+  [[nodiscard]] Eigen::Vector2i to_cell(const uint32_t cell_index) const;
+
+  /// Forget the previous search by moving to a new generation
+  void start_search();
+
+  [[nodiscard]] bool is_visited(const uint32_t cell_index) const {
+    return cells_[cell_index].generation == current_generation_;
+  }
+
+  /// Add a cell to the frontier or move it if it is already there
+  void push_or_update(const uint32_t cell_index, const float priority);
+  [[nodiscard]] uint32_t pop_min();
+  void sift_up(std::size_t heap_position);
+  void sift_down(std::size_t heap_position);
+
+  Eigen::Vector2i size_;
+  Eigen::Vector2i min_cell_;
+
+  uint32_t current_generation_{0U};
+  std::vector<CellState> cells_;
+  std::vector<HeapEntry> heap_;
+
+  std::size_t expanded_node_count_{0UL};
+};
+
+} // namespace algs
+#include "algs/grid_a_star.inl"
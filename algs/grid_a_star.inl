@@ -0,0 +1,239 @@
+#pragma once
+#include <algorithm>
+#include <utility>
+
+namespace algs {
+
+template <typename IsWalkableFunctor>
+Neighbors<Eigen::Vector2i, 8>
+get_grid_neighbors(const Eigen::Vector2i &cell,
+                   const IsWalkableFunctor &is_walkable) {
+  Neighbors<Eigen::Vector2i, 8> neighbors;
+  const auto add_if_walkable = [&](const Eigen::Vector2i &neighbor) {
+    const bool walkable = is_walkable(neighbor);
+    if (walkable) {
+      neighbors.neighbor_array[neighbors.num_neighbors++] = neighbor;
+    }
+    return walkable;
+  };
+  const bool up = add_if_walkable({cell.x(), cell.y() + 1});
+  const bool down = add_if_walkable({cell.x(), cell.y() - 1});
+  const bool right = add_if_walkable({cell.x() + 1, cell.y()});
+  const bool left = add_if_walkable({cell.x() - 1, cell.y()});
+  // the straight results are reused so each surrounding cell is checked once
+  if (up && right) {
+    add_if_walkable({cell.x() + 1, cell.y() + 1});
+  }
+  if (down && left) {
+    add_if_walkable({cell.x() - 1, cell.y() - 1});
+  }
+  if (up && left) {
+    add_if_walkable({cell.x() - 1, cell.y() + 1});
+  }
+  if (down && right) {
+    add_if_walkable({cell.x() + 1, cell.y() - 1});
+  }
+  return neighbors;
+}
+
+inline GridAStar::GridAStar(const Eigen::Vector2i &size,
+                            const Eigen::Vector2i &min_cell)
+    : size_(size), min_cell_(min_cell) {
+  const auto cell_count = static_cast<std::size_t>(size.x()) *
+                          static_cast<std::size_t>(size.y());
+  cells_.resize(cell_count);
+  heap_.reserve(cell_count);
+}
+
+template <typename DistanceFunctor, typename NeighborsFunctor,
+          typename HeuristicFunctor>
+Result<void, std::string> GridAStar::find_path(
+    const DistanceFunctor &distance_func, const NeighborsFunctor &get_neighbors,
+    const HeuristicFunctor &heuristic_func, const Eigen::Vector2i &start,
+    const Eigen::Vector2i &end, const std::size_t storage_size,
+    std::vector<Eigen::Vector2i> &path) {
+  path.clear();
+  if (!is_in_grid(start)) {
+    return Err(std::string("Start of grid A* search is outside the grid"));
+  }
+  start_search();
+
+  const uint32_t start_index = to_cell_index(start);
+  cells_[start_index] = CellState{.generation = current_generation_,
+                                  .cost_so_far = 0.f,
+                                  .came_from = invalid_index,
+                                  .heap_index = invalid_index};
+  std::size_t visited_count = 1UL;
+  push_or_update(start_index, 0.f);
+
+  bool found_path = false;
+  uint32_t best_index = start_index;
+  float best_heuristic = heuristic_func(start);
+  // compared by index since end may be outside the grid
+  const uint32_t end_index = is_in_grid(end) ? to_cell_index(end)
+                                             : invalid_index;
+  while (!heap_.empty()) {
+    const uint32_t current_index = pop_min();
+    if (current_index == end_index) {
+      found_path = true;
+      break;
+    }
+    ++expanded_node_count_;
+
+    const Eigen::Vector2i current = to_cell(current_index);
+    const float cost = cells_[current_index].cost_so_far;
+    const auto neighbors = get_neighbors(current);
+    for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+      const Eigen::Vector2i &next = neighbors.neighbor_array[i];
+      if (!is_in_grid(next)) {
+        continue;
+      }
+      const uint32_t next_index = to_cell_index(next);
+      const float new_cost = cost + distance_func(current, next);
+      auto &next_state = cells_[next_index];
+      const bool was_visited = next_state.generation == current_generation_;
+      if (was_visited && new_cost >= next_state.cost_so_far) {
+        continue;
+      }
+      if (!was_visited) {
+        next_state.generation = current_generation_;
+        next_state.heap_index = invalid_index;
+        ++visited_count;
+      }
+      next_state.cost_so_far = new_cost;
+      next_state.came_from = current_index;
+
+      const float heuristic = heuristic_func(next);
+      if (heuristic < best_heuristic) {
+        best_heuristic = heuristic;
+        best_index = next_index;
+      }
+      push_or_update(next_index, new_cost + heuristic);
+    }
+    if (visited_count > storage_size) {
+      return Err(
+          std::string("Used too much space in grid A*, increase estimate"));
+    }
+  }
+
+  // walk back from the target then flip, came_from only links backwards
+  for (uint32_t index = found_path ? end_index : best_index;
+       index != invalid_index; index = cells_[index].came_from) {
+    path.push_back(to_cell(index));
+  }
+  std::reverse(path.begin(), path.end());
+  return Ok();
+}
+
+inline std::optional<Eigen::Vector2i>
+GridAStar::get_maybe_came_from(const Eigen::Vector2i &cell) const {
+  if (!is_in_grid(cell)) {
+    return std::nullopt;
+  }
+  const uint32_t cell_index = to_cell_index(cell);
+  if (!is_visited(cell_index) ||
+      cells_[cell_index].came_from == invalid_index) {
+    return std::nullopt;
+  }
+  return to_cell(cells_[cell_index].came_from);
+}
+
+inline bool GridAStar::is_in_grid(const Eigen::Vector2i &cell) const {
+  const Eigen::Vector2i offset = cell - min_cell_;
+  // negative offsets wrap to large unsigned values
+  return static_cast<uint32_t>(offset.x()) <
+             static_cast<uint32_t>(size_.x()) &&
+         static_cast<uint32_t>(offset.y()) < static_cast<uint32_t>(size_.y());
+}
+
+inline uint32_t GridAStar::to_cell_index(const Eigen::Vector2i &cell) const {
+  const Eigen::Vector2i offset = cell - min_cell_;
+  return static_cast<uint32_t>(offset.x() + offset.y() * size_.x());
+}
+
+inline Eigen::Vector2i GridAStar::to_cell(const uint32_t cell_index) const {
+  const auto width = static_cast<uint32_t>(size_.x());
+  return min_cell_ + Eigen::Vector2i{static_cast<int>(cell_index % width),
+                                     static_cast<int>(cell_index / width)};
+}
+
+inline void GridAStar::start_search() {
+  heap_.clear();
+  expanded_node_count_ = 0UL;
+  ++current_generation_;
+  if (current_generation_ == 0U) {
+    // after 2^32 searches old stamps could look current again
+    for (auto &cell : cells_) {
+      cell.generation = 0U;
+    }
+    current_generation_ = 1U;
+  }
+}
+
+inline void GridAStar::push_or_update(const uint32_t cell_index,
+                                      const float priority) {
+  uint32_t heap_position = cells_[cell_index].heap_index;
+  if (heap_position == invalid_index || heap_position == closed_heap_index) {
+    // closed cells are only reopened when a cheaper path to them is found,
+    // which needs an inconsistent heuristic
+    heap_position = static_cast<uint32_t>(heap_.size());
+    heap_.push_back(HeapEntry{.priority = priority, .cell_index = cell_index});
+  } else {
+    // costs only ever decrease, so the cell can only move up
+    heap_[heap_position].priority = priority;
+  }
+  sift_up(heap_position);
+}
+
+inline uint32_t GridAStar::pop_min() {
+  const uint32_t cell_index = heap_.front().cell_index;
+  cells_[cell_index].heap_index = closed_heap_index;
+  heap_.front() = heap_.back();
+  heap_.pop_back();
+  if (!heap_.empty()) {
+    sift_down(0UL);
+  }
+  return cell_index;
+}
+
+inline void GridAStar::sift_up(std::size_t heap_position) {
+  const HeapEntry entry = heap_[heap_position];
+  while (heap_position > 0UL) {
+    const std::size_t parent = (heap_position - 1UL) / 2UL;
+    if (heap_[parent].priority <= entry.priority) {
+      break;
+    }
+    heap_[heap_position] = heap_[parent];
+    cells_[heap_[heap_position].cell_index].heap_index =
+        static_cast<uint32_t>(heap_position);
+    heap_position = parent;
+  }
+  heap_[heap_position] = entry;
+  cells_[entry.cell_index].heap_index = static_cast<uint32_t>(heap_position);
+}
+
+inline void GridAStar::sift_down(std::size_t heap_position) {
+  const HeapEntry entry = heap_[heap_position];
+  const std::size_t heap_size = heap_.size();
+  while (true) {
+    std::size_t child = heap_position * 2UL + 1UL;
+    if (child >= heap_size) {
+      break;
+    }
+    if (child + 1UL < heap_size &&
+        heap_[child + 1UL].priority < heap_[child].priority) {
+      ++child;
+    }
+    if (entry.priority <= heap_[child].priority) {
+      break;
+    }
+    heap_[heap_position] = heap_[child];
+    cells_[heap_[heap_position].cell_index].heap_index =
+        static_cast<uint32_t>(heap_position);
+    heap_position = child;
+  }
+  heap_[heap_position] = entry;
+  cells_[entry.cell_index].heap_index = static_cast<uint32_t>(heap_position);
+}
+
+} // namespace algs
@@ -0,0 +1,236 @@
+#pragma once
+#include "algs/bit_grid.hh"
+#include "algs/grid_a_star.hh"
+#include "utility/try.hh"
+#include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace algs {
+
+/**
+ * @brief Hierarchical path-finding A* (HPA*) for large grids
+ *
+ * The grid is split into square clusters. Wherever a cluster border can be
+ * crossed one or two entrance cells are picked on each side, and the cost
+ * between every pair of entrances in a cluster is precomputed, which gives an
+ * abstract graph far smaller than the grid. A query connects start and end to
+ * the entrances of their clusters, runs A* over the abstract graph and then
+ * refines each abstract step with an A* search confined to one cluster.
+ *
+ * Paths follow the same 8-connected corner rule and costs as GridAStar but
+ * may be slightly longer than the cheapest path, since crossings are limited
+ * to the chosen entrance cells and a path which starts and ends in the same
+ * cluster stays inside it when it can. Changing cells only rebuilds the
+ * clusters whose entrances or inner costs depend on them.
+ */
+class HierarchicalAStar {
+public:
+  /**
+   * @param size number of cells along x and y, the first cell is (0, 0)
+   * @param cluster_size number of cells along each side of a cluster, larger
+   * clusters make the abstract graph smaller but refinement slower
+   */
+  explicit HierarchicalAStar(const Eigen::Vector2i &size,
+                             const int cluster_size = 16);
+
+  /**
+   * @brief Build the abstract graph for every cluster
+   * @param is_walkable called once per cell as bool(const Eigen::Vector2i &)
+   */
+  template <typename IsWalkableFunctor>
+  void build(const IsWalkableFunctor &is_walkable);
+
+  /**
+   * @brief Rebuild the clusters affected by cells which changed walkability
+   *
+   * Gives the same graph as a build with the new walkability.
+   *
+   * @param changed_cells cells which may have changed, duplicates and cells
+   * outside the grid are fine
+   * @param is_walkable called once per changed cell as
+   * bool(const Eigen::Vector2i &)
+   */
+  template <typename IsWalkableFunctor>
+  void update_cells(std::span<const Eigen::Vector2i> changed_cells,
+                    const IsWalkableFunctor &is_walkable);
+
+  /**
+   * @brief Find a path from start to end using the walkability of the last
+   * build or update
+   * @param start first cell of the path
+   * @param end cell to find a path to
+   * @param[out] path cells from start to end, each a neighbor of the last,
+   * cleared first so its storage can be reused between searches
+   * @return error if start or end is outside the grid or end can't be reached
+   * from start
+   */
+  [[nodiscard]] Result<void, std::string>
+  find_path(const Eigen::Vector2i &start, const Eigen::Vector2i &end,
+            std::vector<Eigen::Vector2i> &path);
+
+  /**
+   * @return number of abstract nodes taken off the frontier by the last
+   * search
+   */
+  [[nodiscard]] std::size_t get_expanded_node_count() const {
+    return expanded_node_count_;
+  }
+
+  /**
+   * @return number of clusters rebuilt by the last build or update
+   */
+  [[nodiscard]] std::size_t get_rebuilt_cluster_count() const {
+    return rebuilt_cluster_count_;
+  }
+
+  /**
+   * @return number of entrance cells in the abstract graph
+   */
+  [[nodiscard]] std::size_t get_entrance_count() const;
+
+private:
+  static constexpr float infinity{std::numeric_limits<float>::infinity()};
+  /// Border openings at least this wide get an entrance at each end instead
+  /// of one in the middle, so paths along a wide opening don't detour
+  static constexpr int min_double_entrance_width{6};
+
+  struct Edge {
+    /// Abstract node of the entrance this leads to
+    uint32_t to_node;
+    float cost;
+    /// Cell of that entrance, kept here for the heuristic
+    Eigen::Vector2i to_cell;
+  };
+
+  /// Cell of a cluster where a path may cross into a neighboring cluster
+  struct Entrance {
+    Eigen::Vector2i cell;
+    /// Entrance cells of neighboring clusters one straight step away, corner
+    /// cells can cross two borders
+    std::array<Eigen::Vector2i, 2> crossing_cells{Eigen::Vector2i::Zero(),
+                                                  Eigen::Vector2i::Zero()};
+    uint32_t crossing_count{0U};
+    /// Edges of the entrance in Cluster::edges, the steps to crossing_cells
+    /// first then the precomputed paths to the cluster's other entrances
+    uint32_t first_edge{0U};
+    uint32_t edge_count{0U};
+  };
+
+  /// Entrances and their edges, kept in two arrays so expanding an entrance
+  /// doesn't chase a pointer per entrance
+  struct Cluster {
+    std::vector<Entrance> entrances;
+    std::vector<Edge> edges;
+  };
+
+  struct FrontierEntry {
+    float priority;
+    uint32_t index;
+
+    /// Reversed so the std heap functions keep the cheapest entry on top
+    [[nodiscard]] bool operator<(const FrontierEntry &other) const {
+      return other.priority < priority;
+    }
+  };
+
+  /// Per node state of the abstract search
+  struct SearchState {
+    /// The rest of the state is only valid if this is the current generation
+    uint32_t generation{0U};
+    float cost_so_far{0.f};
+    uint32_t came_from{0U};
+  };
+
+  [[nodiscard]] bool is_in_grid(const Eigen::Vector2i &cell) const;
+
+  [[nodiscard]] uint32_t get_cluster_index(const Eigen::Vector2i &cell) const;
+  [[nodiscard]] Eigen::AlignedBox2i
+  get_cluster_bounds(const uint32_t cluster_index) const;
+
+  /// Walkable cells inside the bounds, diagonal moves around their edges
+  /// aren't allowed since the corner cell would be outside
+  [[nodiscard]] bool is_walkable_in(const Eigen::AlignedBox2i &bounds,
+                                    const Eigen::Vector2i &cell) const;
+
+  /// Abstract nodes are numbered by cluster so they stay put when other
+  /// clusters are rebuilt, with start and end after every entrance slot
+  [[nodiscard]] uint32_t get_node(const uint32_t cluster_index,
+                                  const std::size_t entrance_index) const;
+  [[nodiscard]] uint32_t get_start_node() const;
+  [[nodiscard]] uint32_t get_end_node() const;
+
+  /// Recompute a cluster's entrances and the costs between them
+  void rebuild_cluster(const uint32_t cluster_index);
+
+  /// Point a cluster's crossing edges at the entrances of its neighbors
+  void link_cluster(const uint32_t cluster_index);
+
+  /// Add an entrance per crossing on the border between a cluster and the
+  /// neighboring cluster in direction, which must be straight
+  void add_border_entrances(const Eigen::AlignedBox2i &bounds,
+                            const Eigen::Vector2i &direction,
+                            std::vector<Entrance> &entrances) const;
+
+  /// Search from source without leaving its cluster, costs are left in
+  /// local_costs_
+  /// @param maybe_target stop once this cell is reached, otherwise every
+  /// reachable cell of the cluster gets a cost
+  /// @return true if the target was reached
+  bool search_cluster(const Eigen::AlignedBox2i &bounds,
+                      const Eigen::Vector2i &source,
+                      const std::optional<Eigen::Vector2i> &maybe_target);
+
+  [[nodiscard]] uint32_t to_local_index(const Eigen::AlignedBox2i &bounds,
+                                        const Eigen::Vector2i &cell) const;
+  [[nodiscard]] Eigen::Vector2i
+  to_cluster_cell(const Eigen::AlignedBox2i &bounds,
+                  const uint32_t local_index) const;
+
+  /// A* over the abstract graph, fills abstract_path_ with the cells it
+  /// passes through
+  [[nodiscard]] bool find_abstract_path(const Eigen::Vector2i &start,
+                                        const Eigen::Vector2i &end);
+
+  /// Cheapest path between two cells without leaving the cluster of from,
+  /// appended to path without its first cell
+  /// @return false if there is no such path
+  bool append_cluster_path(const Eigen::Vector2i &from,
+                           const Eigen::Vector2i &to,
+                           std::vector<Eigen::Vector2i> &path);
+
+  Eigen::Vector2i size_;
+  int cluster_size_;
+  /// Number of clusters along x and y, clusters on the far edges may be
+  /// smaller than cluster_size_
+  Eigen::Vector2i cluster_counts_;
+  /// Most entrances a cluster can have, every other border cell of each side
+  uint32_t max_cluster_entrances_;
+
+  BitGrid is_walkable_;
+  std::vector<Cluster> clusters_;
+  std::size_t rebuilt_cluster_count_{0UL};
+
+  std::vector<float> local_costs_;
+  std::vector<uint32_t> local_came_from_;
+  std::vector<FrontierEntry> local_frontier_;
+
+  uint32_t current_generation_{0U};
+  std::vector<SearchState> search_states_;
+  std::vector<FrontierEntry> frontier_;
+  std::vector<Edge> start_edges_;
+  /// Cost from each entrance of the end's cluster to the end
+  std::vector<float> end_costs_;
+  std::vector<Eigen::Vector2i> abstract_path_;
+  std::size_t expanded_node_count_{0UL};
+
+  std::vector<Eigen::Vector2i> cluster_path_;
+};
+
+} // namespace algs
+#include "algs/hierarchical_a_star.inl"
@@ -0,0 +1,514 @@
+#pragma once
+#include <algorithm>
+
+namespace algs {
+
+inline HierarchicalAStar::HierarchicalAStar(const Eigen::Vector2i &size,
+                                            const int cluster_size)
+    : size_(size), cluster_size_(cluster_size),
+      cluster_counts_((size.array() + cluster_size - 1) / cluster_size),
+      max_cluster_entrances_(4U * static_cast<uint32_t>(cluster_size + 1) /
+                             2U),
+      is_walkable_(size) {
+  clusters_.resize(static_cast<std::size_t>(cluster_counts_.x()) *
+                   static_cast<std::size_t>(cluster_counts_.y()));
+  const auto cluster_area = static_cast<std::size_t>(cluster_size) *
+                            static_cast<std::size_t>(cluster_size);
+  local_costs_.resize(cluster_area);
+  local_came_from_.resize(cluster_area);
+  // start and end come after every entrance slot
+  search_states_.resize(clusters_.size() * max_cluster_entrances_ + 2UL);
+  end_costs_.resize(max_cluster_entrances_);
+}
+
+template <typename IsWalkableFunctor>
+void HierarchicalAStar::build(const IsWalkableFunctor &is_walkable) {
+  for (int y = 0; y < size_.y(); ++y) {
+    for (int x = 0; x < size_.x(); ++x) {
+      is_walkable_.set({x, y}, is_walkable(Eigen::Vector2i{x, y}));
+    }
+  }
+  for (uint32_t cluster_index = 0U; cluster_index < clusters_.size();
+       ++cluster_index) {
+    rebuild_cluster(cluster_index);
+  }
+  for (uint32_t cluster_index = 0U; cluster_index < clusters_.size();
+       ++cluster_index) {
+    link_cluster(cluster_index);
+  }
+  rebuilt_cluster_count_ = clusters_.size();
+}
+
+template <typename IsWalkableFunctor>
+void HierarchicalAStar::update_cells(
+    std::span<const Eigen::Vector2i> changed_cells,
+    const IsWalkableFunctor &is_walkable) {
+  std::vector<uint32_t> changed_clusters;
+  for (const Eigen::Vector2i &changed_cell : changed_cells) {
+    if (!is_in_grid(changed_cell)) {
+      continue;
+    }
+    is_walkable_.set(changed_cell, is_walkable(changed_cell));
+    const uint32_t cluster_index = get_cluster_index(changed_cell);
+    changed_clusters.push_back(cluster_index);
+    // cells on a border decide the entrances on both sides of it
+    for (const Eigen::Vector2i &direction :
+         {Eigen::Vector2i{1, 0}, Eigen::Vector2i{-1, 0}, Eigen::Vector2i{0, 1},
+          Eigen::Vector2i{0, -1}}) {
+      const Eigen::Vector2i neighbor = changed_cell + direction;
+      if (is_in_grid(neighbor) &&
+          get_cluster_index(neighbor) != cluster_index) {
+        changed_clusters.push_back(get_cluster_index(neighbor));
+      }
+    }
+  }
+  std::sort(changed_clusters.begin(), changed_clusters.end());
+  changed_clusters.erase(
+      std::unique(changed_clusters.begin(), changed_clusters.end()),
+      changed_clusters.end());
+  for (const uint32_t cluster_index : changed_clusters) {
+    rebuild_cluster(cluster_index);
+  }
+  rebuilt_cluster_count_ = changed_clusters.size();
+
+  // rebuilt clusters may number their entrances differently, so crossings
+  // into them from their neighbors are resolved again too
+  std::vector<uint32_t> relinked_clusters;
+  for (const uint32_t cluster_index : changed_clusters) {
+    relinked_clusters.push_back(cluster_index);
+    const Eigen::AlignedBox2i bounds = get_cluster_bounds(cluster_index);
+    for (const Eigen::Vector2i &direction :
+         {Eigen::Vector2i{1, 0}, Eigen::Vector2i{-1, 0}, Eigen::Vector2i{0, 1},
+          Eigen::Vector2i{0, -1}}) {
+      const Eigen::Vector2i neighbor = bounds.min() + direction * cluster_size_;
+      if (is_in_grid(neighbor)) {
+        relinked_clusters.push_back(get_cluster_index(neighbor));
+      }
+    }
+  }
+  std::sort(relinked_clusters.begin(), relinked_clusters.end());
+  relinked_clusters.erase(
+      std::unique(relinked_clusters.begin(), relinked_clusters.end()),
+      relinked_clusters.end());
+  for (const uint32_t cluster_index : relinked_clusters) {
+    link_cluster(cluster_index);
+  }
+}
+
+inline Result<void, std::string>
+HierarchicalAStar::find_path(const Eigen::Vector2i &start,
+                             const Eigen::Vector2i &end,
+                             std::vector<Eigen::Vector2i> &path) {
+  path.clear();
+  expanded_node_count_ = 0UL;
+  if (!is_in_grid(start) || !is_in_grid(end)) {
+    return Err(std::string(
+        "Start or end of hierarchical A* search is outside the grid"));
+  }
+  const auto unreachable_error = []() {
+    return Err(std::string(
+        "End of hierarchical A* search can't be reached from start"));
+  };
+  if (!is_walkable_.get(start) || !is_walkable_.get(end)) {
+    return unreachable_error();
+  }
+
+  path.push_back(start);
+  // most short paths never leave their cluster, which skips the abstract
+  // search entirely
+  if (get_cluster_index(start) == get_cluster_index(end) &&
+      append_cluster_path(start, end, path)) {
+    return Ok();
+  }
+
+  if (!find_abstract_path(start, end)) {
+    path.clear();
+    return unreachable_error();
+  }
+  for (std::size_t i = 1; i < abstract_path_.size(); ++i) {
+    const Eigen::Vector2i &from = abstract_path_[i - 1];
+    const Eigen::Vector2i &to = abstract_path_[i];
+    if (get_cluster_index(from) != get_cluster_index(to)) {
+      // a step across a border between two entrances
+      path.push_back(to);
+    } else if (!append_cluster_path(from, to, path)) {
+      path.clear();
+      return Err(std::string(
+          "Hierarchical A* abstract path couldn't be refined, the graph is "
+          "out of date"));
+    }
+  }
+  return Ok();
+}
+
+inline std::size_t HierarchicalAStar::get_entrance_count() const {
+  std::size_t entrance_count = 0UL;
+  for (const Cluster &cluster : clusters_) {
+    entrance_count += cluster.entrances.size();
+  }
+  return entrance_count;
+}
+
+inline bool HierarchicalAStar::is_in_grid(const Eigen::Vector2i &cell) const {
+  // negative coordinates wrap to large unsigned values
+  return static_cast<uint32_t>(cell.x()) < static_cast<uint32_t>(size_.x()) &&
+         static_cast<uint32_t>(cell.y()) < static_cast<uint32_t>(size_.y());
+}
+
+inline uint32_t
+HierarchicalAStar::get_cluster_index(const Eigen::Vector2i &cell) const {
+  return static_cast<uint32_t>(cell.x() / cluster_size_ +
+                               cell.y() / cluster_size_ * cluster_counts_.x());
+}
+
+inline Eigen::AlignedBox2i
+HierarchicalAStar::get_cluster_bounds(const uint32_t cluster_index) const {
+  const auto cluster_count_x = static_cast<uint32_t>(cluster_counts_.x());
+  const Eigen::Vector2i min_cell =
+      Eigen::Vector2i{static_cast<int>(cluster_index % cluster_count_x),
+                      static_cast<int>(cluster_index / cluster_count_x)} *
+      cluster_size_;
+  const Eigen::Vector2i max_cell =
+      (min_cell + Eigen::Vector2i::Constant(cluster_size_ - 1))
+          .cwiseMin(size_ - Eigen::Vector2i::Ones());
+  return Eigen::AlignedBox2i{min_cell, max_cell};
+}
+
+inline bool
+HierarchicalAStar::is_walkable_in(const Eigen::AlignedBox2i &bounds,
+                                  const Eigen::Vector2i &cell) const {
+  return bounds.contains(cell) && is_walkable_.get(cell);
+}
+
+inline uint32_t
+HierarchicalAStar::get_node(const uint32_t cluster_index,
+                            const std::size_t entrance_index) const {
+  return cluster_index * max_cluster_entrances_ +
+         static_cast<uint32_t>(entrance_index);
+}
+
+inline uint32_t HierarchicalAStar::get_start_node() const {
+  return static_cast<uint32_t>(search_states_.size() - 2UL);
+}
+
+inline uint32_t HierarchicalAStar::get_end_node() const {
+  return static_cast<uint32_t>(search_states_.size() - 1UL);
+}
+
+inline void HierarchicalAStar::rebuild_cluster(const uint32_t cluster_index) {
+  const Eigen::AlignedBox2i bounds = get_cluster_bounds(cluster_index);
+  Cluster &cluster = clusters_[cluster_index];
+  cluster.entrances.clear();
+  cluster.edges.clear();
+  for (const Eigen::Vector2i &direction :
+       {Eigen::Vector2i{1, 0}, Eigen::Vector2i{-1, 0}, Eigen::Vector2i{0, 1},
+        Eigen::Vector2i{0, -1}}) {
+    add_border_entrances(bounds, direction, cluster.entrances);
+  }
+
+  for (Entrance &entrance : cluster.entrances) {
+    entrance.first_edge = static_cast<uint32_t>(cluster.edges.size());
+    for (uint32_t i = 0U; i < entrance.crossing_count; ++i) {
+      // the node is filled in by link_cluster
+      cluster.edges.push_back(Edge{.to_node = 0U,
+                                   .cost = 1.f,
+                                   .to_cell = entrance.crossing_cells[i]});
+    }
+    search_cluster(bounds, entrance.cell, std::nullopt);
+    for (std::size_t i = 0; i < cluster.entrances.size(); ++i) {
+      const Eigen::Vector2i &other_cell = cluster.entrances[i].cell;
+      const float cost = local_costs_[to_local_index(bounds, other_cell)];
+      if (other_cell != entrance.cell && cost != infinity) {
+        cluster.edges.push_back(Edge{.to_node = get_node(cluster_index, i),
+                                     .cost = cost,
+                                     .to_cell = other_cell});
+      }
+    }
+    entrance.edge_count =
+        static_cast<uint32_t>(cluster.edges.size()) - entrance.first_edge;
+  }
+}
+
+inline void HierarchicalAStar::link_cluster(const uint32_t cluster_index) {
+  Cluster &cluster = clusters_[cluster_index];
+  for (const Entrance &entrance : cluster.entrances) {
+    for (uint32_t i = 0U; i < entrance.crossing_count; ++i) {
+      Edge &edge = cluster.edges[entrance.first_edge + i];
+      const uint32_t other_cluster_index = get_cluster_index(edge.to_cell);
+      const auto &other_entrances = clusters_[other_cluster_index].entrances;
+      // both sides of a border pick the same crossings, so this always finds
+      // one once both clusters are built
+      const auto other_entrance = std::find_if(
+          other_entrances.begin(), other_entrances.end(),
+          [&edge](const Entrance &other) { return other.cell == edge.to_cell; });
+      edge.to_node = get_node(other_cluster_index,
+                              static_cast<std::size_t>(std::distance(
+                                  other_entrances.begin(), other_entrance)));
+    }
+  }
+}
+
+inline void
+HierarchicalAStar::add_border_entrances(const Eigen::AlignedBox2i &bounds,
+                                        const Eigen::Vector2i &direction,
+                                        std::vector<Entrance> &entrances) const {
+  // the border is the row or column of the cluster facing direction, walked
+  // along the other axis
+  const int axis = direction.x() != 0 ? 0 : 1;
+  const int other_axis = 1 - axis;
+  Eigen::Vector2i first_cell = bounds.min();
+  if (direction[axis] > 0) {
+    first_cell[axis] = bounds.max()[axis];
+  }
+  if (!is_in_grid(first_cell + direction)) {
+    return;
+  }
+  const int border_length = bounds.sizes()[other_axis] + 1;
+
+  const auto add_entrance = [&](const int offset) {
+    Eigen::Vector2i cell = first_cell;
+    cell[other_axis] += offset;
+    // corner cells can be on two borders
+    auto entrance = std::find_if(
+        entrances.begin(), entrances.end(),
+        [&cell](const Entrance &other) { return other.cell == cell; });
+    if (entrance == entrances.end()) {
+      entrances.push_back(Entrance{.cell = cell});
+      entrance = std::prev(entrances.end());
+    }
+    entrance->crossing_cells[entrance->crossing_count++] = cell + direction;
+  };
+
+  int opening_start = 0;
+  for (int offset = 0; offset <= border_length; ++offset) {
+    Eigen::Vector2i cell = first_cell;
+    cell[other_axis] += offset;
+    const bool is_open = offset < border_length && is_walkable_.get(cell) &&
+                         is_walkable_.get(cell + direction);
+    if (is_open) {
+      continue;
+    }
+    // both sides walk the border the same way, so they pick the same cells
+    const int opening_width = offset - opening_start;
+    if (opening_width >= min_double_entrance_width) {
+      add_entrance(opening_start);
+      add_entrance(offset - 1);
+    } else if (opening_width > 0) {
+      add_entrance(opening_start + (opening_width - 1) / 2);
+    }
+    opening_start = offset + 1;
+  }
+}
+
+inline bool HierarchicalAStar::search_cluster(
+    const Eigen::AlignedBox2i &bounds, const Eigen::Vector2i &source,
+    const std::optional<Eigen::Vector2i> &maybe_target) {
+  std::fill(local_costs_.begin(), local_costs_.end(), infinity);
+  const auto heuristic = [&maybe_target](const Eigen::Vector2i &cell) {
+    return maybe_target.has_value() ? OctileHeuristic{*maybe_target}(cell)
+                                    : 0.f;
+  };
+  const uint32_t source_index = to_local_index(bounds, source);
+  const uint32_t target_index = maybe_target.has_value()
+                                    ? to_local_index(bounds, *maybe_target)
+                                    : std::numeric_limits<uint32_t>::max();
+
+  local_frontier_.clear();
+  local_costs_[source_index] = 0.f;
+  local_frontier_.push_back(
+      FrontierEntry{.priority = heuristic(source), .index = source_index});
+  while (!local_frontier_.empty()) {
+    std::pop_heap(local_frontier_.begin(), local_frontier_.end());
+    const FrontierEntry entry = local_frontier_.back();
+    local_frontier_.pop_back();
+    if (entry.index == target_index) {
+      return true;
+    }
+    const Eigen::Vector2i cell = to_cluster_cell(bounds, entry.index);
+    const float cost = local_costs_[entry.index];
+    if (entry.priority > cost + heuristic(cell)) {
+      // stale entry, the cell was reached more cheaply since
+      continue;
+    }
+    const auto neighbors = get_grid_neighbors(
+        cell, [this, &bounds](const Eigen::Vector2i &neighbor) {
+          return is_walkable_in(bounds, neighbor);
+        });
+    for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+      const Eigen::Vector2i &neighbor = neighbors.neighbor_array[i];
+      const uint32_t neighbor_index = to_local_index(bounds, neighbor);
+      const float neighbor_cost = cost + GridStepCost{}(cell, neighbor);
+      if (neighbor_cost < local_costs_[neighbor_index]) {
+        local_costs_[neighbor_index] = neighbor_cost;
+        local_came_from_[neighbor_index] = entry.index;
+        local_frontier_.push_back(
+            FrontierEntry{.priority = neighbor_cost + heuristic(neighbor),
+                          .index = neighbor_index});
+        std::push_heap(local_frontier_.begin(), local_frontier_.end());
+      }
+    }
+  }
+  return false;
+}
+
+inline uint32_t
+HierarchicalAStar::to_local_index(const Eigen::AlignedBox2i &bounds,
+                                  const Eigen::Vector2i &cell) const {
+  const Eigen::Vector2i offset = cell - bounds.min();
+  return static_cast<uint32_t>(offset.x() + offset.y() * cluster_size_);
+}
+
+inline Eigen::Vector2i
+HierarchicalAStar::to_cluster_cell(const Eigen::AlignedBox2i &bounds,
+                                   const uint32_t local_index) const {
+  const auto cluster_size = static_cast<uint32_t>(cluster_size_);
+  return bounds.min() +
+         Eigen::Vector2i{static_cast<int>(local_index % cluster_size),
+                         static_cast<int>(local_index / cluster_size)};
+}
+
+inline bool HierarchicalAStar::find_abstract_path(const Eigen::Vector2i &start,
+                                                  const Eigen::Vector2i &end) {
+  const uint32_t start_cluster_index = get_cluster_index(start);
+  const Eigen::AlignedBox2i start_bounds =
+      get_cluster_bounds(start_cluster_index);
+  const auto &start_entrances = clusters_[start_cluster_index].entrances;
+  search_cluster(start_bounds, start, std::nullopt);
+  start_edges_.clear();
+  for (std::size_t i = 0; i < start_entrances.size(); ++i) {
+    const float cost =
+        local_costs_[to_local_index(start_bounds, start_entrances[i].cell)];
+    if (cost != infinity) {
+      start_edges_.push_back(
+          Edge{.to_node = get_node(start_cluster_index, i),
+               .cost = cost,
+               .to_cell = start_entrances[i].cell});
+    }
+  }
+
+  // moves are symmetric, so the costs from end are the costs to it
+  const uint32_t end_cluster_index = get_cluster_index(end);
+  const Eigen::AlignedBox2i end_bounds = get_cluster_bounds(end_cluster_index);
+  const auto &end_entrances = clusters_[end_cluster_index].entrances;
+  search_cluster(end_bounds, end, std::nullopt);
+  for (std::size_t i = 0; i < end_entrances.size(); ++i) {
+    end_costs_[i] =
+        local_costs_[to_local_index(end_bounds, end_entrances[i].cell)];
+  }
+
+  ++current_generation_;
+  if (current_generation_ == 0U) {
+    // after 2^32 searches old stamps could look current again
+    for (auto &state : search_states_) {
+      state.generation = 0U;
+    }
+    current_generation_ = 1U;
+  }
+  const OctileHeuristic heuristic{end};
+  const uint32_t start_node = get_start_node();
+  const uint32_t end_node = get_end_node();
+  search_states_[start_node] =
+      SearchState{.generation = current_generation_,
+                  .cost_so_far = 0.f,
+                  .came_from = start_node};
+  frontier_.clear();
+  frontier_.push_back(
+      FrontierEntry{.priority = heuristic(start), .index = start_node});
+
+  const auto relax = [&](const uint32_t from_node, const float from_cost,
+                         const Edge &edge) {
+    const float cost = from_cost + edge.cost;
+    SearchState &state = search_states_[edge.to_node];
+    if (state.generation == current_generation_ && cost >= state.cost_so_far) {
+      return;
+    }
+    state = SearchState{.generation = current_generation_,
+                        .cost_so_far = cost,
+                        .came_from = from_node};
+    frontier_.push_back(FrontierEntry{
+        .priority = cost + heuristic(edge.to_cell), .index = edge.to_node});
+    std::push_heap(frontier_.begin(), frontier_.end());
+  };
+
+  bool found_path = false;
+  while (!frontier_.empty()) {
+    std::pop_heap(frontier_.begin(), frontier_.end());
+    const FrontierEntry entry = frontier_.back();
+    frontier_.pop_back();
+    if (entry.index == end_node) {
+      found_path = true;
+      break;
+    }
+    const float cost = search_states_[entry.index].cost_so_far;
+    if (entry.index == start_node) {
+      ++expanded_node_count_;
+      for (const Edge &edge : start_edges_) {
+        relax(entry.index, cost, edge);
+      }
+      continue;
+    }
+
+    const uint32_t cluster_index = entry.index / max_cluster_entrances_;
+    const uint32_t entrance_index = entry.index % max_cluster_entrances_;
+    const Cluster &cluster = clusters_[cluster_index];
+    const Entrance &entrance = cluster.entrances[entrance_index];
+    if (entry.priority > cost + heuristic(entrance.cell)) {
+      // stale entry, the entrance was reached more cheaply since
+      continue;
+    }
+    ++expanded_node_count_;
+    const Edge *edges = cluster.edges.data() + entrance.first_edge;
+    for (uint32_t i = 0U; i < entrance.edge_count; ++i) {
+      relax(entry.index, cost, edges[i]);
+    }
+    if (cluster_index == end_cluster_index &&
+        end_costs_[entrance_index] != infinity) {
+      relax(entry.index, cost,
+            Edge{.to_node = end_node,
+                 .cost = end_costs_[entrance_index],
+                 .to_cell = end});
+    }
+  }
+  if (!found_path) {
+    return false;
+  }
+
+  // walk back from the end then flip, came_from only links backwards
+  abstract_path_.clear();
+  abstract_path_.push_back(end);
+  for (uint32_t node = search_states_[end_node].came_from; node != start_node;
+       node = search_states_[node].came_from) {
+    abstract_path_.push_back(
+        clusters_[node / max_cluster_entrances_]
+            .entrances[node % max_cluster_entrances_]
+            .cell);
+  }
+  abstract_path_.push_back(start);
+  std::reverse(abstract_path_.begin(), abstract_path_.end());
+  return true;
+}
+
+inline bool
+HierarchicalAStar::append_cluster_path(const Eigen::Vector2i &from,
+                                       const Eigen::Vector2i &to,
+                                       std::vector<Eigen::Vector2i> &path) {
+  if (from == to) {
+    return true;
+  }
+  const Eigen::AlignedBox2i bounds =
+      get_cluster_bounds(get_cluster_index(from));
+  if (!search_cluster(bounds, from, to)) {
+    return false;
+  }
+  // walk back from the target then flip, came_from only links backwards
+  cluster_path_.clear();
+  const uint32_t from_index = to_local_index(bounds, from);
+  for (uint32_t index = to_local_index(bounds, to); index != from_index;
+       index = local_came_from_[index]) {
+    cluster_path_.push_back(to_cluster_cell(bounds, index));
+  }
+  path.insert(path.end(), cluster_path_.rbegin(), cluster_path_.rend());
+  return true;
+}
+
+} // namespace algs
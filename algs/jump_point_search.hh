@@ -0,0 +1,90 @@
+#pragma once
+#include "algs/a_star.hh"
+#include "algs/grid_a_star.hh"
+#include "utility/try.hh"
+#include <Eigen/Dense>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace algs {
+
+/**
+ * @brief Jump Point Search for uniform cost 8-connected grids
+ *
+ * Finds paths as cheap as GridAStar with GridStepCost and the corner cutting
+ * rule of get_grid_neighbors, but only puts jump points on the frontier.
+ * Straight and diagonal runs through open cells are scanned without touching
+ * the heap and stop where a wall forces a turn, so far fewer cells are
+ * expanded. The result is still every cell along the path.
+ *
+ * Only valid when every step costs the same as in GridStepCost, use
+ * GridAStar for weighted grids.
+ */
+class JumpPointSearch {
+public:
+  /**
+   * @param size number of cells along x and y
+   * @param min_cell coordinates of the cell stored first, cells outside of
+   * [min_cell, min_cell + size) are never visited
+   */
+  explicit JumpPointSearch(const Eigen::Vector2i &size,
+                           const Eigen::Vector2i &min_cell = {0, 0});
+
+  /**
+   * @brief Find the cheapest path from start to end
+   *
+   * If end can't be reached the path leads to the jump point with the lowest
+   * heuristic instead, which may differ from the cell GridAStar picks.
+   *
+   * @param is_walkable called as bool(const Eigen::Vector2i &), must return
+   * false for cells off the grid
+   * @param start first cell of the path
+   * @param end cell to find a path to
+   * @param storage_size maximum number of jump points to visit
+   * @param[out] path every cell from start to end (or the closest jump point
+   * found), cleared first so its storage can be reused between searches
+   * @return error if more than storage_size jump points were visited or start
+   * is outside the grid
+   */
+  template <typename IsWalkableFunctor>
+  [[nodiscard]] Result<void, std::string>
+  find_path(const IsWalkableFunctor &is_walkable, const Eigen::Vector2i &start,
+            const Eigen::Vector2i &end, const std::size_t storage_size,
+            std::vector<Eigen::Vector2i> &path);
+
+  /**
+   * @return number of jump points taken off the frontier by the last search
+   */
+  [[nodiscard]] std::size_t get_expanded_node_count() const {
+    return grid_a_star_.get_expanded_node_count();
+  }
+
+private:
+  /// Jump points reachable from cell, pruned by the direction it was entered
+  template <typename IsWalkableFunctor>
+  [[nodiscard]] Neighbors<Eigen::Vector2i, 8>
+  get_successors(const Eigen::Vector2i &cell, const Eigen::Vector2i &end,
+                 const IsWalkableFunctor &is_walkable) const;
+
+  /// Walk from cell in direction until a jump point, end or a wall
+  template <typename IsWalkableFunctor>
+  [[nodiscard]] static std::optional<Eigen::Vector2i>
+  jump(const Eigen::Vector2i &cell, const Eigen::Vector2i &direction,
+       const Eigen::Vector2i &end, const IsWalkableFunctor &is_walkable);
+
+  /// jump for horizontal and vertical directions, stops where a cell beside
+  /// the run can only be reached cheapest through it
+  template <typename IsWalkableFunctor>
+  [[nodiscard]] static std::optional<Eigen::Vector2i>
+  jump_straight(const Eigen::Vector2i &cell, const Eigen::Vector2i &direction,
+                const Eigen::Vector2i &end,
+                const IsWalkableFunctor &is_walkable);
+
+  GridAStar grid_a_star_;
+  /// Path between jump points from the last search, kept for its storage
+  std::vector<Eigen::Vector2i> jump_points_;
+};
+
+} // namespace algs
+#include "algs/jump_point_search.inl"
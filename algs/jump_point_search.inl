@@ -0,0 +1,174 @@
+#pragma once
+
+namespace algs {
+
+inline JumpPointSearch::JumpPointSearch(const Eigen::Vector2i &size,
+                                        const Eigen::Vector2i &min_cell)
+    : grid_a_star_(size, min_cell) {}
+
+template <typename IsWalkableFunctor>
+Result<void, std::string> JumpPointSearch::find_path(
+    const IsWalkableFunctor &is_walkable, const Eigen::Vector2i &start,
+    const Eigen::Vector2i &end, const std::size_t storage_size,
+    std::vector<Eigen::Vector2i> &path) {
+  path.clear();
+  // runs between jump points are straight or diagonal, so the octile
+  // distance is their exact cost
+  const auto distance_func = [](const Eigen::Vector2i &from,
+                                const Eigen::Vector2i &to) {
+    return OctileHeuristic{to}(from);
+  };
+  const auto get_neighbors = [this, &end,
+                              &is_walkable](const Eigen::Vector2i &cell) {
+    return get_successors(cell, end, is_walkable);
+  };
+  auto result =
+      grid_a_star_.find_path(distance_func, get_neighbors,
+                             OctileHeuristic{end}, start, end, storage_size,
+                             jump_points_);
+  if (result.isErr()) {
+    return result;
+  }
+
+  // fill in the cells skipped over between jump points
+  for (const auto &jump_point : jump_points_) {
+    if (path.empty()) {
+      path.push_back(jump_point);
+      continue;
+    }
+    const Eigen::Vector2i step = (jump_point - path.back()).cwiseSign();
+    while (path.back() != jump_point) {
+      path.push_back(path.back() + step);
+    }
+  }
+  return Ok();
+}
+
+template <typename IsWalkableFunctor>
+Neighbors<Eigen::Vector2i, 8>
+JumpPointSearch::get_successors(const Eigen::Vector2i &cell,
+                                const Eigen::Vector2i &end,
+                                const IsWalkableFunctor &is_walkable) const {
+  Neighbors<Eigen::Vector2i, 8> directions;
+  const auto add_direction = [&directions](const Eigen::Vector2i &direction) {
+    directions.neighbor_array[directions.num_neighbors++] = direction;
+  };
+
+  const auto maybe_parent = grid_a_star_.get_maybe_came_from(cell);
+  if (!maybe_parent.has_value()) {
+    // nothing to prune from at the start
+    const auto neighbors = get_grid_neighbors(cell, is_walkable);
+    for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+      add_direction(neighbors.neighbor_array[i] - cell);
+    }
+  } else {
+    const Eigen::Vector2i direction = (cell - *maybe_parent).cwiseSign();
+    if (direction.x() != 0 && direction.y() != 0) {
+      const Eigen::Vector2i horizontal{direction.x(), 0};
+      const Eigen::Vector2i vertical{0, direction.y()};
+      const bool is_horizontal_walkable = is_walkable(cell + horizontal);
+      const bool is_vertical_walkable = is_walkable(cell + vertical);
+      if (is_horizontal_walkable) {
+        add_direction(horizontal);
+      }
+      if (is_vertical_walkable) {
+        add_direction(vertical);
+      }
+      if (is_horizontal_walkable && is_vertical_walkable) {
+        add_direction(direction);
+      }
+    } else {
+      // without corner cutting a straight run can turn to either side
+      const Eigen::Vector2i side{direction.y(), direction.x()};
+      const bool is_ahead_walkable = is_walkable(cell + direction);
+      for (const Eigen::Vector2i &turn : {side, Eigen::Vector2i{-side}}) {
+        if (is_walkable(cell + turn)) {
+          add_direction(turn);
+          if (is_ahead_walkable) {
+            add_direction(direction + turn);
+          }
+        }
+      }
+      if (is_ahead_walkable) {
+        add_direction(direction);
+      }
+    }
+  }
+
+  Neighbors<Eigen::Vector2i, 8> successors;
+  for (std::size_t i = 0; i < directions.num_neighbors; ++i) {
+    const auto maybe_jump_point =
+        jump(cell, directions.neighbor_array[i], end, is_walkable);
+    if (maybe_jump_point.has_value()) {
+      successors.neighbor_array[successors.num_neighbors++] =
+          *maybe_jump_point;
+    }
+  }
+  return successors;
+}
+
+template <typename IsWalkableFunctor>
+std::optional<Eigen::Vector2i>
+JumpPointSearch::jump(const Eigen::Vector2i &cell,
+                      const Eigen::Vector2i &direction,
+                      const Eigen::Vector2i &end,
+                      const IsWalkableFunctor &is_walkable) {
+  if (direction.x() == 0 || direction.y() == 0) {
+    return jump_straight(cell, direction, end, is_walkable);
+  }
+  const Eigen::Vector2i horizontal{direction.x(), 0};
+  const Eigen::Vector2i vertical{0, direction.y()};
+  Eigen::Vector2i current = cell;
+  while (true) {
+    if (!is_walkable(current + horizontal) ||
+        !is_walkable(current + vertical)) {
+      return std::nullopt;
+    }
+    current += direction;
+    if (!is_walkable(current)) {
+      return std::nullopt;
+    }
+    if (current == end) {
+      return current;
+    }
+    // a diagonal run stops wherever one of its straight runs would
+    if (jump_straight(current, horizontal, end, is_walkable).has_value() ||
+        jump_straight(current, vertical, end, is_walkable).has_value()) {
+      return current;
+    }
+  }
+}
+
+template <typename IsWalkableFunctor>
+std::optional<Eigen::Vector2i>
+JumpPointSearch::jump_straight(const Eigen::Vector2i &cell,
+                               const Eigen::Vector2i &direction,
+                               const Eigen::Vector2i &end,
+                               const IsWalkableFunctor &is_walkable) {
+  const Eigen::Vector2i side{direction.y(), direction.x()};
+  // the cells beside each step are checked once and kept for the next one
+  bool was_left_walkable = is_walkable(cell + side);
+  bool was_right_walkable = is_walkable(cell - side);
+  Eigen::Vector2i current = cell;
+  while (true) {
+    current += direction;
+    if (!is_walkable(current)) {
+      return std::nullopt;
+    }
+    if (current == end) {
+      return current;
+    }
+    const bool is_left_walkable = is_walkable(current + side);
+    const bool is_right_walkable = is_walkable(current - side);
+    // a side cell after a wall can't be reached diagonally from the previous
+    // cell without cutting the wall's corner, so it needs a turn here
+    if ((is_left_walkable && !was_left_walkable) ||
+        (is_right_walkable && !was_right_walkable)) {
+      return current;
+    }
+    was_left_walkable = is_left_walkable;
+    was_right_walkable = is_right_walkable;
+  }
+}
+
+} // namespace algs
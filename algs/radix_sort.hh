@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace algs {
+
+/// Stable least significant digit radix sort on an unsigned 32 bit key
+///
+/// Sorts in up to four passes of 8 bits, passes where every key has the same
+/// digit are skipped so small keys (e.g. a z level) only cost a single pass.
+/// Neither buffer is shrunk, so passing the same buffers every frame avoids
+/// allocating once they have grown to their steady state size.
+///
+/// @tparam ValueType type of the values being sorted, must be copy assignable
+/// @tparam GetKeyFunc callable taking a const ValueType& and returning uint32_t
+/// @param[in,out] values values to sort, sorted in ascending key order on
+/// return with ties kept in their original order
+/// @param[in,out] scratch buffer used during sorting, contents are unspecified
+/// on return
+/// @param[in] get_key function used to compute the sort key for a value
+template <typename ValueType, typename GetKeyFunc>
+void radix_sort(std::vector<ValueType> &values,
+                std::vector<ValueType> &scratch, const GetKeyFunc &get_key);
+
+} // namespace algs
+#include "algs/radix_sort.inl"
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace algs {
+
+template <typename ValueType, typename GetKeyFunc>
+void radix_sort(std::vector<ValueType> &values,
+                std::vector<ValueType> &scratch, const GetKeyFunc &get_key) {
+  static_assert(std::is_invocable_r_v<uint32_t, GetKeyFunc, const ValueType &>,
+                "get_key must map a value to a uint32_t key");
+  constexpr uint32_t bits_per_pass{8U};
+  constexpr uint32_t digit_mask{(1U << bits_per_pass) - 1U};
+  constexpr std::size_t bucket_count{1UL << bits_per_pass};
+
+  scratch.resize(values.size());
+  for (uint32_t shift = 0U; shift < 32U; shift += bits_per_pass) {
+    std::array<std::size_t, bucket_count> bucket_offsets{};
+    for (const auto &value : values) {
+      ++bucket_offsets[(get_key(value) >> shift) & digit_mask];
+    }
+
+    // every key shares this digit so the pass wouldn't change the order
+    if (std::ranges::any_of(bucket_offsets, [&values](const auto count) {
+          return count == values.size();
+        })) {
+      continue;
+    }
+
+    std::size_t offset{0UL};
+    for (auto &bucket_offset : bucket_offsets) {
+      const auto count = bucket_offset;
+      bucket_offset = offset;
+      offset += count;
+    }
+
+    for (const auto &value : values) {
+      scratch[bucket_offsets[(get_key(value) >> shift) & digit_mask]++] =
+          value;
+    }
+    std::swap(values, scratch);
+  }
+}
+
+} // namespace algs
@@ -0,0 +1,38 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algs/bit_grid.hh"
+
+using namespace algs;
+
+TEST_CASE("Bit grid starts cleared and reads false outside", "[bit_grid]") {
+  const BitGrid grid{{30, 30}};
+  CHECK_FALSE(grid.get({0, 0}));
+  CHECK_FALSE(grid.get({29, 29}));
+  CHECK_FALSE(grid.get({-1, 0}));
+  CHECK_FALSE(grid.get({0, 30}));
+}
+
+TEST_CASE("Bit grid set reports changes", "[bit_grid]") {
+  BitGrid grid{{30, 30}};
+  // 63 and 64 land either side of a word boundary
+  for (const Eigen::Vector2i &cell :
+       {Eigen::Vector2i{3, 2}, Eigen::Vector2i{4, 2}, Eigen::Vector2i{29, 29}}) {
+    CHECK(grid.set(cell, true));
+    CHECK_FALSE(grid.set(cell, true));
+    CHECK(grid.get(cell));
+  }
+  CHECK_FALSE(grid.get({5, 2}));
+
+  CHECK(grid.set({3, 2}, false));
+  CHECK_FALSE(grid.get({3, 2}));
+  CHECK(grid.get({4, 2}));
+}
+
+TEST_CASE("Bit grid fill sets every cell", "[bit_grid]") {
+  BitGrid grid{{7, 5}};
+  grid.fill(true);
+  CHECK(grid.get({0, 0}));
+  CHECK(grid.get({6, 4}));
+  CHECK_FALSE(grid.get({7, 4}));
+  grid.fill(false);
+  CHECK_FALSE(grid.get({6, 4}));
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algs/flow_field.hh"
+#include "algs/grid_a_star.hh"
+#include "algs/tests/grid_test_utils.hh"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace algs;
+using namespace algs::test;
+
+namespace {
+/// Follow the field from start until it stops, summing the step costs
+std::pair<Eigen::Vector2i, float> follow(const FlowField &field,
+                                         const Eigen::Vector2i &start) {
+  Eigen::Vector2i cell = start;
+  float cost = 0.f;
+  while (const auto maybe_next = field.get_maybe_next_cell(cell)) {
+    cost += GridStepCost{}(cell, *maybe_next);
+    cell = *maybe_next;
+  }
+  return {cell, cost};
+}
+} // namespace
+
+TEST_CASE("Flow field leads around walls to the goal", "[flow_field]") {
+  const TestGrid grid{{
+      "......",
+      ".####.",
+      "....#.",
+      "....#.",
+  }};
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  FlowField field{grid.get_size()};
+  field.build({5, 3}, is_walkable);
+
+  const auto [end, cost] = follow(field, {0, 3});
+  CHECK(end == Eigen::Vector2i{5, 3});
+  CHECK(std::abs(cost - field.get_cost({0, 3})) < 1e-4f);
+  CHECK(field.get_cost({5, 3}) == 0.f);
+  CHECK(std::isinf(field.get_cost({1, 1})));
+  CHECK_FALSE(field.get_maybe_next_cell({5, 3}).has_value());
+  CHECK_FALSE(field.get_maybe_next_cell({-1, 0}).has_value());
+}
+
+TEST_CASE("Flow field costs match grid A* path costs", "[flow_field]") {
+  std::mt19937 rng(11U);
+  constexpr int size = 20;
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  FlowField field{{size, size}};
+  GridAStar grid_a_star{{size, size}};
+  std::vector<Eigen::Vector2i> path;
+
+  for (int grid_index = 0; grid_index < 50; ++grid_index) {
+    auto grid = make_random_grid(size, 0.3, rng);
+    const Eigen::Vector2i goal{coordinate(rng), coordinate(rng)};
+    grid.set_wall(goal, false);
+    const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+      return grid.is_walkable(cell);
+    };
+    field.build(goal, is_walkable);
+
+    for (int start_index = 0; start_index < 10; ++start_index) {
+      const Eigen::Vector2i start{coordinate(rng), coordinate(rng)};
+      if (!grid.is_walkable(start)) {
+        continue;
+      }
+      REQUIRE(find_grid_path(grid_a_star, grid, start, goal, path).isOk());
+      const auto [end, cost] = follow(field, start);
+      if (path.back() == goal) {
+        CHECK(end == goal);
+        CHECK(std::abs(cost - get_path_cost(path)) < 1e-3f);
+      } else {
+        // both give up at the reachable cell closest to the goal
+        CHECK(OctileHeuristic{goal}(end) ==
+              OctileHeuristic{goal}(path.back()));
+      }
+    }
+  }
+}
+
+TEST_CASE("Flow field leads to the closest cell when the goal is "
+          "unreachable",
+          "[flow_field]") {
+  const TestGrid grid{{
+      "...#..",
+      "...#..",
+      "####..",
+  }};
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  FlowField field{grid.get_size()};
+  // off the grid past the bottom right corner, like a worker's goal
+  field.build({6, 3}, is_walkable);
+
+  CHECK(follow(field, {0, 0}).first == Eigen::Vector2i{2, 1});
+  CHECK(follow(field, {4, 0}).first == Eigen::Vector2i{5, 2});
+}
+
+TEST_CASE("Flow field leads from walls back to walkable cells",
+          "[flow_field]") {
+  const TestGrid grid{{"....", ".##.", "...."}};
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  FlowField field{grid.get_size()};
+  field.build({0, 0}, is_walkable);
+
+  const auto maybe_next = field.get_maybe_next_cell({1, 1});
+  REQUIRE(maybe_next.has_value());
+  CHECK(*maybe_next == Eigen::Vector2i{0, 0});
+  CHECK(follow(field, {2, 1}).first == Eigen::Vector2i{0, 0});
+}
+
+TEST_CASE("Repaired flow fields match fresh builds", "[flow_field]") {
+  std::mt19937 rng(23U);
+  constexpr int size = 20;
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  std::uniform_int_distribution<int> change_count(1, 6);
+  FlowField repaired_field{{size, size}};
+  FlowField built_field{{size, size}};
+
+  auto grid = make_random_grid(size, 0.3, rng);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  const Eigen::Vector2i goal{coordinate(rng), coordinate(rng)};
+  repaired_field.build(goal, is_walkable);
+
+  std::vector<Eigen::Vector2i> changed_cells;
+  for (int update_index = 0; update_index < 200; ++update_index) {
+    changed_cells.clear();
+    for (int i = change_count(rng); i > 0; --i) {
+      const Eigen::Vector2i cell{coordinate(rng), coordinate(rng)};
+      grid.toggle_wall(cell);
+      changed_cells.push_back(cell);
+    }
+    repaired_field.update_cells(changed_cells, is_walkable);
+    built_field.build(goal, is_walkable);
+    // far fewer cells are revisited than a build settles
+    CHECK(repaired_field.get_expanded_node_count() <=
+          built_field.get_expanded_node_count());
+
+    for (int y = -1; y <= size; ++y) {
+      for (int x = -1; x <= size; ++x) {
+        const Eigen::Vector2i cell{x, y};
+        const float repaired_cost = repaired_field.get_cost(cell);
+        const float built_cost = built_field.get_cost(cell);
+        REQUIRE((repaired_cost == built_cost ||
+                 (std::isinf(repaired_cost) && std::isinf(built_cost))));
+        REQUIRE(repaired_field.get_maybe_next_cell(cell) ==
+                built_field.get_maybe_next_cell(cell));
+      }
+    }
+  }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algs/a_star.hh"
+#include "algs/grid_a_star.hh"
+#include "algs/tests/grid_test_utils.hh"
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace algs;
+using namespace algs::test;
+
+TEST_CASE("Grid A* goes straight to the goal on an open grid",
+          "[grid_a_star]") {
+  const TestGrid grid{{"......", "......", "......", "......"}};
+  GridAStar grid_a_star{grid.get_size()};
+  std::vector<Eigen::Vector2i> path;
+
+  REQUIRE(find_grid_path(grid_a_star, grid, {0, 0}, {5, 3}, path).isOk());
+  REQUIRE(path.size() == 6UL);
+  CHECK(path.front() == Eigen::Vector2i{0, 0});
+  CHECK(path.back() == Eigen::Vector2i{5, 3});
+  CHECK(is_valid_path(grid, path));
+  CHECK(std::abs(get_path_cost(path) -
+                 (2.f + 3.f * GridStepCost::diagonal_step_cost)) < 1e-4f);
+}
+
+TEST_CASE("Grid A* finds paths as cheap as a_star around walls",
+          "[grid_a_star]") {
+  const TestGrid grid{{
+      "........",
+      ".######.",
+      "......#.",
+      "####..#.",
+      "......#.",
+      ".######.",
+      "........",
+  }};
+  GridAStar grid_a_star{grid.get_size()};
+  std::vector<Eigen::Vector2i> path;
+  const Eigen::Vector2i start{0, 2};
+  const Eigen::Vector2i end{0, 4};
+
+  REQUIRE(find_grid_path(grid_a_star, grid, start, end, path).isOk());
+  CHECK(path.front() == start);
+  CHECK(path.back() == end);
+  CHECK(is_valid_path(grid, path));
+
+  std::optional<std::deque<Eigen::Vector2i>> maybe_a_star_path;
+  REQUIRE(a_star<Eigen::Vector2i, 8>(
+              GridStepCost{},
+              [&grid](const Eigen::Vector2i &cell) {
+                return grid.get_neighbors(cell);
+              },
+              OctileHeuristic{end}, start, end, 1000UL, maybe_a_star_path)
+              .isOk());
+  REQUIRE(maybe_a_star_path.has_value());
+  const std::vector<Eigen::Vector2i> a_star_path(maybe_a_star_path->begin(),
+                                                 maybe_a_star_path->end());
+  CHECK(std::abs(get_path_cost(path) - get_path_cost(a_star_path)) < 1e-4f);
+}
+
+TEST_CASE("Grid A* diagonal moves don't cut corners", "[grid_a_star]") {
+  const TestGrid grid{{"..", "#."}};
+  const auto neighbors = grid.get_neighbors({0, 0});
+
+  std::set<std::pair<int, int>> cells;
+  for (std::size_t i = 0; i < neighbors.num_neighbors; ++i) {
+    cells.emplace(neighbors.neighbor_array[i].x(),
+                  neighbors.neighbor_array[i].y());
+  }
+  CHECK(cells == std::set<std::pair<int, int>>{{1, 0}});
+}
+
+TEST_CASE("Grid A* leads to the closest cell when the goal is unreachable",
+          "[grid_a_star]") {
+  const TestGrid grid{{"...#.", "...#.", "...#."}};
+  GridAStar grid_a_star{grid.get_size()};
+  std::vector<Eigen::Vector2i> path;
+
+  REQUIRE(find_grid_path(grid_a_star, grid, {0, 1}, {4, 1}, path).isOk());
+  CHECK(path.front() == Eigen::Vector2i{0, 1});
+  CHECK(path.back() == Eigen::Vector2i{2, 1});
+}
+
+TEST_CASE("Grid A* returns an error when the storage size is exceeded",
+          "[grid_a_star]") {
+  const TestGrid grid{{"..........", "..........", "..........",
+                       "..........", ".........."}};
+  GridAStar grid_a_star{grid.get_size()};
+  std::vector<Eigen::Vector2i> path;
+
+  CHECK(find_grid_path(grid_a_star, grid, {0, 0}, {9, 4}, path, 4UL).isErr());
+}
+
+TEST_CASE("Grid A* returns an error when starting outside the grid",
+          "[grid_a_star]") {
+  const TestGrid grid{{"...", "..."}};
+  GridAStar grid_a_star{grid.get_size()};
+  std::vector<Eigen::Vector2i> path;
+
+  CHECK(find_grid_path(grid_a_star, grid, {-1, 0}, {2, 1}, path).isErr());
+  CHECK(find_grid_path(grid_a_star, grid, {3, 0}, {2, 1}, path).isErr());
+}
+
+TEST_CASE("Grid A* forgets the previous search when reused",
+          "[grid_a_star]") {
+  TestGrid grid{{".....", ".....", "....."}};
+  GridAStar grid_a_star{grid.get_size()};
+  std::vector<Eigen::Vector2i> path;
+
+  REQUIRE(find_grid_path(grid_a_star, grid, {0, 1}, {4, 1}, path).isOk());
+  CHECK(path.size() == 5UL);
+
+  // a wall appearing between searches is seen by the next one
+  grid.rows = {"..#..", "..#..", "....."};
+  REQUIRE(find_grid_path(grid_a_star, grid, {0, 0}, {4, 0}, path).isOk());
+  CHECK(path.front() == Eigen::Vector2i{0, 0});
+  CHECK(path.back() == Eigen::Vector2i{4, 0});
+  CHECK(is_valid_path(grid, path));
+  CHECK(std::abs(get_path_cost(path) -
+                 (4.f + 2.f * GridStepCost::diagonal_step_cost)) < 1e-4f);
+}
+
+TEST_CASE("Grid A* works on grids which don't start at the origin",
+          "[grid_a_star]") {
+  const Eigen::Vector2i min_cell{-10, 5};
+  GridAStar grid_a_star{{4, 4}, min_cell};
+  std::vector<Eigen::Vector2i> path;
+  const auto get_neighbors = [&min_cell](const Eigen::Vector2i &cell) {
+    return get_grid_neighbors(cell, [&min_cell](const Eigen::Vector2i &next) {
+      const Eigen::Vector2i offset = next - min_cell;
+      return offset.minCoeff() >= 0 && offset.maxCoeff() < 4;
+    });
+  };
+  const Eigen::Vector2i end = min_cell + Eigen::Vector2i{3, 3};
+
+  REQUIRE(grid_a_star
+              .find_path(GridStepCost{}, get_neighbors, OctileHeuristic{end},
+                         min_cell, end, 100UL, path)
+              .isOk());
+  CHECK(path.size() == 4UL);
+  CHECK(path.back() == end);
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "algs/grid_a_star.hh"
+#include <Eigen/Dense>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace algs::test {
+
+/// Grid where '#' is a wall, row 0 is the first string
+struct TestGrid {
+  std::vector<std::string> rows;
+
+  [[nodiscard]] Eigen::Vector2i get_size() const {
+    return {static_cast<int>(rows.front().size()),
+            static_cast<int>(rows.size())};
+  }
+
+  [[nodiscard]] bool is_walkable(const Eigen::Vector2i &cell) const {
+    return cell.x() >= 0 && cell.y() >= 0 && cell.x() < get_size().x() &&
+           cell.y() < get_size().y() && rows[cell.y()][cell.x()] != '#';
+  }
+
+  [[nodiscard]] Neighbors<Eigen::Vector2i, 8>
+  get_neighbors(const Eigen::Vector2i &cell) const {
+    return get_grid_neighbors(cell, [this](const Eigen::Vector2i &neighbor) {
+      return is_walkable(neighbor);
+    });
+  }
+
+  void set_wall(const Eigen::Vector2i &cell, const bool is_wall) {
+    rows[cell.y()][cell.x()] = is_wall ? '#' : '.';
+  }
+
+  void toggle_wall(const Eigen::Vector2i &cell) {
+    set_wall(cell, is_walkable(cell));
+  }
+};
+
+[[nodiscard]] inline TestGrid make_open_grid(const int size) {
+  return TestGrid{std::vector<std::string>(size, std::string(size, '.'))};
+}
+
+[[nodiscard]] inline TestGrid make_random_grid(const int size,
+                                               const double wall_probability,
+                                               std::mt19937 &rng) {
+  std::bernoulli_distribution is_wall(wall_probability);
+  auto grid = make_open_grid(size);
+  for (auto &row : grid.rows) {
+    for (auto &cell : row) {
+      cell = is_wall(rng) ? '#' : '.';
+    }
+  }
+  return grid;
+}
+
+[[nodiscard]] inline float
+get_path_cost(const std::vector<Eigen::Vector2i> &path) {
+  float cost = 0.f;
+  for (std::size_t i = 1; i < path.size(); ++i) {
+    cost += GridStepCost{}(path[i - 1], path[i]);
+  }
+  return cost;
+}
+
+/// Every step moves to a walkable neighbor without cutting a corner
+[[nodiscard]] inline bool
+is_valid_path(const TestGrid &grid, const std::vector<Eigen::Vector2i> &path) {
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    if (!grid.is_walkable(path[i])) {
+      return false;
+    }
+    if (i == 0) {
+      continue;
+    }
+    const Eigen::Vector2i step = path[i] - path[i - 1];
+    if (step.cwiseAbs().maxCoeff() != 1 ||
+        !grid.is_walkable(path[i - 1] + Eigen::Vector2i{step.x(), 0}) ||
+        !grid.is_walkable(path[i - 1] + Eigen::Vector2i{0, step.y()})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Cheapest path by plain grid A*, the reference the other searches are
+/// checked against
+[[nodiscard]] inline Result<void, std::string>
+find_grid_path(GridAStar &grid_a_star, const TestGrid &grid,
+               const Eigen::Vector2i &start, const Eigen::Vector2i &end,
+               std::vector<Eigen::Vector2i> &path,
+               const std::size_t storage_size = 100'000UL) {
+  return grid_a_star.find_path(
+      GridStepCost{},
+      [&grid](const Eigen::Vector2i &cell) {
+        return grid.get_neighbors(cell);
+      },
+      OctileHeuristic{end}, start, end, storage_size, path);
+}
+
+} // namespace algs::test
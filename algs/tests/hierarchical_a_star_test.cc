@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algs/grid_a_star.hh"
+#include "algs/hierarchical_a_star.hh"
+#include "algs/tests/grid_test_utils.hh"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace algs;
+using namespace algs::test;
+
+TEST_CASE("Hierarchical A* finds paths through several clusters",
+          "[hierarchical_a_star]") {
+  // a wall across the middle with a single gap at the far end
+  auto grid = make_open_grid(20);
+  for (int x = 0; x < 19; ++x) {
+    grid.set_wall({x, 10}, true);
+  }
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  HierarchicalAStar hierarchical_a_star{{20, 20}, 4};
+  hierarchical_a_star.build(is_walkable);
+  CHECK(hierarchical_a_star.get_rebuilt_cluster_count() == 25UL);
+  CHECK(hierarchical_a_star.get_entrance_count() > 0UL);
+
+  std::vector<Eigen::Vector2i> path;
+  REQUIRE(hierarchical_a_star.find_path({0, 0}, {0, 19}, path).isOk());
+  CHECK(path.front() == Eigen::Vector2i{0, 0});
+  CHECK(path.back() == Eigen::Vector2i{0, 19});
+  CHECK(is_valid_path(grid, path));
+  CHECK(std::find(path.begin(), path.end(), Eigen::Vector2i{19, 10}) !=
+        path.end());
+
+  REQUIRE(hierarchical_a_star.find_path({1, 1}, {2, 2}, path).isOk());
+  CHECK(path.size() == 2UL);
+
+  CHECK(hierarchical_a_star.find_path({0, 0}, {0, 10}, path).isErr());
+  CHECK(path.empty());
+  CHECK(hierarchical_a_star.find_path({-1, 0}, {0, 19}, path).isErr());
+}
+
+TEST_CASE("Hierarchical A* paths are close to the cheapest path",
+          "[hierarchical_a_star]") {
+  std::mt19937 rng(5U);
+  constexpr int size = 48;
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  GridAStar grid_a_star{{size, size}};
+  std::vector<Eigen::Vector2i> grid_path;
+  std::vector<Eigen::Vector2i> path;
+
+  for (int grid_index = 0; grid_index < 20; ++grid_index) {
+    const auto grid = make_random_grid(size, 0.25f, rng);
+    const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+      return grid.is_walkable(cell);
+    };
+    HierarchicalAStar hierarchical_a_star{{size, size}, 8};
+    hierarchical_a_star.build(is_walkable);
+
+    for (int query_index = 0; query_index < 20; ++query_index) {
+      const Eigen::Vector2i start{coordinate(rng), coordinate(rng)};
+      const Eigen::Vector2i end{coordinate(rng), coordinate(rng)};
+      if (!grid.is_walkable(start) || !grid.is_walkable(end)) {
+        continue;
+      }
+      REQUIRE(find_grid_path(grid_a_star, grid, start, end, grid_path).isOk());
+      const bool is_reachable = grid_path.back() == end;
+      const auto result = hierarchical_a_star.find_path(start, end, path);
+      // same connectivity as the grid
+      REQUIRE(result.isOk() == is_reachable);
+      if (!is_reachable) {
+        continue;
+      }
+      CHECK(path.front() == start);
+      CHECK(path.back() == end);
+      CHECK(is_valid_path(grid, path));
+      CHECK(get_path_cost(path) >= get_path_cost(grid_path) - 1e-3f);
+      CHECK(get_path_cost(path) <= get_path_cost(grid_path) * 1.5f + 4.f);
+    }
+  }
+}
+
+TEST_CASE("Hierarchical A* updates match fresh builds",
+          "[hierarchical_a_star]") {
+  std::mt19937 rng(17U);
+  constexpr int size = 40;
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  auto grid = make_random_grid(size, 0.25f, rng);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  HierarchicalAStar updated{{size, size}, 8};
+  updated.build(is_walkable);
+  std::vector<Eigen::Vector2i> updated_path;
+  std::vector<Eigen::Vector2i> built_path;
+
+  for (int update_index = 0; update_index < 100; ++update_index) {
+    std::vector<Eigen::Vector2i> changed_cells;
+    for (int i = 0; i < 3; ++i) {
+      const Eigen::Vector2i cell{coordinate(rng), coordinate(rng)};
+      grid.toggle_wall(cell);
+      changed_cells.push_back(cell);
+    }
+    updated.update_cells(changed_cells, is_walkable);
+    // each change touches at most its own cluster and two neighbors
+    CHECK(updated.get_rebuilt_cluster_count() <= 9UL);
+    HierarchicalAStar built{{size, size}, 8};
+    built.build(is_walkable);
+    REQUIRE(updated.get_entrance_count() == built.get_entrance_count());
+
+    const Eigen::Vector2i start{coordinate(rng), coordinate(rng)};
+    const Eigen::Vector2i end{coordinate(rng), coordinate(rng)};
+    const auto updated_result = updated.find_path(start, end, updated_path);
+    const auto built_result = built.find_path(start, end, built_path);
+    REQUIRE(updated_result.isOk() == built_result.isOk());
+    CHECK(updated_path == built_path);
+  }
+}
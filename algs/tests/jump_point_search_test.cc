@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algs/grid_a_star.hh"
+#include "algs/jump_point_search.hh"
+#include "algs/tests/grid_test_utils.hh"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace algs;
+using namespace algs::test;
+
+TEST_CASE("Jump point search goes straight across an open grid",
+          "[jump_point_search]") {
+  const auto grid = make_open_grid(16);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  JumpPointSearch jump_point_search{{16, 16}};
+  std::vector<Eigen::Vector2i> path;
+
+  REQUIRE(
+      jump_point_search.find_path(is_walkable, {0, 0}, {15, 15}, 100UL, path)
+          .isOk());
+  CHECK(path.size() == 16UL);
+  CHECK(path.back() == Eigen::Vector2i{15, 15});
+  CHECK(is_valid_path(grid, path));
+  // the diagonal run goes straight to the goal
+  CHECK(jump_point_search.get_expanded_node_count() == 1UL);
+}
+
+TEST_CASE("Jump point search paths cost the same as grid A*",
+          "[jump_point_search]") {
+  std::mt19937 rng(7U);
+  constexpr int size = 24;
+  JumpPointSearch jump_point_search{{size, size}};
+  GridAStar grid_a_star{{size, size}};
+  std::vector<Eigen::Vector2i> jump_point_path;
+  std::vector<Eigen::Vector2i> a_star_path;
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+
+  for (int grid_index = 0; grid_index < 200; ++grid_index) {
+    const float wall_probability = 0.05f * static_cast<float>(grid_index % 8);
+    auto grid = make_random_grid(size, wall_probability, rng);
+    const Eigen::Vector2i start{coordinate(rng), coordinate(rng)};
+    const Eigen::Vector2i end{coordinate(rng), coordinate(rng)};
+    grid.set_wall(start, false);
+    grid.set_wall(end, false);
+    const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+      return grid.is_walkable(cell);
+    };
+
+    REQUIRE(jump_point_search
+                .find_path(is_walkable, start, end, size * size,
+                           jump_point_path)
+                .isOk());
+    REQUIRE(
+        find_grid_path(grid_a_star, grid, start, end, a_star_path).isOk());
+
+    CHECK(jump_point_path.front() == start);
+    CHECK(is_valid_path(grid, jump_point_path));
+    // both reach the goal or neither does
+    CHECK((jump_point_path.back() == end) == (a_star_path.back() == end));
+    if (a_star_path.back() == end) {
+      CHECK(std::abs(get_path_cost(jump_point_path) -
+                     get_path_cost(a_star_path)) < 1e-3f);
+    }
+  }
+}
+
+TEST_CASE("Jump point search returns an error when the storage size is "
+          "exceeded",
+          "[jump_point_search]") {
+  // columns of walls with alternating gaps force a jump point at every gap
+  auto grid = make_open_grid(9);
+  for (int x = 1; x < 9; x += 2) {
+    for (int y = 0; y < 9; ++y) {
+      grid.set_wall({x, y}, y != ((x / 2) % 2 == 0 ? 8 : 0));
+    }
+  }
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+  JumpPointSearch jump_point_search{{9, 9}};
+  std::vector<Eigen::Vector2i> path;
+
+  CHECK(jump_point_search.find_path(is_walkable, {0, 0}, {8, 8}, 3UL, path)
+            .isErr());
+  REQUIRE(jump_point_search.find_path(is_walkable, {0, 0}, {8, 8}, 100UL, path)
+              .isOk());
+  CHECK(path.back() == Eigen::Vector2i{8, 8});
+  CHECK(is_valid_path(grid, path));
+}
@@ -0,0 +1,340 @@
+#include "algs/a_star.hh"
+#include "algs/flow_field.hh"
+#include "algs/grid_a_star.hh"
+#include "algs/hierarchical_a_star.hh"
+#include "algs/jump_point_search.hh"
+#include "benchmarks/grid_fixtures.hh"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <utility>
+
+namespace {
+
+Eigen::Vector2i get_far_corner(const benchmarks::Grid &grid) {
+  return {grid.size - 1, grid.size - 1};
+}
+
+void run_a_star(benchmark::State &state, const benchmarks::Grid &grid,
+                const Eigen::Vector2i &start, const Eigen::Vector2i &goal) {
+  const auto storage_size = static_cast<std::size_t>(grid.size * grid.size);
+
+  const auto distance_func = [](const Eigen::Vector2i &a,
+                                const Eigen::Vector2i &b) {
+    return (a - b).cast<float>().norm();
+  };
+  const auto get_neighbors = [&grid](const Eigen::Vector2i &cell) {
+    return benchmarks::get_grid_neighbors(grid, cell);
+  };
+  const auto heuristic_func = [&goal](const Eigen::Vector2i &cell) {
+    return (cell - goal).cast<float>().norm();
+  };
+
+  std::size_t path_length = 0;
+  for (auto _ : state) {
+    std::optional<std::deque<Eigen::Vector2i>> maybe_path;
+    const auto result = algs::a_star<Eigen::Vector2i, 8>(
+        distance_func, get_neighbors, heuristic_func, start, goal,
+        storage_size, maybe_path);
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+    path_length = maybe_path->size();
+    benchmark::DoNotOptimize(maybe_path);
+  }
+  state.counters["path_length"] = static_cast<double>(path_length);
+}
+
+void BM_AStarOpenGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_open_grid(state.range(0));
+  run_a_star(state, grid, {0, 0}, get_far_corner(grid));
+}
+BENCHMARK(BM_AStarOpenGrid)->Arg(30)->Arg(128)->Arg(512);
+
+void BM_AStarMazeGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_maze_grid(state.range(0));
+  run_a_star(state, grid, {0, 0}, get_far_corner(grid));
+}
+BENCHMARK(BM_AStarMazeGrid)->Arg(30)->Arg(128)->Arg(512);
+
+template <int64_t size> void BM_AStarCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto start = benchmarks::get_first_walkable_cell(grid);
+  run_a_star(state, grid, start,
+             benchmarks::get_farthest_reachable_cell(grid, start));
+}
+BENCHMARK_TEMPLATE(BM_AStarCaveGrid, 30);
+BENCHMARK_TEMPLATE(BM_AStarCaveGrid, 128);
+BENCHMARK_TEMPLATE(BM_AStarCaveGrid, 512);
+
+void run_grid_a_star(benchmark::State &state, const benchmarks::Grid &grid,
+                     const Eigen::Vector2i &start,
+                     const Eigen::Vector2i &goal) {
+  const auto storage_size = static_cast<std::size_t>(grid.size * grid.size);
+
+  const auto get_neighbors = [&grid](const Eigen::Vector2i &cell) {
+    return benchmarks::get_grid_neighbors(grid, cell);
+  };
+
+  // kept between searches the way callers are meant to use it
+  algs::GridAStar grid_a_star({grid.size, grid.size});
+  std::vector<Eigen::Vector2i> path;
+  for (auto _ : state) {
+    const auto result =
+        grid_a_star.find_path(algs::GridStepCost{}, get_neighbors,
+                              algs::OctileHeuristic{goal}, start, goal,
+                              storage_size, path);
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(path.data());
+  }
+  state.counters["path_length"] = static_cast<double>(path.size());
+  state.counters["expanded_nodes"] =
+      static_cast<double>(grid_a_star.get_expanded_node_count());
+}
+
+void BM_GridAStarOpenGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_open_grid(state.range(0));
+  run_grid_a_star(state, grid, {0, 0}, get_far_corner(grid));
+}
+BENCHMARK(BM_GridAStarOpenGrid)->Arg(30)->Arg(128)->Arg(512);
+
+void BM_GridAStarMazeGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_maze_grid(state.range(0));
+  run_grid_a_star(state, grid, {0, 0}, get_far_corner(grid));
+}
+BENCHMARK(BM_GridAStarMazeGrid)->Arg(30)->Arg(128)->Arg(512);
+
+template <int64_t size> void BM_GridAStarCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto start = benchmarks::get_first_walkable_cell(grid);
+  run_grid_a_star(state, grid, start,
+                  benchmarks::get_farthest_reachable_cell(grid, start));
+}
+BENCHMARK_TEMPLATE(BM_GridAStarCaveGrid, 30);
+BENCHMARK_TEMPLATE(BM_GridAStarCaveGrid, 128);
+BENCHMARK_TEMPLATE(BM_GridAStarCaveGrid, 512);
+
+void run_jump_point_search(benchmark::State &state,
+                           const benchmarks::Grid &grid,
+                           const Eigen::Vector2i &start,
+                           const Eigen::Vector2i &goal) {
+  const auto storage_size = static_cast<std::size_t>(grid.size * grid.size);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::JumpPointSearch jump_point_search({grid.size, grid.size});
+  std::vector<Eigen::Vector2i> path;
+  for (auto _ : state) {
+    const auto result = jump_point_search.find_path(is_walkable, start, goal,
+                                                    storage_size, path);
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(path.data());
+  }
+  state.counters["path_length"] = static_cast<double>(path.size());
+  state.counters["expanded_nodes"] =
+      static_cast<double>(jump_point_search.get_expanded_node_count());
+}
+
+void BM_JumpPointSearchOpenGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_open_grid(state.range(0));
+  run_jump_point_search(state, grid, {0, 0}, get_far_corner(grid));
+}
+BENCHMARK(BM_JumpPointSearchOpenGrid)->Arg(30)->Arg(128)->Arg(512);
+
+void BM_JumpPointSearchMazeGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_maze_grid(state.range(0));
+  run_jump_point_search(state, grid, {0, 0}, get_far_corner(grid));
+}
+BENCHMARK(BM_JumpPointSearchMazeGrid)->Arg(30)->Arg(128)->Arg(512);
+
+template <int64_t size>
+void BM_JumpPointSearchCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto start = benchmarks::get_first_walkable_cell(grid);
+  run_jump_point_search(state, grid, start,
+                        benchmarks::get_farthest_reachable_cell(grid, start));
+}
+BENCHMARK_TEMPLATE(BM_JumpPointSearchCaveGrid, 30);
+BENCHMARK_TEMPLATE(BM_JumpPointSearchCaveGrid, 128);
+BENCHMARK_TEMPLATE(BM_JumpPointSearchCaveGrid, 512);
+
+// one build replaces a search per agent heading to the same goal
+template <int64_t size> void BM_FlowFieldCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto start = benchmarks::get_first_walkable_cell(grid);
+  const auto goal = benchmarks::get_farthest_reachable_cell(grid, start);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::FlowField flow_field({grid.size, grid.size});
+  for (auto _ : state) {
+    flow_field.build(goal, is_walkable);
+    benchmark::DoNotOptimize(flow_field.get_cost(start));
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK_TEMPLATE(BM_FlowFieldCaveGrid, 30);
+BENCHMARK_TEMPLATE(BM_FlowFieldCaveGrid, 128);
+BENCHMARK_TEMPLATE(BM_FlowFieldCaveGrid, 512);
+
+/// Toggle one cell on the way to the goal and back, repairing the field each
+/// time instead of rebuilding it
+template <int64_t size>
+void BM_FlowFieldRepairCaveGrid(benchmark::State &state) {
+  auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto start = benchmarks::get_first_walkable_cell(grid);
+  const auto goal = benchmarks::get_farthest_reachable_cell(grid, start);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::FlowField flow_field({grid.size, grid.size});
+  flow_field.build(goal, is_walkable);
+  // halfway along the path so the change matters to start
+  std::vector<Eigen::Vector2i> path{start};
+  while (const auto maybe_next = flow_field.get_maybe_next_cell(path.back())) {
+    path.push_back(*maybe_next);
+  }
+  const std::array<Eigen::Vector2i, 1> changed_cells{path[path.size() / 2]};
+  auto &is_wall = grid.is_wall[changed_cells.front().x() +
+                               changed_cells.front().y() * grid.size];
+  std::size_t expanded_node_count = 0UL;
+  for (auto _ : state) {
+    is_wall ^= 1U;
+    flow_field.update_cells(changed_cells, is_walkable);
+    expanded_node_count += flow_field.get_expanded_node_count();
+    benchmark::DoNotOptimize(flow_field.get_cost(start));
+  }
+  state.counters["expanded"] = benchmark::Counter(
+      static_cast<double>(expanded_node_count), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_FlowFieldRepairCaveGrid, 30);
+BENCHMARK_TEMPLATE(BM_FlowFieldRepairCaveGrid, 128);
+BENCHMARK_TEMPLATE(BM_FlowFieldRepairCaveGrid, 512);
+
+template <int64_t size>
+void BM_HierarchicalAStarBuildCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::HierarchicalAStar hierarchical_a_star({grid.size, grid.size});
+  for (auto _ : state) {
+    hierarchical_a_star.build(is_walkable);
+  }
+  state.counters["entrances"] =
+      static_cast<double>(hierarchical_a_star.get_entrance_count());
+}
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarBuildCaveGrid, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarBuildCaveGrid, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+/// Query between two far apart cells of the main cave region, the path
+/// returned is refined down to every cell
+template <int64_t size>
+void BM_HierarchicalAStarCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto start = benchmarks::get_farthest_reachable_cell(
+      grid, benchmarks::get_middle_walkable_cell(grid));
+  const auto goal = benchmarks::get_farthest_reachable_cell(grid, start);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::HierarchicalAStar hierarchical_a_star({grid.size, grid.size});
+  hierarchical_a_star.build(is_walkable);
+  std::vector<Eigen::Vector2i> path;
+  for (auto _ : state) {
+    if (hierarchical_a_star.find_path(start, goal, path).isErr()) {
+      state.SkipWithError("hierarchical A* failed");
+      break;
+    }
+    benchmark::DoNotOptimize(path.data());
+  }
+  state.counters["expanded"] =
+      static_cast<double>(hierarchical_a_star.get_expanded_node_count());
+  state.counters["path_length"] = static_cast<double>(path.size());
+}
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarCaveGrid, 128);
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarCaveGrid, 512);
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarCaveGrid, 1024);
+
+/// Queries between random pairs of connected cells, closer to how agents use
+/// it than the farthest pair
+template <int64_t size>
+void BM_HierarchicalAStarRandomCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::HierarchicalAStar hierarchical_a_star({grid.size, grid.size});
+  hierarchical_a_star.build(is_walkable);
+  std::vector<Eigen::Vector2i> path;
+  std::mt19937 rng(7U);
+  std::uniform_int_distribution<int> coordinate(0, grid.size - 1);
+  std::vector<std::pair<Eigen::Vector2i, Eigen::Vector2i>> queries;
+  while (queries.size() < 64UL) {
+    const Eigen::Vector2i start{coordinate(rng), coordinate(rng)};
+    const Eigen::Vector2i goal{coordinate(rng), coordinate(rng)};
+    if (hierarchical_a_star.find_path(start, goal, path).isOk()) {
+      queries.emplace_back(start, goal);
+    }
+  }
+
+  std::size_t query_index = 0UL;
+  for (auto _ : state) {
+    const auto &[start, goal] = queries[query_index++ % queries.size()];
+    if (hierarchical_a_star.find_path(start, goal, path).isErr()) {
+      state.SkipWithError("hierarchical A* failed");
+      break;
+    }
+    benchmark::DoNotOptimize(path.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarRandomCaveGrid, 1024);
+
+/// Flat A* over the same 1024 cave for comparison
+void BM_GridAStarLargeCaveGrid(benchmark::State &state) {
+  const auto grid = benchmarks::make_cave_grid<1024>(42U);
+  const auto start = benchmarks::get_farthest_reachable_cell(
+      grid, benchmarks::get_middle_walkable_cell(grid));
+  const auto goal = benchmarks::get_farthest_reachable_cell(grid, start);
+  run_grid_a_star(state, grid, start, goal);
+}
+BENCHMARK(BM_GridAStarLargeCaveGrid)->Unit(benchmark::kMillisecond);
+
+/// Toggle one cell and bring the abstract graph up to date
+template <int64_t size>
+void BM_HierarchicalAStarUpdateCaveGrid(benchmark::State &state) {
+  auto grid = benchmarks::make_cave_grid<size>(42U);
+  const auto is_walkable = [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  };
+
+  algs::HierarchicalAStar hierarchical_a_star({grid.size, grid.size});
+  hierarchical_a_star.build(is_walkable);
+  // on a cluster border so both clusters are rebuilt
+  const std::array<Eigen::Vector2i, 1> changed_cells{
+      Eigen::Vector2i{grid.size / 2, grid.size / 2}};
+  auto &is_wall = grid.is_wall[changed_cells.front().x() +
+                               changed_cells.front().y() * grid.size];
+  for (auto _ : state) {
+    is_wall ^= 1U;
+    hierarchical_a_star.update_cells(changed_cells, is_walkable);
+  }
+}
+BENCHMARK_TEMPLATE(BM_HierarchicalAStarUpdateCaveGrid, 1024);
+
+} // namespace
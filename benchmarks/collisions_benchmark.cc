@@ -0,0 +1,93 @@
+#include "components/collider.hh"
+#include "geometry/rectangle_utils.hh"
+#include "model/game_state.hh"
+#include "systems/collisions.hh"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr float box_half_size{0.1f};
+
+class BoxEntity : public model::Entity {
+public:
+  static constexpr std::string_view entity_type_name = "box_entity";
+
+  BoxEntity(model::GameState &game_state) : model::Entity(game_state) {}
+
+  void init(const Eigen::Vector2f &center, const bool is_static) {
+    transform_ = geometry::make_rectangle_from_center_and_size(
+        center, Eigen::Vector2f{box_half_size, box_half_size});
+    if (is_static) {
+      add_component<component::StaticAABBCollider>(
+          [this]() { return get_transform(); });
+    } else {
+      // resolving the overlap is left out so every iteration sees the same
+      // layout
+      add_component<component::SolidAABBCollider>(
+          [this]() { return get_transform(); },
+          [](const Eigen::Vector2f &) {});
+    }
+  }
+
+  [[nodiscard]] virtual std::string_view get_entity_type_name() const {
+    return entity_type_name;
+  }
+
+  [[nodiscard]] virtual Eigen::Affine2f get_transform() const {
+    return transform_;
+  }
+
+private:
+  Eigen::Affine2f transform_;
+};
+
+/// Boxes are scattered over the area covered by the collisions quad tree.
+/// Static boxes sit on a lattice since overlapping static colliders are
+/// reported as a map error
+void add_boxes(model::GameState &game_state, const int64_t box_count,
+               const int64_t static_percentage) {
+  constexpr float lattice_spacing{2.5f * box_half_size};
+  constexpr float area_half_size{9.5f};
+  std::vector<Eigen::Vector2f> lattice_centers;
+  for (float x = -area_half_size; x < area_half_size; x += lattice_spacing) {
+    for (float y = -area_half_size; y < area_half_size; y += lattice_spacing) {
+      lattice_centers.emplace_back(x, y);
+    }
+  }
+  std::mt19937 generator{1U};
+  std::shuffle(lattice_centers.begin(), lattice_centers.end(), generator);
+
+  std::uniform_real_distribution<float> position_distribution{
+      -area_half_size, area_half_size};
+  const int64_t static_count = box_count * static_percentage / 100;
+  for (int64_t i = 0; i < box_count; ++i) {
+    const bool is_static = i < static_count;
+    const Eigen::Vector2f center =
+        is_static ? lattice_centers.at(i)
+                  : Eigen::Vector2f{position_distribution(generator),
+                                    position_distribution(generator)};
+    game_state.add_entity_and_init<BoxEntity>(center, is_static).unwrap();
+  }
+}
+
+void BM_CollisionsUpdate(benchmark::State &state) {
+  model::GameState game_state;
+  add_boxes(game_state, state.range(0), state.range(1));
+  systems::Collisions collisions;
+  for (auto _ : state) {
+    const auto result = collisions.update(game_state, 0);
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// box count and the percentage of boxes which are static
+BENCHMARK(BM_CollisionsUpdate)
+    ->ArgNames({"boxes", "static_percent"})
+    ->ArgsProduct({{100, 500, 2000}, {0, 50, 90}});
+
+} // namespace
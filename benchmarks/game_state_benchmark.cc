@@ -0,0 +1,101 @@
+#include "components/collider.hh"
+#include "model/game_state.hh"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+class EmptyEntity : public model::Entity {
+public:
+  static constexpr std::string_view entity_type_name = "empty_entity";
+
+  EmptyEntity(model::GameState &game_state) : model::Entity(game_state) {}
+
+  void init(const bool has_collider) {
+    if (has_collider) {
+      add_component<component::StaticAABBCollider>(
+          [this]() { return get_transform(); });
+    }
+  }
+
+  [[nodiscard]] virtual std::string_view get_entity_type_name() const {
+    return entity_type_name;
+  }
+};
+
+/// @return ids of entity_count entities, every other one with a collider
+std::vector<model::EntityID> add_entities(model::GameState &game_state,
+                                          const int64_t entity_count) {
+  std::vector<model::EntityID> entity_ids;
+  for (int64_t i = 0; i < entity_count; ++i) {
+    const auto entity =
+        game_state.add_entity_and_init<EmptyEntity>(i % 2 == 0).unwrap();
+    entity_ids.push_back(entity->get_entity_id());
+  }
+  return entity_ids;
+}
+
+// the game state is capped at 4096 entities
+void entity_counts(benchmark::internal::Benchmark *benchmark) {
+  benchmark->Arg(64)->Arg(512)->Arg(4000);
+}
+
+void BM_GameStateAddRemoveEntity(benchmark::State &state) {
+  model::GameState game_state;
+  add_entities(game_state, state.range(0));
+  for (auto _ : state) {
+    const auto entity =
+        game_state.add_entity_and_init<EmptyEntity>(false).unwrap();
+    game_state.remove_entity(entity->get_entity_id());
+  }
+}
+BENCHMARK(BM_GameStateAddRemoveEntity)->Apply(entity_counts);
+
+void BM_GameStateLookupById(benchmark::State &state) {
+  model::GameState game_state;
+  const auto entity_ids = add_entities(game_state, state.range(0));
+  std::size_t next_id = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        game_state.try_get_entity_pointer_by_id(entity_ids[next_id]));
+    next_id = (next_id + 1) % entity_ids.size();
+  }
+}
+BENCHMARK(BM_GameStateLookupById)->Apply(entity_counts);
+
+void BM_GameStateLookupByIdAs(benchmark::State &state) {
+  model::GameState game_state;
+  const auto entity_ids = add_entities(game_state, state.range(0));
+  std::size_t next_id = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        game_state.get_entity_pointer_by_id_as<EmptyEntity>(
+            entity_ids[next_id]));
+    next_id = (next_id + 1) % entity_ids.size();
+  }
+}
+BENCHMARK(BM_GameStateLookupByIdAs)->Apply(entity_counts);
+
+void BM_GameStateGetEntityPointersByType(benchmark::State &state) {
+  model::GameState game_state;
+  add_entities(game_state, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        game_state.get_entity_pointers_by_type<EmptyEntity>());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GameStateGetEntityPointersByType)->Apply(entity_counts);
+
+void BM_GameStateGetEntitiesWithComponent(benchmark::State &state) {
+  model::GameState game_state;
+  add_entities(game_state, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        game_state.get_entities_with_component<component::Collider>());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GameStateGetEntitiesWithComponent)->Apply(entity_counts);
+
+} // namespace
@@ -0,0 +1,59 @@
+#include "components/grid_collider.hh"
+#include "model/game_state.hh"
+#include "systems/grid_collisions.hh"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace {
+constexpr std::size_t grid_half_size{32UL};
+
+class CellEntity : public model::Entity {
+public:
+  static constexpr std::string_view entity_type_name = "cell_entity";
+
+  CellEntity(model::GameState &game_state) : model::Entity(game_state) {}
+
+  void init(const Eigen::Vector2i &cell) {
+    cell_ = cell;
+    add_component<component::GridCollider>(
+        [this]() { return std::vector<Eigen::Vector2i>{cell_}; },
+        [this](const model::EntityID) { ++collision_count_; });
+  }
+
+  [[nodiscard]] virtual std::string_view get_entity_type_name() const {
+    return entity_type_name;
+  }
+
+private:
+  Eigen::Vector2i cell_;
+  int64_t collision_count_{0};
+};
+
+void BM_GridCollisionsUpdate(benchmark::State &state) {
+  model::GameState game_state;
+  std::mt19937 generator{1U};
+  // range(1) is the half size of the area the entities are placed in, a
+  // smaller area means more entities share a cell
+  std::uniform_int_distribution<int> cell_distribution{
+      -static_cast<int>(state.range(1)), static_cast<int>(state.range(1))};
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    const Eigen::Vector2i cell{cell_distribution(generator),
+                               cell_distribution(generator)};
+    game_state.add_entity_and_init<CellEntity>(cell).unwrap();
+  }
+
+  systems::GridCollisions<grid_half_size, grid_half_size> grid_collisions;
+  for (auto _ : state) {
+    const auto result = grid_collisions.update(game_state, 0);
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GridCollisionsUpdate)
+    ->ArgNames({"entities", "spread"})
+    ->ArgsProduct({{100, 1000, 4000}, {8, 32}});
+
+} // namespace
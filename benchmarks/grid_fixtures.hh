@@ -0,0 +1,156 @@
+#pragma once
+#include "algs/a_star.hh"
+#include "algs/grid_a_star.hh"
+#include "wiz/map/cellular_automata_generator.hh"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace benchmarks {
+
+/**
+ * @brief Walkability grid shared by the pathfinding benchmarks
+ *
+ * Cells outside the grid count as walls so searches never leave it.
+ */
+struct Grid {
+  int size{0};
+  std::vector<uint8_t> is_wall;
+
+  [[nodiscard]] bool is_walkable(const Eigen::Vector2i &cell) const {
+    return cell.x() >= 0 && cell.y() >= 0 && cell.x() < size &&
+           cell.y() < size && !is_wall[cell.x() + cell.y() * size];
+  }
+};
+
+/**
+ * @brief Make a grid without any walls
+ * @param size Number of cells along each side
+ */
+[[nodiscard]] inline Grid make_open_grid(const int size) {
+  return Grid{size, std::vector<uint8_t>(size * size, 0U)};
+}
+
+/**
+ * @brief Make a serpentine maze, the path from corner to corner zig zags
+ * through every corridor
+ * @param size Number of cells along each side
+ */
+[[nodiscard]] inline Grid make_maze_grid(const int size) {
+  auto grid = make_open_grid(size);
+  // every third column is a wall with a gap alternating between the top and
+  // bottom row
+  for (int x = 2, wall_count = 0; x < size - 1; x += 3, ++wall_count) {
+    const int gap_y = wall_count % 2 == 0 ? size - 1 : 0;
+    for (int y = 0; y < size; ++y) {
+      if (y != gap_y) {
+        grid.is_wall[x + y * size] = 1U;
+      }
+    }
+  }
+  return grid;
+}
+
+/**
+ * @brief Make a cave map with the generator and settings wiz uses, caves
+ * aren't always connected so pair it with get_farthest_reachable_cell
+ * @param seed Generator seed, the same seed gives the same grid
+ */
+template <int64_t size>
+[[nodiscard]] Grid make_cave_grid(const uint32_t seed) {
+  using Generator = wiz::CellularAutomataGenerator<size, size>;
+  // the generator holds the whole map, too big for the stack on large sizes
+  auto generator = std::make_unique<Generator>(typename Generator::
+                                                   GenerationParams{
+      .initial_wall_probability = 0.3f,
+      .smoothing_iterations = 3,
+      .seed = seed,
+  });
+  generator->generate();
+
+  auto grid = make_open_grid(size);
+  for (int x = 0; x < size; ++x) {
+    for (int y = 0; y < size; ++y) {
+      grid.is_wall[x + y * size] = generator->is_wall(x, y) ? 1U : 0U;
+    }
+  }
+  return grid;
+}
+
+/**
+ * @brief Get the walkable cell with the lowest index, row by row
+ */
+[[nodiscard]] inline Eigen::Vector2i get_first_walkable_cell(const Grid &grid) {
+  for (int y = 0; y < grid.size; ++y) {
+    for (int x = 0; x < grid.size; ++x) {
+      if (grid.is_walkable({x, y})) {
+        return {x, y};
+      }
+    }
+  }
+  return {0, 0};
+}
+
+/**
+ * @brief Get the walkable cell closest to the middle of the grid, on large
+ * cave maps it is usually in the main region while the first walkable cell
+ * can be in a small pocket
+ */
+[[nodiscard]] inline Eigen::Vector2i
+get_middle_walkable_cell(const Grid &grid) {
+  const Eigen::Vector2i middle{grid.size / 2, grid.size / 2};
+  Eigen::Vector2i closest = get_first_walkable_cell(grid);
+  for (int y = 0; y < grid.size; ++y) {
+    for (int x = 0; x < grid.size; ++x) {
+      const Eigen::Vector2i cell{x, y};
+      if (grid.is_walkable(cell) && (cell - middle).squaredNorm() <
+                                        (closest - middle).squaredNorm()) {
+        closest = cell;
+      }
+    }
+  }
+  return closest;
+}
+
+/**
+ * @brief Get the cell most straight steps away from start which can still
+ * be reached from it, a goal which makes the search cross the whole region
+ */
+[[nodiscard]] inline Eigen::Vector2i
+get_farthest_reachable_cell(const Grid &grid, const Eigen::Vector2i &start) {
+  std::vector<uint8_t> is_reached(grid.is_wall.size(), 0U);
+  std::queue<Eigen::Vector2i> frontier;
+  frontier.push(start);
+  is_reached[start.x() + start.y() * grid.size] = 1U;
+  Eigen::Vector2i farthest = start;
+  while (!frontier.empty()) {
+    farthest = frontier.front();
+    frontier.pop();
+    for (const Eigen::Vector2i &step :
+         {Eigen::Vector2i{1, 0}, Eigen::Vector2i{-1, 0}, Eigen::Vector2i{0, 1},
+          Eigen::Vector2i{0, -1}}) {
+      const Eigen::Vector2i next = farthest + step;
+      if (grid.is_walkable(next) &&
+          is_reached[next.x() + next.y() * grid.size] == 0U) {
+        is_reached[next.x() + next.y() * grid.size] = 1U;
+        frontier.push(next);
+      }
+    }
+  }
+  return farthest;
+}
+
+/**
+ * @brief Get the 8 connected neighbors of a cell the same way wiz does,
+ * diagonal moves may not cut corners
+ */
+[[nodiscard]] inline algs::Neighbors<Eigen::Vector2i, 8>
+get_grid_neighbors(const Grid &grid, const Eigen::Vector2i &cell) {
+  return algs::get_grid_neighbors(cell, [&grid](const Eigen::Vector2i &cell) {
+    return grid.is_walkable(cell);
+  });
+}
+
+} // namespace benchmarks
@@ -0,0 +1,36 @@
+#include "wiz/map/cellular_automata_generator.hh"
+#include "wiz/map/room_corridor_generator.hh"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+template <int64_t map_size>
+void BM_CellularAutomataGenerator(benchmark::State &state) {
+  using Generator = wiz::CellularAutomataGenerator<map_size, map_size>;
+  uint32_t seed = 0U;
+  for (auto _ : state) {
+    // the seed changes every iteration so the timing isn't one lucky map
+    Generator generator(typename Generator::GenerationParams{.seed = seed++});
+    benchmark::DoNotOptimize(generator.generate());
+  }
+  state.SetItemsProcessed(state.iterations() * map_size * map_size);
+}
+BENCHMARK_TEMPLATE(BM_CellularAutomataGenerator, 32);
+BENCHMARK_TEMPLATE(BM_CellularAutomataGenerator, 64);
+BENCHMARK_TEMPLATE(BM_CellularAutomataGenerator, 128);
+
+template <int64_t map_size>
+void BM_RoomCorridorGenerator(benchmark::State &state) {
+  using Generator = wiz::RoomCorridorGenerator<map_size, map_size>;
+  uint32_t seed = 0U;
+  for (auto _ : state) {
+    Generator generator(typename Generator::GenerationParams{.seed = seed++});
+    benchmark::DoNotOptimize(generator.generate());
+  }
+  state.SetItemsProcessed(state.iterations() * map_size * map_size);
+}
+BENCHMARK_TEMPLATE(BM_RoomCorridorGenerator, 32);
+BENCHMARK_TEMPLATE(BM_RoomCorridorGenerator, 64);
+BENCHMARK_TEMPLATE(BM_RoomCorridorGenerator, 128);
+
+} // namespace
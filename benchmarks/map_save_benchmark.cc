@@ -0,0 +1,64 @@
+#include "lightmaze/map/map_saver.hh"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+namespace {
+
+lightmaze::MapSnapshot make_snapshot(const int64_t platform_count) {
+  lightmaze::MapSnapshot snapshot;
+  for (int64_t i = 0; i < platform_count; ++i) {
+    lightmaze::MapEntity::PlatformParams platform_params;
+    platform_params.top_center_position =
+        Eigen::Vector2f{static_cast<float>(i), 1.0f};
+    platform_params.platform_color = view::Color{255, 0, 0};
+    snapshot.platforms.push_back(platform_params);
+  }
+  return snapshot;
+}
+
+std::filesystem::path make_save_path() {
+  const auto directory =
+      std::filesystem::temp_directory_path() / "map_save_benchmark";
+  std::filesystem::create_directories(directory);
+  return directory / "map.yaml";
+}
+
+void BM_SerializeMapSnapshot(benchmark::State &state) {
+  const auto snapshot = make_snapshot(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lightmaze::serialize_map_snapshot(snapshot));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerializeMapSnapshot)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_WriteMapSnapshotAtomically(benchmark::State &state) {
+  const auto snapshot = make_snapshot(state.range(0));
+  const auto path = make_save_path();
+  for (auto _ : state) {
+    const auto result =
+        lightmaze::write_map_snapshot_atomically(snapshot, path);
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteMapSnapshotAtomically)->Arg(10)->Arg(100)->Arg(1000);
+
+// What the game thread pays per save, the write itself happens on the saver's
+// thread
+void BM_AsyncMapSaverSubmit(benchmark::State &state) {
+  const auto snapshot = make_snapshot(state.range(0));
+  const auto path = make_save_path();
+  lightmaze::AsyncMapSaver saver;
+  for (auto _ : state) {
+    saver.submit(snapshot, path);
+  }
+  saver.flush();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsyncMapSaverSubmit)->Arg(10)->Arg(100)->Arg(1000);
+
+} // namespace
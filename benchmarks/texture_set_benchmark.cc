@@ -0,0 +1,36 @@
+#include "view/tileset/texture_set.hh"
+#include <benchmark/benchmark.h>
+
+namespace {
+constexpr std::string_view texture_set_path{
+    "sprites/wiz/map_textures/texture_set.yaml"};
+
+// Images are cached by view::Texture after the first iteration, so this
+// measures the yaml parsing and texture slicing only
+void BM_ParseTextureSet(benchmark::State &state) {
+  for (auto _ : state) {
+    auto result = view::TextureSet::parse_texture_set_uncached(
+        std::filesystem::path(texture_set_path));
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_ParseTextureSet);
+
+void BM_ParseTextureSetCached(benchmark::State &state) {
+  for (auto _ : state) {
+    auto result = view::TextureSet::parse_texture_set(
+        std::filesystem::path(texture_set_path));
+    if (result.isErr()) {
+      state.SkipWithError(result.unwrapErr().c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_ParseTextureSetCached);
+
+} // namespace
@@ -0,0 +1,99 @@
+// Times the per frame work of the LightMaze light visibility system: indexing
+// the platforms, querying those near each light and sweeping the polygon.
+#include "geometry/box_grid.hh"
+#include "geometry/visibility_polygon.hh"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+struct Scenario {
+  const char *name;
+  int platform_count;
+  /// Platforms are scattered over a square of this half size
+  float level_half_size;
+  float light_radius;
+  int light_count;
+};
+
+// a level sized map where each light only reaches a few platforms, and a
+// worst case where every platform is inside the light
+constexpr Scenario scenarios[] = {
+    {"level, player light", 100, 30.0f, 0.8f, 1},
+    {"level, player light", 300, 30.0f, 0.8f, 1},
+    {"level, player light", 1000, 30.0f, 0.8f, 1},
+    {"level, 16 large lights", 1000, 30.0f, 5.0f, 16},
+    {"all platforms in range", 100, 10.0f, 30.0f, 1},
+    {"all platforms in range", 300, 10.0f, 30.0f, 1},
+    {"all platforms in range", 1000, 10.0f, 30.0f, 1},
+};
+
+std::vector<Eigen::AlignedBox2f> make_platforms(const Scenario &scenario) {
+  std::mt19937 generator{1U};
+  std::uniform_real_distribution<float> position_distribution{
+      -scenario.level_half_size, scenario.level_half_size};
+  std::uniform_real_distribution<float> width_distribution{0.2f, 1.5f};
+  std::uniform_real_distribution<float> height_distribution{0.05f, 0.3f};
+
+  std::vector<Eigen::AlignedBox2f> platforms;
+  for (int i = 0; i < scenario.platform_count; ++i) {
+    const Eigen::Vector2f center{position_distribution(generator),
+                                 position_distribution(generator)};
+    const Eigen::Vector2f half_size{width_distribution(generator),
+                                    height_distribution(generator)};
+    platforms.emplace_back(center - half_size, center + half_size);
+  }
+  return platforms;
+}
+
+/// One iteration is one frame, range(0) indexes scenarios
+void BM_VisibilityPolygonFrame(benchmark::State &state) {
+  const auto &scenario = scenarios[state.range(0)];
+  const auto platforms = make_platforms(scenario);
+  std::mt19937 generator{2U};
+  std::uniform_real_distribution<float> light_distribution{
+      -scenario.level_half_size, scenario.level_half_size};
+
+  geometry::BoxGrid platform_grid;
+  std::vector<uint32_t> nearby_platforms;
+  std::vector<geometry::LineSegment> occluders;
+  std::vector<geometry::VisibilityPolygon> polygons(
+      static_cast<std::size_t>(scenario.light_count));
+
+  std::size_t total_occluders = 0;
+  std::size_t total_vertices = 0;
+  for (auto _ : state) {
+    platform_grid.build(platforms);
+    for (auto &polygon : polygons) {
+      const Eigen::Vector2f origin{light_distribution(generator),
+                                   light_distribution(generator)};
+      const Eigen::Vector2f reach =
+          Eigen::Vector2f::Constant(scenario.light_radius);
+      platform_grid.query(Eigen::AlignedBox2f{origin - reach, origin + reach},
+                          nearby_platforms);
+      occluders.clear();
+      for (const auto platform_index : nearby_platforms) {
+        geometry::append_box_edges(platforms[platform_index], origin,
+                                   occluders);
+      }
+      polygon.compute(origin, scenario.light_radius, occluders);
+      total_occluders += occluders.size();
+      total_vertices += polygon.get_vertices().size();
+    }
+  }
+
+  const double samples =
+      static_cast<double>(state.iterations()) * scenario.light_count;
+  state.SetLabel(scenario.name);
+  state.counters["platforms"] = scenario.platform_count;
+  state.counters["lights"] = scenario.light_count;
+  state.counters["occluders_per_light"] =
+      static_cast<double>(total_occluders) / samples;
+  state.counters["vertices_per_light"] =
+      static_cast<double>(total_vertices) / samples;
+}
+BENCHMARK(BM_VisibilityPolygonFrame)
+    ->DenseRange(0, std::size(scenarios) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
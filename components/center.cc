@@ -12,4 +12,10 @@ Center::draw(view::Screen &screen) const {
   screen.set_viewport_center(transform.translation());
   return Ok();
 }
+
+Result<void, std::string>
+Center::record_snapshot(view::RenderSnapshot &snapshot) const {
+  snapshot.maybe_viewport_center = get_transform_().translation();
+  return Ok();
+}
 } // namespace component
@@ -13,6 +13,15 @@ public:
   [[nodiscard]] virtual Result<void, std::string>
   draw(view::Screen &screen) const final;
 
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) const final;
+
+  /// Moves the viewport rather than drawing so it must never be culled
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const final {
+    return std::nullopt;
+  }
+
   [[nodiscard]] virtual std::string_view get_component_type_name() const {
     return component_type_name;
   }
@@ -1,6 +1,9 @@
 #pragma once
 #include "utility/try.hh"
+#include "view/render_snapshot.hh"
 #include "view/screen.hh"
+#include <Eigen/Geometry>
+#include <optional>
 namespace component {
 class Component {
 public:
@@ -13,6 +16,26 @@ public:
     return Ok();
   }
 
+  /// Record what draw would draw so it can be drawn later on another thread
+  /// @param[out] snapshot snapshot to append draw calls to
+  /// @note records nothing by default, components which draw must override
+  /// this as well to be visible when the controller runs pipelined
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) const {
+    return Ok();
+  }
+
+  /// Region of the world this component draws into, used to skip drawing
+  /// entities which are entirely off screen
+  /// @note components which override draw should also override this
+  /// @return empty box if the component draws nothing (the default), nullopt if
+  /// the drawn region is unknown or not in world space, in which case the
+  /// owning entity is never culled
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const {
+    return Eigen::AlignedBox2f{};
+  }
+
   /// Update the internal state of the Component
   /// @param[in] timestamp_ns the current time in nanoseconds
   [[nodiscard]] virtual Result<void, std::string>
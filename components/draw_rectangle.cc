@@ -15,4 +15,23 @@ DrawRectangle::draw(view::Screen &screen) const {
   screen.draw_rectangle(bottom_left, top_right, info.color);
   return Ok();
 }
+
+Result<void, std::string>
+DrawRectangle::record_snapshot(view::RenderSnapshot &snapshot) const {
+  const auto info = get_info_();
+  const auto [bottom_left, top_right] =
+      geometry::get_bottom_left_and_top_right_from_transform(info.transform);
+  snapshot.rectangles.push_back(
+      view::RenderSnapshot::Rectangle{.bottom_left = bottom_left,
+                                      .top_right = top_right,
+                                      .maybe_texture = std::nullopt,
+                                      .color = info.color,
+                                      .z_level = 0.f});
+  return Ok();
+}
+
+std::optional<Eigen::AlignedBox2f>
+DrawRectangle::get_maybe_draw_bounds() const {
+  return geometry::get_bounding_box_from_transform(get_info_().transform);
+}
 } // namespace component
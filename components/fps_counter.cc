@@ -10,22 +10,9 @@ FpsCounter::FpsCounter(const FpsCounterParams &params) : params_(params) {
   frame_times_ns_.fill(16'666'667L); // ~60 FPS initial estimate
 }
 
-Result<void, std::string> FpsCounter::update(const int64_t delta_time_ns) {
-  // Record current frame time
-  frame_times_ns_[frame_index_] = delta_time_ns;
-  frame_index_ = (frame_index_ + 1) % frame_history_size_;
-
-  // Update display text periodically to avoid flickering
-  time_since_last_display_update_ns_ += delta_time_ns;
-  if (time_since_last_display_update_ns_ >= update_interval_ns_) {
-    update_display_text();
-    time_since_last_display_update_ns_ = 0L;
-  }
-
-  return Ok();
-}
-
 Result<void, std::string> FpsCounter::draw(view::Screen &screen) const {
+  record_frame();
+
   // Get the current transform from the parent entity
   const auto transform = params_.transform_func();
   const auto [bottom_left, top_right] =
@@ -36,9 +23,26 @@ Result<void, std::string> FpsCounter::draw(view::Screen &screen) const {
       bottom_left +
       Eigen::Vector2f{0.01f, (top_right.y() - bottom_left.y()) * 0.5f};
 
-  screen.draw_text(text_position, params_.font_size, current_fps_text_,
-                   params_.text_color);
+  fps_text_mesh_.set_text(current_fps_text_, params_.font_size);
+  screen.draw_text(text_position, fps_text_mesh_, params_.text_color);
+
+  return Ok();
+}
+
+Result<void, std::string>
+FpsCounter::record_snapshot(view::RenderSnapshot &snapshot) const {
+  record_frame();
 
+  const auto transform = params_.transform_func();
+  const auto [bottom_left, top_right] =
+      geometry::get_bottom_left_and_top_right_from_transform(transform);
+  snapshot.texts.push_back(view::RenderSnapshot::Text{
+      .location = bottom_left + Eigen::Vector2f{0.01f, (top_right.y() -
+                                                        bottom_left.y()) *
+                                                           0.5f},
+      .font_size = params_.font_size,
+      .text = current_fps_text_,
+      .color = params_.text_color});
   return Ok();
 }
 
@@ -85,6 +89,28 @@ uint32_t FpsCounter::calculate_minimum_fps_1s() const {
   return static_cast<uint32_t>(std::round(min_fps));
 }
 
+void FpsCounter::record_frame() const {
+  const auto now = std::chrono::steady_clock::now();
+  if (!maybe_last_draw_time_.has_value()) {
+    maybe_last_draw_time_ = now;
+    return;
+  }
+  const int64_t frame_time_ns =
+      std::chrono::nanoseconds(now - maybe_last_draw_time_.value()).count();
+  maybe_last_draw_time_ = now;
+
+  // Record current frame time
+  frame_times_ns_[frame_index_] = frame_time_ns;
+  frame_index_ = (frame_index_ + 1) % frame_history_size_;
+
+  // Update display text periodically to avoid flickering
+  time_since_last_display_update_ns_ += frame_time_ns;
+  if (time_since_last_display_update_ns_ >= update_interval_ns_) {
+    update_display_text();
+    time_since_last_display_update_ns_ = 0L;
+  }
+}
+
 void FpsCounter::update_display_text() const {
   const uint32_t avg_fps = calculate_average_fps_1s();
   const uint32_t min_fps = calculate_minimum_fps_1s();
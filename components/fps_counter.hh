@@ -1,10 +1,13 @@
 #pragma once
 #include "components/component.hh"
 #include "view/screen.hh"
+#include "view/text_mesh.hh"
 #include "utility/try.hh"
 #include <Eigen/Geometry>
 #include <array>
+#include <chrono>
 #include <functional>
+#include <optional>
 #include <string>
 
 namespace component {
@@ -12,8 +15,9 @@ namespace component {
 /**
  * @brief Component that displays FPS information with background rectangle
  *
- * This component provides real-time FPS monitoring by tracking frame delta times
- * and calculating rolling averages. It renders a background rectangle and text label
+ * This component provides real-time FPS monitoring by timing the gaps between draws
+ * and calculating rolling averages. Draws rather than updates are timed since the
+ * controller runs a fixed number of simulation steps per second whatever the frame rate. It renders a background rectangle and text label
  * at a position provided by the parent entity, making it reusable across different games.
  *
  * The FPS counter shows both average and minimum FPS over the last 1 second window
@@ -53,15 +57,6 @@ public:
     return component_type_name;
   }
 
-  /**
-   * @brief Update FPS calculations and display text
-   * @param delta_time_ns Time elapsed since last update in nanoseconds
-   * @return Ok() on success, Err(message) if update fails
-   * @post Frame time recorded and display text updated periodically
-   */
-  [[nodiscard]] virtual Result<void, std::string>
-  update(const int64_t delta_time_ns) override;
-
   /**
    * @brief Draw the FPS counter background and text
    * @param screen Screen to draw to
@@ -71,6 +66,27 @@ public:
   [[nodiscard]] virtual Result<void, std::string>
   draw(view::Screen& screen) const override;
 
+  /**
+   * @brief Record the FPS text
+   * @param snapshot Snapshot to append the text to
+   * @return Ok()
+   * @note Snapshots are recorded on the simulation thread, so in pipelined
+   * mode the counter shows how often snapshots are published rather than
+   * drawn
+   */
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot& snapshot) const override;
+
+  /**
+   * @brief The counter is an overlay whose text is sized in pixels, so it is
+   * never culled
+   * @return std::nullopt
+   */
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const override {
+    return std::nullopt;
+  }
+
 private:
   /// Configuration parameters
   FpsCounterParams params_;
@@ -80,10 +96,13 @@ private:
   static constexpr int64_t update_interval_ns_{100'000'000L}; // Update display every 100ms
   static constexpr int64_t one_second_window_ns_{1'000'000'000L}; // 1 second window
 
-  std::array<int64_t, frame_history_size_> frame_times_ns_{};
-  size_t frame_index_{0};
-  int64_t time_since_last_display_update_ns_{0L};
+  mutable std::array<int64_t, frame_history_size_> frame_times_ns_{};
+  mutable size_t frame_index_{0};
+  mutable int64_t time_since_last_display_update_ns_{0L};
+  mutable std::optional<std::chrono::steady_clock::time_point> maybe_last_draw_time_;
   mutable std::string current_fps_text_{"FPS: -- Min: --"};
+  /// Cached layout of current_fps_text_, rebuilt only when the text changes
+  mutable view::TextMesh fps_text_mesh_;
 
   /**
    * @brief Calculate average FPS from frame history over last 1 second
@@ -97,6 +116,12 @@ private:
    */
   [[nodiscard]] uint32_t calculate_minimum_fps_1s() const;
 
+  /**
+   * @brief Record the time since the previous draw
+   * @post Display text updated periodically
+   */
+  void record_frame() const;
+
   /**
    * @brief Update the display text with current average and minimum FPS
    * @post current_fps_text_ updated with latest FPS calculations
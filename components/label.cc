@@ -10,8 +10,22 @@ Label::Label(GetTextInfoFunc get_text_info) : get_text_info_(get_text_info) {}
 Label::draw(view::Screen &screen) const {
   const auto text_info = get_text_info_();
 
-  screen.draw_text(text_info.transform.translation(), text_info.font,
-                   text_info.text, text_info.color);
+  text_mesh_.set_text(text_info.text, text_info.font);
+  screen.draw_text(text_info.transform.translation(), text_mesh_,
+                   text_info.color);
+  return Ok();
+}
+
+Result<void, std::string>
+Label::record_snapshot(view::RenderSnapshot &snapshot) const {
+  const auto text_info = get_text_info_();
+  // the render thread lays the text out again every frame, the cached mesh
+  // isn't shared between threads
+  snapshot.texts.push_back(view::RenderSnapshot::Text{
+      .location = text_info.transform.translation(),
+      .font_size = text_info.font,
+      .text = std::string(text_info.text),
+      .color = text_info.color});
   return Ok();
 }
 } // namespace component
@@ -3,6 +3,7 @@
 #include "model/entity_id.hh"
 #include "model/game_state.hh"
 #include "view/screen.hh"
+#include "view/text_mesh.hh"
 
 namespace component {
 class Label : public Component {
@@ -23,11 +24,24 @@ public:
   [[nodiscard]] virtual Result<void, std::string>
   draw(view::Screen &screen) const final;
 
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) const final;
+
+  /// Text is sized in pixels rather than meters so its world space extent
+  /// isn't known, labels are never culled
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const final {
+    return std::nullopt;
+  }
+
   [[nodiscard]] virtual std::string_view get_component_type_name() const {
     return component_type_name;
   }
 
 private:
   GetTextInfoFunc get_text_info_;
+  /// only laid out again when the text or font size returned by
+  /// get_text_info_ changes
+  mutable view::TextMesh text_mesh_;
 };
 } // namespace component
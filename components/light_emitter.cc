@@ -21,27 +21,42 @@ void CircularLightGeometry::set_radius(float new_radius_meters) {
   }
 }
 
+// ShadowCastingLightGeometry implementation
+
+ShadowCastingLightGeometry::ShadowCastingLightGeometry(float radius_meters)
+    : CircularLightGeometry(radius_meters) {}
+
+void ShadowCastingLightGeometry::update_visibility(
+    const Eigen::Vector2f world_position,
+    const std::vector<geometry::LineSegment>& occluders) {
+  visibility_polygon_.compute(world_position, get_radius(), occluders);
+  has_visibility_ = true;
+}
+
 // LightEmitter implementation
 
 LightEmitter::LightEmitter(const CircularLightParams& params)
     : transform_func_(params.transform_func),
       geometry_(std::make_shared<CircularLightGeometry>(params.radius_meters)),
       color_(params.color),
-      intensity_(std::clamp(params.intensity, 0.0f, 1.0f)) {
+      intensity_(std::clamp(params.intensity, 0.0f, 1.0f)),
+      is_static_(params.is_static) {
 }
 
 LightEmitter::LightEmitter(const GlobalLightParams& params)
     : transform_func_([]() { return Eigen::Affine2f::Identity(); }), // Global lights don't need position
       geometry_(std::make_shared<GlobalLightGeometry>()),
       color_(params.color),
-      intensity_(std::clamp(params.intensity, 0.0f, 1.0f)) {
+      intensity_(std::clamp(params.intensity, 0.0f, 1.0f)),
+      is_static_(true) {
 }
 
 LightEmitter::LightEmitter(const CustomGeometryLightParams& params)
     : transform_func_(params.transform_func),
       geometry_(params.geometry),
       color_(params.color),
-      intensity_(std::clamp(params.intensity, 0.0f, 1.0f)) {
+      intensity_(std::clamp(params.intensity, 0.0f, 1.0f)),
+      is_static_(params.is_static) {
 
   // Ensure we have valid geometry
   if (!geometry_) {
@@ -59,7 +74,8 @@ LightEmitter::LightInfo LightEmitter::get_light_info() const {
     .world_position = world_position,
     .geometry = geometry_,
     .color = color_,
-    .intensity = intensity_
+    .intensity = intensity_,
+    .is_static = is_static_
   };
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "components/component.hh"
+#include "geometry/visibility_polygon.hh"
 #include "view/screen.hh"
 #include <Eigen/Geometry>
 #include <functional>
@@ -27,6 +28,15 @@ public:
    * @return Maximum distance from center that this light can affect
    */
   [[nodiscard]] virtual float get_bounding_radius() const = 0;
+
+  /**
+   * @brief Get the area this light can actually reach around occluders
+   * @return Visibility polygon, or nullptr if the light passes through walls
+   */
+  [[nodiscard]] virtual const geometry::VisibilityPolygon *
+  get_maybe_visibility_polygon() const {
+    return nullptr;
+  }
 };
 
 /**
@@ -95,6 +105,48 @@ private:
   float radius_meters_;
 };
 
+/**
+ * @brief Circular light blocked by occluders
+ *
+ * The geometry only stores the visibility polygon, a system that knows which
+ * entities occlude the light recomputes it each frame with update_visibility.
+ * Until then the light is unoccluded.
+ */
+class ShadowCastingLightGeometry : public CircularLightGeometry {
+public:
+  /// Geometry type identifier for shadow casting lights
+  static constexpr std::string_view geometry_type_name = "shadow_casting";
+
+  /**
+   * @brief Construct shadow casting light geometry
+   * @param radius_meters Light radius in meters
+   * @pre radius_meters > 0.0f
+   */
+  explicit ShadowCastingLightGeometry(float radius_meters);
+
+  [[nodiscard]] std::string_view get_geometry_type() const override {
+    return geometry_type_name;
+  }
+
+  [[nodiscard]] const geometry::VisibilityPolygon *
+  get_maybe_visibility_polygon() const override {
+    return has_visibility_ ? &visibility_polygon_ : nullptr;
+  }
+
+  /**
+   * @brief Recompute the lit area around occluders
+   * @param world_position Current center of the light
+   * @param occluders Segments blocking the light, see geometry::append_box_edges
+   * @post get_maybe_visibility_polygon() returns the new polygon
+   */
+  void update_visibility(const Eigen::Vector2f world_position,
+                         const std::vector<geometry::LineSegment> &occluders);
+
+private:
+  geometry::VisibilityPolygon visibility_polygon_;
+  bool has_visibility_{false};
+};
+
 /**
  * @brief Generic light source component supporting multiple geometries
  *
@@ -112,6 +164,7 @@ public:
     std::shared_ptr<LightGeometry> geometry;  ///< Light geometry (shape and falloff)
     view::Color color;                        ///< Light color (RGB)
     float intensity;                          ///< Overall light intensity (0.0-1.0)
+    bool is_static;                           ///< Light never moves or changes, so it can be cached
   };
 
   /**
@@ -127,6 +180,7 @@ public:
     float radius_meters;
     view::Color color;
     float intensity;
+    bool is_static{false}; ///< Set for lights whose position and color never change
   };
 
   /**
@@ -145,6 +199,7 @@ public:
     std::shared_ptr<LightGeometry> geometry;
     view::Color color;
     float intensity;
+    bool is_static{false}; ///< Set for lights whose position and color never change
   };
 
   /**
@@ -159,6 +214,7 @@ public:
    * @brief Construct a global light emitter
    * @param params Parameters for global light configuration
    * @pre params.intensity >= 0.0f && params.intensity <= 1.0f
+   * @post Global lights are always static
    */
   explicit LightEmitter(const GlobalLightParams& params);
 
@@ -219,6 +275,9 @@ private:
 
   /// Light intensity (0.0-1.0)
   float intensity_;
+
+  /// Whether the lighting system may cache this light's contribution
+  bool is_static_;
 };
 
 } // namespace component
\ No newline at end of file
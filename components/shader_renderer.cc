@@ -1,5 +1,4 @@
 #include "components/shader_renderer.hh"
-#include <iostream>
 
 namespace component {
 
@@ -21,8 +20,7 @@ Result<void, std::string> ShaderRenderer::draw(view::Screen& screen) const {
   auto* mutable_this = const_cast<ShaderRenderer*>(this);
   TRY_VOID(mutable_this->ensure_shader_loaded());
 
-  if (!shader_ || !shader_->is_valid()) {
-    // Skip rendering if shader failed to load
+  if (!shader_.is_valid()) {
     return Ok();
   }
 
@@ -37,8 +35,15 @@ Result<void, std::string> ShaderRenderer::draw(view::Screen& screen) const {
   return Ok();
 }
 
+Result<void, std::string>
+ShaderRenderer::record_snapshot(view::RenderSnapshot& snapshot) const {
+  return Err(std::string(
+      "ShaderRenderer can't be drawn from a render snapshot, run without "
+      "--pipelined"));
+}
+
 bool ShaderRenderer::is_shader_loaded() const {
-  return shader_ && shader_->is_valid();
+  return shader_.is_valid();
 }
 
 Result<void, std::string> ShaderRenderer::ensure_shader_loaded() {
@@ -49,15 +54,12 @@ Result<void, std::string> ShaderRenderer::ensure_shader_loaded() {
 
   shader_load_attempted_ = true;
 
-  // Load shader from files
-  auto shader_result = view::Shader::from_files(vertex_shader_path_, fragment_shader_path_);
-
-  if (shader_result.isOk()) {
-    shader_ = std::move(shader_result).unwrap();
-  } else {
-    std::cerr << "Failed to load shader: " << shader_result.unwrapErr() << std::endl;
-    // Component will be non-functional but won't crash
+  auto shader_result = view::ShaderCache::get().load(
+      view::ShaderFiles{vertex_shader_path_, fragment_shader_path_});
+  if (shader_result.isErr()) {
+    return Err(std::string("Failed to load shader: ") + shader_result.unwrapErr());
   }
+  shader_ = shader_result.unwrap();
 
   return Ok();
 }
@@ -2,6 +2,7 @@
 #include "components/component.hh"
 #include "view/screen.hh"
 #include "view/shader.hh"
+#include "view/shader_cache.hh"
 #include "utility/try.hh"
 #include <Eigen/Dense>
 #include <functional>
@@ -16,7 +17,8 @@ namespace component {
  *
  * This component allows entities to render custom shader effects without
  * needing to know about OpenGL or shader management. The component handles:
- * - Shader loading and compilation
+ * - Shader loading through the view::ShaderCache, so renderers using the same
+ *   files share one program
  * - Uniform parameter management
  * - Fullscreen quad rendering
  * - Animation and time-based effects
@@ -65,6 +67,24 @@ public:
    */
   [[nodiscard]] Result<void, std::string> draw(view::Screen& screen) const override;
 
+  /**
+   * @brief Shader effects need the GL context, so they can't be recorded
+   * @param snapshot Unused
+   * @return Err(message) always, so pipelined mode fails instead of drawing
+   * without the effect
+   */
+  [[nodiscard]] Result<void, std::string>
+  record_snapshot(view::RenderSnapshot& snapshot) const override;
+
+  /**
+   * @brief Fullscreen effects cover the whole viewport so they are never culled
+   * @return std::nullopt
+   */
+  [[nodiscard]] std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const override {
+    return std::nullopt;
+  }
+
   /**
    * @brief Get the z-level for this shader effect
    * @return Z-level value for depth sorting
@@ -84,7 +104,7 @@ public:
   [[nodiscard]] bool is_shader_loaded() const;
 
 private:
-  std::unique_ptr<view::Shader> shader_;
+  view::ShaderHandle shader_;
   UniformProvider uniform_provider_;
   float z_level_;
 
@@ -16,4 +16,22 @@ Sprite::draw(view::Screen &screen) const {
   screen.draw_rectangle(bottom_left, top_right, info.texture, info.z_level);
   return Ok();
 }
+
+Result<void, std::string>
+Sprite::record_snapshot(view::RenderSnapshot &snapshot) const {
+  const auto info = get_info_();
+  const auto [bottom_left, top_right] =
+      geometry::get_bottom_left_and_top_right_from_transform(info.transform);
+  snapshot.rectangles.push_back(
+      view::RenderSnapshot::Rectangle{.bottom_left = bottom_left,
+                                      .top_right = top_right,
+                                      .maybe_texture = info.texture,
+                                      .color = view::Color{255, 255, 255},
+                                      .z_level = info.z_level});
+  return Ok();
+}
+
+std::optional<Eigen::AlignedBox2f> Sprite::get_maybe_draw_bounds() const {
+  return geometry::get_bounding_box_from_transform(get_info_().transform);
+}
 } // namespace component
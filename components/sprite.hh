@@ -20,6 +20,13 @@ public:
   [[nodiscard]] virtual Result<void, std::string>
   draw(view::Screen &screen) const final;
 
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) const final;
+
+  /// Bounds of the rectangle which will be drawn this frame
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const final;
+
   [[nodiscard]] virtual std::string_view get_component_type_name() const {
     return component_type_name;
   }
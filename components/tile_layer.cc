@@ -0,0 +1,135 @@
+#include "components/tile_layer.hh"
+
+namespace component {
+
+TileLayer::TileLayer(const TileLayerParams &params)
+    : params_(params),
+      size_in_chunks_(
+          (params.size_in_tiles.array() +
+           static_cast<int32_t>(params.chunk_size_in_tiles) - 1) /
+          static_cast<int32_t>(params.chunk_size_in_tiles)),
+      tiles_(static_cast<std::size_t>(params.size_in_tiles.prod())),
+      chunks_(static_cast<std::size_t>(size_in_chunks_.prod())) {
+  const Eigen::Vector2f half_tile_m =
+      Eigen::Vector2f::Constant(params_.tile_size_m / 2.0f);
+  const auto chunk_size = static_cast<int32_t>(params_.chunk_size_in_tiles);
+  for (int32_t chunk_y = 0; chunk_y < size_in_chunks_.y(); ++chunk_y) {
+    for (int32_t chunk_x = 0; chunk_x < size_in_chunks_.x(); ++chunk_x) {
+      const Eigen::Vector2i first_tile{chunk_x * chunk_size,
+                                       chunk_y * chunk_size};
+      const Eigen::Vector2i last_tile =
+          (first_tile.array() + chunk_size - 1)
+              .min(params_.size_in_tiles.array() - 1);
+      auto &chunk = chunks_[chunk_x + chunk_y * size_in_chunks_.x()];
+      chunk.bounds.extend(params_.origin_m +
+                          first_tile.cast<float>() * params_.tile_size_m -
+                          half_tile_m);
+      chunk.bounds.extend(params_.origin_m +
+                          last_tile.cast<float>() * params_.tile_size_m +
+                          half_tile_m);
+    }
+  }
+}
+
+Result<void, std::string>
+TileLayer::set_tile(const Eigen::Vector2i tile_index,
+                    std::optional<view::Texture> maybe_texture) {
+  if ((tile_index.array() < 0).any() ||
+      (tile_index.array() >= params_.size_in_tiles.array()).any()) {
+    return Err(std::string("Tile index out of bounds for tile layer"));
+  }
+  tiles_[tile_index.x() + tile_index.y() * params_.size_in_tiles.x()] =
+      std::move(maybe_texture);
+  chunks_[get_chunk_index(tile_index)].is_dirty = true;
+  return Ok();
+}
+
+Result<void, std::string> TileLayer::draw(view::Screen &screen) const {
+  last_rebuilt_chunk_count_ = 0U;
+  const auto visible_bounds = screen.get_visible_bounds();
+  for (std::size_t chunk_index = 0; chunk_index < chunks_.size();
+       ++chunk_index) {
+    auto &chunk = chunks_[chunk_index];
+    if (!chunk.bounds.intersects(visible_bounds)) {
+      // dirty chunks stay dirty until they come into view
+      continue;
+    }
+    if (chunk.is_dirty) {
+      rebuild_chunk(chunk_index);
+    }
+    screen.draw_quad_batch(chunk.batch, params_.z_level);
+  }
+  return Ok();
+}
+
+Result<void, std::string>
+TileLayer::record_snapshot(view::RenderSnapshot &snapshot) const {
+  const Eigen::Vector2f half_tile_m =
+      Eigen::Vector2f::Constant(params_.tile_size_m / 2.0f);
+  for (int32_t y = 0; y < params_.size_in_tiles.y(); ++y) {
+    for (int32_t x = 0; x < params_.size_in_tiles.x(); ++x) {
+      const auto &maybe_texture = tiles_[x + y * params_.size_in_tiles.x()];
+      if (!maybe_texture.has_value()) {
+        continue;
+      }
+      const Eigen::Vector2f center_m =
+          params_.origin_m +
+          Eigen::Vector2f{static_cast<float>(x), static_cast<float>(y)} *
+              params_.tile_size_m;
+      snapshot.rectangles.push_back(view::RenderSnapshot::Rectangle{
+          .bottom_left = center_m - half_tile_m,
+          .top_right = center_m + half_tile_m,
+          .maybe_texture = maybe_texture,
+          .color = view::Color{255, 255, 255},
+          .z_level = params_.z_level});
+    }
+  }
+  return Ok();
+}
+
+std::optional<Eigen::AlignedBox2f> TileLayer::get_maybe_draw_bounds() const {
+  Eigen::AlignedBox2f draw_bounds;
+  for (const auto &chunk : chunks_) {
+    draw_bounds.extend(chunk.bounds);
+  }
+  return draw_bounds;
+}
+
+std::size_t TileLayer::get_chunk_index(const Eigen::Vector2i tile_index) const {
+  const auto chunk_size = static_cast<int32_t>(params_.chunk_size_in_tiles);
+  return tile_index.x() / chunk_size +
+         (tile_index.y() / chunk_size) * size_in_chunks_.x();
+}
+
+void TileLayer::rebuild_chunk(const std::size_t chunk_index) const {
+  auto &chunk = chunks_[chunk_index];
+  chunk.batch.clear();
+
+  const auto chunk_size = static_cast<int32_t>(params_.chunk_size_in_tiles);
+  const Eigen::Vector2i first_tile{
+      static_cast<int32_t>(chunk_index % size_in_chunks_.x()) * chunk_size,
+      static_cast<int32_t>(chunk_index / size_in_chunks_.x()) * chunk_size};
+  const Eigen::Vector2i end_tile =
+      (first_tile.array() + chunk_size).min(params_.size_in_tiles.array());
+  const Eigen::Vector2f half_tile_m =
+      Eigen::Vector2f::Constant(params_.tile_size_m / 2.0f);
+
+  for (int32_t y = first_tile.y(); y < end_tile.y(); ++y) {
+    for (int32_t x = first_tile.x(); x < end_tile.x(); ++x) {
+      const auto &maybe_texture = tiles_[x + y * params_.size_in_tiles.x()];
+      if (!maybe_texture.has_value()) {
+        continue;
+      }
+      const Eigen::Vector2f center_m =
+          params_.origin_m +
+          Eigen::Vector2f{static_cast<float>(x), static_cast<float>(y)} *
+              params_.tile_size_m;
+      chunk.batch.add_quad(center_m - half_tile_m, center_m + half_tile_m,
+                           maybe_texture.value());
+    }
+  }
+
+  chunk.is_dirty = false;
+  ++last_rebuilt_chunk_count_;
+}
+} // namespace component
@@ -0,0 +1,125 @@
+#pragma once
+#include "components/component.hh"
+#include "view/quad_batch.hh"
+#include "view/screen.hh"
+#include "view/texture.hh"
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace component {
+
+/**
+ * @brief Draws a grid of textured tiles using cached per-chunk batches
+ *
+ * The grid is split into square chunks, each of which is baked into a
+ * view::QuadBatch the first time it is drawn. Changing a tile only marks its
+ * chunk dirty, so a frame where nothing changed costs one draw call per
+ * texture per visible chunk rather than one per tile. Chunks outside of the
+ * visible part of the world are skipped.
+ */
+class TileLayer : public Component {
+public:
+  static constexpr std::string_view component_type_name =
+      "tile_layer_component";
+
+  /**
+   * @brief Parameters describing the layout of the grid
+   */
+  struct TileLayerParams {
+    /// World position of the center of tile (0, 0)
+    Eigen::Vector2f origin_m{0.0f, 0.0f};
+    /// Side length of a single tile
+    float tile_size_m{1.0f};
+    /// Number of tiles along each axis
+    Eigen::Vector2i size_in_tiles{1, 1};
+    /// Side length of a chunk, larger chunks mean fewer draw calls but more
+    /// work to rebuild when a tile changes
+    uint32_t chunk_size_in_tiles{8U};
+    /// Depth passed through to the screen
+    float z_level{0.0f};
+  };
+
+  /**
+   * @brief Construct an empty tile layer
+   * @param params Layout of the grid
+   * @pre all of size_in_tiles and chunk_size_in_tiles are positive
+   */
+  explicit TileLayer(const TileLayerParams &params);
+
+  /**
+   * @brief Get the component type name for identification
+   * @return Static string identifying this component type
+   */
+  [[nodiscard]] virtual std::string_view
+  get_component_type_name() const override {
+    return component_type_name;
+  }
+
+  /**
+   * @brief Set or clear the texture drawn for a tile
+   * @param tile_index Grid coordinates of the tile
+   * @param maybe_texture Texture to draw, nullopt leaves the tile empty
+   * @return Ok() on success, Err(message) if tile_index is out of bounds
+   * @post The chunk containing the tile will be rebuilt on the next draw
+   */
+  Result<void, std::string>
+  set_tile(const Eigen::Vector2i tile_index,
+           std::optional<view::Texture> maybe_texture);
+
+  /**
+   * @brief Rebuild any dirty chunks and draw the visible ones
+   * @param screen Screen to draw to
+   * @return Ok() on success
+   */
+  [[nodiscard]] virtual Result<void, std::string>
+  draw(view::Screen &screen) const override;
+
+  /**
+   * @brief Record every non-empty tile as a rectangle
+   * @param snapshot Snapshot to append the tiles to
+   * @return Ok() on success
+   * @note Chunk batches hold GL buffers, so tiles aren't batched here and
+   * nothing is culled since the viewport belongs to the render thread
+   */
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) const override;
+
+  /**
+   * @brief Bounds of the whole grid
+   * @return Box covering every tile in the layer
+   */
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const override;
+
+  /**
+   * @brief Number of chunks rebuilt during the last draw, useful for checking
+   * that unchanged chunks stay cached
+   * @return chunk rebuild count from the last draw call
+   */
+  [[nodiscard]] uint32_t get_last_rebuilt_chunk_count() const {
+    return last_rebuilt_chunk_count_;
+  }
+
+private:
+  struct Chunk {
+    view::QuadBatch batch;
+    Eigen::AlignedBox2f bounds;
+    bool is_dirty{true};
+  };
+
+  [[nodiscard]] std::size_t
+  get_chunk_index(const Eigen::Vector2i tile_index) const;
+
+  void rebuild_chunk(const std::size_t chunk_index) const;
+
+  TileLayerParams params_;
+  Eigen::Vector2i size_in_chunks_;
+  /// indexed by x + y * size_in_tiles.x()
+  std::vector<std::optional<view::Texture>> tiles_;
+  /// rebuilt lazily in draw, indexed by x + y * size_in_chunks_.x()
+  mutable std::vector<Chunk> chunks_;
+  mutable uint32_t last_rebuilt_chunk_count_{0U};
+};
+} // namespace component
@@ -26,6 +26,12 @@ Result<void, std::string> Zoom::draw(view::Screen& screen) const {
   return Ok();
 }
 
+Result<void, std::string>
+Zoom::record_snapshot(view::RenderSnapshot& snapshot) const {
+  snapshot.maybe_zoom_level = zoom_level_;
+  return Ok();
+}
+
 void Zoom::set_zoom_level(float new_zoom_level) {
   zoom_level_ = std::clamp(new_zoom_level, min_zoom_level_, max_zoom_level_);
 }
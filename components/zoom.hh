@@ -43,6 +43,24 @@ public:
   [[nodiscard]] Result<void, std::string>
   draw(view::Screen& screen) const override;
 
+  /**
+   * @brief Record the zoom level, the render thread scales the viewport size
+   * it started with by it
+   * @param snapshot Snapshot to record the zoom level in
+   * @return Ok()
+   */
+  [[nodiscard]] Result<void, std::string>
+  record_snapshot(view::RenderSnapshot& snapshot) const override;
+
+  /**
+   * @brief Zoom resizes the viewport rather than drawing so it is never culled
+   * @return std::nullopt
+   */
+  [[nodiscard]] std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const override {
+    return std::nullopt;
+  }
+
   /**
    * @brief Set the zoom level
    * @param new_zoom_level New zoom level (1.0 = normal, >1.0 = zoomed in, <1.0 = zoomed out)
@@ -1,8 +1,13 @@
 #include "controller/controller.hh"
 #include "utility/overload.hh"
+#include "utility/profiler.hh"
+#include "utility/random.hh"
 #include "utility/try.hh"
+#include "view/profiler_overlay.hh"
 #include <SFML/Window/Event.hpp>
+#include <charconv>
 #include <chrono>
+#include <iostream>
 #include <thread>
 using namespace std::chrono_literals;
 
@@ -11,37 +16,317 @@ Controller::Controller(std::unique_ptr<view::Screen> screen,
                        std::unique_ptr<model::GameState> game_state)
     : screen_(std::move(screen)), game_state_(std::move(game_state)) {}
 
+Result<void, std::string> Controller::run() { return run(LoopParams{}); }
+
 Result<void, std::string>
-Controller::run(std::chrono::milliseconds min_update_interval) {
-  return run(std::make_optional(min_update_interval));
+Controller::run(const std::chrono::milliseconds simulation_step) {
+  return run(LoopParams{.simulation_step = simulation_step});
 }
 
-Result<void, std::string> Controller::run() { return run(std::nullopt); }
+Result<void, std::string> Controller::run(const LoopParams &params) {
+  if (params.is_pipelined) {
+    return run_pipelined(params);
+  }
+  if (!screen_) {
+    return Err(std::string("Controller::run needs a screen, use run_headless "
+                           "to simulate without one"));
+  }
+
+  auto maybe_input_recorder_result = make_maybe_input_recorder(params);
+  if (maybe_input_recorder_result.isErr()) {
+    return Err(maybe_input_recorder_result.unwrapErr());
+  }
+  auto maybe_input_recorder = std::move(maybe_input_recorder_result).unwrap();
 
-Result<void, std::string> Controller::run(
-    std::optional<std::chrono::milliseconds> maybe_min_update_interval) {
-  auto last_update = std::chrono::high_resolution_clock::now();
+  start_profiling(params);
+  std::optional<view::ProfilerOverlay> maybe_profiler_overlay;
+  if (params.is_profiling_enabled) {
+    maybe_profiler_overlay.emplace();
+  }
+
+  FixedTimestep timestep{params.simulation_step, params.max_steps_per_frame};
+  const int64_t step_ns = params.simulation_step.count();
+  uint64_t tick = 0U;
+  auto last_frame = std::chrono::steady_clock::now();
   while (true) {
-    screen_->start_update();
-    const auto now = std::chrono::high_resolution_clock::now();
-    if (!maybe_min_update_interval.has_value() ||
-        (now - last_update) > maybe_min_update_interval.value()) {
+    const auto frame_start = std::chrono::steady_clock::now();
+    const uint32_t step_count = timestep.advance(frame_start - last_frame);
+    last_frame = frame_start;
+
+    {
+      PROFILE_SCOPE("Controller::poll_events");
+      screen_->start_update();
       if (!TRY(screen_->poll_events_and_check_for_close())) {
-        return Ok();
+        break;
       }
+    }
 
+    {
+      // events are handled every frame so input isn't delayed until the next
+      // step, they see the state from the end of the last step
+      PROFILE_SCOPE("Controller::handle_events");
       for (const auto &event : screen_->get_events()) {
-        TRY_VOID(game_state_->handle_event(event, *screen_));
+        if (maybe_input_recorder.has_value()) {
+          TRY_VOID(maybe_input_recorder->record(tick, event));
+        }
+        TRY_VOID(game_state_->handle_event(event));
       }
+      screen_->clear_events();
+    }
 
-      TRY_VOID(game_state_->advance_state(
-          std::chrono::nanoseconds(now - last_update).count()));
+    {
+      PROFILE_SCOPE("Controller::simulate");
+      for (uint32_t step = 0U; step < step_count; ++step) {
+        TRY_VOID(game_state_->advance_state(step_ns));
+      }
+      tick += step_count;
+    }
+
+    {
+      PROFILE_SCOPE("Controller::draw");
+      game_state_->set_interpolation_alpha(
+          timestep.get_interpolation_alpha());
+      TRY_VOID(game_state_->draw(*screen_));
+      if (maybe_profiler_overlay.has_value()) {
+        maybe_profiler_overlay->draw();
+      }
+    }
+
+    {
+      PROFILE_SCOPE("Controller::present");
+      screen_->finish_update();
+    }
+
+    if (params.maybe_render_interval.has_value()) {
+      std::this_thread::sleep_until(frame_start +
+                                    params.maybe_render_interval.value());
+    }
+    utility::Profiler::get().end_frame();
+  }
+  return finish_profiling(params);
+}
+
+Result<void, std::string>
+Controller::run_pipelined(const LoopParams &params) {
+  if (!screen_) {
+    return Err(std::string("Controller::run_pipelined needs a screen, use "
+                           "run_headless to simulate without one"));
+  }
+
+  auto maybe_input_recorder_result = make_maybe_input_recorder(params);
+  if (maybe_input_recorder_result.isErr()) {
+    return Err(maybe_input_recorder_result.unwrapErr());
+  }
+  auto maybe_input_recorder = std::move(maybe_input_recorder_result).unwrap();
+
+  start_profiling(params);
+  std::optional<view::ProfilerOverlay> maybe_profiler_overlay;
+  if (params.is_profiling_enabled) {
+    maybe_profiler_overlay.emplace();
+  }
+
+  EventQueue events;
+  SnapshotBuffer snapshots;
+  std::atomic<bool> should_stop{false};
+  std::optional<std::string> maybe_simulation_error;
+  std::thread simulation_thread([&]() {
+    if (params.is_profiling_enabled) {
+      utility::Profiler::get().set_thread_name("simulation");
+    }
+    auto result = run_simulation(params, events, snapshots,
+                                 maybe_input_recorder, should_stop);
+    if (result.isErr()) {
+      maybe_simulation_error = result.unwrapErr();
+    }
+    should_stop.store(true, std::memory_order_release);
+  });
+
+  // zoom levels in snapshots scale the viewport the screen started with
+  const Eigen::Vector2f base_viewport_size = screen_->get_viewport_size();
+  std::optional<std::string> maybe_render_error;
+  while (!should_stop.load(std::memory_order_acquire)) {
+    const auto frame_start = std::chrono::steady_clock::now();
+    {
+      PROFILE_SCOPE("Controller::poll_events");
+      screen_->start_update();
+      const auto poll_result = screen_->poll_events_and_check_for_close();
+      if (poll_result.isErr()) {
+        maybe_render_error = poll_result.unwrapErr();
+        break;
+      }
+      if (!poll_result.unwrap()) {
+        break;
+      }
+
+      for (const auto &event : screen_->get_events()) {
+        if (!events.try_push(event)) {
+          ++dropped_input_event_count_;
+        }
+      }
       screen_->clear_events();
-      last_update = now;
     }
-    TRY_VOID(game_state_->draw(*screen_));
-    screen_->finish_update();
+
+    {
+      PROFILE_SCOPE("Controller::draw");
+      snapshots.update_read_buffer();
+      const auto draw_result =
+          snapshots.get_read_buffer().draw(*screen_, base_viewport_size);
+      if (draw_result.isErr()) {
+        maybe_render_error = draw_result.unwrapErr();
+        break;
+      }
+      if (maybe_profiler_overlay.has_value()) {
+        maybe_profiler_overlay->draw();
+      }
+    }
+
+    {
+      PROFILE_SCOPE("Controller::present");
+      screen_->finish_update();
+    }
+
+    if (params.maybe_render_interval.has_value()) {
+      std::this_thread::sleep_until(frame_start +
+                                    params.maybe_render_interval.value());
+    }
+    utility::Profiler::get().end_frame();
+  }
+
+  should_stop.store(true, std::memory_order_release);
+  simulation_thread.join();
+  if (dropped_input_event_count_ > 0UL) {
+    std::cerr << "Simulation fell behind, dropped "
+              << dropped_input_event_count_ << " input events" << std::endl;
+  }
+  if (maybe_render_error.has_value()) {
+    return Err(std::move(maybe_render_error).value());
+  }
+  if (maybe_simulation_error.has_value()) {
+    return Err(std::move(maybe_simulation_error).value());
+  }
+  return finish_profiling(params);
+}
+
+Result<void, std::string>
+Controller::run_simulation(const LoopParams &params, EventQueue &events,
+                           SnapshotBuffer &snapshots,
+                           std::optional<InputRecorder> &maybe_input_recorder,
+                           const std::atomic<bool> &should_stop) {
+  FixedTimestep timestep{params.simulation_step, params.max_steps_per_frame};
+  const int64_t step_ns = params.simulation_step.count();
+  // snapshots are recorded right after a step, so there's nothing to blend
+  game_state_->set_interpolation_alpha(1.0f);
+  uint64_t tick = 0U;
+  auto last_update = std::chrono::steady_clock::now();
+  while (!should_stop.load(std::memory_order_acquire)) {
+    const auto update_start = std::chrono::steady_clock::now();
+    const uint32_t step_count = timestep.advance(update_start - last_update);
+    last_update = update_start;
+
+    while (const auto maybe_event = events.try_pop()) {
+      if (maybe_input_recorder.has_value()) {
+        TRY_VOID(maybe_input_recorder->record(tick, maybe_event.value()));
+      }
+      TRY_VOID(game_state_->handle_event(maybe_event.value()));
+    }
+
+    if (step_count > 0U) {
+      PROFILE_SCOPE("Controller::simulate");
+      for (uint32_t step = 0U; step < step_count; ++step) {
+        TRY_VOID(game_state_->advance_state(step_ns));
+      }
+      tick += step_count;
+      auto &snapshot = snapshots.get_write_buffer();
+      snapshot.clear();
+      TRY_VOID(game_state_->record_render_snapshot(snapshot));
+      snapshots.publish();
+    }
+
+    std::this_thread::sleep_until(update_start + params.simulation_step);
   }
   return Ok();
 }
+
+Result<void, std::string>
+Controller::run_headless(const std::chrono::nanoseconds simulation_step,
+                         const uint64_t step_count) {
+  // nothing is drawn, so every entity is drawn at its latest state
+  game_state_->set_interpolation_alpha(1.0f);
+  auto &profiler = utility::Profiler::get();
+  for (uint64_t step = 0U; step < step_count; ++step) {
+    TRY_VOID(game_state_->advance_state(simulation_step.count()));
+    profiler.end_frame();
+  }
+  return Ok();
+}
+
+Result<std::optional<InputRecorder>, std::string>
+Controller::make_maybe_input_recorder(const LoopParams &params) {
+  if (!params.maybe_input_recording_path.has_value()) {
+    return Ok(std::optional<InputRecorder>{});
+  }
+  auto recorder_result =
+      InputRecorder::create(params.maybe_input_recording_path.value(),
+                            utility::get_rng_seed(), params.simulation_step);
+  if (recorder_result.isErr()) {
+    return Err(recorder_result.unwrapErr());
+  }
+  return Ok(std::optional<InputRecorder>{std::move(recorder_result).unwrap()});
+}
+
+void Controller::start_profiling(const LoopParams &params) {
+  if (!params.is_profiling_enabled) {
+    return;
+  }
+  auto &profiler = utility::Profiler::get();
+  profiler.set_thread_name("main");
+  profiler.set_enabled(true);
+}
+
+Result<void, std::string>
+Controller::finish_profiling(const LoopParams &params) {
+  if (!params.is_profiling_enabled ||
+      !params.maybe_profile_trace_path.has_value()) {
+    return Ok();
+  }
+  return utility::Profiler::get().write_chrome_trace(
+      params.maybe_profile_trace_path.value());
+}
+
+Result<Controller::LoopParams, std::string>
+parse_command_line(const int argc, char **argv) {
+  Controller::LoopParams params;
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    constexpr std::string_view record_prefix{"--record="};
+    constexpr std::string_view seed_prefix{"--seed="};
+    constexpr std::string_view profile_trace_prefix{"--profile_trace="};
+    if (argument == "--profile") {
+      params.is_profiling_enabled = true;
+    } else if (argument == "--pipelined") {
+      params.is_pipelined = true;
+    } else if (argument.starts_with(profile_trace_prefix)) {
+      params.is_profiling_enabled = true;
+      params.maybe_profile_trace_path =
+          std::filesystem::path(argument.substr(profile_trace_prefix.size()));
+    } else if (argument.starts_with(record_prefix)) {
+      params.maybe_input_recording_path =
+          std::filesystem::path(argument.substr(record_prefix.size()));
+    } else if (argument.starts_with(seed_prefix)) {
+      const auto value = argument.substr(seed_prefix.size());
+      uint32_t seed{0U};
+      const auto [end, error] =
+          std::from_chars(value.data(), value.data() + value.size(), seed);
+      if (error != std::errc{} || end != value.data() + value.size()) {
+        return Err(std::string("Invalid seed: ") + std::string(value));
+      }
+      utility::seed_rng(seed);
+    } else {
+      return Err(std::string("Unknown argument: ") + std::string(argument) +
+                 ", expected --seed=N, --record=path, --profile, "
+                 "--profile_trace=path or --pipelined");
+    }
+  }
+  return Ok(std::move(params));
+}
 } // namespace controller
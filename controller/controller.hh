@@ -1,23 +1,138 @@
 #pragma once
+#include "controller/fixed_timestep.hh"
+#include "controller/input_recording.hh"
 #include "model/game_state.hh"
+#include "utility/spsc_queue.hh"
+#include "utility/triple_buffer.hh"
 #include "utility/try.hh"
+#include "view/render_snapshot.hh"
 #include "view/screen.hh"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <optional>
 
 namespace controller {
 class Controller {
 public:
+  /// Timing of the main loop
+  struct LoopParams {
+    /// Simulated time passed to every GameState::advance_state call, the
+    /// simulation runs at this rate whatever the frame rate
+    std::chrono::nanoseconds simulation_step{
+        std::chrono::nanoseconds{1'000'000'000 / 60}};
+    /// Minimum time between rendered frames, nullopt draws as often as vsync
+    /// allows
+    std::optional<std::chrono::nanoseconds> maybe_render_interval;
+    /// Most simulation steps run before each draw, time beyond that is
+    /// dropped so the game slows down instead of spiralling when steps cost
+    /// more than they simulate
+    uint32_t max_steps_per_frame{8U};
+    /// File to record every input event to along with the RNG seed, for
+    /// replaying the run with //tools:simulate --replay
+    std::optional<std::filesystem::path> maybe_input_recording_path;
+    /// Record utility::Profiler zones and show the profiler overlay
+    bool is_profiling_enabled{false};
+    /// File the profiled frames are written to as a Chrome trace when the
+    /// loop exits, only used while profiling
+    std::optional<std::filesystem::path> maybe_profile_trace_path;
+    /// Make run() simulate and draw on separate threads, see run_pipelined
+    bool is_pipelined{false};
+  };
+
+  /// @param[in] screen window to draw to, may be null if only run_headless is
+  /// used
+  /// @param[in] game_state game to run
   Controller(std::unique_ptr<view::Screen> screen,
              std::unique_ptr<model::GameState> game_state);
 
+  /// Run until the window is closed with the default LoopParams
   Result<void, std::string> run();
-  Result<void, std::string> run(std::chrono::milliseconds min_update_interval);
+
+  /// Run until the window is closed with a fixed simulation step
+  /// @param[in] simulation_step simulated time per step, e.g. the tick of a
+  /// turn based game
+  Result<void, std::string> run(std::chrono::milliseconds simulation_step);
+
+  /// Run until the window is closed
+  /// @param[in] params simulation and render rates, run_pipelined is used
+  /// instead if they ask for it
+  Result<void, std::string> run(const LoopParams &params);
+
+  /// Run until the window is closed with simulation and drawing on separate
+  /// threads, so waiting on vsync doesn't take time from the simulation
+  ///
+  /// A simulation thread steps the game state and publishes a RenderSnapshot
+  /// after each batch of steps, while this thread polls events, forwards them
+  /// through a queue and draws the latest snapshot.
+  ///
+  /// @param[in] params simulation and render rates
+  /// @return error from the game state if a step, event or recorded draw
+  /// fails, including for components which can't be recorded
+  /// @note only what entities and systems record through record_snapshot is
+  /// drawn, and frames show the latest step without interpolation
+  Result<void, std::string> run_pipelined(const LoopParams &params);
+
+  /// Simulate without a window or real time pacing, as fast as possible
+  /// @param[in] simulation_step simulated time per step
+  /// @param[in] step_count number of steps to run
+  /// @return error from the game state if a step fails
+  /// @note every step is one profiler frame while the profiler is enabled
+  Result<void, std::string>
+  run_headless(std::chrono::nanoseconds simulation_step, uint64_t step_count);
+
+  /// Input events run_pipelined dropped because the simulation fell more than
+  /// max_queued_events behind, reported once when the loop exits
+  [[nodiscard]] uint64_t get_dropped_input_event_count() const {
+    return dropped_input_event_count_;
+  }
 
 private:
+  /// Start recording if params ask for it
+  /// @return recorder, nullopt if params have no recording path
+  [[nodiscard]] static Result<std::optional<InputRecorder>, std::string>
+  make_maybe_input_recorder(const LoopParams &params);
+
+  /// Enable the profiler and name the calling thread if params ask for it
+  static void start_profiling(const LoopParams &params);
+
+  /// Write the profiled frames if params ask for a trace
+  /// @return error if the trace can't be written
+  [[nodiscard]] static Result<void, std::string>
+  finish_profiling(const LoopParams &params);
+
+  /// Most events queued between the render and simulation threads, events
+  /// beyond this are dropped if the simulation falls behind
+  static constexpr std::size_t max_queued_events{256UL};
+
+  using EventQueue = utility::SpscQueue<view::EventType, max_queued_events>;
+  using SnapshotBuffer = utility::TripleBuffer<view::RenderSnapshot>;
+
+  /// Simulation thread body of run_pipelined, runs until should_stop is set
   Result<void, std::string>
-  run(std::optional<std::chrono::milliseconds> maybe_min_update_interval);
+  run_simulation(const LoopParams &params, EventQueue &events,
+                 SnapshotBuffer &snapshots,
+                 std::optional<InputRecorder> &maybe_input_recorder,
+                 const std::atomic<bool> &should_stop);
+
   std::unique_ptr<view::Screen> screen_;
   std::unique_ptr<model::GameState> game_state_;
+  uint64_t dropped_input_event_count_{0UL};
 };
+
+/// Read the loop options shared by the game binaries from the command line
+///
+/// --seed=N seeds utility::get_rng right away, so call this before creating
+/// the game. --record=path sets LoopParams::maybe_input_recording_path.
+/// --profile enables profiling, --profile_trace=path also writes the frames
+/// to a Chrome trace on exit. --pipelined sets LoopParams::is_pipelined.
+///
+/// @param[in] argc argument count from main
+/// @param[in] argv arguments from main
+/// @return default LoopParams with the options applied, error for unknown
+/// arguments
+[[nodiscard]] Result<Controller::LoopParams, std::string>
+parse_command_line(const int argc, char **argv);
 } // namespace controller
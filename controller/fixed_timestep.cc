@@ -0,0 +1,30 @@
+#include "controller/fixed_timestep.hh"
+#include <algorithm>
+
+namespace controller {
+FixedTimestep::FixedTimestep(const std::chrono::nanoseconds step,
+                             const uint32_t max_steps_per_frame)
+    : step_(step), max_steps_per_frame_(max_steps_per_frame) {}
+
+uint32_t FixedTimestep::advance(const std::chrono::nanoseconds elapsed) {
+  accumulated_time_ += std::max(elapsed, std::chrono::nanoseconds{0});
+  const auto due_steps = static_cast<uint64_t>(accumulated_time_ / step_);
+  const auto step_count = static_cast<uint32_t>(
+      std::min<uint64_t>(due_steps, max_steps_per_frame_));
+  accumulated_time_ -= step_ * step_count;
+
+  if (step_count < due_steps) {
+    // keep the partial step so the interpolation alpha stays continuous
+    const auto remainder = accumulated_time_ % step_;
+    dropped_time_ += accumulated_time_ - remainder;
+    accumulated_time_ = remainder;
+  }
+  return step_count;
+}
+
+float FixedTimestep::get_interpolation_alpha() const {
+  return static_cast<float>(
+      std::chrono::duration<double>(accumulated_time_) /
+      std::chrono::duration<double>(step_));
+}
+} // namespace controller
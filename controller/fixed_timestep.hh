@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace controller {
+/// Turns real elapsed time into a whole number of fixed simulation steps
+///
+/// Elapsed time accumulates until it covers a step, the remainder carries over
+/// to the next frame and gives the interpolation alpha used to draw between
+/// the last two simulated states. At most max_steps_per_frame steps are run
+/// per frame; time beyond that is dropped rather than carried over, so a frame
+/// which is too slow to simulate doesn't make every later frame slower.
+class FixedTimestep {
+public:
+  /// @param[in] step simulated time per step
+  /// @param[in] max_steps_per_frame most steps advance will ever return
+  /// @pre step > 0 and max_steps_per_frame > 0
+  FixedTimestep(const std::chrono::nanoseconds step,
+                const uint32_t max_steps_per_frame);
+
+  /// Add the real time since the previous call
+  /// @param[in] elapsed time since the previous call
+  /// @return number of steps to simulate now
+  [[nodiscard]] uint32_t advance(const std::chrono::nanoseconds elapsed);
+
+  /// Fraction of a step accumulated but not simulated yet
+  /// @return value in [0, 1), 0 draws the state before the last step and
+  /// values towards 1 approach the latest simulated state
+  [[nodiscard]] float get_interpolation_alpha() const;
+
+  /// @return simulated time per step
+  [[nodiscard]] std::chrono::nanoseconds get_step() const { return step_; }
+
+  /// @return total time discarded because frames needed too many steps
+  [[nodiscard]] std::chrono::nanoseconds get_dropped_time() const {
+    return dropped_time_;
+  }
+
+private:
+  std::chrono::nanoseconds step_;
+  uint32_t max_steps_per_frame_;
+  std::chrono::nanoseconds accumulated_time_{0};
+  std::chrono::nanoseconds dropped_time_{0};
+};
+} // namespace controller
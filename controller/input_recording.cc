@@ -0,0 +1,275 @@
+#include "controller/input_recording.hh"
+#include "utility/overload.hh"
+#include <array>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace controller {
+namespace {
+constexpr std::array<char, 4> magic{'G', 'I', 'N', 'P'};
+constexpr uint32_t format_version{1U};
+
+// fields are written in native byte order, every platform we build for is
+// little endian
+template <typename Value> void write_value(std::ostream &output, Value value) {
+  static_assert(std::is_trivially_copyable_v<Value>);
+  std::array<char, sizeof(Value)> bytes;
+  std::memcpy(bytes.data(), &value, sizeof(Value));
+  output.write(bytes.data(), bytes.size());
+}
+
+template <typename Value> std::optional<Value> read_value(std::istream &input) {
+  static_assert(std::is_trivially_copyable_v<Value>);
+  std::array<char, sizeof(Value)> bytes;
+  if (!input.read(bytes.data(), bytes.size())) {
+    return std::nullopt;
+  }
+  Value value;
+  std::memcpy(&value, bytes.data(), sizeof(Value));
+  return value;
+}
+
+void write_varint(std::ostream &output, uint64_t value) {
+  while (value >= 0x80U) {
+    output.put(static_cast<char>((value & 0x7fU) | 0x80U));
+    value >>= 7U;
+  }
+  output.put(static_cast<char>(value));
+}
+
+std::optional<uint64_t> read_varint(std::istream &input) {
+  uint64_t value{0U};
+  for (uint32_t shift = 0U; shift < 64U; shift += 7U) {
+    const auto byte = input.get();
+    if (byte == std::istream::traits_type::eof()) {
+      return std::nullopt;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+void write_position(std::ostream &output, const Eigen::Vector2f &position) {
+  write_value(output, position.x());
+  write_value(output, position.y());
+}
+
+std::optional<Eigen::Vector2f> read_position(std::istream &input) {
+  const auto maybe_x = read_value<float>(input);
+  const auto maybe_y = read_value<float>(input);
+  if (!maybe_x.has_value() || !maybe_y.has_value()) {
+    return std::nullopt;
+  }
+  return Eigen::Vector2f{maybe_x.value(), maybe_y.value()};
+}
+
+void write_key_event(std::ostream &output, const sf::Event::KeyEvent &key) {
+  write_value(output, static_cast<int32_t>(key.code));
+  const uint8_t modifiers = (key.alt ? 1U : 0U) | (key.control ? 2U : 0U) |
+                            (key.shift ? 4U : 0U) | (key.system ? 8U : 0U);
+  write_value(output, modifiers);
+}
+
+std::optional<sf::Event::KeyEvent> read_key_event(std::istream &input) {
+  const auto maybe_code = read_value<int32_t>(input);
+  const auto maybe_modifiers = read_value<uint8_t>(input);
+  if (!maybe_code.has_value() || !maybe_modifiers.has_value()) {
+    return std::nullopt;
+  }
+  sf::Event::KeyEvent key{};
+  key.code = static_cast<sf::Keyboard::Key>(maybe_code.value());
+  key.alt = (maybe_modifiers.value() & 1U) != 0U;
+  key.control = (maybe_modifiers.value() & 2U) != 0U;
+  key.shift = (maybe_modifiers.value() & 4U) != 0U;
+  key.system = (maybe_modifiers.value() & 8U) != 0U;
+  return key;
+}
+
+/// Stored instead of the variant index so reordering view::EventType doesn't
+/// break existing recordings
+enum class EventTag : uint8_t {
+  mouse_up = 0U,
+  mouse_down = 1U,
+  mouse_moved = 2U,
+  mouse_scroll = 3U,
+  key_pressed = 4U,
+  key_released = 5U,
+};
+
+void write_event(std::ostream &output, const view::EventType &event) {
+  std::visit(
+      utility::Overload{
+          [&](const view::MouseUpEvent &mouse_up) {
+            write_value(output, EventTag::mouse_up);
+            write_value(output, static_cast<uint8_t>(mouse_up.button));
+            write_position(output, mouse_up.position);
+          },
+          [&](const view::MouseDownEvent &mouse_down) {
+            write_value(output, EventTag::mouse_down);
+            write_value(output, static_cast<uint8_t>(mouse_down.button));
+            write_position(output, mouse_down.position);
+          },
+          [&](const view::MouseMovedEvent &mouse_moved) {
+            write_value(output, EventTag::mouse_moved);
+            write_position(output, mouse_moved.position);
+          },
+          [&](const view::MouseScrollEvent &mouse_scroll) {
+            write_value(output, EventTag::mouse_scroll);
+            write_value(output, mouse_scroll.delta);
+            write_position(output, mouse_scroll.position);
+          },
+          [&](const view::KeyPressedEvent &key_press) {
+            write_value(output, EventTag::key_pressed);
+            write_key_event(output, key_press.key_event);
+          },
+          [&](const view::KeyReleasedEvent &key_release) {
+            write_value(output, EventTag::key_released);
+            write_key_event(output, key_release.key_event);
+          },
+      },
+      event);
+}
+
+/// @return event, nullopt if the input ends part way through it, error for
+/// unknown event types
+Result<std::optional<view::EventType>, std::string>
+read_event(std::istream &input) {
+  const auto maybe_tag = read_value<EventTag>(input);
+  if (!maybe_tag.has_value()) {
+    return Ok(std::optional<view::EventType>{});
+  }
+
+  const auto maybe_button = [&]() -> std::optional<view::MouseButton> {
+    const auto maybe_value = read_value<uint8_t>(input);
+    if (!maybe_value.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<view::MouseButton>(maybe_value.value());
+  };
+
+  std::optional<view::EventType> maybe_event;
+  switch (maybe_tag.value()) {
+  case EventTag::mouse_up:
+  case EventTag::mouse_down: {
+    const auto button = maybe_button();
+    const auto position = read_position(input);
+    if (button.has_value() && position.has_value()) {
+      if (maybe_tag.value() == EventTag::mouse_up) {
+        maybe_event = view::MouseUpEvent{button.value(), position.value()};
+      } else {
+        maybe_event = view::MouseDownEvent{button.value(), position.value()};
+      }
+    }
+    break;
+  }
+  case EventTag::mouse_moved: {
+    const auto position = read_position(input);
+    if (position.has_value()) {
+      maybe_event = view::MouseMovedEvent{position.value()};
+    }
+    break;
+  }
+  case EventTag::mouse_scroll: {
+    const auto delta = read_value<float>(input);
+    const auto position = read_position(input);
+    if (delta.has_value() && position.has_value()) {
+      maybe_event = view::MouseScrollEvent{delta.value(), position.value()};
+    }
+    break;
+  }
+  case EventTag::key_pressed:
+  case EventTag::key_released: {
+    const auto key = read_key_event(input);
+    if (key.has_value()) {
+      if (maybe_tag.value() == EventTag::key_pressed) {
+        maybe_event = view::KeyPressedEvent{key.value()};
+      } else {
+        maybe_event = view::KeyReleasedEvent{key.value()};
+      }
+    }
+    break;
+  }
+  default:
+    return Err(std::string("Unknown event type in input recording: ") +
+               std::to_string(static_cast<int>(maybe_tag.value())));
+  }
+  return Ok(maybe_event);
+}
+} // namespace
+
+Result<InputRecorder, std::string>
+InputRecorder::create(const std::filesystem::path &path,
+                      const uint32_t rng_seed,
+                      const std::chrono::nanoseconds simulation_step) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Err(std::string("Failed to create input recording: ") +
+               path.string());
+  }
+  file.write(magic.data(), magic.size());
+  write_value(file, format_version);
+  write_value(file, rng_seed);
+  write_value(file, static_cast<int64_t>(simulation_step.count()));
+  if (!file) {
+    return Err(std::string("Failed to write input recording: ") +
+               path.string());
+  }
+  return Ok(InputRecorder(std::move(file), path));
+}
+
+Result<void, std::string> InputRecorder::record(const uint64_t tick,
+                                                const view::EventType &event) {
+  if (tick < last_tick_) {
+    return Err(std::string("Input recording ticks must not go backwards"));
+  }
+  write_varint(file_, tick - last_tick_);
+  write_event(file_, event);
+  last_tick_ = tick;
+  if (!file_) {
+    return Err(std::string("Failed to write input recording: ") +
+               path_.string());
+  }
+  return Ok();
+}
+
+Result<InputRecording, std::string>
+read_input_recording(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return Err(std::string("Failed to open input recording: ") +
+               path.string());
+  }
+
+  std::array<char, magic.size()> file_magic;
+  file.read(file_magic.data(), file_magic.size());
+  const auto maybe_version = read_value<uint32_t>(file);
+  const auto maybe_rng_seed = read_value<uint32_t>(file);
+  const auto maybe_step_ns = read_value<int64_t>(file);
+  if (file_magic != magic || !maybe_step_ns.has_value()) {
+    return Err(std::string("Not an input recording: ") + path.string());
+  }
+  if (maybe_version.value() != format_version) {
+    return Err(std::string("Unsupported input recording version ") +
+               std::to_string(maybe_version.value()) + ": " + path.string());
+  }
+
+  InputRecording recording{
+      .rng_seed = maybe_rng_seed.value(),
+      .simulation_step = std::chrono::nanoseconds{maybe_step_ns.value()}};
+  uint64_t tick{0U};
+  while (const auto maybe_tick_delta = read_varint(file)) {
+    const auto maybe_event = TRY(read_event(file));
+    if (!maybe_event.has_value()) {
+      break;
+    }
+    tick += maybe_tick_delta.value();
+    recording.events.push_back(TickedEvent{tick, maybe_event.value()});
+  }
+  return Ok(std::move(recording));
+}
+
+} // namespace controller
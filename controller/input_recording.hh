@@ -0,0 +1,78 @@
+#pragma once
+#include "utility/try.hh"
+#include "view/screen.hh"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace controller {
+
+/// Event handled right before a simulation step
+struct TickedEvent {
+  /// Number of simulation steps run before the event was handled
+  uint64_t tick;
+  view::EventType event;
+};
+
+/// Everything needed to reproduce a run: the seed of utility::get_rng when
+/// the game was created, the step length and the input
+struct InputRecording {
+  uint32_t rng_seed{0U};
+  std::chrono::nanoseconds simulation_step{0};
+  std::vector<TickedEvent> events;
+};
+
+/**
+ * @brief Writes input events to a compact binary file as they happen
+ *
+ * The file starts with a header holding the RNG seed and step length,
+ * followed by one record per event: the tick as a delta from the previous
+ * event (LEB128 encoded, so usually one byte), the event type and its fields.
+ * Records are written through a buffered stream, a recording cut short by a
+ * crash is still readable up to the last complete record.
+ */
+class InputRecorder {
+public:
+  /**
+   * @brief Create the file and write its header
+   * @param path file to write, replaced if it exists
+   * @param rng_seed seed the game was created with, see utility::get_rng_seed
+   * @param simulation_step simulated time per step
+   * @return recorder, error if the file can't be created
+   */
+  [[nodiscard]] static Result<InputRecorder, std::string>
+  create(const std::filesystem::path &path, const uint32_t rng_seed,
+         const std::chrono::nanoseconds simulation_step);
+
+  /**
+   * @brief Append an event
+   * @param tick number of steps run before the event is handled, must not be
+   * less than the tick of the previous event
+   * @param event event to record
+   * @return error if writing fails or tick goes backwards
+   */
+  [[nodiscard]] Result<void, std::string>
+  record(const uint64_t tick, const view::EventType &event);
+
+private:
+  InputRecorder(std::ofstream file, std::filesystem::path path)
+      : file_(std::move(file)), path_(std::move(path)) {}
+
+  std::ofstream file_;
+  std::filesystem::path path_;
+  uint64_t last_tick_{0U};
+};
+
+/**
+ * @brief Read a file written by InputRecorder
+ * @param path file to read
+ * @return recording, error if the file can't be read, isn't a recording or
+ * holds an unknown event type
+ * @note a trailing partial record, e.g. from a crash, is ignored
+ */
+[[nodiscard]] Result<InputRecording, std::string>
+read_input_recording(const std::filesystem::path &path);
+
+} // namespace controller
@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+#include "controller/fixed_timestep.hh"
+#include <cmath>
+
+using namespace controller;
+using namespace std::chrono_literals;
+
+namespace {
+bool is_near(const float value, const float expected) {
+  return std::abs(value - expected) < 1e-6f;
+}
+} // namespace
+
+TEST_CASE("Fixed timestep accumulates elapsed time", "[fixed_timestep]") {
+  FixedTimestep timestep{10ms, 8U};
+
+  SECTION("Partial steps carry over to later frames") {
+    CHECK(timestep.advance(4ms) == 0U);
+    CHECK(is_near(timestep.get_interpolation_alpha(), 0.4f));
+    CHECK(timestep.advance(7ms) == 1U);
+    CHECK(is_near(timestep.get_interpolation_alpha(), 0.1f));
+  }
+
+  SECTION("Long frames run several steps") {
+    CHECK(timestep.advance(35ms) == 3U);
+    CHECK(is_near(timestep.get_interpolation_alpha(), 0.5f));
+  }
+
+  SECTION("Simulated time matches real time over many frames") {
+    uint64_t step_count = 0U;
+    for (int frame = 0; frame < 1000; ++frame) {
+      step_count += timestep.advance(16'666'667ns);
+    }
+    CHECK(step_count == 1666U);
+    CHECK(timestep.get_dropped_time() == 0ns);
+  }
+}
+
+TEST_CASE("Fixed timestep caps steps per frame", "[fixed_timestep]") {
+  FixedTimestep timestep{10ms, 4U};
+
+  // a stall only costs max_steps_per_frame steps, the rest is dropped
+  CHECK(timestep.advance(1s + 3ms) == 4U);
+  CHECK(timestep.get_dropped_time() == 960ms);
+  CHECK(is_near(timestep.get_interpolation_alpha(), 0.3f));
+
+  // and the next frame is back to normal
+  CHECK(timestep.advance(10ms) == 1U);
+}
+
+TEST_CASE("Fixed timestep ignores negative elapsed time", "[fixed_timestep]") {
+  FixedTimestep timestep{10ms, 4U};
+  CHECK(timestep.advance(-5ms) == 0U);
+  CHECK(timestep.get_interpolation_alpha() == 0.0f);
+}
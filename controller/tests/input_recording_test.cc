@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include "controller/input_recording.hh"
+#include <filesystem>
+#include <fstream>
+
+using namespace controller;
+using namespace std::chrono_literals;
+
+namespace {
+std::filesystem::path get_recording_path() {
+  return std::filesystem::temp_directory_path() / "input_recording_test.bin";
+}
+
+sf::Event::KeyEvent make_key_event(const sf::Keyboard::Key code) {
+  sf::Event::KeyEvent key_event{};
+  key_event.code = code;
+  key_event.shift = true;
+  return key_event;
+}
+} // namespace
+
+TEST_CASE("Input recordings round trip", "[input_recording]") {
+  const auto path = get_recording_path();
+  {
+    auto recorder_result = InputRecorder::create(path, 42U, 16ms);
+    REQUIRE(recorder_result.isOk());
+    auto recorder = std::move(recorder_result).unwrap();
+    CHECK(recorder
+              .record(0U, view::KeyPressedEvent{make_key_event(sf::Keyboard::W)})
+              .isOk());
+    CHECK(recorder
+              .record(0U, view::MouseDownEvent{view::MouseButton::Right,
+                                               Eigen::Vector2f{1.f, -2.f}})
+              .isOk());
+    CHECK(recorder.record(300U, view::MouseMovedEvent{{0.5f, 0.25f}}).isOk());
+    CHECK(recorder.record(300U, view::MouseScrollEvent{-1.f, {3.f, 4.f}})
+              .isOk());
+    CHECK(recorder
+              .record(1000U,
+                      view::KeyReleasedEvent{make_key_event(sf::Keyboard::W)})
+              .isOk());
+    CHECK(recorder
+              .record(999U, view::MouseUpEvent{view::MouseButton::Left,
+                                               Eigen::Vector2f{0.f, 0.f}})
+              .isErr());
+  }
+
+  const auto recording_result = read_input_recording(path);
+  REQUIRE(recording_result.isOk());
+  const auto &recording = recording_result.unwrap();
+  CHECK(recording.rng_seed == 42U);
+  CHECK(recording.simulation_step == 16ms);
+  REQUIRE(recording.events.size() == 5U);
+
+  CHECK(recording.events[0].tick == 0U);
+  REQUIRE(std::holds_alternative<view::KeyPressedEvent>(
+      recording.events[0].event));
+  const auto &key_press =
+      std::get<view::KeyPressedEvent>(recording.events[0].event);
+  CHECK(key_press.key_event.code == sf::Keyboard::W);
+  CHECK(key_press.key_event.shift);
+  CHECK_FALSE(key_press.key_event.control);
+
+  REQUIRE(
+      std::holds_alternative<view::MouseDownEvent>(recording.events[1].event));
+  const auto &mouse_down =
+      std::get<view::MouseDownEvent>(recording.events[1].event);
+  CHECK(mouse_down.button == view::MouseButton::Right);
+  CHECK(mouse_down.position == Eigen::Vector2f{1.f, -2.f});
+
+  CHECK(recording.events[2].tick == 300U);
+  CHECK(std::holds_alternative<view::MouseMovedEvent>(
+      recording.events[2].event));
+  CHECK(recording.events[3].tick == 300U);
+  REQUIRE(std::holds_alternative<view::MouseScrollEvent>(
+      recording.events[3].event));
+  CHECK(std::get<view::MouseScrollEvent>(recording.events[3].event).delta ==
+        -1.f);
+  CHECK(recording.events[4].tick == 1000U);
+  CHECK(std::holds_alternative<view::KeyReleasedEvent>(
+      recording.events[4].event));
+
+  SECTION("A truncated last record is ignored") {
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2U);
+    const auto truncated_result = read_input_recording(path);
+    REQUIRE(truncated_result.isOk());
+    CHECK(truncated_result.unwrap().events.size() == 4U);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Files which aren't recordings are rejected", "[input_recording]") {
+  const auto path = get_recording_path();
+  {
+    std::ofstream file(path);
+    file << "not a recording";
+  }
+  CHECK(read_input_recording(path).isErr());
+  std::filesystem::remove(path);
+  CHECK(read_input_recording(path).isErr());
+}
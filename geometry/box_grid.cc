@@ -0,0 +1,116 @@
+#include "geometry/box_grid.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace geometry {
+
+BoxGrid::BoxGrid(const float cell_size) : preferred_cell_size_(cell_size) {}
+
+void BoxGrid::build(const std::vector<Eigen::AlignedBox2f> &boxes) {
+  boxes_ = boxes;
+
+  Eigen::AlignedBox2f bounds;
+  for (const auto &box : boxes_) {
+    bounds.extend(box);
+  }
+  if (bounds.isEmpty()) {
+    cell_count_ = Eigen::Vector2i::Zero();
+    cell_offsets_.assign(1U, 0U);
+    box_indices_.clear();
+    return;
+  }
+
+  origin_ = bounds.min();
+  cell_size_ = std::max(preferred_cell_size_,
+                        bounds.sizes().maxCoeff() / max_cells_per_axis);
+  cell_count_ = (bounds.sizes() / cell_size_)
+                    .array()
+                    .floor()
+                    .cast<int32_t>()
+                    .matrix() +
+                Eigen::Vector2i::Ones();
+  cell_count_ = cell_count_.cwiseMin(max_cells_per_axis);
+
+  const auto for_each_overlap = [&](const auto &visit) {
+    for (uint32_t box_index = 0; box_index < boxes_.size(); ++box_index) {
+      Eigen::Vector2i min_cell;
+      Eigen::Vector2i max_cell;
+      if (!get_cell_range(boxes_[box_index], min_cell, max_cell)) {
+        continue;
+      }
+      for (int32_t y = min_cell.y(); y <= max_cell.y(); ++y) {
+        for (int32_t x = min_cell.x(); x <= max_cell.x(); ++x) {
+          visit(box_index, static_cast<std::size_t>(y * cell_count_.x() + x));
+        }
+      }
+    }
+  };
+
+  // counting sort into cells, see systems::bin_lights_into_tiles
+  cell_offsets_.assign(
+      static_cast<std::size_t>(cell_count_.x() * cell_count_.y()) + 1, 0U);
+  for_each_overlap([this](uint32_t, const std::size_t cell_index) {
+    ++cell_offsets_[cell_index + 1];
+  });
+  for (std::size_t i = 1; i < cell_offsets_.size(); ++i) {
+    cell_offsets_[i] += cell_offsets_[i - 1];
+  }
+
+  box_indices_.resize(cell_offsets_.back());
+  for_each_overlap(
+      [this](const uint32_t box_index, const std::size_t cell_index) {
+        box_indices_[cell_offsets_[cell_index]++] = box_index;
+      });
+  for (std::size_t i = cell_offsets_.size() - 1; i > 0; --i) {
+    cell_offsets_[i] = cell_offsets_[i - 1];
+  }
+  cell_offsets_[0] = 0U;
+}
+
+void BoxGrid::query(const Eigen::AlignedBox2f &area,
+                    std::vector<uint32_t> &box_indices) const {
+  box_indices.clear();
+  Eigen::Vector2i min_cell;
+  Eigen::Vector2i max_cell;
+  if (!get_cell_range(area, min_cell, max_cell)) {
+    return;
+  }
+  for (int32_t y = min_cell.y(); y <= max_cell.y(); ++y) {
+    for (int32_t x = min_cell.x(); x <= max_cell.x(); ++x) {
+      const auto cell_index = static_cast<std::size_t>(y * cell_count_.x() + x);
+      for (uint32_t i = cell_offsets_[cell_index];
+           i < cell_offsets_[cell_index + 1]; ++i) {
+        if (boxes_[box_indices_[i]].intersects(area)) {
+          box_indices.push_back(box_indices_[i]);
+        }
+      }
+    }
+  }
+
+  // boxes spanning several cells are found once per cell
+  std::ranges::sort(box_indices);
+  const auto duplicates = std::ranges::unique(box_indices);
+  box_indices.erase(duplicates.begin(), duplicates.end());
+}
+
+bool BoxGrid::get_cell_range(const Eigen::AlignedBox2f &box,
+                             Eigen::Vector2i &min_cell,
+                             Eigen::Vector2i &max_cell) const {
+  if (box.isEmpty()) {
+    return false;
+  }
+  const Eigen::Vector2f min_offset = (box.min() - origin_) / cell_size_;
+  const Eigen::Vector2f max_offset = (box.max() - origin_) / cell_size_;
+  for (int axis = 0; axis < 2; ++axis) {
+    if (max_offset[axis] < 0.0f || min_offset[axis] >= cell_count_[axis]) {
+      return false;
+    }
+    min_cell[axis] =
+        std::max(0, static_cast<int32_t>(std::floor(min_offset[axis])));
+    max_cell[axis] = std::min(cell_count_[axis] - 1,
+                              static_cast<int32_t>(std::floor(max_offset[axis])));
+  }
+  return true;
+}
+
+} // namespace geometry
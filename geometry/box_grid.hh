@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <vector>
+
+namespace geometry {
+
+/// Uniform grid over a set of axis aligned boxes for fast area queries
+///
+/// Each cell stores the indices of the boxes overlapping it back to back, the
+/// same layout systems::LightTileGrid uses for lights. The grid covers the
+/// bounding box of every box it was built from, so queries outside it are
+/// cheap misses.
+class BoxGrid {
+public:
+  /// Most cells along either axis, the cell size grows for larger levels
+  static constexpr int32_t max_cells_per_axis{256};
+
+  /// @param[in] cell_size preferred width and height of a cell
+  /// @pre cell_size > 0
+  explicit BoxGrid(const float cell_size = 1.0f);
+
+  /// Replace the indexed boxes
+  /// @param[in] boxes boxes to index, query results are indices into this
+  /// vector
+  /// @note existing allocations are reused
+  void build(const std::vector<Eigen::AlignedBox2f> &boxes);
+
+  /// Find every box overlapping area
+  /// @param[in] area region to search
+  /// @param[out] box_indices cleared then filled with the indices of the
+  /// overlapping boxes, ascending and without duplicates
+  void query(const Eigen::AlignedBox2f &area,
+             std::vector<uint32_t> &box_indices) const;
+
+private:
+  /// Range of cells touched by box, both ends inclusive
+  /// @return false if box misses the grid entirely
+  [[nodiscard]] bool get_cell_range(const Eigen::AlignedBox2f &box,
+                                    Eigen::Vector2i &min_cell,
+                                    Eigen::Vector2i &max_cell) const;
+
+  float preferred_cell_size_;
+  float cell_size_{1.0f};
+  Eigen::Vector2f origin_{0.0f, 0.0f};
+  Eigen::Vector2i cell_count_{0, 0};
+  std::vector<Eigen::AlignedBox2f> boxes_;
+  std::vector<uint32_t> cell_offsets_;
+  std::vector<uint32_t> box_indices_;
+};
+
+} // namespace geometry
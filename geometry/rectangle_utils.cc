@@ -8,6 +8,16 @@ get_bottom_left_and_top_right_from_transform(const Eigen::Affine2f &transform) {
   return {transform * bottom_left, transform * top_right};
 }
 
+Eigen::AlignedBox2f
+get_bounding_box_from_transform(const Eigen::Affine2f &transform) {
+  Eigen::AlignedBox2f bounding_box;
+  bounding_box.extend(transform * Eigen::Vector2f{-1.0f, -1.0f});
+  bounding_box.extend(transform * Eigen::Vector2f{-1.0f, 1.0f});
+  bounding_box.extend(transform * Eigen::Vector2f{1.0f, -1.0f});
+  bounding_box.extend(transform * Eigen::Vector2f{1.0f, 1.0f});
+  return bounding_box;
+}
+
 bool rectangle_contains_point(const Eigen::Affine2f &transform,
                               const Eigen::Vector2f &point) {
   const auto transformed_point = transform.inverse() * point;
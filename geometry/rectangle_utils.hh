@@ -6,6 +6,14 @@ namespace geometry {
 [[nodiscard]] std::pair<Eigen::Vector2f, Eigen::Vector2f>
 get_bottom_left_and_top_right_from_transform(const Eigen::Affine2f &transform);
 
+/// Get the axis aligned box enclosing the unit square mapped through transform
+/// @note unlike get_bottom_left_and_top_right_from_transform this handles
+/// rotated and mirrored transforms
+/// @param[in] transform transform applied to the square from (-1, -1) to (1, 1)
+/// @return smallest axis aligned box containing the transformed square
+[[nodiscard]] Eigen::AlignedBox2f
+get_bounding_box_from_transform(const Eigen::Affine2f &transform);
+
 [[nodiscard]] bool rectangle_contains_point(const Eigen::Affine2f &transform,
                                             const Eigen::Vector2f &point);
 
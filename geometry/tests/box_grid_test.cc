@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+#include "geometry/box_grid.hh"
+#include <vector>
+
+using namespace geometry;
+
+namespace {
+Eigen::AlignedBox2f make_box(const Eigen::Vector2f min,
+                             const Eigen::Vector2f max) {
+  return Eigen::AlignedBox2f{min, max};
+}
+} // namespace
+
+TEST_CASE("Query returns only overlapping boxes", "[box_grid]") {
+  BoxGrid grid{1.0f};
+  grid.build({
+      make_box({0.0f, 0.0f}, {1.0f, 0.5f}),   // bottom left
+      make_box({5.0f, 5.0f}, {6.0f, 6.0f}),   // top right
+      make_box({0.5f, 2.0f}, {5.5f, 2.5f}),   // long box across many cells
+      make_box({2.2f, 0.2f}, {2.4f, 0.4f}),   // shares a cell with the query
+  });
+
+  std::vector<uint32_t> box_indices;
+  grid.query(make_box({0.0f, 0.0f}, {2.1f, 3.0f}), box_indices);
+  CHECK(box_indices == std::vector<uint32_t>{0U, 2U});
+
+  grid.query(make_box({4.9f, 1.0f}, {7.0f, 7.0f}), box_indices);
+  CHECK(box_indices == std::vector<uint32_t>{1U, 2U});
+}
+
+TEST_CASE("Boxes spanning several cells are returned once", "[box_grid]") {
+  BoxGrid grid{0.5f};
+  grid.build({make_box({0.0f, 0.0f}, {10.0f, 10.0f})});
+
+  std::vector<uint32_t> box_indices;
+  grid.query(make_box({1.0f, 1.0f}, {9.0f, 9.0f}), box_indices);
+  CHECK(box_indices == std::vector<uint32_t>{0U});
+}
+
+TEST_CASE("Queries outside the grid find nothing", "[box_grid]") {
+  BoxGrid grid;
+  std::vector<uint32_t> box_indices{7U};
+  grid.build({});
+  grid.query(make_box({0.0f, 0.0f}, {1.0f, 1.0f}), box_indices);
+  CHECK(box_indices.empty());
+
+  grid.build({make_box({0.0f, 0.0f}, {1.0f, 1.0f})});
+  grid.query(make_box({-3.0f, -3.0f}, {-2.0f, -2.0f}), box_indices);
+  CHECK(box_indices.empty());
+}
+
+TEST_CASE("Large levels are capped at the maximum cell count", "[box_grid]") {
+  BoxGrid grid{0.01f};
+  grid.build({make_box({0.0f, 0.0f}, {0.1f, 0.1f}),
+              make_box({999.9f, 999.9f}, {1000.0f, 1000.0f})});
+
+  std::vector<uint32_t> box_indices;
+  grid.query(make_box({999.0f, 999.0f}, {1001.0f, 1001.0f}), box_indices);
+  CHECK(box_indices == std::vector<uint32_t>{1U});
+}
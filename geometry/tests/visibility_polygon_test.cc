@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include "geometry/visibility_polygon.hh"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+
+namespace {
+float cross(const Eigen::Vector2f a, const Eigen::Vector2f b) {
+  return a.x() * b.y() - a.y() * b.x();
+}
+
+bool segments_cross(const Eigen::Vector2f p, const Eigen::Vector2f q,
+                    const Eigen::Vector2f a, const Eigen::Vector2f b) {
+  return (cross(q - p, a - p) > 0.0f) != (cross(q - p, b - p) > 0.0f) &&
+         (cross(b - a, p - a) > 0.0f) != (cross(b - a, q - a) > 0.0f);
+}
+
+/// Brute force visibility: nothing blocks the straight line from the origin
+bool is_visible(const Eigen::Vector2f origin,
+                const std::vector<LineSegment> &occluders,
+                const Eigen::Vector2f point) {
+  for (const auto &occluder : occluders) {
+    if (segments_cross(origin, point, occluder.start, occluder.end)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Polygon without occluders covers the light's circle",
+          "[visibility_polygon]") {
+  VisibilityPolygon polygon;
+  polygon.compute({1.0f, 2.0f}, 2.0f, {});
+
+  CHECK(polygon.get_vertices().size() == VisibilityPolygon::circle_segment_count);
+  CHECK(polygon.contains({1.0f, 2.0f}));
+  CHECK(polygon.contains({2.8f, 2.0f}));
+  CHECK(polygon.contains({1.0f, 0.2f}));
+  CHECK_FALSE(polygon.contains({3.1f, 2.0f}));
+  CHECK_FALSE(polygon.contains({2.5f, 3.5f}));
+}
+
+TEST_CASE("Box casts a shadow away from the light", "[visibility_polygon]") {
+  const Eigen::AlignedBox2f box{Eigen::Vector2f{1.0f, -0.5f},
+                                Eigen::Vector2f{2.0f, 0.5f}};
+  std::vector<LineSegment> occluders;
+  append_box_edges(box, Eigen::Vector2f::Zero(), occluders);
+
+  // only the edge facing the light is needed
+  CHECK(occluders.size() == 1U);
+
+  VisibilityPolygon polygon;
+  polygon.compute(Eigen::Vector2f::Zero(), 5.0f, occluders);
+
+  CHECK(polygon.contains({0.9f, 0.0f}));
+  CHECK_FALSE(polygon.contains({1.5f, 0.0f}));
+  CHECK_FALSE(polygon.contains({4.0f, 0.5f}));
+  CHECK(polygon.contains({4.0f, 2.5f}));
+  CHECK(polygon.contains({-4.0f, 0.0f}));
+
+  CHECK(polygon.intersects(box));
+  CHECK_FALSE(polygon.intersects(Eigen::AlignedBox2f{
+      Eigen::Vector2f{3.0f, -0.2f}, Eigen::Vector2f{4.0f, 0.2f}}));
+  CHECK(polygon.intersects(Eigen::AlignedBox2f{Eigen::Vector2f{3.0f, -0.2f},
+                                               Eigen::Vector2f{4.0f, 3.0f}}));
+}
+
+TEST_CASE("Vertex angles are sorted around the origin",
+          "[visibility_polygon]") {
+  std::vector<LineSegment> occluders;
+  for (const auto &box :
+       {Eigen::AlignedBox2f{Eigen::Vector2f{-2.0f, 1.0f}, Eigen::Vector2f{2.0f, 1.2f}},
+        Eigen::AlignedBox2f{Eigen::Vector2f{-3.0f, -0.5f}, Eigen::Vector2f{-2.5f, 0.5f}}}) {
+    append_box_edges(box, Eigen::Vector2f::Zero(), occluders);
+  }
+
+  VisibilityPolygon polygon;
+  polygon.compute(Eigen::Vector2f::Zero(), 4.0f, occluders);
+
+  const auto &angles = polygon.get_vertex_angles();
+  REQUIRE(angles.size() == polygon.get_vertices().size());
+  CHECK(std::ranges::is_sorted(angles));
+}
+
+TEST_CASE("Polygon matches brute force visibility among random boxes",
+          "[visibility_polygon]") {
+  std::mt19937 generator{7U};
+  std::uniform_real_distribution<float> position_distribution{-4.0f, 4.0f};
+  std::uniform_real_distribution<float> size_distribution{0.05f, 0.8f};
+
+  for (int trial = 0; trial < 20; ++trial) {
+    const Eigen::Vector2f origin{position_distribution(generator) * 0.2f,
+                                 position_distribution(generator) * 0.2f};
+
+    // boxes may overlap, which makes occluders cross between endpoints
+    std::vector<LineSegment> occluders;
+    for (int i = 0; i < 20; ++i) {
+      const Eigen::Vector2f center{position_distribution(generator),
+                                   position_distribution(generator)};
+      const Eigen::Vector2f half_size{size_distribution(generator),
+                                      size_distribution(generator) * 0.3f};
+      append_box_edges(Eigen::AlignedBox2f{center - half_size, center + half_size},
+                       origin, occluders);
+    }
+
+    VisibilityPolygon polygon;
+    // large enough that the circle never clips the sampled points
+    polygon.compute(origin, 10.0f, occluders);
+
+    int mismatch_count = 0;
+    for (int i = 0; i < 500; ++i) {
+      const Eigen::Vector2f point{position_distribution(generator),
+                                  position_distribution(generator)};
+      if (polygon.contains(point) != is_visible(origin, occluders, point)) {
+        ++mismatch_count;
+      }
+    }
+    CHECK(mismatch_count == 0);
+  }
+}
@@ -0,0 +1,366 @@
+#include "geometry/visibility_polygon.hh"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace geometry {
+namespace {
+float cross(const Eigen::Vector2f a, const Eigen::Vector2f b) {
+  return a.x() * b.y() - a.y() * b.x();
+}
+
+float get_angle(const Eigen::Vector2f offset) {
+  return std::atan2(offset.y(), offset.x());
+}
+
+/// Liang-Barsky clip of a segment against a box
+bool segment_intersects_box(const Eigen::Vector2f start,
+                            const Eigen::Vector2f end,
+                            const Eigen::AlignedBox2f &box) {
+  const Eigen::Vector2f direction = end - start;
+  float t_min = 0.0f;
+  float t_max = 1.0f;
+  for (int axis = 0; axis < 2; ++axis) {
+    if (std::abs(direction[axis]) < std::numeric_limits<float>::epsilon()) {
+      if (start[axis] < box.min()[axis] || start[axis] > box.max()[axis]) {
+        return false;
+      }
+      continue;
+    }
+    float t_near = (box.min()[axis] - start[axis]) / direction[axis];
+    float t_far = (box.max()[axis] - start[axis]) / direction[axis];
+    if (t_near > t_far) {
+      std::swap(t_near, t_far);
+    }
+    t_min = std::max(t_min, t_near);
+    t_max = std::min(t_max, t_far);
+    if (t_min > t_max) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+void append_box_edges(const Eigen::AlignedBox2f &box,
+                      const Eigen::Vector2f viewpoint,
+                      std::vector<LineSegment> &segments) {
+  using Corner = Eigen::AlignedBox2f::CornerType;
+  const Eigen::Vector2f bottom_left = box.corner(Corner::BottomLeft);
+  const Eigen::Vector2f bottom_right = box.corner(Corner::BottomRight);
+  const Eigen::Vector2f top_right = box.corner(Corner::TopRight);
+  const Eigen::Vector2f top_left = box.corner(Corner::TopLeft);
+  const bool is_inside = box.contains(viewpoint);
+  if (is_inside || viewpoint.y() < box.min().y()) {
+    segments.push_back(LineSegment{bottom_left, bottom_right});
+  }
+  if (is_inside || viewpoint.x() > box.max().x()) {
+    segments.push_back(LineSegment{bottom_right, top_right});
+  }
+  if (is_inside || viewpoint.y() > box.max().y()) {
+    segments.push_back(LineSegment{top_right, top_left});
+  }
+  if (is_inside || viewpoint.x() < box.min().x()) {
+    segments.push_back(LineSegment{top_left, bottom_left});
+  }
+}
+
+void VisibilityPolygon::compute(const Eigen::Vector2f origin,
+                                const float radius,
+                                const std::vector<LineSegment> &occluders) {
+  origin_ = origin;
+  radius_ = radius;
+  vertices_.clear();
+  vertex_angles_.clear();
+  segments_.clear();
+  events_.clear();
+  active_segments_.clear();
+
+  // the circle is approximated by an inscribed polygon which is swept like any
+  // other occluder, so every ray hits at least one segment. Its vertices are
+  // offset by half a step so none lies exactly on the -pi/pi seam
+  constexpr float circle_step =
+      2.0f * std::numbers::pi_v<float> / circle_segment_count;
+  const auto get_circle_vertex = [&](const uint32_t i) -> Eigen::Vector2f {
+    const float angle = (static_cast<float>(i) + 0.5f) * circle_step;
+    return origin + radius * Eigen::Vector2f{std::cos(angle), std::sin(angle)};
+  };
+  for (uint32_t i = 0; i < circle_segment_count; ++i) {
+    add_sweep_segment(get_circle_vertex(i), get_circle_vertex(i + 1));
+  }
+  for (const auto &occluder : occluders) {
+    // segments entirely outside the circle can't hide anything inside it
+    const Eigen::Vector2f direction = occluder.end - occluder.start;
+    const float length_squared = direction.squaredNorm();
+    const float t =
+        length_squared > 0.0f
+            ? std::clamp((origin - occluder.start).dot(direction) /
+                             length_squared,
+                         0.0f, 1.0f)
+            : 0.0f;
+    if ((occluder.start + t * direction - origin).squaredNorm() >=
+        radius * radius) {
+      continue;
+    }
+    add_sweep_segment(occluder.start, occluder.end);
+  }
+
+  std::ranges::sort(events_, {}, &SweepEvent::angle);
+
+  // the first pass only settles which segments straddle the seam and so are
+  // already active when the second pass starts at -pi
+  for (std::size_t event_index = 0; event_index < events_.size();
+       ++event_index) {
+    apply_event(events_[event_index]);
+  }
+
+  // nearest segments only change at segment endpoints or where two segments
+  // cross (including occluders leaving the light's circle), endpoints are
+  // handled as events and crossings are traced between events
+  constexpr float seam_angle = std::numbers::pi_v<float>;
+  const auto get_probe_angle = [&](const float angle,
+                                   const std::size_t next_event_index) {
+    const float next_angle = next_event_index < events_.size()
+                                 ? events_[next_event_index].angle
+                                 : seam_angle;
+    return std::min(angle + 1e-3f, 0.5f * (angle + next_angle));
+  };
+  uint32_t nearest_segment =
+      find_nearest_active_segment(-seam_angle, get_probe_angle(-seam_angle, 0U));
+  float previous_angle = -seam_angle;
+  std::size_t event_index = 0;
+  while (event_index < events_.size()) {
+    const float angle = events_[event_index].angle;
+    const uint32_t nearest_before =
+        trace_crossings(nearest_segment, previous_angle, angle);
+
+    // apply every event at this angle before looking for a new nearest
+    // segment so coincident endpoints (box corners) don't emit spikes
+    for (; event_index < events_.size() && events_[event_index].angle == angle;
+         ++event_index) {
+      apply_event(events_[event_index]);
+    }
+
+    nearest_segment =
+        find_nearest_active_segment(angle, get_probe_angle(angle, event_index));
+    if (nearest_segment != nearest_before) {
+      add_vertex(get_ray_hit(nearest_before, angle), angle);
+      add_vertex(get_ray_hit(nearest_segment, angle), angle);
+    }
+    previous_angle = angle;
+  }
+  trace_crossings(nearest_segment, previous_angle, seam_angle);
+
+  // the sweep ends where it started, drop the repeated vertex so the closing
+  // edge isn't degenerate
+  if (vertices_.size() > 1U &&
+      (vertices_.back() - vertices_.front()).squaredNorm() <
+          std::numeric_limits<float>::epsilon()) {
+    vertices_.pop_back();
+    vertex_angles_.pop_back();
+  }
+}
+
+bool VisibilityPolygon::contains(const Eigen::Vector2f point) const {
+  if (vertices_.size() < 3U) {
+    return false;
+  }
+  const Eigen::Vector2f offset = point - origin_;
+  if (offset.squaredNorm() > radius_ * radius_) {
+    return false;
+  }
+
+  // find the edge whose angular range covers the point, the edge from the last
+  // vertex back to the first covers the seam
+  const float angle = get_angle(offset);
+  const auto it = std::ranges::upper_bound(vertex_angles_, angle);
+  const std::size_t next_index =
+      it == vertex_angles_.end()
+          ? 0U
+          : static_cast<std::size_t>(it - vertex_angles_.begin());
+  const std::size_t index =
+      next_index == 0U ? vertices_.size() - 1U : next_index - 1U;
+
+  const Eigen::Vector2f &edge_start = vertices_[index];
+  const Eigen::Vector2f &edge_end = vertices_[next_index];
+  // the origin is on the left of every counter clockwise edge
+  return cross(edge_end - edge_start, point - edge_start) >= 0.0f;
+}
+
+bool VisibilityPolygon::intersects(const Eigen::AlignedBox2f &box) const {
+  if (vertices_.size() < 3U) {
+    return false;
+  }
+  if (box.squaredExteriorDistance(origin_) > radius_ * radius_) {
+    return false;
+  }
+
+  using Corner = Eigen::AlignedBox2f::CornerType;
+  for (const auto corner : {Corner::BottomLeft, Corner::BottomRight,
+                            Corner::TopLeft, Corner::TopRight}) {
+    if (contains(box.corner(corner))) {
+      return true;
+    }
+  }
+  for (std::size_t i = 0; i < vertices_.size(); ++i) {
+    const auto &edge_start = vertices_[i];
+    const auto &edge_end = vertices_[(i + 1) % vertices_.size()];
+    if (segment_intersects_box(edge_start, edge_end, box)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void VisibilityPolygon::add_sweep_segment(const Eigen::Vector2f a,
+                                          const Eigen::Vector2f b) {
+  const float a_angle = get_angle(a - origin_);
+  const float b_angle = get_angle(b - origin_);
+  float angle_delta = b_angle - a_angle;
+  if (angle_delta > std::numbers::pi_v<float>) {
+    angle_delta -= 2.0f * std::numbers::pi_v<float>;
+  } else if (angle_delta <= -std::numbers::pi_v<float>) {
+    angle_delta += 2.0f * std::numbers::pi_v<float>;
+  }
+
+  // segments pointing at the origin are seen edge on and hide nothing
+  if (std::abs(angle_delta) < std::numeric_limits<float>::epsilon()) {
+    return;
+  }
+
+  const auto segment_index = static_cast<uint32_t>(segments_.size());
+  if (angle_delta > 0.0f) {
+    segments_.push_back(SweepSegment{a, b});
+    events_.push_back(SweepEvent{a_angle, segment_index, true});
+    events_.push_back(SweepEvent{b_angle, segment_index, false});
+  } else {
+    segments_.push_back(SweepSegment{b, a});
+    events_.push_back(SweepEvent{b_angle, segment_index, true});
+    events_.push_back(SweepEvent{a_angle, segment_index, false});
+  }
+}
+
+void VisibilityPolygon::apply_event(const SweepEvent &event) {
+  if (event.is_begin) {
+    active_segments_.push_back(event.segment_index);
+  } else if (const auto it =
+                 std::ranges::find(active_segments_, event.segment_index);
+             it != active_segments_.end()) {
+    *it = active_segments_.back();
+    active_segments_.pop_back();
+  }
+}
+
+uint32_t VisibilityPolygon::trace_crossings(uint32_t nearest_segment,
+                                            float from_angle,
+                                            const float to_angle) {
+  // crossings exactly at either end are shared endpoints, which the events
+  // already handle
+  constexpr float angle_tolerance{1e-6f};
+  while (true) {
+    const auto &nearest = segments_[nearest_segment];
+    const Eigen::Vector2f nearest_direction = nearest.end - nearest.begin;
+
+    uint32_t crossing_segment = nearest_segment;
+    float crossing_angle = to_angle - angle_tolerance;
+    Eigen::Vector2f crossing_point;
+    for (const auto segment_index : active_segments_) {
+      if (segment_index == nearest_segment) {
+        continue;
+      }
+      const auto &segment = segments_[segment_index];
+      const Eigen::Vector2f segment_direction = segment.end - segment.begin;
+      const float denominator = cross(nearest_direction, segment_direction);
+      if (std::abs(denominator) < std::numeric_limits<float>::epsilon()) {
+        continue;
+      }
+      const Eigen::Vector2f offset = segment.begin - nearest.begin;
+      const float nearest_t = cross(offset, segment_direction) / denominator;
+      const float segment_t = cross(offset, nearest_direction) / denominator;
+      if (nearest_t < 0.0f || nearest_t > 1.0f || segment_t < 0.0f ||
+          segment_t > 1.0f) {
+        continue;
+      }
+      const Eigen::Vector2f point = nearest.begin + nearest_t * nearest_direction;
+      const float angle = get_angle(point - origin_);
+      if (angle > from_angle + angle_tolerance && angle < crossing_angle) {
+        crossing_segment = segment_index;
+        crossing_angle = angle;
+        crossing_point = point;
+      }
+    }
+
+    if (crossing_segment == nearest_segment) {
+      return nearest_segment;
+    }
+    add_vertex(crossing_point, crossing_angle);
+    nearest_segment = crossing_segment;
+    from_angle = crossing_angle;
+  }
+}
+
+uint32_t
+VisibilityPolygon::find_nearest_active_segment(const float angle,
+                                               const float probe_angle) const {
+  // segments sharing an endpoint on the ray are equally near, the one in front
+  // just past the ray is the one that stays visible
+  constexpr float relative_tolerance{1e-5f};
+  uint32_t nearest_segment = 0U;
+  float nearest_distance = std::numeric_limits<float>::max();
+  float nearest_probe_distance = std::numeric_limits<float>::max();
+  for (const auto segment_index : active_segments_) {
+    const float distance = get_ray_distance(segment_index, angle);
+    if (distance < 0.0f ||
+        distance > nearest_distance * (1.0f + relative_tolerance)) {
+      continue;
+    }
+    const float probe_distance = get_ray_distance(segment_index, probe_angle);
+    if (distance < nearest_distance * (1.0f - relative_tolerance) ||
+        probe_distance < nearest_probe_distance) {
+      nearest_distance = std::min(distance, nearest_distance);
+      nearest_probe_distance = probe_distance;
+      nearest_segment = segment_index;
+    }
+  }
+  return nearest_segment;
+}
+
+float VisibilityPolygon::get_ray_distance(const uint32_t segment_index,
+                                          const float angle) const {
+  const auto &segment = segments_[segment_index];
+  const Eigen::Vector2f direction{std::cos(angle), std::sin(angle)};
+  const Eigen::Vector2f segment_direction = segment.end - segment.begin;
+  const float denominator = cross(direction, segment_direction);
+  if (std::abs(denominator) < std::numeric_limits<float>::epsilon()) {
+    return -1.0f;
+  }
+  return cross(segment.begin - origin_, segment_direction) / denominator;
+}
+
+Eigen::Vector2f VisibilityPolygon::get_ray_hit(const uint32_t segment_index,
+                                               const float angle) const {
+  const auto &segment = segments_[segment_index];
+  const Eigen::Vector2f direction{std::cos(angle), std::sin(angle)};
+  const Eigen::Vector2f segment_direction = segment.end - segment.begin;
+  const float denominator = cross(direction, segment_direction);
+  if (std::abs(denominator) < std::numeric_limits<float>::epsilon()) {
+    return segment.begin;
+  }
+  const float distance =
+      cross(segment.begin - origin_, segment_direction) / denominator;
+  return origin_ + distance * direction;
+}
+
+void VisibilityPolygon::add_vertex(const Eigen::Vector2f vertex,
+                                   const float angle) {
+  if (!vertices_.empty() &&
+      (vertices_.back() - vertex).squaredNorm() <
+          std::numeric_limits<float>::epsilon()) {
+    return;
+  }
+  vertices_.push_back(vertex);
+  vertex_angles_.push_back(angle);
+}
+
+} // namespace geometry
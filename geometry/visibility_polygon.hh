@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <vector>
+
+namespace geometry {
+
+struct LineSegment {
+  Eigen::Vector2f start;
+  Eigen::Vector2f end;
+};
+
+/// Append the edges of a box which face viewpoint to segments
+///
+/// Edges facing away from the viewpoint are always hidden behind the others so
+/// they are skipped, which halves the work for a sweep. All four edges are
+/// appended if the viewpoint is inside the box.
+void append_box_edges(const Eigen::AlignedBox2f &box,
+                      const Eigen::Vector2f viewpoint,
+                      std::vector<LineSegment> &segments);
+
+/// Area visible from a point light, bounded by occluding segments and the
+/// light's radius
+///
+/// The polygon is star shaped around the origin and its vertices are stored in
+/// counter clockwise order of angle around the origin, starting from -pi, so
+/// point queries only need a binary search over the vertex angles.
+class VisibilityPolygon {
+public:
+  /// Number of segments used to approximate the light's circle
+  static constexpr uint32_t circle_segment_count{32U};
+
+  /// Recompute the polygon with an angular sweep over the occluders
+  /// @param[in] origin position of the light
+  /// @param[in] radius distance the light reaches, the polygon is clipped to a
+  /// regular polygon inscribed in this circle
+  /// @param[in] occluders segments which block light, segments outside the
+  /// radius cost time but don't change the result
+  /// @pre radius > 0
+  /// @note scratch storage is kept between calls so recomputing every frame
+  /// doesn't allocate once warmed up
+  void compute(const Eigen::Vector2f origin, const float radius,
+               const std::vector<LineSegment> &occluders);
+
+  [[nodiscard]] const Eigen::Vector2f &get_origin() const { return origin_; }
+  [[nodiscard]] float get_radius() const { return radius_; }
+
+  /// @return polygon vertices in counter clockwise order
+  [[nodiscard]] const std::vector<Eigen::Vector2f> &get_vertices() const {
+    return vertices_;
+  }
+
+  /// @return angle of each vertex around the origin in [-pi, pi], ascending
+  [[nodiscard]] const std::vector<float> &get_vertex_angles() const {
+    return vertex_angles_;
+  }
+
+  /// @return true if point can be seen from the origin
+  [[nodiscard]] bool contains(const Eigen::Vector2f point) const;
+
+  /// @return true if any part of box can be seen from the origin
+  [[nodiscard]] bool intersects(const Eigen::AlignedBox2f &box) const;
+
+private:
+  /// Segment oriented so that it sweeps counter clockwise from begin to end
+  struct SweepSegment {
+    Eigen::Vector2f begin;
+    Eigen::Vector2f end;
+  };
+
+  struct SweepEvent {
+    float angle;
+    uint32_t segment_index;
+    bool is_begin;
+  };
+
+  void add_sweep_segment(const Eigen::Vector2f a, const Eigen::Vector2f b);
+
+  /// Add or remove a segment from the active set
+  void apply_event(const SweepEvent &event);
+
+  /// @return index of the closest active segment along the ray at angle,
+  /// ties are broken by the distance along the ray at probe_angle
+  [[nodiscard]] uint32_t
+  find_nearest_active_segment(const float angle,
+                              const float probe_angle) const;
+
+  /// @return distance along the ray at angle to the segment's line, negative
+  /// if the ray is parallel to it
+  [[nodiscard]] float get_ray_distance(const uint32_t segment_index,
+                                       const float angle) const;
+
+  /// @return point where the ray at angle crosses the segment's line
+  [[nodiscard]] Eigen::Vector2f
+  get_ray_hit(const uint32_t segment_index, const float angle) const;
+
+  /// Follow the nearest segment from from_angle to to_angle, adding a vertex
+  /// wherever another active segment crosses in front of it
+  /// @return nearest segment at to_angle
+  uint32_t trace_crossings(uint32_t nearest_segment, float from_angle,
+                           const float to_angle);
+
+  void add_vertex(const Eigen::Vector2f vertex, const float angle);
+
+  Eigen::Vector2f origin_{0.0f, 0.0f};
+  float radius_{0.0f};
+  std::vector<Eigen::Vector2f> vertices_;
+  std::vector<float> vertex_angles_;
+
+  // sweep scratch, reused between calls
+  std::vector<SweepSegment> segments_;
+  std::vector<SweepEvent> events_;
+  std::vector<uint32_t> active_segments_;
+};
+
+} // namespace geometry
@@ -11,4 +11,21 @@ LightMazeLightVolume::LightMazeLightVolume(GetTransformFunc get_transform,
   set_interaction_type(InteractionType::lightmaze_light_volume);
 }
 
+LightMazeLightVolume::LightMazeLightVolume(
+    GetTransformFunc get_transform, const view::Color &light_color,
+    std::shared_ptr<const LightGeometry> light_geometry,
+    CollisionCallback collision_callback)
+    : LightMazeLightVolume(get_transform, light_color, collision_callback) {
+  light_geometry_ = std::move(light_geometry);
+}
+
+bool LightMazeLightVolume::illuminates(const Eigen::AlignedBox2f &box) const {
+  if (!light_geometry_) {
+    return true;
+  }
+  const auto *visibility_polygon =
+      light_geometry_->get_maybe_visibility_polygon();
+  return visibility_polygon == nullptr || visibility_polygon->intersects(box);
+}
+
 } // namespace component
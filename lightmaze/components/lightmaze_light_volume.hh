@@ -1,7 +1,9 @@
 #pragma once
 #include "components/collider.hh"
+#include "components/light_emitter.hh"
 #include "view/screen.hh"
 #include <Eigen/Dense>
+#include <memory>
 
 namespace component {
 
@@ -15,7 +17,10 @@ namespace component {
  * detected light volumes.
  *
  * The component extends NonCollidableAABBCollider to provide collision
- * detection without physical interaction (no position changes).
+ * detection without physical interaction (no position changes). The collider
+ * box is only a broad phase: when the volume is given the geometry of the
+ * light it belongs to, illuminates() also checks the light's visibility
+ * polygon so platforms behind walls stay dark.
  */
 class LightMazeLightVolume : public NonCollidableAABBCollider {
 public:
@@ -30,6 +35,19 @@ public:
       GetTransformFunc get_transform, const view::Color &light_color,
       CollisionCallback collision_callback = [](const model::EntityID) {});
 
+  /**
+   * @brief Construct a LightMazeLightVolume blocked by the light's occluders
+   * @param get_transform Function to get the entity's transform for collision
+   * bounds
+   * @param light_color RGB color of the light volume for matching
+   * @param light_geometry Geometry of the light this volume represents
+   * @param collision_callback Optional callback when collision is detected
+   */
+  LightMazeLightVolume(
+      GetTransformFunc get_transform, const view::Color &light_color,
+      std::shared_ptr<const LightGeometry> light_geometry,
+      CollisionCallback collision_callback = [](const model::EntityID) {});
+
   /**
    * @brief Get the light color for matching with platforms
    * @return RGB color of this light volume
@@ -47,9 +65,21 @@ public:
     light_color_ = new_color;
   }
 
+  /**
+   * @brief Check whether the light actually reaches a box
+   * @param box Area to test in world coordinates, usually a platform's
+   * detection bounds
+   * @return True if the box overlaps the light's visibility polygon, or if the
+   * light has no polygon
+   */
+  [[nodiscard]] bool illuminates(const Eigen::AlignedBox2f &box) const;
+
 private:
   /// RGB color of the light volume for matching
   view::Color light_color_;
+
+  /// Geometry of the light, nullptr if only the collider box is used
+  std::shared_ptr<const LightGeometry> light_geometry_;
 };
 
 } // namespace component
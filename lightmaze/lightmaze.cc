@@ -1,4 +1,5 @@
 #include "lightmaze/lightmaze.hh"
+#include "lightmaze/systems/lightmaze_light_visibility.hh"
 #include "systems/collisions.hh"
 #include "systems/lighting_system.hh"
 #include "lightmaze/mode_manager.hh"
@@ -8,6 +9,8 @@ namespace lightmaze {
 make_lightmaze_game() {
   auto game_state = std::make_unique<model::GameState>();
   TRY(game_state->add_entity(std::make_unique<LightMazeModeManager>(*game_state)));
+  // visibility first so collisions and lighting use this frame's shadows
+  game_state->add_system<systems::LightMazeLightVisibility>();
   game_state->add_system<systems::Collisions>();
   game_state->add_system<systems::LightingSystem>();
   return Ok(std::move(game_state));
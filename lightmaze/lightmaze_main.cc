@@ -1,11 +1,19 @@
 #include "controller/controller.hh"
 #include "view/screen.hh"
 #include "lightmaze/lightmaze.hh"
+#include "systems/lighting_system.hh"
+#include "view/shader_cache.hh"
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
 
-int main() {
+int main(int argc, char **argv) {
+  // parsed first since --seed has to apply before the game is created
+  const auto params_result = controller::parse_command_line(argc, argv);
+  if (params_result.isErr()) {
+    std::cerr << params_result.unwrapErr() << std::endl;
+    return EXIT_FAILURE;
+  }
   auto game_result = lightmaze::make_lightmaze_game();
   if (game_result.isErr()) {
     std::cerr << "Failed to initialize game with error: "
@@ -14,11 +22,21 @@ int main() {
   }
 
   // Use a 4x3 viewport for platformer aspect ratio
-  controller::Controller controller(
-      std::make_unique<view::Screen>(Eigen::Vector2f{4.0f, 3.0f}),
-      std::move(game_result).unwrap());
+  auto screen = std::make_unique<view::Screen>(Eigen::Vector2f{4.0f, 3.0f});
+
+  // Compile shaders now that the GL context exists, so the first frame
+  // doesn't stall and broken shaders are reported before the game starts
+  const auto precompile_result = view::ShaderCache::get().precompile(
+      {systems::LightingSystem::get_shader_files()});
+  if (precompile_result.isErr()) {
+    std::cerr << precompile_result.unwrapErr() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  controller::Controller controller(std::move(screen),
+                                    std::move(game_result).unwrap());
 
-  const auto result = controller.run();
+  const auto result = controller.run(params_result.unwrap());
   if (result.isErr()) {
     std::cerr << "Application ended with error: " << result.unwrapErr()
               << std::endl;
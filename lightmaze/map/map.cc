@@ -10,7 +10,6 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <cstdlib>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <yaml-cpp/yaml.h>
 
@@ -80,43 +79,26 @@ Map::add_platform(const Eigen::Vector2f &top_center_position,
 
 Result<void, std::string>
 Map::save_current_state(const std::string &file_path) {
-  try {
-    // Create saves directory if it doesn't exist
-    std::filesystem::path save_path(file_path);
-    std::filesystem::create_directories(save_path.parent_path());
-
-    // Create YAML document
-    YAML::Node root;
-    root["format_version"] = "1.0";
-
-    // Serialize all child map entities
-    YAML::Node entities_node;
-    for (const auto &child_id : get_child_entities()) {
-      auto map_entity_result =
-          game_state_.get_entity_pointer_by_id_as<MapEntity>(child_id);
-      if (map_entity_result.isOk()) {
-        auto *map_entity = map_entity_result.unwrap();
-        entities_node.push_back(map_entity->serialize());
-      }
-    }
-
-    root["entities"] = entities_node;
+  // make sure an older background save can't land after this one
+  auto_saver_.flush();
+  TRY_VOID(write_map_snapshot_atomically(TRY(take_snapshot()), file_path));
+  time_since_last_save_ns_ = 0;
+  return Ok();
+}
 
-    // Write to file
-    std::ofstream file(file_path);
-    if (!file.is_open()) {
-      return Err(std::string("Failed to open file for writing: ") + file_path);
+Result<MapSnapshot, std::string> Map::take_snapshot() const {
+  MapSnapshot snapshot;
+  const auto &child_ids = get_child_entities();
+  snapshot.platforms.reserve(child_ids.size());
+  for (const auto &child_id : child_ids) {
+    auto map_entity_result =
+        game_state_.get_entity_pointer_by_id_as<MapEntity>(child_id);
+    if (map_entity_result.isOk()) {
+      snapshot.platforms.push_back(
+          TRY(map_entity_result.unwrap()->get_platform_snapshot()));
     }
-
-    file << root;
-    file.close();
-
-    time_since_last_save_ns_ = 0;
-    return Ok();
-
-  } catch (const std::exception &e) {
-    return Err(std::string("Failed to save map: ") + e.what());
   }
+  return Ok(std::move(snapshot));
 }
 
 Result<void, std::string> Map::load_saved_state(const std::string &file_path) {
@@ -251,8 +233,16 @@ Result<void, std::string> Map::create_platform(const Eigen::Vector2f &start,
 }
 
 Result<void, std::string> Map::auto_save_if_needed() {
+  const auto maybe_error = auto_saver_.take_maybe_error();
+  if (maybe_error.has_value()) {
+    return Err(maybe_error.value());
+  }
+
   if (time_since_last_save_ns_ >= auto_save_interval_ns_) {
-    TRY_VOID(save_current_state());
+    // only the snapshot is taken on the game thread, serialization and disk
+    // I/O happen on the auto saver's thread
+    auto_saver_.submit(TRY(take_snapshot()), default_save_path);
+    time_since_last_save_ns_ = 0;
   }
   return Ok();
 }
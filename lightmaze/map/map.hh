@@ -1,4 +1,5 @@
 #pragma once
+#include "lightmaze/map/map_saver.hh"
 #include "model/game_state.hh"
 #include "view/screen.hh"
 #include <Eigen/Geometry>
@@ -15,7 +16,7 @@ class MapModeManager;
  * The Map entity serves as the parent container for all platforms in the level
  * and coordinates map editor functionality. It handles:
  * - Platform creation via left-click drag in editor mode
- * - Auto-saving every 5 seconds
+ * - Auto-saving every 5 seconds on a background I/O thread
  * - Save/load integration with YAML persistence
  * - Platform management and coordination
  * - Integration with MapModeManager for editor state
@@ -67,10 +68,11 @@ public:
 
 
   /**
-   * @brief Save current map state to YAML file
+   * @brief Save current map state to YAML file, blocking until written
    * @param file_path Path to save file (default: uses default_save_path)
    * @return Ok() on success, Err(message) if save fails
-   * @post Current platform layout and player position saved to YAML file
+   * @post Any in-flight auto-save has finished and the current platform layout
+   * is saved to YAML file
    */
   Result<void, std::string>
   save_current_state(const std::string &file_path = default_save_path);
@@ -85,6 +87,13 @@ public:
   Result<void, std::string>
   load_saved_state(const std::string &file_path = default_save_path);
 
+  /**
+   * @brief Copy the state of every child platform into a flat snapshot
+   * @return Snapshot that no longer references any entity, or Err(message)
+   * if a child isn't a platform
+   */
+  [[nodiscard]] Result<MapSnapshot, std::string> take_snapshot() const;
+
 
   /**
    * @brief Handle mouse down events for platform creation
@@ -161,6 +170,9 @@ private:
   int64_t time_since_last_save_ns_{0};
   static constexpr int64_t auto_save_interval_ns_{5'000'000'000}; // 5 seconds
 
+  /// Serializes and writes auto-save snapshots off the game thread
+  AsyncMapSaver auto_saver_;
+
   /// Global illumination state for editor mode
   bool was_in_editor_mode_{false};
 
@@ -175,9 +187,11 @@ private:
                                             const Eigen::Vector2f &end);
 
   /**
-   * @brief Check auto-save timer and save if interval elapsed
-   * @return Ok() on success, Err(message) if save fails
-   * @post Save may occur if enough time has passed since last save
+   * @brief Check auto-save timer and queue a background save if interval
+   * elapsed
+   * @return Ok() on success, Err(message) if a previous background save failed
+   * @post A snapshot may be handed to the auto saver if enough time has passed
+   * since last save
    */
   Result<void, std::string> auto_save_if_needed();
 
@@ -84,15 +84,17 @@ void MapEntity::add_collider_components() {
 }
 
 void MapEntity::add_light_detector_component() {
+  const auto get_detector_transform = [this]() {
+    Eigen::Affine2f transform = this->get_transform();
+    transform.scale(1.1);
+    return transform;
+  };
+
   // Add LightMazeCollider for color-based collision mechanics
   add_component<component::LightMazeCollider>(
-      [this]() {
-        Eigen::Affine2f transform = this->get_transform();
-        transform.scale(1.1);
-        return transform;
-      },      // transform function
-      color_, // platform color from parameters
-      [this](const model::EntityID entity_id) {
+      get_detector_transform, // transform function
+      color_,                 // platform color from parameters
+      [this, get_detector_transform](const model::EntityID entity_id) {
         const auto maybe_light_volume_entity =
             game_state_.try_get_entity_pointer_by_id(entity_id);
         if (!maybe_light_volume_entity.has_value()) {
@@ -101,11 +103,20 @@ void MapEntity::add_light_detector_component() {
         const auto components = maybe_light_volume_entity.value()
                                     ->get_components<component::Collider>();
 
+        // the colliders only overlap as boxes, the light must also reach the
+        // platform around any walls in between
+        const auto detector_box =
+            geometry::get_bounding_box_from_transform(get_detector_transform());
         for (const auto component : components) {
-          if (component->get_collider_type_name() ==
-                  component::LightMazeLightVolume::collider_type_name &&
-              dynamic_cast<component::LightMazeLightVolume *>(component)
-                      ->get_light_color() == color_) {
+          if (component->get_collider_type_name() !=
+              component::LightMazeLightVolume::collider_type_name) {
+            continue;
+          }
+          const auto *light_volume =
+              dynamic_cast<component::LightMazeLightVolume *>(component);
+          if (light_volume != nullptr &&
+              light_volume->get_light_color() == color_ &&
+              light_volume->illuminates(detector_box)) {
             this->is_illuminated_ = true;
           }
         }
@@ -126,9 +137,7 @@ Result<void, std::string> MapEntity::update(const int64_t delta_time_ns) {
   }
   is_illuminated_ = false;
 
-  for (const auto &component : components_) {
-    TRY_VOID(component->update(delta_time_ns));
-  }
+  TRY_VOID(update_components(delta_time_ns));
 
   return Ok();
 }
@@ -156,28 +165,44 @@ Eigen::Vector2f MapEntity::get_size() const {
 }
 
 YAML::Node MapEntity::serialize() const {
-  YAML::Node node;
+  auto platform_result = get_platform_snapshot();
+  if (platform_result.isOk()) {
+    return serialize_platform(platform_result.unwrap());
+  }
 
+  // only platforms have anything to save beyond their color
+  YAML::Node node;
   node["color"]["r"] = color_.r;
   node["color"]["g"] = color_.g;
   node["color"]["b"] = color_.b;
-  return std::visit(
-      [&node](const auto &specific_params) -> YAML::Node {
-        using T = std::decay_t<decltype(specific_params)>;
+  return node;
+}
 
-        if constexpr (std::is_same_v<T, PlatformParams>) {
-          node["type"] = "platform";
-          node["top_center_position"]["x"] =
-              specific_params.top_center_position.x();
-          node["top_center_position"]["y"] =
-              specific_params.top_center_position.y();
-          node["size"]["x"] = specific_params.size.x();
-          node["size"]["y"] = specific_params.size.y();
-        }
+Result<MapEntity::PlatformParams, std::string>
+MapEntity::get_platform_snapshot() const {
+  const auto *maybe_platform_params =
+      std::get_if<PlatformParams>(&entity_params_);
+  if (maybe_platform_params == nullptr) {
+    return Err(std::string("Map entity is not a platform"));
+  }
+  auto platform_params = *maybe_platform_params;
+  // color_ is the source of truth since it can be changed while dragging
+  platform_params.platform_color = color_;
+  return Ok(platform_params);
+}
 
-        return node;
-      },
-      entity_params_);
+YAML::Node MapEntity::serialize_platform(const PlatformParams &platform_params) {
+  YAML::Node node;
+
+  node["color"]["r"] = platform_params.platform_color.r;
+  node["color"]["g"] = platform_params.platform_color.g;
+  node["color"]["b"] = platform_params.platform_color.b;
+  node["type"] = "platform";
+  node["top_center_position"]["x"] = platform_params.top_center_position.x();
+  node["top_center_position"]["y"] = platform_params.top_center_position.y();
+  node["size"]["x"] = platform_params.size.x();
+  node["size"]["y"] = platform_params.size.y();
+  return node;
 }
 
 Result<void, std::string>
@@ -115,6 +115,25 @@ public:
    */
   [[nodiscard]] YAML::Node serialize() const;
 
+  /**
+   * @brief Copy the current platform state into a flat value
+   * @return Platform parameters reflecting the current position, size and
+   * color, suitable for handing to another thread, or Err(message) if the
+   * entity isn't a platform
+   */
+  [[nodiscard]] Result<PlatformParams, std::string>
+  get_platform_snapshot() const;
+
+  /**
+   * @brief Serialize platform parameters to a YAML node
+   * @param platform_params Platform state to serialize
+   * @return YAML node in the same format produced by serialize()
+   * @note Does not touch any entity state so it is safe to call off the game
+   * thread
+   */
+  [[nodiscard]] static YAML::Node
+  serialize_platform(const PlatformParams &platform_params);
+
   /**
    * @brief Handle mouse down events for platform manipulation
    * @param event Mouse down event with button and position
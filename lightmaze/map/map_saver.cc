@@ -0,0 +1,116 @@
+#include "lightmaze/map/map_saver.hh"
+#include <fstream>
+
+namespace lightmaze {
+
+YAML::Node serialize_map_snapshot(const MapSnapshot &snapshot) {
+  YAML::Node root;
+  root["format_version"] = "1.0";
+
+  YAML::Node entities_node;
+  for (const auto &platform_params : snapshot.platforms) {
+    entities_node.push_back(MapEntity::serialize_platform(platform_params));
+  }
+  root["entities"] = entities_node;
+  return root;
+}
+
+Result<void, std::string>
+write_map_snapshot_atomically(const MapSnapshot &snapshot,
+                              const std::filesystem::path &file_path) {
+  try {
+    if (file_path.has_parent_path()) {
+      std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    const auto root = serialize_map_snapshot(snapshot);
+
+    std::filesystem::path temp_path = file_path;
+    temp_path += ".tmp";
+    {
+      std::ofstream file(temp_path, std::ios::trunc);
+      if (!file.is_open()) {
+        return Err(std::string("Failed to open file for writing: ") +
+                   temp_path.string());
+      }
+      file << root;
+      file.flush();
+      if (!file.good()) {
+        return Err(std::string("Failed to write file: ") + temp_path.string());
+      }
+    }
+
+    // rename is atomic on POSIX when source and destination are on the same
+    // filesystem, which is guaranteed since they share a directory
+    std::filesystem::rename(temp_path, file_path);
+    return Ok();
+  } catch (const std::exception &e) {
+    return Err(std::string("Failed to save map: ") + e.what());
+  }
+}
+
+AsyncMapSaver::AsyncMapSaver() : worker_([this]() { run(); }) {}
+
+AsyncMapSaver::~AsyncMapSaver() {
+  {
+    std::lock_guard lock(mutex_);
+    should_stop_ = true;
+  }
+  work_available_.notify_one();
+  worker_.join();
+}
+
+void AsyncMapSaver::submit(MapSnapshot snapshot,
+                           std::filesystem::path file_path) {
+  {
+    std::lock_guard lock(mutex_);
+    maybe_pending_save_ = PendingSave{std::move(snapshot), std::move(file_path)};
+  }
+  work_available_.notify_one();
+}
+
+void AsyncMapSaver::flush() {
+  std::unique_lock lock(mutex_);
+  work_done_.wait(lock, [this]() {
+    return !maybe_pending_save_.has_value() && !is_writing_;
+  });
+}
+
+std::optional<std::string> AsyncMapSaver::take_maybe_error() {
+  std::lock_guard lock(mutex_);
+  auto maybe_error = std::move(maybe_error_);
+  maybe_error_.reset();
+  return maybe_error;
+}
+
+void AsyncMapSaver::run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_available_.wait(lock, [this]() {
+      return should_stop_ || maybe_pending_save_.has_value();
+    });
+    if (!maybe_pending_save_.has_value()) {
+      // only reachable when stopping with nothing left to write
+      return;
+    }
+
+    auto pending_save = std::move(maybe_pending_save_.value());
+    maybe_pending_save_.reset();
+    is_writing_ = true;
+
+    // serialization and file I/O happen without holding the lock so the game
+    // thread never waits on the disk when submitting
+    lock.unlock();
+    auto result = write_map_snapshot_atomically(pending_save.snapshot,
+                                                pending_save.file_path);
+    lock.lock();
+
+    is_writing_ = false;
+    if (result.isErr()) {
+      maybe_error_ = result.unwrapErr();
+    }
+    work_done_.notify_all();
+  }
+}
+
+} // namespace lightmaze
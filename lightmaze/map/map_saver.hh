@@ -0,0 +1,112 @@
+#pragma once
+#include "lightmaze/map/map_entity.hh"
+#include "utility/try.hh"
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace lightmaze {
+
+/**
+ * @brief Flat, self-contained copy of everything needed to save a level
+ *
+ * Snapshots hold plain values only (no entity pointers or YAML nodes) so they
+ * can be built cheaply on the game thread and handed to another thread.
+ */
+struct MapSnapshot {
+  std::vector<MapEntity::PlatformParams> platforms;
+};
+
+/**
+ * @brief Convert a snapshot into the YAML document written to save files
+ * @param snapshot Snapshot of the level to serialize
+ * @return Root YAML node with format_version and entities sections
+ */
+[[nodiscard]] YAML::Node serialize_map_snapshot(const MapSnapshot &snapshot);
+
+/**
+ * @brief Serialize a snapshot and write it to disk atomically
+ *
+ * The document is written to "<file_path>.tmp" first and then renamed over
+ * file_path, so readers never observe a partially written save file.
+ *
+ * @param snapshot Snapshot of the level to save
+ * @param file_path Destination save file
+ * @return Ok() on success, Err(message) if serialization or any file
+ * operation fails
+ * @post On success file_path contains the complete serialized snapshot
+ */
+Result<void, std::string>
+write_map_snapshot_atomically(const MapSnapshot &snapshot,
+                              const std::filesystem::path &file_path);
+
+/**
+ * @brief Writes map snapshots on a background I/O thread
+ *
+ * Only the most recently submitted snapshot is kept: if a new snapshot is
+ * submitted while an older one is still waiting to be written the older one
+ * is dropped, since it would be overwritten immediately anyway. Errors from
+ * the background thread are stored and reported on the next call to
+ * take_maybe_error().
+ */
+class AsyncMapSaver {
+public:
+  /**
+   * @brief Start the background I/O thread
+   */
+  AsyncMapSaver();
+
+  /**
+   * @brief Write any pending snapshot and join the background thread
+   */
+  ~AsyncMapSaver();
+
+  AsyncMapSaver(const AsyncMapSaver &) = delete;
+  AsyncMapSaver &operator=(const AsyncMapSaver &) = delete;
+
+  /**
+   * @brief Queue a snapshot to be written to file_path
+   * @param snapshot Snapshot to write, moved onto the background thread
+   * @param file_path Destination save file
+   * @post Any snapshot still waiting to be written is replaced
+   */
+  void submit(MapSnapshot snapshot, std::filesystem::path file_path);
+
+  /**
+   * @brief Block until all submitted snapshots have been written
+   * @post No snapshot is pending or being written
+   */
+  void flush();
+
+  /**
+   * @brief Retrieve and clear the last error reported by the I/O thread
+   * @return Error message if a background save failed since the last call
+   */
+  [[nodiscard]] std::optional<std::string> take_maybe_error();
+
+private:
+  struct PendingSave {
+    MapSnapshot snapshot;
+    std::filesystem::path file_path;
+  };
+
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+  std::optional<PendingSave> maybe_pending_save_;
+  std::optional<std::string> maybe_error_;
+  bool is_writing_{false};
+  bool should_stop_{false};
+
+  // declared last so every other member is constructed before the thread
+  // starts using them
+  std::thread worker_;
+};
+
+} // namespace lightmaze
@@ -21,7 +21,8 @@ Player::Player(model::GameState &game_state) : model::Entity(game_state) {}
 
 Result<void, std::string> Player::init() {
   // Add centering component for automatic positioning
-  add_component<component::Center>([this]() { return get_transform(); });
+  add_component<component::Center>(
+      [this]() { return get_interpolated_transform(); });
 
   // Add collision component for physics
   add_component<component::SolidAABBCollider>(
@@ -39,9 +40,9 @@ Result<void, std::string> Player::init() {
 
   // For now, just use the idle animation
   auto idle_textures = texture_set->get_texture_set_by_name("idle");
-  add_component<component::Animation>([this]() { return get_transform(); },
-                                      idle_textures,
-                                      5.0f // 5 fps animation
+  add_component<component::Animation>(
+      [this]() { return get_interpolated_transform(); }, idle_textures,
+      5.0f // 5 fps animation
   );
 
   // Add gravity component for physics
@@ -65,11 +66,14 @@ Result<void, std::string> Player::init() {
       1 // max jumps (double jump)
   );
 
-  // Add light emitter component for lighting gameplay
+  // Add light emitter component for lighting gameplay, platforms cast shadows
+  // so the light (and the light volume below) can't reach through walls
+  const auto light_geometry =
+      std::make_shared<component::ShadowCastingLightGeometry>(.8f);
   light_emitter_component_ = add_component<component::LightEmitter>(
-      component::LightEmitter::CircularLightParams{
+      component::LightEmitter::CustomGeometryLightParams{
           .transform_func = [this]() { return get_transform(); },
-          .radius_meters = .8,
+          .geometry = light_geometry,
           .color = player_light_color_, // Pure white light
           .intensity = 1.0f             // Full intensity
       });
@@ -82,8 +86,8 @@ Result<void, std::string> Player::init() {
         transform.scale(1.5f); // Expand by 50%
         return transform;
       },
-      player_light_color_ // same color as light emitter
-  );
+      player_light_color_, // same color as light emitter
+      light_geometry);
 
   return Ok();
 }
@@ -122,9 +126,7 @@ Result<void, std::string> Player::update(const int64_t delta_time_ns) {
   // Ground detection is now handled by the Jumper component through JumpReset
   // collisions
 
-  for (const auto &component : components_) {
-    TRY_VOID(component->update(delta_time_ns));
-  }
+  TRY_VOID(update_components(delta_time_ns));
 
   return Ok();
 }
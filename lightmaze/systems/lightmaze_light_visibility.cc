@@ -0,0 +1,67 @@
+#include "lightmaze/systems/lightmaze_light_visibility.hh"
+#include "components/collider.hh"
+#include "components/light_emitter.hh"
+#include "geometry/rectangle_utils.hh"
+#include "lightmaze/components/lightmaze_collider.hh"
+
+namespace systems {
+
+Result<void, std::string>
+LightMazeLightVisibility::update(model::GameState &game_state,
+                                 const int64_t delta_time_ns) {
+  platform_boxes_.clear();
+  platform_colors_.clear();
+  for (const auto *entity :
+       game_state.get_entities_with_component<component::Collider>()) {
+    for (const auto *collider :
+         entity->get_components<component::Collider>()) {
+      const auto *platform_collider =
+          dynamic_cast<const component::LightMazeCollider *>(collider);
+      if (platform_collider != nullptr) {
+        // the detector is slightly larger than the platform, occlude with the
+        // platform itself
+        platform_boxes_.push_back(geometry::get_bounding_box_from_transform(
+            entity->get_transform()));
+        platform_colors_.push_back(platform_collider->get_platform_color());
+        break;
+      }
+    }
+  }
+  platform_grid_.build(platform_boxes_);
+
+  for (const auto *entity :
+       game_state.get_entities_with_component<component::LightEmitter>()) {
+    for (const auto *light_emitter :
+         entity->get_components<component::LightEmitter>()) {
+      const auto light_info = light_emitter->get_light_info();
+      if (!light_info.geometry ||
+          light_info.geometry->get_geometry_type() !=
+              component::ShadowCastingLightGeometry::geometry_type_name) {
+        continue;
+      }
+      auto &geometry = static_cast<component::ShadowCastingLightGeometry &>(
+          *light_info.geometry);
+
+      const Eigen::Vector2f reach =
+          Eigen::Vector2f::Constant(geometry.get_radius());
+      platform_grid_.query(
+          Eigen::AlignedBox2f{light_info.world_position - reach,
+                              light_info.world_position + reach},
+          nearby_platforms_);
+
+      occluders_.clear();
+      for (const auto platform_index : nearby_platforms_) {
+        if (platform_colors_[platform_index] == light_info.color) {
+          continue;
+        }
+        geometry::append_box_edges(platform_boxes_[platform_index],
+                                   light_info.world_position, occluders_);
+      }
+      geometry.update_visibility(light_info.world_position, occluders_);
+    }
+  }
+
+  return Ok();
+}
+
+} // namespace systems
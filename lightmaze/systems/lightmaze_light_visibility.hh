@@ -0,0 +1,52 @@
+#pragma once
+#include "geometry/box_grid.hh"
+#include "geometry/visibility_polygon.hh"
+#include "model/game_state.hh"
+#include "systems/system.hh"
+#include "view/screen.hh"
+#include <vector>
+
+namespace systems {
+
+/**
+ * @brief Recomputes which areas LightMaze lights can reach around platforms
+ *
+ * Every frame the platforms (entities with a LightMazeCollider) are indexed in
+ * a geometry::BoxGrid, then each ShadowCastingLightGeometry light queries the
+ * platforms within its radius and sweeps their edges into its visibility
+ * polygon. Platforms matching the light's color are revealed by it rather
+ * than blocking it, so they are skipped.
+ *
+ * Add this system before the collision and lighting systems so both see the
+ * polygons for the current positions.
+ */
+class LightMazeLightVisibility : public System {
+public:
+  static constexpr std::string_view system_type_name =
+      "lightmaze_light_visibility_system";
+
+  LightMazeLightVisibility() = default;
+
+  virtual ~LightMazeLightVisibility() = default;
+
+  virtual Result<void, std::string> update(model::GameState &game_state,
+                                           const int64_t delta_time_ns) final;
+
+  virtual std::string_view get_system_type_name() const final {
+    return system_type_name;
+  }
+
+private:
+  /// Platform bounds and colors for the current frame, matching indices
+  std::vector<Eigen::AlignedBox2f> platform_boxes_;
+  std::vector<view::Color> platform_colors_;
+
+  /// Spatial index over platform_boxes_
+  geometry::BoxGrid platform_grid_;
+
+  /// Scratch reused between lights and frames
+  std::vector<uint32_t> nearby_platforms_;
+  std::vector<geometry::LineSegment> occluders_;
+};
+
+} // namespace systems
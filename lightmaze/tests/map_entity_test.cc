@@ -29,6 +29,12 @@ TEST_CASE("MapEntity platform serialization", "[MapEntity][serialization]") {
     CHECK(serialized["top_center_position"]["y"].as<float>() == 2.0f);
     CHECK(serialized["size"]["x"].as<float>() == 3.0f);
     CHECK(serialized["size"]["y"].as<float>() == 0.5f);
+
+    auto snapshot_result = map_entity->get_platform_snapshot();
+    REQUIRE(snapshot_result.isOk());
+    const auto snapshot = snapshot_result.unwrap();
+    CHECK(snapshot.top_center_position == Eigen::Vector2f{1.5f, 2.0f});
+    CHECK(snapshot.size == Eigen::Vector2f{3.0f, 0.5f});
   }
 }
 
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include "lightmaze/map/map_saver.hh"
+#include <filesystem>
+#include <yaml-cpp/yaml.h>
+
+using namespace lightmaze;
+
+namespace {
+MapSnapshot make_snapshot(const std::size_t platform_count) {
+  MapSnapshot snapshot;
+  for (std::size_t i = 0; i < platform_count; ++i) {
+    MapEntity::PlatformParams platform_params;
+    platform_params.top_center_position =
+        Eigen::Vector2f{static_cast<float>(i), 1.0f};
+    platform_params.size = Eigen::Vector2f{0.5f, 0.1f};
+    platform_params.platform_color = view::Color{255, 0, 0};
+    snapshot.platforms.push_back(platform_params);
+  }
+  return snapshot;
+}
+
+std::filesystem::path make_temp_save_path(const std::string &name) {
+  const auto directory =
+      std::filesystem::temp_directory_path() / "lightmaze_map_saver_test";
+  std::filesystem::create_directories(directory);
+  const auto path = directory / name;
+  std::filesystem::remove(path);
+  return path;
+}
+} // namespace
+
+TEST_CASE("Map snapshot serialization", "[MapSaver][serialization]") {
+  const auto root = serialize_map_snapshot(make_snapshot(2));
+
+  CHECK(root["format_version"].as<std::string>() == "1.0");
+  REQUIRE(root["entities"].size() == 2);
+  CHECK(root["entities"][1]["type"].as<std::string>() == "platform");
+  CHECK(root["entities"][1]["top_center_position"]["x"].as<float>() == 1.0f);
+  CHECK(root["entities"][1]["size"]["y"].as<float>() == 0.1f);
+  CHECK(root["entities"][1]["color"]["r"].as<int>() == 255);
+}
+
+TEST_CASE("Map snapshot atomic write", "[MapSaver][io]") {
+  const auto path = make_temp_save_path("atomic_write.yaml");
+
+  SECTION("Writes file and leaves no temp file behind") {
+    REQUIRE(write_map_snapshot_atomically(make_snapshot(3), path).isOk());
+
+    CHECK(std::filesystem::exists(path));
+    CHECK_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    CHECK(YAML::LoadFile(path)["entities"].size() == 3);
+  }
+
+  SECTION("Replaces an existing save") {
+    REQUIRE(write_map_snapshot_atomically(make_snapshot(3), path).isOk());
+    REQUIRE(write_map_snapshot_atomically(make_snapshot(1), path).isOk());
+
+    CHECK(YAML::LoadFile(path)["entities"].size() == 1);
+  }
+
+  SECTION("Reports unwritable paths") {
+    const auto blocking_file = make_temp_save_path("not_a_directory");
+    REQUIRE(write_map_snapshot_atomically(make_snapshot(1), blocking_file)
+                .isOk());
+
+    CHECK(write_map_snapshot_atomically(make_snapshot(1),
+                                        blocking_file / "save.yaml")
+              .isErr());
+  }
+}
+
+TEST_CASE("Async map saver", "[MapSaver][async]") {
+  const auto path = make_temp_save_path("async.yaml");
+
+  SECTION("Flush waits for the latest snapshot") {
+    AsyncMapSaver saver;
+    saver.submit(make_snapshot(5), path);
+    saver.submit(make_snapshot(7), path);
+    saver.flush();
+
+    CHECK(YAML::LoadFile(path)["entities"].size() == 7);
+    CHECK_FALSE(saver.take_maybe_error().has_value());
+  }
+
+  SECTION("Pending snapshot is written on destruction") {
+    {
+      AsyncMapSaver saver;
+      saver.submit(make_snapshot(4), path);
+    }
+    CHECK(YAML::LoadFile(path)["entities"].size() == 4);
+  }
+
+  SECTION("Background errors are reported once") {
+    const auto blocking_file = make_temp_save_path("async_not_a_directory");
+    REQUIRE(write_map_snapshot_atomically(make_snapshot(1), blocking_file)
+                .isOk());
+
+    AsyncMapSaver saver;
+    saver.submit(make_snapshot(1), blocking_file / "save.yaml");
+    saver.flush();
+
+    CHECK(saver.take_maybe_error().has_value());
+    CHECK_FALSE(saver.take_maybe_error().has_value());
+  }
+}
@@ -0,0 +1,97 @@
+#include "model/cost_accounting.hh"
+#include <algorithm>
+#include <fstream>
+
+namespace model {
+namespace {
+constexpr std::array<std::string_view, cost_phase_count> phase_names{
+    "update", "late_update", "draw"};
+
+void append_rows(std::ofstream &file, const uint64_t step_count,
+                 const std::string_view kind, const CostTable &table) {
+  for (const auto &cost : table.get_costs()) {
+    file << step_count << ',' << kind << ',' << cost.type_name;
+    for (const auto &phase : cost.phases) {
+      file << ',' << phase.total.count() << ',' << phase.call_count;
+    }
+    file << '\n';
+  }
+}
+} // namespace
+
+std::chrono::nanoseconds TypeCost::get_total() const {
+  std::chrono::nanoseconds total{0};
+  for (const auto &phase : phases) {
+    total += phase.total;
+  }
+  return total;
+}
+
+void CostTable::add(const std::string_view type_name, const CostPhase phase,
+                    const std::chrono::nanoseconds duration) {
+  if (costs_.empty() || type_name.data() != last_type_name_.data() ||
+      type_name.size() != last_type_name_.size()) {
+    const auto [it, is_new] =
+        index_by_type_name_.try_emplace(type_name, costs_.size());
+    if (is_new) {
+      costs_.push_back(TypeCost{.type_name = type_name});
+    }
+    last_type_name_ = type_name;
+    last_index_ = it->second;
+  }
+  auto &phase_cost =
+      costs_[last_index_].phases[static_cast<std::size_t>(phase)];
+  phase_cost.total += duration;
+  ++phase_cost.call_count;
+}
+
+std::vector<TypeCost> CostTable::get_costs_by_total() const {
+  auto costs = costs_;
+  std::ranges::stable_sort(costs, std::ranges::greater{},
+                           &TypeCost::get_total);
+  return costs;
+}
+
+std::optional<TypeCost>
+CostTable::get_maybe_cost(const std::string_view type_name) const {
+  const auto it = index_by_type_name_.find(type_name);
+  if (it == index_by_type_name_.end()) {
+    return std::nullopt;
+  }
+  return costs_[it->second];
+}
+
+void CostTable::clear() {
+  costs_.clear();
+  index_by_type_name_.clear();
+  last_type_name_ = {};
+  last_index_ = 0UL;
+}
+
+Result<void, std::string>
+append_costs_to_csv(const std::filesystem::path &path,
+                    const uint64_t step_count, const CostTable &entity_costs,
+                    const CostTable &component_costs) {
+  std::error_code error;
+  const bool needs_header = !std::filesystem::exists(path, error) ||
+                            std::filesystem::file_size(path, error) == 0U;
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    return Err(std::string("Failed to open cost file: ") + path.string());
+  }
+  if (needs_header) {
+    file << "step,kind,type";
+    for (const auto phase_name : phase_names) {
+      file << ',' << phase_name << "_ns," << phase_name << "_calls";
+    }
+    file << '\n';
+  }
+  append_rows(file, step_count, "entity", entity_costs);
+  append_rows(file, step_count, "component", component_costs);
+  if (!file.good()) {
+    return Err(std::string("Failed to write cost file: ") + path.string());
+  }
+  return Ok();
+}
+
+} // namespace model
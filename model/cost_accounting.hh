@@ -0,0 +1,138 @@
+#pragma once
+#include "utility/try.hh"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace model {
+
+/// Part of a step or frame a cost was measured in
+enum class CostPhase : uint8_t { update, late_update, draw };
+
+inline constexpr std::size_t cost_phase_count{3UL};
+
+/// Time spent in one phase and how many calls it took
+struct PhaseCost {
+  std::chrono::nanoseconds total{0};
+  uint64_t call_count{0U};
+};
+
+/// Costs of every entity or component of one type
+struct TypeCost {
+  /// entity_type_name or component_type_name of the type
+  std::string_view type_name;
+  /// indexed by CostPhase
+  std::array<PhaseCost, cost_phase_count> phases{};
+
+  [[nodiscard]] const PhaseCost &get(const CostPhase phase) const {
+    return phases[static_cast<std::size_t>(phase)];
+  }
+
+  /// @return time spent in every phase together
+  [[nodiscard]] std::chrono::nanoseconds get_total() const;
+};
+
+/// Time and call counts summed per type name, so e.g. all GrassTile updates
+/// show up as one row
+class CostTable {
+public:
+  /// Add one call to the costs of a type
+  /// @param[in] type_name type name, must outlive the table (e.g. a
+  /// entity_type_name constant)
+  /// @param[in] phase phase the call ran in
+  /// @param[in] duration time the call took
+  void add(const std::string_view type_name, const CostPhase phase,
+           const std::chrono::nanoseconds duration);
+
+  /// @return costs of every type seen so far, in the order first seen
+  [[nodiscard]] const std::vector<TypeCost> &get_costs() const {
+    return costs_;
+  }
+
+  /// @return costs of every type seen so far, most expensive first
+  [[nodiscard]] std::vector<TypeCost> get_costs_by_total() const;
+
+  /// @param[in] type_name type to look up
+  /// @return costs of the type, nullopt if it hasn't been seen
+  [[nodiscard]] std::optional<TypeCost>
+  get_maybe_cost(const std::string_view type_name) const;
+
+  /// Forget every type and its costs
+  void clear();
+
+private:
+  std::vector<TypeCost> costs_;
+  std::unordered_map<std::string_view, std::size_t> index_by_type_name_;
+  /// Entities of one type tend to be next to each other, so remember the
+  /// last type to skip most hash lookups
+  std::string_view last_type_name_;
+  std::size_t last_index_{0UL};
+};
+
+/// Times a scope and adds it to a CostTable, use through MODEL_COST_SCOPE
+class CostScope {
+public:
+  CostScope(CostTable &table, const std::string_view type_name,
+            const CostPhase phase)
+      : table_(table), type_name_(type_name), phase_(phase),
+        start_(std::chrono::steady_clock::now()) {}
+
+  ~CostScope() {
+    table_.add(type_name_, phase_, std::chrono::steady_clock::now() - start_);
+  }
+
+  CostScope(const CostScope &) = delete;
+  CostScope &operator=(const CostScope &) = delete;
+
+private:
+  CostTable &table_;
+  std::string_view type_name_;
+  CostPhase phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/// Append the costs of both tables to a CSV file, one row per type, writing
+/// the header first if the file is empty
+/// @param[in] path file to append to
+/// @param[in] step_count steps run so far, written as the first column so
+/// dumps from the same run can be told apart
+/// @param[in] entity_costs costs by entity type
+/// @param[in] component_costs costs by component type
+/// @return error if the file can't be written
+[[nodiscard]] Result<void, std::string>
+append_costs_to_csv(const std::filesystem::path &path,
+                    const uint64_t step_count, const CostTable &entity_costs,
+                    const CostTable &component_costs);
+
+/// True when built with MODEL_COST_ACCOUNTING, otherwise the cost tables
+/// stay empty
+/// @note the define must be the same in every translation unit, inline
+/// functions timed with MODEL_COST_SCOPE would otherwise differ between them,
+/// so set it with --define=track_costs=true rather than a per-target copt
+#ifdef MODEL_COST_ACCOUNTING
+inline constexpr bool is_cost_accounting_enabled{true};
+#else
+inline constexpr bool is_cost_accounting_enabled{false};
+#endif
+
+} // namespace model
+
+#define MODEL_COST_CONCAT_INNER(a, b) a##b
+#define MODEL_COST_CONCAT(a, b) MODEL_COST_CONCAT_INNER(a, b)
+
+/// Time the rest of the enclosing scope and add it to table under type_name,
+/// compiles to nothing unless built with MODEL_COST_ACCOUNTING
+#ifdef MODEL_COST_ACCOUNTING
+#define MODEL_COST_SCOPE(table, type_name, phase)                              \
+  const ::model::CostScope MODEL_COST_CONCAT(cost_scope_, __LINE__) {          \
+    table, type_name, phase                                                    \
+  }
+#else
+#define MODEL_COST_SCOPE(table, type_name, phase) static_cast<void>(0)
+#endif
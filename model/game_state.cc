@@ -1,7 +1,9 @@
 #include "model/game_state.hh"
+#include "algs/radix_sort.hh"
 #include "geometry/rectangle_utils.hh"
 #include "model/entity_id.hh"
 #include "utility/overload.hh"
+#include "utility/profiler.hh"
 #include "utility/try.hh"
 #include "view/screen.hh"
 #include <algorithm>
@@ -11,7 +13,18 @@
 
 namespace model {
 
-GameState::GameState() {}
+GameState::GameState() {
+  render_queue_.reserve(max_entity_count);
+  render_queue_scratch_.reserve(max_entity_count);
+}
+
+GameState::~GameState() {
+  // letting the array destroy itself would leave destroyed children in their
+  // slots for their parents to find
+  for (auto &entity : entities_) {
+    entity.reset();
+  }
+}
 
 Result<EntityID, std::string>
 GameState::add_entity(std::unique_ptr<Entity> entity) {
@@ -31,7 +44,7 @@ GameState::add_entity(std::unique_ptr<Entity> entity) {
   // current entity count wasn't too high
   while (entities_[next_index_] != nullptr) {
     next_index_++;
-    if (next_index_ > max_entity_count) {
+    if (next_index_ >= max_entity_count) {
       epoch_++;
       std::cout << "new epoch " << epoch_ << std::endl;
       next_index_ = 0UL;
@@ -50,22 +63,73 @@ void GameState::remove_entity(const EntityID id) {
 
 Result<void, std::string>
 GameState::advance_state(const int64_t delta_time_ns) {
+  // only reads the clock while timings are enabled
+  auto phase_start = std::chrono::steady_clock::time_point{};
+  const auto start_phase = [&]() {
+    if (maybe_update_timings_.has_value()) {
+      phase_start = std::chrono::steady_clock::now();
+    }
+  };
+  const auto finish_phase = [&](std::chrono::nanoseconds &total) {
+    if (maybe_update_timings_.has_value()) {
+      total += std::chrono::steady_clock::now() - phase_start;
+    }
+  };
+
+  PROFILE_SCOPE("GameState::advance_state");
+  start_phase();
+  for (const auto &entity : entities_) {
+    if (entity && entity->maybe_previous_transform_.has_value()) {
+      entity->maybe_previous_transform_ = entity->get_transform();
+    }
+  }
+
   // note that updates can add new entities, we rely on entities_ being fixed
   // size to make this iteration valid
   for (const auto &entity : entities_) {
     if (entity) {
+      PROFILE_SCOPE(entity->get_entity_type_name());
+      MODEL_COST_SCOPE(entity_costs_, entity->get_entity_type_name(),
+                       CostPhase::update);
       TRY_VOID(entity->update(delta_time_ns));
     }
   }
 
-  for (const auto &system : systems_) {
-    TRY_VOID(system->update(*this, delta_time_ns));
+  if (maybe_update_timings_.has_value()) {
+    finish_phase(maybe_update_timings_->entity_update);
+    // systems added since timings were enabled get their own entries
+    auto &system_updates = maybe_update_timings_->system_updates;
+    for (std::size_t index = system_updates.size(); index < systems_.size();
+         ++index) {
+      system_updates.emplace_back(systems_[index]->get_system_type_name(),
+                                  std::chrono::nanoseconds{0});
+    }
   }
 
+  for (std::size_t index = 0U; index < systems_.size(); ++index) {
+    PROFILE_SCOPE(systems_[index]->get_system_type_name());
+    start_phase();
+    TRY_VOID(systems_[index]->update(*this, delta_time_ns));
+    if (maybe_update_timings_.has_value()) {
+      finish_phase(maybe_update_timings_->system_updates[index].second);
+    }
+  }
+
+  PROFILE_SCOPE("GameState::late_update");
+  start_phase();
   for (const auto &entity : entities_) {
     if (entity) {
+      MODEL_COST_SCOPE(entity_costs_, entity->get_entity_type_name(),
+                       CostPhase::late_update);
       TRY_VOID(entity->late_update());
-      for (const auto component : entity->get_components()) {
+      // indexed rather than copied with get_components() so steps don't
+      // allocate, and so components added here don't invalidate the loop
+      auto &components = entity->components_;
+      for (std::size_t index = 0U; index < components.size(); ++index) {
+        const auto &component = components[index];
+        MODEL_COST_SCOPE(component_costs_,
+                         component->get_component_type_name(),
+                         CostPhase::late_update);
         TRY_VOID(component->late_update());
       }
     }
@@ -77,28 +141,79 @@ GameState::advance_state(const int64_t delta_time_ns) {
         remove_entity(entity->get_entity_id());
     }
   }
+
+  if (maybe_update_timings_.has_value()) {
+    finish_phase(maybe_update_timings_->late_update);
+    ++maybe_update_timings_->step_count;
+  }
+
+  ++step_count_;
+  if (is_cost_accounting_enabled && maybe_cost_csv_path_.has_value() &&
+      step_count_ % cost_csv_interval_steps_ == 0U) {
+    TRY_VOID(append_costs_to_csv(maybe_cost_csv_path_.value(), step_count_,
+                                 entity_costs_, component_costs_));
+  }
   return Ok();
 }
 
-Result<void, std::string> GameState::handle_event(const view::EventType &event,
-                                                  const view::Screen &screen) {
+void GameState::clear_costs() {
+  entity_costs_.clear();
+  component_costs_.clear();
+}
+
+void GameState::set_cost_csv_dump(
+    std::optional<std::filesystem::path> maybe_path,
+    const uint64_t interval_steps) {
+  maybe_cost_csv_path_ = std::move(maybe_path);
+  cost_csv_interval_steps_ = std::max<uint64_t>(interval_steps, 1U);
+}
+
+void GameState::set_update_timings_enabled(const bool is_enabled) {
+  if (is_enabled) {
+    maybe_update_timings_ = UpdateTimings{};
+  } else {
+    maybe_update_timings_.reset();
+  }
+}
+
+std::vector<std::pair<std::string_view, uint64_t>>
+GameState::get_entity_counts_by_type() const {
+  std::vector<std::pair<std::string_view, uint64_t>> counts;
+  for (const auto &entity : entities_) {
+    if (!entity) {
+      continue;
+    }
+    const auto type_name = entity->get_entity_type_name();
+    const auto it = std::ranges::lower_bound(
+        counts, type_name, {},
+        [](const auto &name_and_count) { return name_and_count.first; });
+    if (it != counts.end() && it->first == type_name) {
+      ++it->second;
+    } else {
+      counts.emplace(it, type_name, 1U);
+    }
+  }
+  return counts;
+}
+
+Result<void, std::string>
+GameState::handle_event(const view::EventType &event) {
+  PROFILE_SCOPE("GameState::handle_event");
   for (const auto &entity : entities_) {
     if (entity) {
       const auto should_continue = TRY(std::visit(
           utility::Overload{
-              [this, &entity, &screen](const view::MouseUpEvent &mouse_up)
+              [this, &entity](const view::MouseUpEvent &mouse_up)
                   -> Result<bool, std::string> {
-                return handle_mouse_up_for_entity(*entity, mouse_up, screen);
+                return handle_mouse_up_for_entity(*entity, mouse_up);
               },
-              [this, &entity, &screen](const view::MouseDownEvent &mouse_down)
+              [this, &entity](const view::MouseDownEvent &mouse_down)
                   -> Result<bool, std::string> {
-                return handle_mouse_down_for_entity(*entity, mouse_down,
-                                                    screen);
+                return handle_mouse_down_for_entity(*entity, mouse_down);
               },
-              [this, &entity, &screen](const view::MouseMovedEvent &mouse_moved)
+              [this, &entity](const view::MouseMovedEvent &mouse_moved)
                   -> Result<bool, std::string> {
-                return handle_mouse_moved_for_entity(*entity, mouse_moved,
-                                                     screen);
+                return handle_mouse_moved_for_entity(*entity, mouse_moved);
               },
               [&entity](const view::KeyPressedEvent &key_press)
                   -> Result<bool, std::string> {
@@ -128,8 +243,7 @@ Result<void, std::string> GameState::handle_event(const view::EventType &event,
 
 Result<bool, std::string>
 GameState::handle_mouse_up_for_entity(Entity &entity,
-                                      const view::MouseUpEvent &mouse_up,
-                                      const view::Screen &screen) {
+                                      const view::MouseUpEvent &mouse_up) {
   if (geometry::rectangle_contains_point(entity.get_transform(),
                                          mouse_up.position) ||
       entity.get_handle_mouse_events_outside_entitiy()) {
@@ -139,9 +253,8 @@ GameState::handle_mouse_up_for_entity(Entity &entity,
 }
 
 Result<bool, std::string>
-GameState::handle_mouse_down_for_entity(Entity &entity,
-                                        const view::MouseDownEvent &mouse_down,
-                                        const view::Screen &screen) {
+GameState::handle_mouse_down_for_entity(
+    Entity &entity, const view::MouseDownEvent &mouse_down) {
   if (geometry::rectangle_contains_point(entity.get_transform(),
                                          mouse_down.position) ||
       entity.get_handle_mouse_events_outside_entitiy()) {
@@ -151,36 +264,82 @@ GameState::handle_mouse_down_for_entity(Entity &entity,
 }
 
 Result<bool, std::string> GameState::handle_mouse_moved_for_entity(
-    Entity &entity, const view::MouseMovedEvent &mouse_moved,
-    const view::Screen &screen) {
+    Entity &entity, const view::MouseMovedEvent &mouse_moved) {
   return entity.on_mouse_moved(mouse_moved);
 }
 
 Result<void, std::string> GameState::draw(view::Screen &screen) const {
-  std::array<std::vector<std::size_t>, 5UL> draw_lists;
-  for (const auto &entity : entities_) {
-    if (entity) {
-      const auto z_ordering = entity->get_z_level();
-      if (z_ordering == 0U) {
-        TRY_VOID(entity->draw(screen));
-      } else {
-        draw_lists[z_ordering - 1].emplace_back(entity->get_entity_id().index);
-      }
+  PROFILE_SCOPE("GameState::draw");
+  last_draw_stats_ = DrawStats{};
+  auto visible_bounds = screen.get_visible_bounds();
+
+  const auto draw_if_visible =
+      [&](const Entity &entity) -> Result<void, std::string> {
+    const auto maybe_draw_bounds = entity.get_maybe_draw_bounds();
+    if (maybe_draw_bounds.has_value() &&
+        !maybe_draw_bounds.value().intersects(visible_bounds)) {
+      ++last_draw_stats_.culled_entity_count;
+      return Ok();
     }
-  }
 
-  for (const auto &draw_list : draw_lists) {
-    for (const auto &index : draw_list) {
-      TRY_VOID(entities_[index]->draw(screen));
+    ++last_draw_stats_.submitted_entity_count;
+    PROFILE_SCOPE(entity.get_entity_type_name());
+    MODEL_COST_SCOPE(entity_costs_, entity.get_entity_type_name(),
+                     CostPhase::draw);
+    TRY_VOID(entity.draw(screen));
+    if (!maybe_draw_bounds.has_value()) {
+      // entities without bounds include the ones which move or zoom the
+      // viewport (e.g. Zoom), so pick up any change before testing the rest
+      visible_bounds = screen.get_visible_bounds();
     }
+    return Ok();
+  };
+
+  build_render_queue();
+  for (const auto &draw_item : render_queue_) {
+    TRY_VOID(draw_if_visible(*entities_[draw_item.entity_index]));
   }
 
   for (const auto &system : systems_) {
+    PROFILE_SCOPE(system->get_system_type_name());
     TRY_VOID(system->draw(screen));
   }
   return Ok();
 }
 
+Result<void, std::string>
+GameState::record_render_snapshot(view::RenderSnapshot &snapshot) const {
+  PROFILE_SCOPE("GameState::record_render_snapshot");
+  build_render_queue();
+  for (const auto &draw_item : render_queue_) {
+    const auto &entity = *entities_[draw_item.entity_index];
+    MODEL_COST_SCOPE(entity_costs_, entity.get_entity_type_name(),
+                     CostPhase::draw);
+    TRY_VOID(entity.record_snapshot(snapshot));
+  }
+
+  for (const auto &system : systems_) {
+    PROFILE_SCOPE(system->get_system_type_name());
+    TRY_VOID(system->record_snapshot(snapshot));
+  }
+  return Ok();
+}
+
+void GameState::build_render_queue() const {
+  // entities are queued in index order and the sort is stable, so keying on
+  // the z level alone keeps insertion order within a level
+  render_queue_.clear();
+  for (uint32_t index = 0U; index < entities_.size(); ++index) {
+    if (entities_[index]) {
+      render_queue_.push_back(
+          DrawItem{.sort_key = entities_[index]->get_z_level(),
+                   .entity_index = index});
+    }
+  }
+  algs::radix_sort(render_queue_, render_queue_scratch_,
+                   [](const DrawItem &draw_item) { return draw_item.sort_key; });
+}
+
 std::optional<Entity *>
 GameState::try_get_entity_pointer_by_id(const EntityID entity_id) const {
   if (entity_id.index >= entities_.size()) {
@@ -200,11 +359,61 @@ Entity::Entity(GameState &game_state) : game_state_(game_state) {}
 
 Result<void, std::string> Entity::draw(view::Screen &screen) const {
   for (const auto &component : components_) {
+    MODEL_COST_SCOPE(game_state_.component_costs_,
+                     component->get_component_type_name(), CostPhase::draw);
     TRY_VOID(component->draw(screen));
   }
   return Ok();
 }
 
+Result<void, std::string>
+Entity::record_snapshot(view::RenderSnapshot &snapshot) const {
+  for (const auto &component : components_) {
+    MODEL_COST_SCOPE(game_state_.component_costs_,
+                     component->get_component_type_name(), CostPhase::draw);
+    TRY_VOID(component->record_snapshot(snapshot));
+  }
+  return Ok();
+}
+
+Result<void, std::string>
+Entity::update_components(const int64_t delta_time_ns) {
+  for (const auto &component : components_) {
+    MODEL_COST_SCOPE(game_state_.component_costs_,
+                     component->get_component_type_name(), CostPhase::update);
+    TRY_VOID(component->update(delta_time_ns));
+  }
+  return Ok();
+}
+
+Eigen::Affine2f Entity::get_interpolated_transform() const {
+  const Eigen::Affine2f transform = get_transform();
+  if (!maybe_previous_transform_.has_value()) {
+    maybe_previous_transform_ = transform;
+    return transform;
+  }
+  const Eigen::Matrix3f &previous = maybe_previous_transform_.value().matrix();
+  return Eigen::Affine2f{
+      previous +
+      game_state_.get_interpolation_alpha() * (transform.matrix() - previous)};
+}
+
+std::optional<Eigen::AlignedBox2f> Entity::get_maybe_draw_bounds() const {
+  Eigen::AlignedBox2f draw_bounds;
+  for (const auto &component : components_) {
+    const auto maybe_component_bounds = component->get_maybe_draw_bounds();
+    if (!maybe_component_bounds.has_value()) {
+      return std::nullopt;
+    }
+    draw_bounds.extend(maybe_component_bounds.value());
+  }
+  if (draw_bounds.isEmpty()) {
+    // nothing to cull against, keep drawing in case a subclass draws directly
+    return std::nullopt;
+  }
+  return draw_bounds;
+}
+
 std::vector<component::Component *> Entity::get_components() const {
   std::vector<component::Component *> result;
   result.reserve(components_.size());
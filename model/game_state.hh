@@ -1,12 +1,16 @@
 #pragma once
 #include "components/component.hh"
+#include "model/cost_accounting.hh"
 #include "model/entity_id.hh"
 #include "systems/system.hh"
 #include "utility/try.hh"
+#include "view/render_snapshot.hh"
 #include "view/screen.hh"
 #include <Eigen/Dense>
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <limits>
 #include <memory>
 #include <type_traits>
@@ -30,9 +34,27 @@ public:
   [[nodiscard]] virtual Result<void, std::string>
   draw(view::Screen &screen) const;
 
-  /// Z level to draw object on (entities are drawn from low to high)
+  /// Record what draw would draw so it can be drawn on another thread
+  /// @param[out] snapshot snapshot to append draw calls to
+  /// @note defaults to recording every component, entities which override
+  /// draw to use the screen directly aren't visible when the controller runs
+  /// pipelined unless they override this as well
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) const;
+
+  /// Z level to draw object on (entities are drawn from low to high, entities
+  /// on the same level are drawn in the order they were added)
   [[nodiscard]] virtual uint8_t get_z_level() const { return 0; }
 
+  /// Region of the world this entity draws into, entities whose bounds don't
+  /// overlap the visible part of the world are skipped during draw
+  /// @note defaults to the union of the component draw bounds, entities which
+  /// override draw should override this as well
+  /// @return bounds in world coordinates, or nullopt if the entity should
+  /// always be drawn
+  [[nodiscard]] virtual std::optional<Eigen::AlignedBox2f>
+  get_maybe_draw_bounds() const;
+
   /// Update the internal state of the Enitity
   /// @param[in] delta_time_ns the current time in nanoseconds
   [[nodiscard]] virtual Result<void, std::string>
@@ -127,6 +149,15 @@ public:
     return Eigen::Affine2f::Identity();
   };
 
+  /// Transform to draw the entity at, blending the transform from before the
+  /// last simulation step into the current one by the game state's
+  /// interpolation alpha so motion stays smooth when steps and frames don't
+  /// line up
+  /// @note the previous transform is only recorded for entities which have
+  /// called this, so the first call returns get_transform()
+  /// @return interpolated transform, only use it for drawing
+  [[nodiscard]] Eigen::Affine2f get_interpolated_transform() const;
+
   template <
       typename ComponentType,
       typename std::enable_if_t<
@@ -244,6 +275,13 @@ protected:
           std::is_base_of_v<component::Component, ComponentType>, int> = 0>
   ComponentType *add_component(Args &&...args);
 
+  /// Update every component in the order they were added
+  /// @note entities which override update should call this rather than
+  /// looping over components_ so component costs are accounted
+  /// @param[in] delta_time_ns time since the last update in nanoseconds
+  [[nodiscard]] Result<void, std::string>
+  update_components(const int64_t delta_time_ns);
+
   /// underlying reference the game state note, that entities are owned by the
   /// game state so it will always outlive the entity
   GameState &game_state_;
@@ -256,6 +294,9 @@ private:
   [[nodiscard]] std::optional<Entity *> try_get_parent_entity() const;
 
   EntityID entity_id_;
+  /// Transform before the latest simulation step, set once
+  /// get_interpolated_transform has been called
+  mutable std::optional<Eigen::Affine2f> maybe_previous_transform_;
   std::optional<EntityID> maybe_parent_entity_;
   std::vector<EntityID> child_entities_;
 };
@@ -264,8 +305,33 @@ private:
 /// game
 class GameState {
 public:
+  /// Counts from the most recent call to draw
+  struct DrawStats {
+    /// entities whose draw method was called
+    uint32_t submitted_entity_count{0U};
+    /// entities skipped because they were entirely outside the viewport
+    uint32_t culled_entity_count{0U};
+  };
+
+  /// Time spent in each phase of advance_state, summed over every step since
+  /// timings were enabled
+  struct UpdateTimings {
+    uint64_t step_count{0U};
+    /// entity and component update calls
+    std::chrono::nanoseconds entity_update{0};
+    /// each system's update, in the order the systems were added
+    std::vector<std::pair<std::string_view, std::chrono::nanoseconds>>
+        system_updates;
+    /// late_update calls and removing entities
+    std::chrono::nanoseconds late_update{0};
+  };
+
   GameState();
 
+  /// Destroys the entities one at a time, each slot is emptied before its
+  /// entity's destructor removes the entity's children
+  ~GameState();
+
   /// Add a new entity to the game state
   /// @param[in] entity entity to be added to the game state
   [[nodiscard]] Result<EntityID, std::string>
@@ -296,7 +362,7 @@ public:
 
   /// Handle mouse down event
   [[nodiscard]] Result<void, std::string>
-  handle_event(const view::EventType &event, const view::Screen &screen);
+  handle_event(const view::EventType &event);
 
   [[nodiscard]] std::optional<Entity *>
   try_get_entity_pointer_by_id(const EntityID entity_id) const;
@@ -329,27 +395,99 @@ public:
                 std::is_base_of_v<component::Component, ComponentType>, int>>
   [[nodiscard]] std::vector<Entity *> get_entities_with_component() const;
 
+  /// Start or stop timing the phases of advance_state
+  /// @param[in] is_enabled true to time every following step, enabling resets
+  /// the timings
+  /// @note off by default so steps don't pay for reading the clock
+  void set_update_timings_enabled(const bool is_enabled);
+
+  /// @return timings summed since they were enabled, nullopt if disabled
+  [[nodiscard]] const std::optional<UpdateTimings> &
+  get_maybe_update_timings() const {
+    return maybe_update_timings_;
+  }
+
+  /// @return number of entities currently in the game
+  [[nodiscard]] uint64_t get_entity_count() const {
+    return current_entity_count_;
+  }
+
+  /// Count the entities of each type currently in the game
+  /// @return entity type names and counts, sorted by name
+  [[nodiscard]] std::vector<std::pair<std::string_view, uint64_t>>
+  get_entity_counts_by_type() const;
+
+  /// Set how far between the last two simulation steps the next draw is
+  /// @param[in] interpolation_alpha 0 draws the state before the last step, 1
+  /// the state after it
+  void set_interpolation_alpha(const float interpolation_alpha) {
+    interpolation_alpha_ = interpolation_alpha;
+  }
+
+  /// @return blend factor used by Entity::get_interpolated_transform
+  [[nodiscard]] float get_interpolation_alpha() const {
+    return interpolation_alpha_;
+  }
+
+  /// Draw all entities which overlap the viewport followed by all systems
+  /// @param[in] screen screen to draw to
   [[nodiscard]] Result<void, std::string> draw(view::Screen &screen) const;
 
+  /// Record every entity in draw order, then every system, for drawing on
+  /// another thread
+  /// @param[out] snapshot snapshot to append the draw calls to
+  /// @note unlike draw nothing is culled since the viewport belongs to the
+  /// render thread
+  [[nodiscard]] Result<void, std::string>
+  record_render_snapshot(view::RenderSnapshot &snapshot) const;
+
+  /// Get the culling statistics from the last call to draw
+  /// @return number of entities drawn and culled during the last frame
+  [[nodiscard]] DrawStats get_last_draw_stats() const {
+    return last_draw_stats_;
+  }
+
+  /// Time and calls of update, late_update and draw summed per entity type
+  /// @note entity costs include the costs of their components
+  /// @note always empty unless built with MODEL_COST_ACCOUNTING
+  [[nodiscard]] const CostTable &get_entity_costs() const {
+    return entity_costs_;
+  }
+
+  /// Time and calls of update, late_update and draw summed per component type
+  /// @note always empty unless built with MODEL_COST_ACCOUNTING
+  [[nodiscard]] const CostTable &get_component_costs() const {
+    return component_costs_;
+  }
+
+  /// Forget the entity and component costs collected so far
+  void clear_costs();
+
+  /// Periodically append the entity and component costs to a CSV file, see
+  /// append_costs_to_csv
+  /// @param[in] maybe_path file to append to, nullopt to stop dumping
+  /// @param[in] interval_steps number of steps between dumps
+  /// @note does nothing unless built with MODEL_COST_ACCOUNTING
+  void set_cost_csv_dump(std::optional<std::filesystem::path> maybe_path,
+                         const uint64_t interval_steps = 600U);
+
 private:
+  friend class Entity;
+
   static constexpr std::size_t max_entity_count{4096UL};
   static constexpr EntityID invalid_entity_id{
       std::numeric_limits<EntityID>::max()};
-  static constexpr std::size_t max_z_level{5UL};
 
   [[nodiscard]] Result<bool, std::string>
-  handle_mouse_up_for_entity(Entity &entity, const view::MouseUpEvent &event,
-                             const view::Screen &screen);
+  handle_mouse_up_for_entity(Entity &entity, const view::MouseUpEvent &event);
 
   Result<bool, std::string>
   handle_mouse_down_for_entity(Entity &entity,
-                               const view::MouseDownEvent &mouse_down,
-                               const view::Screen &screen);
+                               const view::MouseDownEvent &mouse_down);
 
   Result<bool, std::string>
   handle_mouse_moved_for_entity(Entity &entity,
-                                const view::MouseMovedEvent &mouse_moved,
-                                const view::Screen &screen);
+                                const view::MouseMovedEvent &mouse_moved);
 
   /// Current entities in the game
   std::array<std::unique_ptr<Entity>, max_entity_count> entities_{nullptr};
@@ -359,6 +497,34 @@ private:
   uint64_t epoch_{0UL};
   uint64_t next_index_{0UL};
   uint64_t current_entity_count_{0UL};
+
+  /// Entity to draw along with the key used to order the render queue
+  struct DrawItem {
+    uint32_t sort_key;
+    uint32_t entity_index;
+  };
+
+  /// Fill render_queue_ with every entity sorted by z level
+  void build_render_queue() const;
+
+  /// Rebuilt and sorted every draw, kept as members so their storage is
+  /// reused between frames
+  mutable std::vector<DrawItem> render_queue_;
+  mutable std::vector<DrawItem> render_queue_scratch_;
+
+  mutable DrawStats last_draw_stats_;
+
+  float interpolation_alpha_{1.0f};
+
+  std::optional<UpdateTimings> maybe_update_timings_;
+
+  /// Filled in by draw as well as by advance_state
+  mutable CostTable entity_costs_;
+  mutable CostTable component_costs_;
+  std::optional<std::filesystem::path> maybe_cost_csv_path_;
+  uint64_t cost_csv_interval_steps_{600U};
+  /// Steps run since the game state was created
+  uint64_t step_count_{0U};
 };
 } // namespace model
 
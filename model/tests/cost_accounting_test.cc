@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include "model/cost_accounting.hh"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace model;
+using namespace std::chrono_literals;
+
+namespace {
+constexpr std::string_view grass_tile{"grass_tile"};
+constexpr std::string_view skeleton{"skeleton"};
+constexpr std::string_view sprite{"sprite"};
+
+std::string read_file(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  return {std::istreambuf_iterator<char>(file),
+          std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST_CASE("Costs are summed per type and phase", "[cost_accounting]") {
+  CostTable table;
+  table.add(grass_tile, CostPhase::update, 2ns);
+  table.add(grass_tile, CostPhase::update, 3ns);
+  table.add(skeleton, CostPhase::update, 40ns);
+  table.add(grass_tile, CostPhase::draw, 7ns);
+
+  REQUIRE(table.get_costs().size() == 2U);
+  const auto grass_cost = table.get_maybe_cost(grass_tile).value();
+  CHECK(grass_cost.get(CostPhase::update).total == 5ns);
+  CHECK(grass_cost.get(CostPhase::update).call_count == 2U);
+  CHECK(grass_cost.get(CostPhase::late_update).call_count == 0U);
+  CHECK(grass_cost.get(CostPhase::draw).total == 7ns);
+  CHECK(grass_cost.get_total() == 12ns);
+
+  // looked up by value, not by where the name is stored
+  CHECK(table.get_maybe_cost(std::string("skeleton")).has_value());
+  CHECK_FALSE(table.get_maybe_cost(sprite).has_value());
+}
+
+TEST_CASE("Costs can be sorted by total time", "[cost_accounting]") {
+  CostTable table;
+  table.add(grass_tile, CostPhase::update, 5ns);
+  table.add(skeleton, CostPhase::update, 40ns);
+  table.add(sprite, CostPhase::draw, 10ns);
+
+  const auto costs = table.get_costs_by_total();
+  REQUIRE(costs.size() == 3U);
+  CHECK(costs[0].type_name == skeleton);
+  CHECK(costs[1].type_name == sprite);
+  CHECK(costs[2].type_name == grass_tile);
+
+  table.clear();
+  CHECK(table.get_costs().empty());
+  table.add(sprite, CostPhase::draw, 1ns);
+  CHECK(table.get_maybe_cost(sprite)->get(CostPhase::draw).call_count == 1U);
+}
+
+TEST_CASE("Costs are appended to a CSV file", "[cost_accounting]") {
+  CostTable entity_costs;
+  entity_costs.add(skeleton, CostPhase::update, 40ns);
+  CostTable component_costs;
+  component_costs.add(sprite, CostPhase::draw, 10ns);
+
+  const auto path =
+      std::filesystem::temp_directory_path() / "cost_accounting_test.csv";
+  std::filesystem::remove(path);
+  REQUIRE(append_costs_to_csv(path, 60U, entity_costs, component_costs)
+              .isOk());
+  REQUIRE(append_costs_to_csv(path, 120U, entity_costs, component_costs)
+              .isOk());
+
+  CHECK(read_file(path) ==
+        "step,kind,type,update_ns,update_calls,late_update_ns,"
+        "late_update_calls,draw_ns,draw_calls\n"
+        "60,entity,skeleton,40,1,0,0,0,0\n"
+        "60,component,sprite,0,0,0,0,10,1\n"
+        "120,entity,skeleton,40,1,0,0,0,0\n"
+        "120,component,sprite,0,0,0,0,10,1\n");
+  std::filesystem::remove(path);
+
+  CHECK(append_costs_to_csv("/nonexistent_directory/costs.csv", 1U,
+                            entity_costs, component_costs)
+            .isErr());
+}
+
+TEST_CASE("Cost scopes compile out unless enabled", "[cost_accounting]") {
+  CostTable table;
+  {
+    MODEL_COST_SCOPE(table, skeleton, CostPhase::update);
+  }
+  CHECK(table.get_costs().size() == (is_cost_accounting_enabled ? 1U : 0U));
+}
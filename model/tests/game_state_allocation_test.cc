@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "model/game_state.hh"
+#include "utility/allocation_tracker.hh"
+
+namespace {
+class StepCounter : public component::Component {
+public:
+  static constexpr std::string_view component_type_name = "step_counter";
+
+  [[nodiscard]] virtual Result<void, std::string>
+  update(const int64_t delta_time_ns) {
+    ++update_count;
+    return Ok();
+  }
+
+  [[nodiscard]] virtual Result<void, std::string> late_update() {
+    ++late_update_count;
+    return Ok();
+  }
+
+  [[nodiscard]] virtual std::string_view get_component_type_name() const {
+    return component_type_name;
+  }
+
+  uint64_t update_count{0U};
+  uint64_t late_update_count{0U};
+};
+
+class CountedEntity : public model::Entity {
+public:
+  static constexpr std::string_view entity_type_name = "counted_entity";
+
+  CountedEntity(model::GameState &game_state) : model::Entity(game_state) {}
+
+  void init() {
+    add_component<StepCounter>();
+    add_component<StepCounter>();
+  }
+
+  [[nodiscard]] virtual Result<void, std::string>
+  update(const int64_t delta_time_ns) {
+    return update_components(delta_time_ns);
+  }
+
+  [[nodiscard]] virtual std::string_view get_entity_type_name() const {
+    return entity_type_name;
+  }
+};
+} // namespace
+
+TEST_CASE("Steady state steps don't allocate", "[game_state][allocations]") {
+  REQUIRE(utility::are_allocation_hooks_linked());
+
+  model::GameState game_state;
+  std::vector<CountedEntity *> entities;
+  for (int index = 0; index < 256; ++index) {
+    entities.push_back(
+        game_state.add_entity_and_init<CountedEntity>().unwrap());
+  }
+  // anything lazily set up on the first step is allowed to allocate
+  REQUIRE(game_state.advance_state(16'666'667).isOk());
+
+  const auto start = utility::get_thread_allocation_counts();
+  for (int step = 0; step < 100; ++step) {
+    REQUIRE(game_state.advance_state(16'666'667).isOk());
+  }
+  const auto allocations = utility::get_thread_allocation_counts() - start;
+  CHECK(allocations.count == 0U);
+  CHECK(allocations.bytes == 0U);
+
+  // make sure the steps did the work being measured
+  const auto counters = entities.front()->get_components<StepCounter>();
+  REQUIRE(counters.size() == 2U);
+  CHECK(counters.front()->update_count == 101U);
+  CHECK(counters.front()->late_update_count == 101U);
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+#include "components/zoom.hh"
+#include "model/game_state.hh"
+#include "systems/system.hh"
+#include "view/render_snapshot.hh"
+
+namespace {
+class ZoomedCamera : public model::Entity {
+public:
+  static constexpr std::string_view entity_type_name = "zoomed_camera";
+
+  ZoomedCamera(model::GameState &game_state) : model::Entity(game_state) {}
+
+  void init() { add_component<component::Zoom>(2.0f); }
+
+  [[nodiscard]] virtual std::string_view get_entity_type_name() const {
+    return entity_type_name;
+  }
+};
+
+class OverlaySystem : public systems::System {
+public:
+  Result<void, std::string> update(model::GameState &game_state,
+                                   const int64_t delta_time_ns) override {
+    return Ok();
+  }
+
+  Result<void, std::string>
+  record_snapshot(view::RenderSnapshot &snapshot) override {
+    snapshot.system_draws.push_back(
+        [](view::Screen &screen) -> Result<void, std::string> {
+          return Ok();
+        });
+    return Ok();
+  }
+
+  std::string_view get_system_type_name() const override {
+    return "overlay_system";
+  }
+};
+} // namespace
+
+TEST_CASE("Render snapshots record zoom and system draws",
+          "[game_state][render_snapshot]") {
+  model::GameState game_state;
+  REQUIRE(game_state.add_entity_and_init<ZoomedCamera>().isOk());
+  game_state.add_system<OverlaySystem>();
+
+  view::RenderSnapshot snapshot;
+  REQUIRE(game_state.record_render_snapshot(snapshot).isOk());
+  REQUIRE(snapshot.maybe_zoom_level.has_value());
+  CHECK(snapshot.maybe_zoom_level.value() == 2.0f);
+  CHECK(snapshot.system_draws.size() == 1UL);
+
+  snapshot.clear();
+  CHECK_FALSE(snapshot.maybe_zoom_level.has_value());
+  CHECK(snapshot.system_draws.empty());
+}
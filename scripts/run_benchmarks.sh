@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Build the //benchmarks suite with optimizations and write one google
+# benchmark JSON file per binary, e.g. to compare against an older run with
+# google benchmark's tools/compare.py.
+#
+#   scripts/run_benchmarks.sh [output_directory] [extra benchmark flags...]
+set -euo pipefail
+
+output_directory="$(realpath -m "${1:-benchmark_results}")"
+shift || true
+mkdir -p "${output_directory}"
+
+benchmarks=(
+  a_star_benchmark
+  collisions_benchmark
+  game_state_benchmark
+  grid_collisions_benchmark
+  map_generation_benchmark
+  map_save_benchmark
+  texture_set_benchmark
+  visibility_polygon_benchmark
+)
+
+for benchmark in "${benchmarks[@]}"; do
+  bazel run -c opt "//benchmarks:${benchmark}" -- \
+    --benchmark_out="${output_directory}/${benchmark}.json" \
+    --benchmark_out_format=json \
+    "$@"
+done
@@ -1,5 +1,6 @@
 #include "shader_demo/shader_demo.hh"
 #include "controller/controller.hh"
+#include "view/shader_cache.hh"
 #include <iostream>
 
 int main() {
@@ -18,6 +19,9 @@ int main() {
     Eigen::Vector2f{0.0f, 0.0f}   // centered at origin
   );
 
+  // Edits to the demo shaders show up without restarting
+  view::ShaderCache::get().enable_hot_reload();
+
   // Run the game loop
   controller::Controller controller(std::move(screen), std::move(game_result).unwrap());
   const auto result = controller.run();
@@ -17,17 +17,23 @@ Result<void, std::string> TestEntity::init(const Eigen::Vector2f& position) {
     .vertex_shader_path = std::string(vertex_shader_path),
     .fragment_shader_path = std::string(fragment_shader_path),
     .uniform_provider = [this](view::Shader& shader) {
+      // Names are resolved once, unchanged values are skipped by the shader
+      static const view::UniformId viewport_center{"viewport_center"};
+      static const view::UniformId viewport_size{"viewport_size"};
+      static const view::UniformId test_light_pos{"test_light_pos"};
+      static const view::UniformId test_light_color{"test_light_color"};
+
       // Get entity position as light position
       const Eigen::Affine2f transform = get_transform();
       const Eigen::Vector2f position = transform.translation();
 
       // Set viewport parameters (these should come from screen/camera)
-      shader.set_uniform("viewport_center", Eigen::Vector2f{0.0f, 0.0f});
-      shader.set_uniform("viewport_size", Eigen::Vector2f{4.0f, 4.0f});
+      shader.set_uniform(viewport_center, Eigen::Vector2f{0.0f, 0.0f});
+      shader.set_uniform(viewport_size, Eigen::Vector2f{4.0f, 4.0f});
 
       // Set light parameters
-      shader.set_uniform("test_light_pos", position);
-      shader.set_uniform("test_light_color", Eigen::Vector3f{1.0f, 0.8f, 0.6f});
+      shader.set_uniform(test_light_pos, position);
+      shader.set_uniform(test_light_color, Eigen::Vector3f{1.0f, 0.8f, 0.6f});
     },
     .z_level = -1.0f  // Behind other entities
   };
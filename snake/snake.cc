@@ -6,6 +6,7 @@
 #include "geometry/transform_utils.hh"
 #include "model/rectangle.hh"
 #include "systems/grid_collisions.hh"
+#include "utility/random.hh"
 #include "view/screen.hh"
 #include "view/texture.hh"
 #include <SFML/Window/Keyboard.hpp>
@@ -99,15 +100,12 @@ Result<void, std::string> SnakeBoard::init() {
 }
 
 Eigen::Vector2i SnakeBoard::get_random_cell_position() {
-  // TODO don't generate every time
-  std::random_device rd_{}; // obtain a random number from hardware
-  std::mt19937 gen(rd_());  // seed the generator
   const auto bounds = get_grid_size();
   const auto max_x = bounds.x() - 1;
   const auto max_y = bounds.y() - 1;
   std::uniform_int_distribution<> x_distr(-max_x, max_x);
   std::uniform_int_distribution<> y_distr(-max_y, max_y);
-  return {x_distr(gen), y_distr(gen)};
+  return {x_distr(utility::get_rng()), y_distr(utility::get_rng())};
 }
 
 Result<void, std::string> SnakeBoard::ate_apple() {
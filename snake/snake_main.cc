@@ -4,7 +4,13 @@
 #include <chrono>
 #include <cstdlib>
 
-int main() {
+int main(int argc, char **argv) {
+  // parsed first since --seed has to apply before the game is created
+  const auto params_result = controller::parse_command_line(argc, argv);
+  if (params_result.isErr()) {
+    std::cerr << params_result.unwrapErr() << std::endl;
+    return EXIT_FAILURE;
+  }
   auto game_result = snake::make_snake_game();
   if (game_result.isErr()) {
     std::cerr << "Failed to initialize game with error: "
@@ -13,7 +19,9 @@ int main() {
   }
   controller::Controller controller(std::make_unique<view::Screen>(),
                                     std::move(game_result).unwrap());
-  const auto result = controller.run(std::chrono::milliseconds(100));
+  auto params = params_result.unwrap();
+  params.simulation_step = std::chrono::milliseconds(100);
+  const auto result = controller.run(params);
   if (result.isErr()) {
     std::cerr << "Application ended with error: " << result.unwrapErr()
               << std::endl;
@@ -6,31 +6,101 @@ in vec2 world_position;
 // Output color
 out vec4 FragColor;
 
-// Light configuration
-const int MAX_LIGHTS = 32;
-uniform int light_count;                    // Actual number of lights
-uniform vec2 light_positions[MAX_LIGHTS];   // Light positions in world coordinates
-uniform vec3 light_colors[MAX_LIGHTS];      // Light RGB colors (0-255 range)
-uniform float light_radii[MAX_LIGHTS];     // Light radii in world units
+#include "lighting_params.glsl"
+
+uniform sampler2D lightmap;
+
+// Three texels per light: (x, y, radius, 0), (r, g, b, 0) with colors in 0-255 range,
+// then (first vertex, vertex count, 0, 0) of its visibility polygon
+uniform samplerBuffer light_data;
+
+// The same texels for up to max_block_lights lights. Uniform block reads go through the
+// constant cache on most GPUs, so they are used whenever the visible lights fit.
+const int max_block_lights = 256;
+layout(std140) uniform LightBlock {
+    vec4 block_light_data[3 * max_block_lights];
+};
+
+vec4 get_light_texel(int index) {
+    if (light_data_in_block != 0) {
+        return block_light_data[index];
+    }
+    return texelFetch(light_data, index);
+}
+
+// Visibility polygon vertices as (x, y, angle around the light, 0), each polygon sorted by
+// angle from -pi (see geometry/visibility_polygon.hh)
+uniform samplerBuffer visibility_polygons;
+
+// Tile offsets (tile_count.x * tile_count.y + 1 entries) followed by light indices, a
+// tile's lights are the indices between its offset and the next tile's offset
+uniform usamplerBuffer light_grid;
+
+// Same test as geometry::VisibilityPolygon::contains, lights without a polygon reach
+// everywhere in their radius
+bool is_in_visibility_polygon(vec2 light_position, int first_vertex, int vertex_count) {
+    if (vertex_count == 0) {
+        return true;
+    }
+
+    // binary search for the edge whose angular range covers this pixel
+    vec2 offset = world_position - light_position;
+    float angle = atan(offset.y, offset.x);
+    int low = 0;
+    int high = vertex_count;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (texelFetch(visibility_polygons, first_vertex + middle).z <= angle) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    int next_index = low == vertex_count ? 0 : low;
+    int index = next_index == 0 ? vertex_count - 1 : next_index - 1;
+
+    vec2 edge_start = texelFetch(visibility_polygons, first_vertex + index).xy;
+    vec2 edge_end = texelFetch(visibility_polygons, first_vertex + next_index).xy;
+    vec2 edge = edge_end - edge_start;
+    vec2 to_pixel = world_position - edge_start;
+    return edge.x * to_pixel.y - edge.y * to_pixel.x >= 0.0;
+}
 
 void main() {
-    // Start with no light (black multiplier)
-    vec3 total_light_color = vec3(0.0, 0.0, 0.0);
+    // Global lights contribute uniformly
+    vec3 total_light_color = ambient_light_color / 255.0;
+    if (lightmap_enabled != 0) {
+        total_light_color += texture(lightmap, (world_position - lightmap_origin) / lightmap_size).rgb;
+    }
+
+    // Find the tile this pixel is in
+    ivec2 tile = clamp(ivec2(floor((world_position - light_grid_origin) / light_tile_size)),
+                       ivec2(0), light_tile_count - 1);
+    int tile_index = tile.y * light_tile_count.x + tile.x;
+    int first_light = int(texelFetch(light_grid, tile_index).r);
+    int last_light = int(texelFetch(light_grid, tile_index + 1).r);
+
+    // Accumulate contributions from only the lights touching this tile
+    for (int i = first_light; i < last_light; i++) {
+        int light_index = int(texelFetch(light_grid, i).r);
+        vec4 position_and_radius = get_light_texel(3 * light_index);
+        vec3 light_color = get_light_texel(3 * light_index + 1).rgb;
+        vec2 visibility_polygon = get_light_texel(3 * light_index + 2).xy;
 
-    // Accumulate light contributions with their colors
-    for (int i = 0; i < light_count && i < MAX_LIGHTS; i++) {
         // Calculate distance from this pixel to the light
-        float distance = length(world_position - light_positions[i]);
+        float distance = length(world_position - position_and_radius.xy);
+        float radius = position_and_radius.z;
 
         // Calculate light intensity with smooth falloff
-        if (distance < light_radii[i]) {
-            // // Quadratic falloff for realistic lighting
-            float normalized_distance = distance / light_radii[i];
+        if (distance < radius &&
+            is_in_visibility_polygon(position_and_radius.xy, int(visibility_polygon.x),
+                                     int(visibility_polygon.y))) {
+            // Quadratic falloff for realistic lighting
+            float normalized_distance = distance / radius;
             float intensity = 1.0 - (normalized_distance * normalized_distance);
-            // float intensity = 1.0; // fall off is disabled for now
 
             // Convert light color from 0-255 range to 0-1 range and apply intensity
-            vec3 light_contribution = (light_colors[i] / 255.0) * intensity;
+            vec3 light_contribution = (light_color / 255.0) * intensity;
 
             // Additive blending - lights combine naturally
             total_light_color += light_contribution;
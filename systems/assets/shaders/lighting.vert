@@ -3,9 +3,7 @@
 // Vertex attributes for fullscreen quad
 layout (location = 0) in vec2 position;  // Screen-space position (-1 to 1)
 
-// Camera/viewport uniforms
-uniform vec2 viewport_center;    // Camera position in world coordinates
-uniform vec2 viewport_size;      // Size of viewport in world units
+#include "lighting_params.glsl"
 
 // Outputs to fragment shader
 out vec2 world_position;         // World coordinates for this pixel
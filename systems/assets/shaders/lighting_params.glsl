@@ -0,0 +1,22 @@
+// Per-pass parameters, uploaded in one uniform buffer (systems::LightingSystem::LightingParams
+// must match this std140 layout). Included by both stages so they share the block.
+layout(std140) uniform LightingParams {
+    vec2 viewport_center;       // Camera position in world coordinates
+    vec2 viewport_size;         // Size of viewport in world units
+
+    // Static lights baked by this same shader with lightmap_enabled = 0, sampled
+    // over the world space area starting at lightmap_origin
+    vec2 lightmap_origin;
+    vec2 lightmap_size;
+
+    // Lights binned into a grid of tiles covering the viewport (see
+    // systems/light_binning.hh)
+    vec2 light_grid_origin;     // World position of the grid's minimum corner
+    vec2 light_tile_size;       // Size of one tile in world units
+    ivec2 light_tile_count;     // Number of tiles along each axis
+    int lightmap_enabled;
+    int light_data_in_block;    // Light texels are in LightBlock rather than light_data
+
+    // Sum of global lights (0-255 range), applied everywhere
+    vec3 ambient_light_color;
+};
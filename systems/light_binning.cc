@@ -0,0 +1,130 @@
+#include "systems/light_binning.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace systems {
+namespace {
+bool does_light_overlap_box(const PackedLight &light,
+                            const Eigen::AlignedBox2f &box) {
+  // squaredExteriorDistance is zero when the center is inside the box
+  return box.squaredExteriorDistance(light.position) <
+         light.radius * light.radius;
+}
+
+/// Range of tiles touched by a light's bounding square, both ends inclusive
+/// @return false if the light's bounding square misses the grid entirely
+bool get_light_tile_range(const PackedLight &light,
+                          const Eigen::AlignedBox2f &bounds,
+                          const Eigen::Vector2i tile_count,
+                          const Eigen::Vector2f tile_size,
+                          Eigen::Vector2i &min_tile, Eigen::Vector2i &max_tile) {
+  const Eigen::Vector2f min_offset =
+      (light.position - Eigen::Vector2f::Constant(light.radius) - bounds.min())
+          .cwiseQuotient(tile_size);
+  const Eigen::Vector2f max_offset =
+      (light.position + Eigen::Vector2f::Constant(light.radius) - bounds.min())
+          .cwiseQuotient(tile_size);
+  for (int axis = 0; axis < 2; ++axis) {
+    if (max_offset[axis] < 0.0f || min_offset[axis] >= tile_count[axis]) {
+      return false;
+    }
+    min_tile[axis] =
+        std::max(0, static_cast<int32_t>(std::floor(min_offset[axis])));
+    max_tile[axis] = std::min(tile_count[axis] - 1,
+                              static_cast<int32_t>(std::floor(max_offset[axis])));
+  }
+  return true;
+}
+
+Eigen::AlignedBox2f get_tile_box(const LightTileGrid &grid,
+                                 const Eigen::Vector2f tile_size,
+                                 const Eigen::Vector2i tile) {
+  const Eigen::Vector2f tile_min =
+      grid.bounds.min() + tile.cast<float>().cwiseProduct(tile_size);
+  return Eigen::AlignedBox2f{tile_min, tile_min + tile_size};
+}
+} // namespace
+
+Eigen::Vector2f LightTileGrid::get_tile_size() const {
+  return bounds.sizes().cwiseQuotient(tile_count.cast<float>());
+}
+
+std::span<const uint32_t>
+LightTileGrid::get_tile_lights(const Eigen::Vector2i tile) const {
+  const auto tile_index =
+      static_cast<std::size_t>(tile.y() * tile_count.x() + tile.x());
+  const auto begin = light_indices.begin() + tile_offsets[tile_index];
+  const auto end = light_indices.begin() + tile_offsets[tile_index + 1];
+  return {begin, end};
+}
+
+void cull_lights_to_bounds(const std::vector<PackedLight> &lights,
+                           const Eigen::AlignedBox2f &bounds,
+                           std::vector<PackedLight> &visible_lights) {
+  visible_lights.clear();
+  for (const auto &light : lights) {
+    if (does_light_overlap_box(light, bounds)) {
+      visible_lights.push_back(light);
+    }
+  }
+}
+
+void bin_lights_into_tiles(const std::vector<PackedLight> &lights,
+                           const Eigen::AlignedBox2f &bounds,
+                           const Eigen::Vector2i tile_count,
+                           LightTileGrid &grid) {
+  grid.bounds = bounds;
+  grid.tile_count = tile_count;
+  const auto total_tile_count =
+      static_cast<std::size_t>(tile_count.x() * tile_count.y());
+  grid.tile_offsets.assign(total_tile_count + 1, 0U);
+  grid.light_indices.clear();
+
+  const Eigen::Vector2f tile_size = grid.get_tile_size();
+
+  // visits every (light, tile) overlap, tiles in row order for each light
+  const auto for_each_overlap = [&](const auto &visit) {
+    for (uint32_t light_index = 0; light_index < lights.size();
+         ++light_index) {
+      const auto &light = lights[light_index];
+      Eigen::Vector2i min_tile;
+      Eigen::Vector2i max_tile;
+      if (!get_light_tile_range(light, bounds, tile_count, tile_size, min_tile,
+                                max_tile)) {
+        continue;
+      }
+      for (int32_t y = min_tile.y(); y <= max_tile.y(); ++y) {
+        for (int32_t x = min_tile.x(); x <= max_tile.x(); ++x) {
+          if (does_light_overlap_box(light,
+                                     get_tile_box(grid, tile_size, {x, y}))) {
+            visit(light_index,
+                  static_cast<std::size_t>(y * tile_count.x() + x));
+          }
+        }
+      }
+    }
+  };
+
+  // counting sort: count lights per tile, prefix sum into offsets, then fill
+  // each tile's slice in light order
+  for_each_overlap([&grid](uint32_t, const std::size_t tile_index) {
+    ++grid.tile_offsets[tile_index + 1];
+  });
+  for (std::size_t i = 1; i < grid.tile_offsets.size(); ++i) {
+    grid.tile_offsets[i] += grid.tile_offsets[i - 1];
+  }
+
+  grid.light_indices.resize(grid.tile_offsets.back());
+  // tile_offsets[i] is used as the write cursor for tile i and ends up at the
+  // start of tile i + 1, shifting back restores the offsets afterwards
+  for_each_overlap(
+      [&grid](const uint32_t light_index, const std::size_t tile_index) {
+        grid.light_indices[grid.tile_offsets[tile_index]++] = light_index;
+      });
+  for (std::size_t i = grid.tile_offsets.size() - 1; i > 0; --i) {
+    grid.tile_offsets[i] = grid.tile_offsets[i - 1];
+  }
+  grid.tile_offsets[0] = 0U;
+}
+
+} // namespace systems
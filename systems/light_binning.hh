@@ -0,0 +1,76 @@
+#pragma once
+#include "geometry/visibility_polygon.hh"
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace systems {
+
+/**
+ * @brief Circular light reduced to the values the lighting shader reads
+ */
+struct PackedLight {
+  Eigen::Vector2f position; ///< Center in world coordinates
+  float radius;             ///< Distance at which the light fades to zero
+  Eigen::Vector3f color;    ///< RGB in 0-255 range, scaled by intensity
+  /// Area the light reaches around occluders, nullptr if nothing blocks it
+  const geometry::VisibilityPolygon *visibility_polygon{nullptr};
+};
+
+/**
+ * @brief Lights assigned to a uniform grid of tiles covering the viewport
+ *
+ * Per-tile light lists are stored back to back in light_indices: the lights
+ * touching tile i are light_indices[tile_offsets[i]] up to (but excluding)
+ * light_indices[tile_offsets[i + 1]]. Tiles are numbered row by row starting
+ * from the minimum corner of bounds.
+ */
+struct LightTileGrid {
+  Eigen::AlignedBox2f bounds;
+  Eigen::Vector2i tile_count{0, 0};
+  std::vector<uint32_t> tile_offsets;
+  std::vector<uint32_t> light_indices;
+
+  /**
+   * @brief Get the world space size of a single tile
+   * @return Width and height of each tile
+   */
+  [[nodiscard]] Eigen::Vector2f get_tile_size() const;
+
+  /**
+   * @brief Get the lights touching a tile
+   * @param tile Column and row of the tile
+   * @pre 0 <= tile < tile_count on both axes
+   * @return Indices into the binned light list, in ascending order
+   */
+  [[nodiscard]] std::span<const uint32_t>
+  get_tile_lights(const Eigen::Vector2i tile) const;
+};
+
+/**
+ * @brief Keep only the lights whose circle overlaps bounds
+ * @param lights All lights in the level
+ * @param bounds Visible area in world coordinates
+ * @param[out] visible_lights Cleared then filled with the overlapping lights,
+ * in their original order
+ */
+void cull_lights_to_bounds(const std::vector<PackedLight> &lights,
+                           const Eigen::AlignedBox2f &bounds,
+                           std::vector<PackedLight> &visible_lights);
+
+/**
+ * @brief Assign each light to every tile its circle overlaps
+ * @param lights Lights to bin, usually the output of cull_lights_to_bounds
+ * @param bounds Area covered by the grid in world coordinates
+ * @param tile_count Number of tiles along each axis
+ * @pre tile_count.x() > 0 && tile_count.y() > 0
+ * @param[out] grid Overwritten with the binned lights, existing allocations
+ * are reused
+ */
+void bin_lights_into_tiles(const std::vector<PackedLight> &lights,
+                           const Eigen::AlignedBox2f &bounds,
+                           const Eigen::Vector2i tile_count,
+                           LightTileGrid &grid);
+
+} // namespace systems
@@ -1,14 +1,16 @@
 #include "systems/lighting_system.hh"
 #include "components/light_emitter.hh"
 #include <algorithm>
-#include <iostream>
 
 namespace systems {
 
 Result<void, std::string> LightingSystem::update(model::GameState &game_state,
                                                  const int64_t delta_time_ns) {
   // Clear previous frame's lights
-  active_lights_.clear();
+  lights_.static_lights.clear();
+  lights_.dynamic_lights.clear();
+  lights_.static_ambient_light_color = Eigen::Vector3f::Zero();
+  lights_.dynamic_ambient_light_color = Eigen::Vector3f::Zero();
 
   // Get all entities with LightEmitter components
   const auto entities =
@@ -24,13 +26,40 @@ Result<void, std::string> LightingSystem::update(model::GameState &game_state,
       if (!light_emitter)
         continue;
 
-      // Get current light info and store for rendering
       const auto light_info = light_emitter->get_light_info();
 
       // Only include lights with positive intensity
-      if (light_info.intensity > 0.0f) {
-        active_lights_.push_back(light_info);
+      if (light_info.intensity <= 0.0f) {
+        continue;
+      }
+
+      // Color with intensity applied
+      const Eigen::Vector3f color =
+          Eigen::Vector3f{static_cast<float>(light_info.color.r),
+                          static_cast<float>(light_info.color.g),
+                          static_cast<float>(light_info.color.b)} *
+          light_info.intensity;
+
+      if (light_info.geometry &&
+          light_info.geometry->get_geometry_type() ==
+              component::GlobalLightGeometry::geometry_type_name) {
+        // Global lights reach every pixel at full strength
+        (light_info.is_static ? lights_.static_ambient_light_color
+                              : lights_.dynamic_ambient_light_color) += color;
+        continue;
       }
+
+      // Lights without geometry fall back to a 1m radius
+      const float radius = light_info.geometry
+                               ? light_info.geometry->get_bounding_radius()
+                               : 1.0f;
+      const auto *visibility_polygon =
+          light_info.geometry
+              ? light_info.geometry->get_maybe_visibility_polygon()
+              : nullptr;
+      (light_info.is_static ? lights_.static_lights : lights_.dynamic_lights)
+          .push_back(PackedLight{light_info.world_position, radius, color,
+                                 visibility_polygon});
     }
   }
 
@@ -38,16 +67,57 @@ Result<void, std::string> LightingSystem::update(model::GameState &game_state,
 }
 
 Result<void, std::string> LightingSystem::draw(view::Screen &screen) {
+  return draw_lights(screen, lights_);
+}
+
+Result<void, std::string>
+LightingSystem::record_snapshot(view::RenderSnapshot &snapshot) {
+  auto lights = std::make_shared<CollectedLights>(lights_);
+  // reserved up front so the copies don't move while lights point at them
+  const auto has_polygon = [](const PackedLight &light) {
+    return light.visibility_polygon != nullptr;
+  };
+  lights->visibility_polygons.reserve(
+      static_cast<std::size_t>(
+          std::ranges::count_if(lights->static_lights, has_polygon)) +
+      static_cast<std::size_t>(
+          std::ranges::count_if(lights->dynamic_lights, has_polygon)));
+  for (auto *light_list : {&lights->static_lights, &lights->dynamic_lights}) {
+    for (auto &light : *light_list) {
+      if (has_polygon(light)) {
+        light.visibility_polygon =
+            &lights->visibility_polygons.emplace_back(*light.visibility_polygon);
+      }
+    }
+  }
+
+  snapshot.system_draws.push_back(
+      [this, lights = std::shared_ptr<const CollectedLights>(std::move(lights))](
+          view::Screen &screen) { return draw_lights(screen, *lights); });
+  return Ok();
+}
+
+Result<void, std::string>
+LightingSystem::draw_lights(view::Screen &screen,
+                            const CollectedLights &lights) {
   // Lazy-load shader on first draw call
   TRY_VOID(ensure_shader_loaded());
 
   // Skip rendering if shader failed to load
-  if (!lighting_shader_ || !lighting_shader_->is_valid()) {
+  if (!lighting_shader_.is_valid()) {
     return Ok();
   }
 
+  // the lightmap was baked with the previous program
+  if (lighting_shader_.get_source_hash() != lightmap_shader_hash_) {
+    lightmap_shader_hash_ = lighting_shader_.get_source_hash();
+    lightmap_cache_.invalidate();
+  }
+
+  TRY_VOID(bake_static_lightmap_if_needed(screen, lights));
+
   // Set up shader uniforms with current lights and screen info
-  TRY_VOID(set_lighting_uniforms(screen));
+  TRY_VOID(set_lighting_uniforms(screen, lights));
 
   // Render fullscreen lighting shader on top of game entities with
   // multiplicative blending
@@ -64,97 +134,178 @@ Result<void, std::string> LightingSystem::ensure_shader_loaded() {
 
   shader_load_attempted_ = true;
 
-  // Load shader from files
-  auto shader_result = view::Shader::from_files(
-      std::string(vertex_shader_path_), std::string(fragment_shader_path_));
-
-  if (shader_result.isOk()) {
-    lighting_shader_ = std::move(shader_result).unwrap();
-  } else {
-    std::cerr << "Failed to load lighting shader: " << shader_result.unwrapErr()
-              << std::endl;
-    // System will be non-functional but won't crash
+  auto shader_result = view::ShaderCache::get().load(get_shader_files());
+  if (shader_result.isErr()) {
+    return Err(std::string("Failed to load lighting shader: ") +
+               shader_result.unwrapErr());
   }
+  lighting_shader_ = shader_result.unwrap();
+  lightmap_shader_hash_ = lighting_shader_.get_source_hash();
 
   return Ok();
 }
 
+namespace {
+/// Same area the vertex shader maps the fullscreen quad onto
+Eigen::AlignedBox2f get_viewport_bounds(const view::Screen &screen) {
+  const Eigen::Vector2f viewport_center = screen.get_viewport_center();
+  const Eigen::Vector2f viewport_size = screen.get_actual_viewport_size();
+  return Eigen::AlignedBox2f{viewport_center - viewport_size / 2,
+                             viewport_center + viewport_size / 2};
+}
+
+std::array<float, 2> to_array(const Eigen::Vector2f &vector) {
+  return {vector.x(), vector.y()};
+}
+
+const view::UniformId lighting_params_block{"LightingParams"};
+const view::UniformId light_block{"LightBlock"};
+const view::UniformId lightmap_uniform{"lightmap"};
+const view::UniformId light_data_uniform{"light_data"};
+const view::UniformId light_grid_uniform{"light_grid"};
+const view::UniformId visibility_polygons_uniform{"visibility_polygons"};
+} // namespace
+
 Result<void, std::string>
-LightingSystem::set_lighting_uniforms(const view::Screen &screen) const {
-  if (!lighting_shader_) {
+LightingSystem::bake_static_lightmap_if_needed(view::Screen &screen,
+                                               const CollectedLights &lights) {
+  if (!lighting_shader_.is_valid()) {
     return Err(std::string("Lighting shader not loaded"));
   }
 
-  // Set viewport uniforms from screen
-  lighting_shader_->set_uniform("viewport_center",
-                                screen.get_viewport_center());
-  lighting_shader_->set_uniform("viewport_size", screen.get_actual_viewport_size());
-
-  // Set light count
-  const int32_t light_count =
-      std::min(static_cast<int32_t>(active_lights_.size()), 32);
-  lighting_shader_->set_uniform("light_count", light_count);
-
-  // Prepare light data arrays
-  std::vector<Eigen::Vector2f> light_positions;
-  std::vector<Eigen::Vector3f> light_colors;
-  std::vector<float> light_radii;
-
-  light_positions.reserve(light_count);
-  light_colors.reserve(light_count);
-  light_radii.reserve(light_count);
-
-  // Extract data from active lights
-  for (int32_t i = 0; i < light_count; ++i) {
-    const auto &light_info = active_lights_[i];
-
-    // Position and radius (depends on geometry type)
-    Eigen::Vector2f position;
-    float radius = 1.0f; // Default fallback
-
-    if (light_info.geometry) {
-      const auto geometry_type = light_info.geometry->get_geometry_type();
-
-      if (geometry_type == component::CircularLightGeometry::geometry_type_name) {
-        // Regular circular light - use entity position
-        position = light_info.world_position;
-        const auto *circular_geometry =
-            dynamic_cast<const component::CircularLightGeometry *>(
-                light_info.geometry.get());
-        if (circular_geometry) {
-          radius = circular_geometry->get_radius();
-        }
-      } else if (geometry_type == component::GlobalLightGeometry::geometry_type_name) {
-        // Global light - center at viewport with very large radius
-        position = screen.get_viewport_center();
-        radius = 1000.0f; // Very large radius to cover entire screen
-      } else {
-        // Unknown geometry type - fallback to entity position
-        position = light_info.world_position;
-      }
-    } else {
-      // No geometry - fallback to entity position
-      position = light_info.world_position;
-    }
+  if (!lightmap_cache_.update(lights.static_lights,
+                              lights.static_ambient_light_color,
+                              get_viewport_bounds(screen))) {
+    return Ok();
+  }
 
-    // Add processed data to arrays
-    light_positions.push_back(position);
-    light_radii.push_back(radius);
+  // the bake runs the regular lighting shader over the cached area with only
+  // the static lights bound
+  const auto &lightmap_bounds = lightmap_cache_.get_bounds();
+  lightmap_.resize(Eigen::Vector2i::Constant(lightmap_resolution_));
+  LightingParams params;
+  params.viewport_center = to_array(lightmap_bounds.center());
+  params.viewport_size = to_array(lightmap_bounds.sizes());
+  params.lightmap_enabled = 0;
+  upload_lights(lights.static_lights, lights.static_ambient_light_color,
+                lightmap_bounds, params, lightmap_pass_buffers_);
+  screen.draw_fullscreen_shader_to_framebuffer(*lighting_shader_, lightmap_);
 
-    // Color with intensity applied
-    const float effective_intensity = light_info.intensity;
-    light_colors.push_back(
-        Eigen::Vector3f{light_info.color.r * effective_intensity,
-                        light_info.color.g * effective_intensity,
-                        light_info.color.b * effective_intensity});
+  return Ok();
+}
+
+Result<void, std::string>
+LightingSystem::set_lighting_uniforms(const view::Screen &screen,
+                                      const CollectedLights &lights) {
+  if (!lighting_shader_.is_valid()) {
+    return Err(std::string("Lighting shader not loaded"));
   }
 
-  // Set uniform arrays
-  lighting_shader_->set_uniform_array("light_positions", light_positions);
-  lighting_shader_->set_uniform_array("light_colors", light_colors);
-  lighting_shader_->set_uniform_array("light_radii", light_radii);
+  const auto viewport_bounds = get_viewport_bounds(screen);
+  const auto &lightmap_bounds = lightmap_cache_.get_bounds();
+  lightmap_.bind_texture(lightmap_texture_unit_);
+
+  LightingParams params;
+  params.viewport_center = to_array(viewport_bounds.center());
+  params.viewport_size = to_array(viewport_bounds.sizes());
+  params.lightmap_enabled = 1;
+  params.lightmap_origin = to_array(lightmap_bounds.min());
+  params.lightmap_size = to_array(lightmap_bounds.sizes());
+  upload_lights(lights.dynamic_lights, lights.dynamic_ambient_light_color,
+                viewport_bounds, params, screen_pass_buffers_);
 
   return Ok();
 }
 
+void LightingSystem::upload_lights(const std::vector<PackedLight> &lights,
+                                   const Eigen::Vector3f &ambient_light_color,
+                                   const Eigen::AlignedBox2f &bounds,
+                                   LightingParams &params,
+                                   LightingPassBuffers &pass_buffers) {
+  cull_lights_to_bounds(lights, bounds, visible_lights_);
+  bin_lights_into_tiles(visible_lights_, bounds,
+                        Eigen::Vector2i::Constant(light_grid_tiles_per_axis_),
+                        light_grid_);
+
+  light_texels_.clear();
+  visibility_polygon_texels_.clear();
+  for (const auto &light : visible_lights_) {
+    light_texels_.emplace_back(light.position.x(), light.position.y(),
+                               light.radius, 0.0f);
+    light_texels_.emplace_back(light.color.x(), light.color.y(),
+                               light.color.z(), 0.0f);
+
+    // vertex offsets stay well below 2^24 so they survive the float texel
+    const auto first_vertex =
+        static_cast<float>(visibility_polygon_texels_.size());
+    float vertex_count = 0.0f;
+    if (light.visibility_polygon != nullptr) {
+      const auto &vertices = light.visibility_polygon->get_vertices();
+      const auto &vertex_angles = light.visibility_polygon->get_vertex_angles();
+      for (std::size_t i = 0; i < vertices.size(); ++i) {
+        visibility_polygon_texels_.emplace_back(
+            vertices[i].x(), vertices[i].y(), vertex_angles[i], 0.0f);
+      }
+      vertex_count = static_cast<float>(vertices.size());
+    }
+    light_texels_.emplace_back(first_vertex, vertex_count, 0.0f, 0.0f);
+  }
+
+  // the shader reads the block whenever the lights fit and the buffer texture
+  // otherwise, the block stays bound either way so it is always filled to its
+  // declared size
+  const std::size_t block_texel_count = 3U * max_block_lights_;
+  const bool is_light_data_in_block = light_texels_.size() <= block_texel_count;
+  if (is_light_data_in_block) {
+    light_texels_.resize(block_texel_count, Eigen::Vector4f::Zero());
+  } else {
+    light_data_buffer_.upload(light_texels_);
+  }
+  pass_buffers.light_block.upload_bytes(
+      light_texels_.data(), block_texel_count * sizeof(Eigen::Vector4f));
+  visibility_polygon_buffer_.upload(visibility_polygon_texels_);
+
+  // offsets are stored first, so shift them to index into the combined buffer
+  const auto offset_table_size =
+      static_cast<uint32_t>(light_grid_.tile_offsets.size());
+  light_grid_texels_.clear();
+  for (const auto offset : light_grid_.tile_offsets) {
+    light_grid_texels_.push_back(offset + offset_table_size);
+  }
+  light_grid_texels_.insert(light_grid_texels_.end(),
+                            light_grid_.light_indices.begin(),
+                            light_grid_.light_indices.end());
+  light_grid_buffer_.upload(light_grid_texels_);
+
+  light_data_buffer_.bind(light_data_texture_unit_);
+  light_grid_buffer_.bind(light_grid_texture_unit_);
+  visibility_polygon_buffer_.bind(visibility_polygon_texture_unit_);
+
+  params.light_grid_origin = to_array(light_grid_.bounds.min());
+  params.light_tile_size = to_array(light_grid_.get_tile_size());
+  params.light_tile_count = {light_grid_.tile_count.x(),
+                             light_grid_.tile_count.y()};
+  params.light_data_in_block = is_light_data_in_block ? 1 : 0;
+  params.ambient_light_color = {ambient_light_color.x(), ambient_light_color.y(),
+                                ambient_light_color.z()};
+  pass_buffers.params.upload(params);
+  pass_buffers.params.bind(lighting_params_binding_);
+  pass_buffers.light_block.bind(light_block_binding_);
+
+  // blocks and samplers never change, after the first frame these make no GL
+  // calls
+  lighting_shader_->bind_uniform_block(lighting_params_block,
+                                       lighting_params_binding_);
+  lighting_shader_->bind_uniform_block(light_block, light_block_binding_);
+  lighting_shader_->set_uniform(lightmap_uniform,
+                                static_cast<int32_t>(lightmap_texture_unit_));
+  lighting_shader_->set_uniform(
+      light_data_uniform, static_cast<int32_t>(light_data_texture_unit_));
+  lighting_shader_->set_uniform(
+      light_grid_uniform, static_cast<int32_t>(light_grid_texture_unit_));
+  lighting_shader_->set_uniform(
+      visibility_polygons_uniform,
+      static_cast<int32_t>(visibility_polygon_texture_unit_));
+}
+
 } // namespace systems
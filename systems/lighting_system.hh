@@ -1,9 +1,17 @@
 #pragma once
 #include "components/light_emitter.hh"
 #include "model/game_state.hh"
+#include "systems/light_binning.hh"
+#include "systems/lightmap.hh"
 #include "systems/system.hh"
+#include "view/buffer_texture.hh"
+#include "view/framebuffer.hh"
+#include "view/render_snapshot.hh"
 #include "view/screen.hh"
 #include "view/shader.hh"
+#include "view/shader_cache.hh"
+#include "view/uniform_buffer.hh"
+#include <array>
 #include <vector>
 #include <memory>
 
@@ -16,6 +24,26 @@ namespace systems {
  * and renders a shader-based lighting overlay during draw. It implements a "black by default"
  * lighting model where only illuminated areas are visible using GLSL shaders for realistic
  * lighting effects with smooth falloff and multiple light support.
+ *
+ * Lights are culled against the viewport and binned into a grid of screen tiles on the CPU
+ * each frame, so each pixel only evaluates the lights that can reach its tile. Global lights
+ * are summed into a single ambient term instead of being evaluated per pixel.
+ *
+ * Static lights (global lights and emitters created with is_static) are baked into a low
+ * resolution lightmap covering an area around the viewport. The lightmap is only baked again
+ * when the static lights change or the viewport leaves the baked area, so each frame only
+ * evaluates the dynamic lights.
+ *
+ * Lights with a visibility polygon (see component::ShadowCastingLightGeometry) only light
+ * pixels inside their polygon, so occluders cast hard shadows.
+ *
+ * Per-pass parameters and, when they fit, the visible lights are uploaded in uniform buffers
+ * kept per pass, so an unchanged frame uploads nothing and switching between the bake and
+ * the screen pass only rebinds buffers.
+ *
+ * When the controller runs pipelined, record_snapshot hands a copy of the
+ * collected lights to the render thread, which draws them with the GL state
+ * kept here. That state is then only touched on the render thread.
  */
 class LightingSystem : public System {
 public:
@@ -24,6 +52,15 @@ public:
    */
   LightingSystem() = default;
 
+  /**
+   * @brief Get the lighting shader files, e.g. to precompile them at startup
+   * @return Vertex and fragment shader paths
+   */
+  [[nodiscard]] static view::ShaderFiles get_shader_files() {
+    return view::ShaderFiles{std::string(vertex_shader_path_),
+                             std::string(fragment_shader_path_)};
+  }
+
   /**
    * @brief Get the system type name for identification
    * @return Static string identifying this system type
@@ -51,32 +88,173 @@ public:
   [[nodiscard]] virtual Result<void, std::string>
   draw(view::Screen& screen) override;
 
+  /**
+   * @brief Record a draw of the collected lights for the render thread
+   * @param snapshot Snapshot to append the lighting draw to
+   * @return Ok()
+   * @post The draw holds its own copy of the lights and visibility polygons
+   */
+  [[nodiscard]] virtual Result<void, std::string>
+  record_snapshot(view::RenderSnapshot& snapshot) override;
+
 private:
-  /// Collected light information for current frame
-  std::vector<component::LightEmitter::LightInfo> active_lights_;
+  /// Everything draw needs from the game state
+  struct CollectedLights {
+    /// Circular lights collected for the current frame, split by whether
+    /// they can be baked into the lightmap
+    std::vector<PackedLight> static_lights;
+    std::vector<PackedLight> dynamic_lights;
+
+    /// Sum of global light colors (0-255 range, scaled by intensity)
+    Eigen::Vector3f static_ambient_light_color{0.0f, 0.0f, 0.0f};
+    Eigen::Vector3f dynamic_ambient_light_color{0.0f, 0.0f, 0.0f};
+
+    /// Copies of the polygons the lights point at, only filled for lights
+    /// recorded into a snapshot since the originals belong to components
+    std::vector<geometry::VisibilityPolygon> visibility_polygons;
+  };
+
+  CollectedLights lights_;
+
+  /// Decides when the static lightmap has to be baked again
+  StaticLightmapCache lightmap_cache_;
+
+  /// Static lighting baked over lightmap_cache_.get_bounds()
+  view::Framebuffer lightmap_;
+
+  /// Lights overlapping the viewport, reused between frames
+  std::vector<PackedLight> visible_lights_;
+
+  /// Per-tile light lists for visible_lights_
+  LightTileGrid light_grid_;
+
+  /// Staging data for the buffer textures, reused between frames
+  std::vector<Eigen::Vector4f> light_texels_;
+  std::vector<uint32_t> light_grid_texels_;
+  std::vector<Eigen::Vector4f> visibility_polygon_texels_;
+
+  /// Three RGBA32F texels per visible light: (x, y, radius, 0), (r, g, b, 0),
+  /// then (first polygon vertex, polygon vertex count, 0, 0). Only uploaded
+  /// when more than max_block_lights_ lights are visible
+  view::BufferTexture light_data_buffer_;
 
-  /// Lighting shader for rendering all lights at once
-  std::unique_ptr<view::Shader> lighting_shader_;
+  /// Visibility polygon vertices of every visible light as (x, y, angle, 0)
+  view::BufferTexture visibility_polygon_buffer_;
+
+  /// Tile offsets followed by light indices, offsets already point past the
+  /// offset table
+  view::BufferTexture light_grid_buffer_;
+
+  /// std140 layout of the LightingParams block in lighting_params.glsl
+  struct LightingParams {
+    std::array<float, 2> viewport_center{};
+    std::array<float, 2> viewport_size{};
+    std::array<float, 2> lightmap_origin{};
+    std::array<float, 2> lightmap_size{};
+    std::array<float, 2> light_grid_origin{};
+    std::array<float, 2> light_tile_size{};
+    std::array<int32_t, 2> light_tile_count{};
+    int32_t lightmap_enabled{0};
+    int32_t light_data_in_block{0};
+    std::array<float, 3> ambient_light_color{};
+    float padding{0.0f};
+  };
+  static_assert(sizeof(LightingParams) == 80);
+
+  /// Uniform buffers of one pass of the lighting shader, the lightmap bake and
+  /// the screen pass each keep their own so switching pass is a bind and
+  /// unchanged contents aren't uploaded again
+  struct LightingPassBuffers {
+    view::UniformBuffer params;
+    /// Same texels as light_data_buffer_, read instead of it when the visible
+    /// lights fit
+    view::UniformBuffer light_block;
+  };
+  LightingPassBuffers lightmap_pass_buffers_;
+  LightingPassBuffers screen_pass_buffers_;
+
+  /// Size of the LightBlock array in lighting.frag, 3 texels per light keep
+  /// it within the 16 KiB every GL 3.3 driver supports
+  static constexpr std::size_t max_block_lights_{256U};
+
+  /// Uniform buffer binding points
+  static constexpr uint32_t lighting_params_binding_{0U};
+  static constexpr uint32_t light_block_binding_{1U};
+
+  /// Number of light tiles along each viewport axis
+  static constexpr int32_t light_grid_tiles_per_axis_{16};
+
+  /// Lightmap width and height in texels
+  static constexpr int32_t lightmap_resolution_{256};
+
+  /// Texture units for the light buffers and lightmap, unit 0 is left for sprites
+  static constexpr uint32_t light_data_texture_unit_{1U};
+  static constexpr uint32_t light_grid_texture_unit_{2U};
+  static constexpr uint32_t lightmap_texture_unit_{3U};
+  static constexpr uint32_t visibility_polygon_texture_unit_{4U};
+
+  /// Lighting shader for rendering all lights at once, shared through the
+  /// ShaderCache
+  view::ShaderHandle lighting_shader_;
 
   /// Flag to track shader loading attempts
   bool shader_load_attempted_{false};
 
+  /// Source hash the lightmap was baked with, a hot reload rebakes it
+  uint64_t lightmap_shader_hash_{0};
+
   /// Shader file paths
   static constexpr std::string_view vertex_shader_path_ = "systems/assets/shaders/lighting.vert";
   static constexpr std::string_view fragment_shader_path_ = "systems/assets/shaders/lighting.frag";
 
   /**
    * @brief Ensure lighting shader is loaded (lazy loading)
-   * @return Ok() on success, Err(message) if shader loading fails
+   * @return Ok() on success, Err(message) if the shader fails to load
    */
   Result<void, std::string> ensure_shader_loaded();
 
   /**
-   * @brief Set shader uniforms based on collected lights and screen viewport
+   * @brief Draw the lighting overlay for a set of lights
+   * @param screen Screen to render lighting effects to
+   * @param lights Lights to draw
+   * @return Ok() on success, Err(message) if rendering fails
+   */
+  Result<void, std::string> draw_lights(view::Screen& screen,
+                                        const CollectedLights& lights);
+
+  /**
+   * @brief Bake the static lights into lightmap_ if the cache was invalidated
+   * @param screen Screen to get viewport information from and render with
+   * @param lights Lights to bake the static ones of
+   * @return Ok() on success, Err(message) if baking fails
+   */
+  Result<void, std::string>
+  bake_static_lightmap_if_needed(view::Screen& screen,
+                                 const CollectedLights& lights);
+
+  /**
+   * @brief Set shader uniforms to draw the dynamic lights over the lightmap
    * @param screen Screen to get viewport information from
+   * @param lights Lights to upload the dynamic ones of
    * @return Ok() on success, Err(message) if uniform setting fails
    */
-  Result<void, std::string> set_lighting_uniforms(const view::Screen& screen) const;
+  Result<void, std::string> set_lighting_uniforms(const view::Screen& screen,
+                                                  const CollectedLights& lights);
+
+  /**
+   * @brief Cull and bin lights to an area, upload them with the pass parameters
+   * and bind everything the lighting shader reads
+   * @param lights Circular lights to upload
+   * @param ambient_light_color Sum of global lights to upload
+   * @param bounds Area the fullscreen quad covers
+   * @param params Pass parameters with the viewport and lightmap fields set,
+   * the light fields are filled in here
+   * @param pass_buffers Uniform buffers of the pass being drawn
+   */
+  void upload_lights(const std::vector<PackedLight>& lights,
+                     const Eigen::Vector3f& ambient_light_color,
+                     const Eigen::AlignedBox2f& bounds, LightingParams& params,
+                     LightingPassBuffers& pass_buffers);
 };
 
 } // namespace systems
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "systems/lightmap.hh"
+#include <algorithm>
+
+namespace systems {
+namespace {
+bool are_lights_equal(const std::vector<PackedLight> &lhs,
+                      const std::vector<PackedLight> &rhs) {
+  return std::ranges::equal(
+      lhs, rhs, [](const PackedLight &lhs_light, const PackedLight &rhs_light) {
+        return lhs_light.position == rhs_light.position &&
+               lhs_light.radius == rhs_light.radius &&
+               lhs_light.color == rhs_light.color &&
+               (lhs_light.visibility_polygon == nullptr) ==
+                   (rhs_light.visibility_polygon == nullptr);
+      });
+}
+
+bool are_polygons_equal(
+    const std::vector<PackedLight> &lights,
+    const std::vector<std::vector<Eigen::Vector2f>> &polygons) {
+  return std::ranges::equal(
+      lights, polygons,
+      [](const PackedLight &light,
+         const std::vector<Eigen::Vector2f> &polygon_vertices) {
+        return light.visibility_polygon == nullptr
+                   ? polygon_vertices.empty()
+                   : light.visibility_polygon->get_vertices() ==
+                         polygon_vertices;
+      });
+}
+} // namespace
+
+Eigen::Vector3f evaluate_lighting(const std::vector<PackedLight> &lights,
+                                  const Eigen::Vector3f &ambient_light_color,
+                                  const Eigen::Vector2f world_position) {
+  Eigen::Vector3f total_light_color = ambient_light_color / 255.0f;
+  for (const auto &light : lights) {
+    const float distance = (world_position - light.position).norm();
+    if (distance < light.radius &&
+        (light.visibility_polygon == nullptr ||
+         light.visibility_polygon->contains(world_position))) {
+      const float normalized_distance = distance / light.radius;
+      const float intensity = 1.0f - normalized_distance * normalized_distance;
+      total_light_color += light.color / 255.0f * intensity;
+    }
+  }
+  return total_light_color.cwiseMin(1.0f);
+}
+
+void accumulate_lightmap(const std::vector<PackedLight> &lights,
+                         const Eigen::Vector3f &ambient_light_color,
+                         const Eigen::AlignedBox2f &bounds,
+                         const Eigen::Vector2i resolution,
+                         std::vector<Eigen::Vector3f> &texels) {
+  texels.resize(static_cast<std::size_t>(resolution.x() * resolution.y()));
+  const Eigen::Vector2f texel_size =
+      bounds.sizes().cwiseQuotient(resolution.cast<float>());
+  for (int32_t y = 0; y < resolution.y(); ++y) {
+    for (int32_t x = 0; x < resolution.x(); ++x) {
+      const Eigen::Vector2f texel_center =
+          bounds.min() +
+          (Eigen::Vector2f{static_cast<float>(x), static_cast<float>(y)} +
+           Eigen::Vector2f::Constant(0.5f))
+              .cwiseProduct(texel_size);
+      texels[static_cast<std::size_t>(y * resolution.x() + x)] =
+          evaluate_lighting(lights, ambient_light_color, texel_center);
+    }
+  }
+}
+
+StaticLightmapCache::StaticLightmapCache(const float margin_scale)
+    : margin_scale_(margin_scale) {}
+
+bool StaticLightmapCache::update(
+    const std::vector<PackedLight> &static_lights,
+    const Eigen::Vector3f &static_ambient_light_color,
+    const Eigen::AlignedBox2f &viewport_bounds) {
+  const Eigen::Vector2f viewport_size = viewport_bounds.sizes();
+  // the viewport size is recomputed from the camera transform every frame, so
+  // allow for rounding noise while the camera pans
+  constexpr float viewport_size_tolerance{1e-4f};
+  if (is_valid_ &&
+      viewport_size.isApprox(viewport_size_, viewport_size_tolerance) &&
+      bounds_.contains(viewport_bounds) &&
+      static_ambient_light_color == static_ambient_light_color_ &&
+      are_lights_equal(static_lights, static_lights_) &&
+      are_polygons_equal(static_lights, static_light_polygons_)) {
+    return false;
+  }
+
+  is_valid_ = true;
+  static_lights_ = static_lights;
+  static_light_polygons_.resize(static_lights.size());
+  for (std::size_t i = 0; i < static_lights.size(); ++i) {
+    if (static_lights[i].visibility_polygon == nullptr) {
+      static_light_polygons_[i].clear();
+    } else {
+      static_light_polygons_[i] =
+          static_lights[i].visibility_polygon->get_vertices();
+    }
+  }
+  static_ambient_light_color_ = static_ambient_light_color;
+  viewport_size_ = viewport_size;
+  const Eigen::Vector2f half_size = viewport_size * margin_scale_ / 2.0f;
+  bounds_ = Eigen::AlignedBox2f{viewport_bounds.center() - half_size,
+                                viewport_bounds.center() + half_size};
+  return true;
+}
+
+} // namespace systems
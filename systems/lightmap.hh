@@ -0,0 +1,100 @@
+#pragma once
+#include "systems/light_binning.hh"
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <vector>
+
+namespace systems {
+
+/**
+ * @brief Light reaching a point from a set of lights
+ *
+ * CPU reference for the per-pixel loop in lighting.frag: quadratic falloff to
+ * zero at each light's radius, colors summed and clamped to 1. Points outside
+ * a light's visibility polygon get nothing from it.
+ *
+ * @param lights Circular lights to evaluate
+ * @param ambient_light_color Light added everywhere (0-255 range)
+ * @param world_position Point to evaluate the lighting at
+ * @return RGB light multiplier in 0-1 range
+ */
+[[nodiscard]] Eigen::Vector3f
+evaluate_lighting(const std::vector<PackedLight> &lights,
+                  const Eigen::Vector3f &ambient_light_color,
+                  const Eigen::Vector2f world_position);
+
+/**
+ * @brief Accumulate lights into a lightmap on the CPU
+ *
+ * Produces the same texels the GPU bake renders: texel (x, y) is evaluated at
+ * its center and row 0 is at the minimum y of bounds.
+ *
+ * @param lights Circular lights to accumulate
+ * @param ambient_light_color Light added everywhere (0-255 range)
+ * @param bounds World space area covered by the lightmap
+ * @param resolution Number of texels along each axis
+ * @param[out] texels Resized to resolution.x() * resolution.y(), stored row by
+ * row
+ */
+void accumulate_lightmap(const std::vector<PackedLight> &lights,
+                         const Eigen::Vector3f &ambient_light_color,
+                         const Eigen::AlignedBox2f &bounds,
+                         const Eigen::Vector2i resolution,
+                         std::vector<Eigen::Vector3f> &texels);
+
+/**
+ * @brief Tracks when a cached lightmap of static lights must be baked again
+ *
+ * The lightmap covers a margin around the viewport so small camera movements
+ * reuse it. It is invalidated when the set of static lights or their
+ * visibility polygons change, the viewport leaves the cached area, or the
+ * viewport is resized (zoomed).
+ */
+class StaticLightmapCache {
+public:
+  /**
+   * @brief Construct a cache
+   * @param margin_scale Size of the cached area relative to the viewport
+   * @pre margin_scale >= 1.0f
+   */
+  explicit StaticLightmapCache(const float margin_scale = 2.0f);
+
+  /**
+   * @brief Check the current static lights and viewport against the cache
+   * @param static_lights Static circular lights this frame
+   * @param static_ambient_light_color Sum of static global lights this frame
+   * @param viewport_bounds Area currently visible
+   * @return True if the lightmap must be baked again
+   * @post If true is returned the cache holds the new lights and get_bounds()
+   * is centered on the viewport
+   */
+  [[nodiscard]] bool update(const std::vector<PackedLight> &static_lights,
+                            const Eigen::Vector3f &static_ambient_light_color,
+                            const Eigen::AlignedBox2f &viewport_bounds);
+
+  /**
+   * @brief Force the next update() to rebake, e.g. after losing the GPU copy
+   */
+  void invalidate() { is_valid_ = false; }
+
+  /**
+   * @brief Get the world space area covered by the cached lightmap
+   * @return Bounds of the lightmap, empty until the first update()
+   */
+  [[nodiscard]] const Eigen::AlignedBox2f &get_bounds() const {
+    return bounds_;
+  }
+
+private:
+  float margin_scale_;
+  bool is_valid_{false};
+  std::vector<PackedLight> static_lights_;
+  /// Copies of the static lights' polygon vertices, the lights only point at
+  /// polygons which are recomputed in place
+  std::vector<std::vector<Eigen::Vector2f>> static_light_polygons_;
+  Eigen::Vector3f static_ambient_light_color_{0.0f, 0.0f, 0.0f};
+  Eigen::Vector2f viewport_size_{0.0f, 0.0f};
+  Eigen::AlignedBox2f bounds_;
+};
+
+} // namespace systems
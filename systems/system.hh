@@ -3,6 +3,7 @@
 
 namespace view {
 class Screen;
+struct RenderSnapshot;
 }
 
 namespace model {
@@ -21,6 +22,15 @@ public:
     return Ok();
   }
 
+  /// Record what draw would draw so it can be drawn on another thread, see
+  /// view::RenderSnapshot::system_draws
+  /// @param[out] snapshot snapshot to append the draw to
+  /// @note records nothing by default, systems which draw must override this
+  /// as well to be visible when the controller runs pipelined
+  virtual Result<void, std::string> record_snapshot(view::RenderSnapshot& snapshot) {
+    return Ok();
+  }
+
   virtual std::string_view get_system_type_name() const = 0;
 };
 } // namespace systems
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "systems/light_binning.hh"
+#include <vector>
+
+using namespace systems;
+
+namespace {
+const Eigen::AlignedBox2f viewport_bounds{Eigen::Vector2f{0.0f, 0.0f},
+                                          Eigen::Vector2f{4.0f, 4.0f}};
+const Eigen::Vector2i tile_count{4, 4};
+
+PackedLight make_light(const Eigen::Vector2f position, const float radius) {
+  return PackedLight{position, radius, Eigen::Vector3f{255.0f, 255.0f, 255.0f}};
+}
+
+std::vector<uint32_t> get_tile_lights(const LightTileGrid &grid,
+                                      const Eigen::Vector2i tile) {
+  const auto tile_lights = grid.get_tile_lights(tile);
+  return {tile_lights.begin(), tile_lights.end()};
+}
+} // namespace
+
+TEST_CASE("Lights outside the viewport are culled", "[light_binning]") {
+  const std::vector<PackedLight> lights{
+      make_light({2.0f, 2.0f}, 0.5f),   // inside
+      make_light({-1.0f, 2.0f}, 0.5f),  // left of the viewport
+      make_light({-0.4f, 2.0f}, 0.5f),  // center outside but circle overlaps
+      make_light({5.0f, 5.0f}, 1.0f),   // misses the top right corner
+  };
+
+  std::vector<PackedLight> visible_lights;
+  cull_lights_to_bounds(lights, viewport_bounds, visible_lights);
+
+  REQUIRE(visible_lights.size() == 2U);
+  CHECK(visible_lights[0].position == Eigen::Vector2f{2.0f, 2.0f});
+  CHECK(visible_lights[1].position == Eigen::Vector2f{-0.4f, 2.0f});
+}
+
+TEST_CASE("Small light is binned into only its own tile",
+          "[light_binning]") {
+  const std::vector<PackedLight> lights{make_light({1.5f, 2.5f}, 0.25f)};
+
+  LightTileGrid grid;
+  bin_lights_into_tiles(lights, viewport_bounds, tile_count, grid);
+
+  CHECK(grid.tile_offsets.size() == 17U);
+  CHECK(grid.light_indices.size() == 1U);
+  CHECK(get_tile_lights(grid, {1, 2}) == std::vector<uint32_t>{0U});
+  CHECK(get_tile_lights(grid, {0, 0}).empty());
+  CHECK(get_tile_lights(grid, {3, 3}).empty());
+}
+
+TEST_CASE("Light is only binned into tiles its circle overlaps",
+          "[light_binning]") {
+  // centered on the corner shared by tiles (1, 1), (2, 1), (1, 2) and (2, 2),
+  // its bounding square touches the diagonal neighbours but the circle doesn't
+  const std::vector<PackedLight> lights{make_light({2.0f, 2.0f}, 1.1f)};
+
+  LightTileGrid grid;
+  bin_lights_into_tiles(lights, viewport_bounds, tile_count, grid);
+
+  CHECK(get_tile_lights(grid, {1, 1}).size() == 1U);
+  CHECK(get_tile_lights(grid, {2, 2}).size() == 1U);
+  CHECK(get_tile_lights(grid, {0, 2}).size() == 1U);
+  CHECK(get_tile_lights(grid, {2, 0}).size() == 1U);
+  CHECK(get_tile_lights(grid, {0, 0}).empty());
+  CHECK(get_tile_lights(grid, {3, 3}).empty());
+  CHECK(get_tile_lights(grid, {0, 3}).empty());
+  CHECK(grid.light_indices.size() == 12U);
+}
+
+TEST_CASE("Tile light lists keep lights in their original order",
+          "[light_binning]") {
+  const std::vector<PackedLight> lights{
+      make_light({0.5f, 0.5f}, 0.25f),
+      make_light({3.5f, 3.5f}, 0.25f),
+      make_light({0.6f, 0.4f}, 0.25f),
+  };
+
+  LightTileGrid grid;
+  bin_lights_into_tiles(lights, viewport_bounds, tile_count, grid);
+
+  CHECK(get_tile_lights(grid, {0, 0}) == std::vector<uint32_t>{0U, 2U});
+  CHECK(get_tile_lights(grid, {3, 3}) == std::vector<uint32_t>{1U});
+}
+
+TEST_CASE("Binning many lights bounds the work per tile", "[light_binning]") {
+  // a row of small lights along the bottom edge only lands in the bottom row
+  std::vector<PackedLight> lights;
+  for (int i = 0; i < 400; ++i) {
+    lights.push_back(make_light({0.01f * static_cast<float>(i), 0.2f}, 0.1f));
+  }
+
+  LightTileGrid grid;
+  bin_lights_into_tiles(lights, viewport_bounds, tile_count, grid);
+
+  for (int32_t x = 0; x < tile_count.x(); ++x) {
+    for (int32_t y = 1; y < tile_count.y(); ++y) {
+      CHECK(get_tile_lights(grid, {x, y}).empty());
+    }
+  }
+  std::size_t binned_count = 0U;
+  for (int32_t x = 0; x < tile_count.x(); ++x) {
+    binned_count += get_tile_lights(grid, {x, 0}).size();
+  }
+  CHECK(binned_count == grid.light_indices.size());
+  CHECK(binned_count >= lights.size());
+}
+
+TEST_CASE("Rebinning reuses the grid", "[light_binning]") {
+  LightTileGrid grid;
+  bin_lights_into_tiles({make_light({0.5f, 0.5f}, 0.25f)}, viewport_bounds,
+                        tile_count, grid);
+  bin_lights_into_tiles({}, viewport_bounds, tile_count, grid);
+
+  CHECK(grid.light_indices.empty());
+  CHECK(get_tile_lights(grid, {0, 0}).empty());
+}
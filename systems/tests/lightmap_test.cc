@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include "geometry/visibility_polygon.hh"
+#include "systems/lightmap.hh"
+#include <vector>
+
+using namespace systems;
+
+namespace {
+const Eigen::Vector3f no_ambient_light{0.0f, 0.0f, 0.0f};
+
+PackedLight make_light(const Eigen::Vector2f position, const float radius,
+                       const Eigen::Vector3f color = {255.0f, 255.0f,
+                                                      255.0f}) {
+  return PackedLight{position, radius, color};
+}
+
+bool is_close(const Eigen::Vector3f &actual, const Eigen::Vector3f &expected) {
+  return (actual - expected).cwiseAbs().maxCoeff() < 1e-5f;
+}
+} // namespace
+
+TEST_CASE("Light falls off quadratically to its radius", "[lightmap]") {
+  const std::vector<PackedLight> lights{make_light({0.0f, 0.0f}, 2.0f)};
+
+  CHECK(is_close(evaluate_lighting(lights, no_ambient_light, {0.0f, 0.0f}),
+                 {1.0f, 1.0f, 1.0f}));
+  CHECK(is_close(evaluate_lighting(lights, no_ambient_light, {1.0f, 0.0f}),
+                 {0.75f, 0.75f, 0.75f}));
+  CHECK(is_close(evaluate_lighting(lights, no_ambient_light, {0.0f, 2.0f}),
+                 {0.0f, 0.0f, 0.0f}));
+  CHECK(is_close(evaluate_lighting(lights, no_ambient_light, {3.0f, 3.0f}),
+                 {0.0f, 0.0f, 0.0f}));
+}
+
+TEST_CASE("Ambient and overlapping lights add and clamp", "[lightmap]") {
+  const std::vector<PackedLight> lights{
+      make_light({0.0f, 0.0f}, 1.0f, {255.0f, 0.0f, 0.0f}),
+      make_light({0.0f, 0.0f}, 1.0f, {255.0f, 51.0f, 0.0f}),
+  };
+  const Eigen::Vector3f ambient_light{0.0f, 0.0f, 102.0f};
+
+  CHECK(is_close(evaluate_lighting(lights, ambient_light, {0.0f, 0.0f}),
+                 {1.0f, 0.2f, 0.4f}));
+  CHECK(is_close(evaluate_lighting(lights, ambient_light, {5.0f, 0.0f}),
+                 {0.0f, 0.0f, 0.4f}));
+}
+
+TEST_CASE("Lightmap texels sample their centers row by row", "[lightmap]") {
+  const std::vector<PackedLight> lights{make_light({0.5f, 0.5f}, 1.0f)};
+  const Eigen::AlignedBox2f bounds{Eigen::Vector2f{0.0f, 0.0f},
+                                   Eigen::Vector2f{4.0f, 2.0f}};
+
+  std::vector<Eigen::Vector3f> texels;
+  accumulate_lightmap(lights, no_ambient_light, bounds, {4, 2}, texels);
+
+  REQUIRE(texels.size() == 8U);
+  // texel (0, 0) is centered on the light
+  CHECK(is_close(texels[0], {1.0f, 1.0f, 1.0f}));
+  // texel (1, 0) is centered at (1.5, 0.5), exactly one radius away
+  CHECK(is_close(texels[1], {0.0f, 0.0f, 0.0f}));
+  // texel (0, 1) is centered at (0.5, 1.5), also one radius away
+  CHECK(is_close(texels[4], {0.0f, 0.0f, 0.0f}));
+  // texel (3, 1) is centered at (3.5, 1.5), well outside the light
+  CHECK(is_close(texels[7], {0.0f, 0.0f, 0.0f}));
+}
+
+TEST_CASE("Static lightmap is only rebaked when needed", "[lightmap]") {
+  StaticLightmapCache cache{2.0f};
+  const Eigen::AlignedBox2f viewport{Eigen::Vector2f{-1.0f, -1.0f},
+                                     Eigen::Vector2f{1.0f, 1.0f}};
+  std::vector<PackedLight> static_lights{make_light({0.0f, 0.0f}, 1.0f)};
+
+  SECTION("First update always bakes") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    CHECK(cache.get_bounds().min() == Eigen::Vector2f{-2.0f, -2.0f});
+    CHECK(cache.get_bounds().max() == Eigen::Vector2f{2.0f, 2.0f});
+  }
+
+  SECTION("Unchanged lights and viewport reuse the lightmap") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    CHECK_FALSE(cache.update(static_lights, no_ambient_light, viewport));
+  }
+
+  SECTION("Panning within the baked area reuses the lightmap") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    const Eigen::AlignedBox2f panned{Eigen::Vector2f{-0.5f, -0.5f},
+                                     Eigen::Vector2f{1.5f, 1.5f}};
+    CHECK_FALSE(cache.update(static_lights, no_ambient_light, panned));
+  }
+
+  SECTION("Panning out of the baked area rebakes around the viewport") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    const Eigen::AlignedBox2f panned{Eigen::Vector2f{2.0f, -1.0f},
+                                     Eigen::Vector2f{4.0f, 1.0f}};
+    CHECK(cache.update(static_lights, no_ambient_light, panned));
+    CHECK(cache.get_bounds().min() == Eigen::Vector2f{1.0f, -2.0f});
+  }
+
+  SECTION("Zooming rebakes") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    const Eigen::AlignedBox2f zoomed{Eigen::Vector2f{-0.5f, -0.5f},
+                                     Eigen::Vector2f{0.5f, 0.5f}};
+    CHECK(cache.update(static_lights, no_ambient_light, zoomed));
+  }
+
+  SECTION("Changing static lights rebakes") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    static_lights.front().radius = 2.0f;
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    static_lights.push_back(make_light({1.0f, 1.0f}, 1.0f));
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    CHECK(cache.update(static_lights, {10.0f, 10.0f, 10.0f}, viewport));
+  }
+
+  SECTION("Invalidating rebakes") {
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+    cache.invalidate();
+    CHECK(cache.update(static_lights, no_ambient_light, viewport));
+  }
+}
+
+TEST_CASE("Occluded points get no light", "[lightmap]") {
+  std::vector<geometry::LineSegment> occluders;
+  geometry::append_box_edges(Eigen::AlignedBox2f{Eigen::Vector2f{0.5f, -0.5f},
+                                                 Eigen::Vector2f{0.6f, 0.5f}},
+                             Eigen::Vector2f::Zero(), occluders);
+  geometry::VisibilityPolygon visibility_polygon;
+  visibility_polygon.compute(Eigen::Vector2f::Zero(), 2.0f, occluders);
+
+  auto light = make_light({0.0f, 0.0f}, 2.0f);
+  light.visibility_polygon = &visibility_polygon;
+  const std::vector<PackedLight> lights{light};
+
+  CHECK(is_close(evaluate_lighting(lights, no_ambient_light, {-1.0f, 0.0f}),
+                 {0.75f, 0.75f, 0.75f}));
+  CHECK(is_close(evaluate_lighting(lights, no_ambient_light, {1.0f, 0.0f}),
+                 {0.0f, 0.0f, 0.0f}));
+}
+
+TEST_CASE("Static lightmap is rebaked when a visibility polygon changes",
+          "[lightmap]") {
+  StaticLightmapCache cache;
+  const Eigen::AlignedBox2f viewport{Eigen::Vector2f{-1.0f, -1.0f},
+                                     Eigen::Vector2f{1.0f, 1.0f}};
+
+  // lights point at polygons which are recomputed in place
+  geometry::VisibilityPolygon visibility_polygon;
+  visibility_polygon.compute(Eigen::Vector2f::Zero(), 2.0f, {});
+  auto light = make_light({0.0f, 0.0f}, 2.0f);
+  light.visibility_polygon = &visibility_polygon;
+  const std::vector<PackedLight> lights{light};
+
+  CHECK(cache.update(lights, no_ambient_light, viewport));
+  CHECK_FALSE(cache.update(lights, no_ambient_light, viewport));
+
+  std::vector<geometry::LineSegment> occluders;
+  geometry::append_box_edges(Eigen::AlignedBox2f{Eigen::Vector2f{0.5f, -0.5f},
+                                                 Eigen::Vector2f{0.6f, 0.5f}},
+                             Eigen::Vector2f::Zero(), occluders);
+  visibility_polygon.compute(Eigen::Vector2f::Zero(), 2.0f, occluders);
+  CHECK(cache.update(lights, no_ambient_light, viewport));
+  CHECK_FALSE(cache.update(lights, no_ambient_light, viewport));
+}
@@ -0,0 +1,36 @@
+#include "tools/games.hh"
+#include "lightmaze/lightmaze.hh"
+#include "shader_demo/shader_demo.hh"
+#include "snake/snake.hh"
+#include "tic/tic.hh"
+#include "wiz/wiz.hh"
+#include <array>
+
+namespace tools {
+
+std::span<const GameFactory> get_game_factories() {
+  static const std::array<GameFactory, 5> game_factories{{
+      {"lightmaze", lightmaze::make_lightmaze_game},
+      {"shader_demo", shader_demo::make_shader_demo_game},
+      {"snake", snake::make_snake_game},
+      {"tic", tic::make_tic_game},
+      {"wiz", wiz::make_wiz_game},
+  }};
+  return game_factories;
+}
+
+Result<const GameFactory *, std::string>
+find_game_factory(const std::string_view name) {
+  std::string known_names;
+  for (const auto &game_factory : get_game_factories()) {
+    if (game_factory.name == name) {
+      return Ok(&game_factory);
+    }
+    known_names += known_names.empty() ? "" : ", ";
+    known_names += game_factory.name;
+  }
+  return Err(std::string("Unknown game '") + std::string(name) +
+             "', expected one of: " + known_names);
+}
+
+} // namespace tools
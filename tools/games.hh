@@ -0,0 +1,28 @@
+#pragma once
+#include "model/game_state.hh"
+#include "utility/try.hh"
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace tools {
+
+/// Named factory creating a fully initialized game
+struct GameFactory {
+  std::string_view name;
+  std::function<Result<std::unique_ptr<model::GameState>, std::string>()>
+      make_game;
+};
+
+/// @return every game in the repository, in alphabetical order
+[[nodiscard]] std::span<const GameFactory> get_game_factories();
+
+/// Look up a game by name
+/// @param[in] name name as listed by get_game_factories
+/// @return factory for the game, error listing the known games otherwise
+[[nodiscard]] Result<const GameFactory *, std::string>
+find_game_factory(std::string_view name);
+
+} // namespace tools
@@ -0,0 +1,138 @@
+#include "tools/input_script.hh"
+#include <SFML/Window/Keyboard.hpp>
+#include <array>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string_view>
+
+namespace tools {
+namespace {
+std::optional<sf::Keyboard::Key> parse_key(const std::string_view name) {
+  if (name.size() == 1U && name[0] >= 'A' && name[0] <= 'Z') {
+    return static_cast<sf::Keyboard::Key>(sf::Keyboard::A + (name[0] - 'A'));
+  }
+  if (name.size() == 4U && name.starts_with("Num") && name[3] >= '0' &&
+      name[3] <= '9') {
+    return static_cast<sf::Keyboard::Key>(sf::Keyboard::Num0 +
+                                          (name[3] - '0'));
+  }
+  constexpr std::array<std::pair<std::string_view, sf::Keyboard::Key>, 7>
+      named_keys{{{"Space", sf::Keyboard::Space},
+                  {"Enter", sf::Keyboard::Enter},
+                  {"Escape", sf::Keyboard::Escape},
+                  {"Left", sf::Keyboard::Left},
+                  {"Right", sf::Keyboard::Right},
+                  {"Up", sf::Keyboard::Up},
+                  {"Down", sf::Keyboard::Down}}};
+  for (const auto &[key_name, key] : named_keys) {
+    if (key_name == name) {
+      return key;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<view::MouseButton> parse_button(const std::string_view name) {
+  if (name == "left") {
+    return view::MouseButton::Left;
+  }
+  if (name == "right") {
+    return view::MouseButton::Right;
+  }
+  if (name == "middle") {
+    return view::MouseButton::Middle;
+  }
+  return std::nullopt;
+}
+
+std::optional<view::EventType> parse_event(std::istringstream &line) {
+  std::string type;
+  line >> type;
+  if (type == "key_press" || type == "key_release") {
+    std::string key_name;
+    line >> key_name;
+    const auto maybe_key = parse_key(key_name);
+    if (!line || !maybe_key.has_value()) {
+      return std::nullopt;
+    }
+    sf::Event::KeyEvent key_event{};
+    key_event.code = maybe_key.value();
+    if (type == "key_press") {
+      return view::KeyPressedEvent{key_event};
+    }
+    return view::KeyReleasedEvent{key_event};
+  }
+  if (type == "mouse_down" || type == "mouse_up") {
+    std::string button_name;
+    Eigen::Vector2f position;
+    line >> button_name >> position.x() >> position.y();
+    const auto maybe_button = parse_button(button_name);
+    if (!line || !maybe_button.has_value()) {
+      return std::nullopt;
+    }
+    if (type == "mouse_down") {
+      return view::MouseDownEvent{maybe_button.value(), position};
+    }
+    return view::MouseUpEvent{maybe_button.value(), position};
+  }
+  if (type == "mouse_move") {
+    Eigen::Vector2f position;
+    line >> position.x() >> position.y();
+    if (!line) {
+      return std::nullopt;
+    }
+    return view::MouseMovedEvent{position};
+  }
+  if (type == "scroll") {
+    float delta;
+    Eigen::Vector2f position;
+    line >> delta >> position.x() >> position.y();
+    if (!line) {
+      return std::nullopt;
+    }
+    return view::MouseScrollEvent{delta, position};
+  }
+  return std::nullopt;
+}
+} // namespace
+
+Result<std::vector<ScriptedEvent>, std::string>
+parse_input_script(std::istream &input) {
+  std::vector<ScriptedEvent> events;
+  std::string line;
+  for (uint64_t line_number = 1U; std::getline(input, line); ++line_number) {
+    const auto first = line.find_first_not_of(" \t");
+    if (first == std::string::npos || line[first] == '#') {
+      continue;
+    }
+
+    std::istringstream line_stream(line);
+    uint64_t tick;
+    line_stream >> tick;
+    const auto maybe_event =
+        line_stream ? parse_event(line_stream) : std::nullopt;
+    std::string trailing;
+    if (!maybe_event.has_value() || (line_stream >> trailing)) {
+      return Err(std::string("Invalid input script line ") +
+                 std::to_string(line_number) + ": " + line);
+    }
+    if (!events.empty() && tick < events.back().tick) {
+      return Err(std::string("Input script ticks go backwards on line ") +
+                 std::to_string(line_number) + ": " + line);
+    }
+    events.push_back(ScriptedEvent{tick, maybe_event.value()});
+  }
+  return Ok(std::move(events));
+}
+
+Result<std::vector<ScriptedEvent>, std::string>
+load_input_script(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return Err(std::string("Failed to open input script: ") + path.string());
+  }
+  return parse_input_script(file);
+}
+
+} // namespace tools
@@ -0,0 +1,47 @@
+#pragma once
+#include "controller/input_recording.hh"
+#include "utility/try.hh"
+#include "view/screen.hh"
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace tools {
+
+/// Event to hand to the game state before a given simulation step, the same
+/// as a recorded event
+using ScriptedEvent = controller::TickedEvent;
+
+/**
+ * @brief Parse a text script of input events
+ *
+ * Each non empty line not starting with # is one event, in non decreasing
+ * tick order:
+ *
+ *     <tick> key_press <key>
+ *     <tick> key_release <key>
+ *     <tick> mouse_down <left|right|middle> <x> <y>
+ *     <tick> mouse_up <left|right|middle> <x> <y>
+ *     <tick> mouse_move <x> <y>
+ *     <tick> scroll <delta> <x> <y>
+ *
+ * Keys are named like sf::Keyboard keys: A-Z, Num0-Num9, Space, Enter,
+ * Escape, Left, Right, Up and Down. Positions are in game meters.
+ *
+ * @param input text to parse
+ * @return events in file order, error naming the first bad line
+ */
+[[nodiscard]] Result<std::vector<ScriptedEvent>, std::string>
+parse_input_script(std::istream &input);
+
+/**
+ * @brief Read and parse an input script file, see parse_input_script
+ * @param path script to read
+ * @return events in file order, error if the file can't be read or parsed
+ */
+[[nodiscard]] Result<std::vector<ScriptedEvent>, std::string>
+load_input_script(const std::filesystem::path &path);
+
+} // namespace tools
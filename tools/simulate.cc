@@ -0,0 +1,249 @@
+#include "tools/games.hh"
+#include "tools/input_script.hh"
+#include "utility/allocation_tracker.hh"
+#include "utility/profiler.hh"
+#include "utility/random.hh"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+struct Options {
+  std::string game;
+  std::optional<uint64_t> maybe_tick_count;
+  std::optional<std::chrono::nanoseconds> maybe_step;
+  std::optional<uint32_t> maybe_seed;
+  std::optional<std::string> maybe_script_path;
+  std::optional<std::string> maybe_replay_path;
+  std::optional<std::string> maybe_profile_trace_path;
+};
+
+/// Everything the run needs once the options and input files are resolved
+struct Workload {
+  uint64_t tick_count;
+  std::chrono::nanoseconds step;
+  uint32_t seed;
+  std::vector<tools::ScriptedEvent> events;
+};
+
+template <typename Integer>
+Result<Integer, std::string> parse_integer(const std::string_view name,
+                                           const std::string_view value) {
+  Integer result{};
+  const auto [end, error] =
+      std::from_chars(value.data(), value.data() + value.size(), result);
+  if (error != std::errc{} || end != value.data() + value.size()) {
+    return Err(std::string("Invalid value for ") + std::string(name) + ": " +
+               std::string(value));
+  }
+  return Ok(result);
+}
+
+Result<Options, std::string> parse_options(const int argc, char **argv) {
+  Options options;
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    const auto equals = argument.find('=');
+    const auto name = argument.substr(0, equals);
+    const auto value = equals == std::string_view::npos
+                           ? std::string_view{}
+                           : argument.substr(equals + 1);
+    if (name == "--game") {
+      options.game = value;
+    } else if (name == "--ticks") {
+      options.maybe_tick_count = TRY(parse_integer<uint64_t>(name, value));
+    } else if (name == "--step_us") {
+      options.maybe_step =
+          std::chrono::microseconds{TRY(parse_integer<int64_t>(name, value))};
+    } else if (name == "--seed") {
+      options.maybe_seed = TRY(parse_integer<uint32_t>(name, value));
+    } else if (name == "--script") {
+      options.maybe_script_path = std::string(value);
+    } else if (name == "--replay") {
+      options.maybe_replay_path = std::string(value);
+    } else if (name == "--profile_trace") {
+      options.maybe_profile_trace_path = std::string(value);
+    } else {
+      return Err(std::string("Unknown argument: ") + std::string(argument));
+    }
+  }
+  if (options.game.empty()) {
+    return Err(std::string("--game is required"));
+  }
+  if (options.maybe_step.has_value() && options.maybe_step->count() <= 0) {
+    return Err(std::string("--step_us must be positive"));
+  }
+  if (options.maybe_replay_path.has_value() &&
+      (options.maybe_script_path.has_value() || options.maybe_step.has_value() ||
+       options.maybe_seed.has_value())) {
+    return Err(std::string("--replay takes the input, step and seed from the "
+                           "recording, it can't be combined with --script, "
+                           "--step_us or --seed"));
+  }
+  return Ok(std::move(options));
+}
+
+Result<Workload, std::string> load_workload(const Options &options) {
+  if (options.maybe_replay_path.has_value()) {
+    auto recording = TRY(
+        controller::read_input_recording(options.maybe_replay_path.value()));
+    // by default run until the last recorded event has been handled
+    const uint64_t tick_count = options.maybe_tick_count.value_or(
+        recording.events.empty() ? 0U : recording.events.back().tick + 1U);
+    return Ok(Workload{.tick_count = tick_count,
+                       .step = recording.simulation_step,
+                       .seed = recording.rng_seed,
+                       .events = std::move(recording.events)});
+  }
+
+  Workload workload{
+      .tick_count = options.maybe_tick_count.value_or(3600U),
+      .step = options.maybe_step.value_or(std::chrono::microseconds{16667}),
+      // fixed by default so runs of different builds do the same work
+      .seed = options.maybe_seed.value_or(1U),
+      .events = {}};
+  if (options.maybe_script_path.has_value()) {
+    workload.events =
+        TRY(tools::load_input_script(options.maybe_script_path.value()));
+  }
+  return Ok(std::move(workload));
+}
+
+double to_microseconds(const std::chrono::nanoseconds duration,
+                       const uint64_t tick_count) {
+  return static_cast<double>(duration.count()) / 1e3 /
+         static_cast<double>(std::max<uint64_t>(tick_count, 1U));
+}
+
+Result<void, std::string> simulate(const Options &options) {
+  const auto *game_factory = TRY(tools::find_game_factory(options.game));
+  const auto workload = TRY(load_workload(options));
+
+  // the game draws its random numbers while it is created, so seed first
+  utility::seed_rng(workload.seed);
+  auto game_state_result = game_factory->make_game();
+  if (game_state_result.isErr()) {
+    return Err(game_state_result.unwrapErr());
+  }
+  const auto game_state = std::move(game_state_result).unwrap();
+  game_state->set_update_timings_enabled(true);
+  auto &profiler = utility::Profiler::get();
+  profiler.set_enabled(options.maybe_profile_trace_path.has_value());
+
+  uint64_t peak_entity_count = game_state->get_entity_count();
+  auto next_event = workload.events.begin();
+  const auto start_allocations = utility::get_thread_allocation_counts();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t tick = 0U; tick < workload.tick_count; ++tick) {
+    for (; next_event != workload.events.end() && next_event->tick == tick;
+         ++next_event) {
+      TRY_VOID(game_state->handle_event(next_event->event));
+    }
+    TRY_VOID(game_state->advance_state(workload.step.count()));
+    profiler.end_frame();
+    peak_entity_count =
+        std::max(peak_entity_count, game_state->get_entity_count());
+  }
+  const std::chrono::nanoseconds elapsed =
+      std::chrono::steady_clock::now() - start;
+  const auto allocations =
+      utility::get_thread_allocation_counts() - start_allocations;
+
+  const double elapsed_s = static_cast<double>(elapsed.count()) / 1e9;
+  const auto &timings = game_state->get_maybe_update_timings().value();
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "game:      " << game_factory->name << "\n"
+            << "seed:      " << workload.seed << "\n"
+            << "ticks:     " << workload.tick_count << " in " << elapsed_s
+            << " s\n"
+            << "ticks/s:   "
+            << static_cast<double>(workload.tick_count) / elapsed_s << "\n"
+            << "simulated: "
+            << static_cast<double>(workload.tick_count) *
+                   static_cast<double>(workload.step.count()) / 1e9
+            << " s\n";
+  if (utility::are_allocation_hooks_linked()) {
+    const auto tick_count = std::max<uint64_t>(workload.tick_count, 1U);
+    std::cout << "allocs:    "
+              << static_cast<double>(allocations.count) /
+                     static_cast<double>(tick_count)
+              << " per tick, "
+              << static_cast<double>(allocations.bytes) /
+                     static_cast<double>(tick_count)
+              << " bytes per tick\n";
+  }
+  std::cout << "\n";
+
+  std::cout << "mean time per tick (us):\n"
+            << "  " << std::left << std::setw(24) << "entity update"
+            << to_microseconds(timings.entity_update, timings.step_count)
+            << "\n";
+  for (const auto &[system_name, system_time] : timings.system_updates) {
+    std::cout << "  " << std::setw(24) << system_name
+              << to_microseconds(system_time, timings.step_count) << "\n";
+  }
+  std::cout << "  " << std::setw(24) << "late update"
+            << to_microseconds(timings.late_update, timings.step_count)
+            << "\n\n";
+
+  std::cout << "entities: " << game_state->get_entity_count() << " at end, "
+            << peak_entity_count << " peak\n";
+  for (const auto &[type_name, count] :
+       game_state->get_entity_counts_by_type()) {
+    std::cout << "  " << std::setw(24) << type_name << count << "\n";
+  }
+  if (model::is_cost_accounting_enabled) {
+    std::cout << "\nmean time per tick by type (us):\n";
+    for (const auto *table : {&game_state->get_entity_costs(),
+                              &game_state->get_component_costs()}) {
+      for (const auto &cost : table->get_costs_by_total()) {
+        std::cout << "  " << std::setw(24) << cost.type_name
+                  << to_microseconds(cost.get_total(), workload.tick_count)
+                  << "\n";
+      }
+    }
+  }
+  if (next_event != workload.events.end()) {
+    std::cout << "\n"
+              << std::distance(next_event, workload.events.end())
+              << " input events after the last tick were not handled\n";
+  }
+  if (options.maybe_profile_trace_path.has_value()) {
+    // only the last Profiler::max_frame_count ticks are kept
+    TRY_VOID(profiler.write_chrome_trace(
+        options.maybe_profile_trace_path.value()));
+    std::cout << "\nprofile of the last " << profiler.get_frames().size()
+              << " ticks written to "
+              << options.maybe_profile_trace_path.value() << "\n";
+  }
+  return Ok();
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto options_result = parse_options(argc, argv);
+  if (options_result.isErr()) {
+    std::cerr << options_result.unwrapErr() << "\n\nusage: simulate "
+              << "--game=<name> [--ticks=N] [--step_us=N] [--seed=N] "
+              << "[--script=path | --replay=path] [--profile_trace=path]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto result = simulate(options_result.unwrap());
+  if (result.isErr()) {
+    std::cerr << "Simulation failed with error: " << result.unwrapErr()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+#include "tools/input_script.hh"
+#include <sstream>
+
+using namespace tools;
+
+namespace {
+Result<std::vector<ScriptedEvent>, std::string>
+parse(const std::string &script) {
+  std::istringstream input(script);
+  return parse_input_script(input);
+}
+} // namespace
+
+TEST_CASE("Input scripts parse every event type", "[input_script]") {
+  const auto result = parse("# comment\n"
+                            "0 key_press W\n"
+                            "\n"
+                            "2 key_release Num3\n"
+                            "2 mouse_down left 1.5 -2\n"
+                            "3 mouse_up right 0 0\n"
+                            "4 mouse_move 0.25 0.5\n"
+                            "5 scroll -1 2 3\n");
+  REQUIRE(result.isOk());
+  const auto &events = result.unwrap();
+  REQUIRE(events.size() == 6U);
+
+  CHECK(events[0].tick == 0U);
+  REQUIRE(std::holds_alternative<view::KeyPressedEvent>(events[0].event));
+  CHECK(std::get<view::KeyPressedEvent>(events[0].event).key_event.code ==
+        sf::Keyboard::W);
+
+  CHECK(events[1].tick == 2U);
+  REQUIRE(std::holds_alternative<view::KeyReleasedEvent>(events[1].event));
+  CHECK(std::get<view::KeyReleasedEvent>(events[1].event).key_event.code ==
+        sf::Keyboard::Num3);
+
+  REQUIRE(std::holds_alternative<view::MouseDownEvent>(events[2].event));
+  const auto &mouse_down = std::get<view::MouseDownEvent>(events[2].event);
+  CHECK(mouse_down.button == view::MouseButton::Left);
+  CHECK(mouse_down.position == Eigen::Vector2f{1.5f, -2.f});
+
+  REQUIRE(std::holds_alternative<view::MouseUpEvent>(events[3].event));
+  CHECK(std::get<view::MouseUpEvent>(events[3].event).button ==
+        view::MouseButton::Right);
+
+  REQUIRE(std::holds_alternative<view::MouseMovedEvent>(events[4].event));
+  CHECK(std::get<view::MouseMovedEvent>(events[4].event).position ==
+        Eigen::Vector2f{0.25f, 0.5f});
+
+  REQUIRE(std::holds_alternative<view::MouseScrollEvent>(events[5].event));
+  CHECK(std::get<view::MouseScrollEvent>(events[5].event).delta == -1.f);
+}
+
+TEST_CASE("Invalid input scripts are rejected", "[input_script]") {
+  CHECK(parse("0 key_press Banana\n").isErr());
+  CHECK(parse("0 mouse_move 1\n").isErr());
+  CHECK(parse("0 key_press W extra\n").isErr());
+  CHECK(parse("jump\n").isErr());
+  CHECK(parse("5 key_press W\n4 key_press A\n").isErr());
+}
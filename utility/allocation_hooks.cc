@@ -0,0 +1,103 @@
+// Replaces the global operator new and delete so every heap allocation is
+// counted by utility/allocation_tracker.hh. Only linked into binaries which
+// opt in, see the allocation_hooks target.
+#include "utility/allocation_tracker.hh"
+#include <cstdlib>
+#include <new>
+
+namespace {
+void *allocate(const std::size_t size) {
+  utility::record_allocation(size);
+  // malloc(0) may return nullptr, which operator new must not
+  return std::malloc(size == 0U ? 1U : size);
+}
+
+void *allocate_aligned(const std::size_t size,
+                       const std::align_val_t alignment) {
+  utility::record_allocation(size);
+  const auto alignment_bytes = static_cast<std::size_t>(alignment);
+  // aligned_alloc needs the size to be a multiple of the alignment
+  const std::size_t padded_size =
+      (size + alignment_bytes - 1U) / alignment_bytes * alignment_bytes;
+  return std::aligned_alloc(alignment_bytes,
+                            padded_size == 0U ? alignment_bytes : padded_size);
+}
+
+void *allocate_or_throw(const std::size_t size) {
+  if (void *pointer = allocate(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void *allocate_aligned_or_throw(const std::size_t size,
+                                const std::align_val_t alignment) {
+  if (void *pointer = allocate_aligned(size, alignment)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+[[maybe_unused]] const bool is_registered = []() {
+  utility::set_allocation_hooks_linked();
+  return true;
+}();
+} // namespace
+
+void *operator new(std::size_t size) { return allocate_or_throw(size); }
+void *operator new[](std::size_t size) { return allocate_or_throw(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate_aligned_or_throw(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate_aligned_or_throw(size, alignment);
+}
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  return allocate_aligned(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  return allocate_aligned(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
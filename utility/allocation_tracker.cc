@@ -0,0 +1,36 @@
+#include "utility/allocation_tracker.hh"
+#include <atomic>
+
+namespace utility {
+namespace {
+// trivially constructed so reading them from inside operator new never
+// allocates
+thread_local AllocationCounts t_allocation_counts;
+std::atomic<uint64_t> process_allocation_count{0U};
+std::atomic<uint64_t> process_allocation_bytes{0U};
+std::atomic<bool> are_hooks_linked{false};
+} // namespace
+
+bool are_allocation_hooks_linked() {
+  return are_hooks_linked.load(std::memory_order_relaxed);
+}
+
+AllocationCounts get_thread_allocation_counts() { return t_allocation_counts; }
+
+AllocationCounts get_process_allocation_counts() {
+  return {.count = process_allocation_count.load(std::memory_order_relaxed),
+          .bytes = process_allocation_bytes.load(std::memory_order_relaxed)};
+}
+
+void record_allocation(const std::size_t size) {
+  ++t_allocation_counts.count;
+  t_allocation_counts.bytes += size;
+  process_allocation_count.fetch_add(1U, std::memory_order_relaxed);
+  process_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void set_allocation_hooks_linked() {
+  are_hooks_linked.store(true, std::memory_order_relaxed);
+}
+
+} // namespace utility
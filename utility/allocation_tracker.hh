@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace utility {
+
+/**
+ * @brief Number and total size of heap allocations
+ */
+struct AllocationCounts {
+  uint64_t count{0U};
+  uint64_t bytes{0U};
+
+  [[nodiscard]] AllocationCounts
+  operator-(const AllocationCounts &other) const {
+    return {.count = count - other.count, .bytes = bytes - other.bytes};
+  }
+};
+
+/**
+ * @brief Check if the global operator new hooks from //utility:allocation_hooks
+ * are linked in
+ *
+ * Allocations are only counted when they are, otherwise every count stays 0.
+ *
+ * @return true if allocations are counted
+ */
+[[nodiscard]] bool are_allocation_hooks_linked();
+
+/**
+ * @brief Get the allocations made by the calling thread
+ *
+ * Cheap enough to read around any scope, subtract two readings to get the
+ * allocations in between.
+ *
+ * @return allocations since the thread started
+ */
+[[nodiscard]] AllocationCounts get_thread_allocation_counts();
+
+/**
+ * @brief Get the allocations made by every thread
+ * @return allocations since the process started
+ */
+[[nodiscard]] AllocationCounts get_process_allocation_counts();
+
+/**
+ * @brief Count one allocation on the calling thread
+ * @note only for the operator new hooks, must not allocate
+ * @param size requested size in bytes
+ */
+void record_allocation(const std::size_t size);
+
+/**
+ * @brief Mark the operator new hooks as linked in
+ * @note only for the operator new hooks
+ */
+void set_allocation_hooks_linked();
+
+} // namespace utility
@@ -0,0 +1,325 @@
+#include "utility/profiler.hh"
+#include "utility/spsc_queue.hh"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#if defined(PROFILER_USE_RDTSC) && defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace utility {
+namespace {
+#if defined(PROFILER_USE_RDTSC) && defined(__x86_64__)
+int64_t read_steady_clock_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Time stamp counter ticks per nanosecond, measured once against the steady
+/// clock
+double get_ticks_per_ns() {
+  static const double ticks_per_ns = []() {
+    const int64_t start_ns = read_steady_clock_ns();
+    const auto start_ticks = static_cast<int64_t>(__rdtsc());
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto end_ticks = static_cast<int64_t>(__rdtsc());
+    const int64_t end_ns = read_steady_clock_ns();
+    return static_cast<double>(end_ticks - start_ticks) /
+           static_cast<double>(end_ns - start_ns);
+  }();
+  return ticks_per_ns;
+}
+#endif
+
+constexpr std::string_view no_zone_name{"(no zone)"};
+
+void append_json_string(std::string &output, const std::string_view value) {
+  output += '"';
+  for (const char character : value) {
+    if (character == '"' || character == '\\') {
+      output += '\\';
+    }
+    output += character;
+  }
+  output += '"';
+}
+} // namespace
+
+int64_t profiler_now_ticks() {
+#if defined(PROFILER_USE_RDTSC) && defined(__x86_64__)
+  return static_cast<int64_t>(__rdtsc());
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+int64_t profiler_ticks_to_ns(const int64_t ticks) {
+#if defined(PROFILER_USE_RDTSC) && defined(__x86_64__)
+  return static_cast<int64_t>(static_cast<double>(ticks) / get_ticks_per_ns());
+#else
+  return ticks;
+#endif
+}
+
+struct Profiler::ThreadBuffer {
+  /// Written by the owning thread, drained by end_frame
+  SpscQueue<ProfileZone, zones_per_thread> zones;
+  uint32_t thread_index{0U};
+  /// Zones currently open on the owning thread, only touched by that thread
+  uint16_t depth{0U};
+  std::atomic<uint64_t> dropped_zone_count{0U};
+  /// Guarded by thread_buffers_mutex_
+  std::string name;
+};
+
+Profiler &Profiler::get() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler()
+    : epoch_ticks_(profiler_now_ticks()), last_frame_end_ticks_(epoch_ticks_),
+      last_frame_end_allocations_(get_process_allocation_counts()) {
+  // calibrates the time stamp counter now rather than inside the first zone
+  static_cast<void>(profiler_ticks_to_ns(0));
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::set_enabled(const bool is_enabled) {
+  if (is_enabled && !is_enabled_.load(std::memory_order_relaxed)) {
+    // the first frame shouldn't include the time profiling was off
+    last_frame_end_ticks_ = profiler_now_ticks();
+    last_frame_end_allocations_ = get_process_allocation_counts();
+  }
+  is_enabled_.store(is_enabled, std::memory_order_relaxed);
+}
+
+void Profiler::set_thread_name(std::string name) {
+  auto &thread_buffer = get_thread_buffer();
+  std::lock_guard lock(thread_buffers_mutex_);
+  thread_buffer.name = std::move(name);
+}
+
+Profiler::ThreadBuffer &Profiler::get_thread_buffer() {
+  // set on the calling thread's first zone
+  thread_local ThreadBuffer *t_thread_buffer{nullptr};
+  if (t_thread_buffer == nullptr) {
+    auto thread_buffer = std::make_unique<ThreadBuffer>();
+    std::lock_guard lock(thread_buffers_mutex_);
+    thread_buffer->thread_index =
+        static_cast<uint32_t>(thread_buffers_.size());
+    thread_buffer->name =
+        "thread " + std::to_string(thread_buffer->thread_index);
+    t_thread_buffer = thread_buffer.get();
+    thread_buffers_.push_back(std::move(thread_buffer));
+  }
+  return *t_thread_buffer;
+}
+
+Profiler::ThreadBuffer *Profiler::begin_zone() {
+  auto &thread_buffer = get_thread_buffer();
+  ++thread_buffer.depth;
+  return &thread_buffer;
+}
+
+void Profiler::end_zone(ThreadBuffer &thread_buffer,
+                        const std::string_view name,
+                        const int64_t start_ticks,
+                        const AllocationCounts &start_allocations) {
+  const int64_t end_ticks = profiler_now_ticks();
+  const AllocationCounts end_allocations = get_thread_allocation_counts();
+  --thread_buffer.depth;
+  const ProfileZone zone{
+      .name = name,
+      .start_ns = profiler_ticks_to_ns(start_ticks - epoch_ticks_),
+      .end_ns = profiler_ticks_to_ns(end_ticks - epoch_ticks_),
+      .thread_index = thread_buffer.thread_index,
+      .depth = thread_buffer.depth,
+      .allocations = end_allocations - start_allocations,
+  };
+  if (!thread_buffer.zones.try_push(zone)) {
+    thread_buffer.dropped_zone_count.fetch_add(1U, std::memory_order_relaxed);
+  }
+}
+
+void Profiler::end_frame() {
+  if (!is_enabled()) {
+    return;
+  }
+  const int64_t frame_end_ticks = profiler_now_ticks();
+  const AllocationCounts frame_end_allocations =
+      get_process_allocation_counts();
+  ProfileFrame frame{
+      .start_ns = profiler_ticks_to_ns(last_frame_end_ticks_ - epoch_ticks_),
+      .end_ns = profiler_ticks_to_ns(frame_end_ticks - epoch_ticks_),
+      .zones = {},
+      .allocations = frame_end_allocations - last_frame_end_allocations_,
+  };
+  last_frame_end_ticks_ = frame_end_ticks;
+  last_frame_end_allocations_ = frame_end_allocations;
+
+  {
+    std::lock_guard lock(thread_buffers_mutex_);
+    for (const auto &thread_buffer : thread_buffers_) {
+      while (auto maybe_zone = thread_buffer->zones.try_pop()) {
+        frame.zones.push_back(maybe_zone.value());
+      }
+    }
+  }
+  // the buffers are drained while paused too so they don't overflow
+  if (is_paused_) {
+    return;
+  }
+
+  std::ranges::sort(frame.zones, [](const ProfileZone &a,
+                                    const ProfileZone &b) {
+    if (a.thread_index != b.thread_index) {
+      return a.thread_index < b.thread_index;
+    }
+    // an enclosing zone may start on the same tick as its first child
+    return a.start_ns != b.start_ns ? a.start_ns < b.start_ns
+                                    : a.depth < b.depth;
+  });
+  frames_.push_back(std::move(frame));
+  if (frames_.size() > max_frame_count) {
+    frames_.pop_front();
+  }
+}
+
+std::vector<std::string> Profiler::get_thread_names() const {
+  std::lock_guard lock(thread_buffers_mutex_);
+  std::vector<std::string> names;
+  names.reserve(thread_buffers_.size());
+  for (const auto &thread_buffer : thread_buffers_) {
+    names.push_back(thread_buffer->name);
+  }
+  return names;
+}
+
+uint64_t Profiler::get_dropped_zone_count() const {
+  std::lock_guard lock(thread_buffers_mutex_);
+  uint64_t dropped_zone_count = 0U;
+  for (const auto &thread_buffer : thread_buffers_) {
+    dropped_zone_count +=
+        thread_buffer->dropped_zone_count.load(std::memory_order_relaxed);
+  }
+  return dropped_zone_count;
+}
+
+void Profiler::clear() { frames_.clear(); }
+
+std::vector<std::pair<std::string_view, AllocationCounts>>
+get_allocations_by_zone(const ProfileFrame &frame) {
+  // start from each zone's own allocations, then move what its nested zones
+  // made out of it
+  std::vector<AllocationCounts> self_allocations;
+  self_allocations.reserve(frame.zones.size());
+  std::vector<std::size_t> open_zones;
+  for (std::size_t index = 0U; index < frame.zones.size(); ++index) {
+    const auto &zone = frame.zones[index];
+    self_allocations.push_back(zone.allocations);
+    // zones are sorted by thread then start, so the enclosing zone is the
+    // innermost earlier one on the same thread which hasn't ended yet
+    while (!open_zones.empty()) {
+      const auto &open_zone = frame.zones[open_zones.back()];
+      if (open_zone.thread_index == zone.thread_index &&
+          open_zone.depth < zone.depth && open_zone.end_ns >= zone.end_ns) {
+        break;
+      }
+      open_zones.pop_back();
+    }
+    if (!open_zones.empty()) {
+      auto &parent = self_allocations[open_zones.back()];
+      parent = parent - zone.allocations;
+    }
+    open_zones.push_back(index);
+  }
+
+  std::vector<std::pair<std::string_view, AllocationCounts>> totals;
+  AllocationCounts in_zones;
+  for (std::size_t index = 0U; index < frame.zones.size(); ++index) {
+    const auto name = frame.zones[index].name;
+    auto it = std::ranges::find_if(totals, [&](const auto &name_and_counts) {
+      return name_and_counts.first == name;
+    });
+    if (it == totals.end()) {
+      it = totals.emplace(totals.end(), name, AllocationCounts{});
+    }
+    auto &total = it->second;
+    total.count += self_allocations[index].count;
+    total.bytes += self_allocations[index].bytes;
+    in_zones.count += self_allocations[index].count;
+    in_zones.bytes += self_allocations[index].bytes;
+  }
+  // zones which spanned the end of the frame can count more than the frame
+  if (frame.allocations.count > in_zones.count) {
+    totals.emplace_back(no_zone_name, frame.allocations - in_zones);
+  }
+  std::ranges::stable_sort(totals, std::ranges::greater{},
+                           [](const auto &name_and_counts) {
+                             return name_and_counts.second.count;
+                           });
+  return totals;
+}
+
+Result<void, std::string>
+Profiler::write_chrome_trace(const std::filesystem::path &path) const {
+  // trace event format: complete ("X") events with microsecond times, plus
+  // metadata events naming the threads
+  std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool is_first_event = true;
+  const auto start_event = [&]() {
+    if (!is_first_event) {
+      output += ",\n";
+    }
+    is_first_event = false;
+  };
+
+  const auto thread_names = get_thread_names();
+  for (std::size_t index = 0U; index < thread_names.size(); ++index) {
+    start_event();
+    output += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" +
+              std::to_string(index) + ",\"args\":{\"name\":";
+    append_json_string(output, thread_names[index]);
+    output += "}}";
+  }
+
+  for (const auto &frame : frames_) {
+    for (const auto &zone : frame.zones) {
+      start_event();
+      output += "{\"ph\":\"X\",\"name\":";
+      append_json_string(output, zone.name);
+      const double duration_us = (zone.end_ns - zone.start_ns) / 1e3;
+      output += ",\"pid\":0,\"tid\":" + std::to_string(zone.thread_index) +
+                ",\"ts\":" + std::to_string(zone.start_ns / 1e3) +
+                ",\"dur\":" + std::to_string(duration_us);
+      if (are_allocation_hooks_linked()) {
+        output += ",\"args\":{\"allocations\":" +
+                  std::to_string(zone.allocations.count) +
+                  ",\"allocated_bytes\":" +
+                  std::to_string(zone.allocations.bytes) + "}";
+      }
+      output += "}";
+    }
+  }
+  output += "]}\n";
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return Err(std::string("Failed to open profile trace file: ") +
+               path.string());
+  }
+  file << output;
+  if (!file.good()) {
+    return Err(std::string("Failed to write profile trace file: ") +
+               path.string());
+  }
+  return Ok();
+}
+
+} // namespace utility
@@ -0,0 +1,259 @@
+#pragma once
+#include "utility/allocation_tracker.hh"
+#include "utility/try.hh"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace utility {
+
+/**
+ * @brief Read the profiler clock
+ *
+ * Uses the time stamp counter when built with PROFILER_USE_RDTSC on x86-64,
+ * std::chrono::steady_clock otherwise.
+ *
+ * @return ticks since an arbitrary point, convert with profiler_ticks_to_ns
+ */
+[[nodiscard]] int64_t profiler_now_ticks();
+
+/**
+ * @brief Convert a difference of profiler_now_ticks() values to nanoseconds
+ * @param ticks tick count to convert
+ * @return duration in nanoseconds
+ */
+[[nodiscard]] int64_t profiler_ticks_to_ns(const int64_t ticks);
+
+/**
+ * @brief A timed scope on one thread
+ */
+struct ProfileZone {
+  /// Name given to the scope, must outlive the profiler (e.g. a literal)
+  std::string_view name;
+  /// Start and end in nanoseconds since the profiler was created
+  int64_t start_ns{0};
+  int64_t end_ns{0};
+  /// Index of the thread the zone ran on, see Profiler::get_thread_names
+  uint32_t thread_index{0U};
+  /// Number of zones this one is nested in
+  uint16_t depth{0U};
+  /// Heap allocations made inside the zone, including nested zones, only
+  /// counted when the allocation hooks are linked in
+  AllocationCounts allocations;
+};
+
+/**
+ * @brief Zones collected between two Profiler::end_frame calls
+ */
+struct ProfileFrame {
+  int64_t start_ns{0};
+  int64_t end_ns{0};
+  /// Sorted by thread, then by start time so parents come before children
+  std::vector<ProfileZone> zones;
+  /// Heap allocations made by every thread during the frame
+  AllocationCounts allocations;
+};
+
+/**
+ * @brief Attribute the allocations of a frame to the zones they were made in
+ *
+ * Allocations made in a nested zone are attributed to that zone rather than
+ * to its parents, and allocations made outside of every zone are attributed
+ * to "(no zone)".
+ *
+ * @param frame frame to summarize
+ * @return zone names and allocations, most allocations first
+ */
+[[nodiscard]] std::vector<std::pair<std::string_view, AllocationCounts>>
+get_allocations_by_zone(const ProfileFrame &frame);
+
+/**
+ * @brief Process wide collector for ProfileScope zones
+ *
+ * Every thread writes finished zones to its own lock-free ring buffer, so
+ * recording a zone never waits on other threads. end_frame(), called once per
+ * rendered frame, drains the buffers into a ProfileFrame and keeps the last
+ * max_frame_count frames for the overlay and for trace export.
+ *
+ * Profiling is off until set_enabled(true); disabled zones only check a flag.
+ */
+class Profiler {
+public:
+  /// Frames kept for inspection, about two seconds at 60 FPS
+  static constexpr std::size_t max_frame_count{120UL};
+  /// Zones a thread can record between two end_frame calls before zones are
+  /// dropped
+  static constexpr std::size_t zones_per_thread{1UL << 15U};
+
+  /**
+   * @brief Get the process wide profiler
+   * @return Profiler shared by every ProfileScope
+   */
+  [[nodiscard]] static Profiler &get();
+
+  /**
+   * @brief Start or stop recording zones
+   * @param is_enabled true to record zones
+   */
+  void set_enabled(const bool is_enabled);
+
+  /**
+   * @brief Check if zones are recorded, cheap enough to call per zone
+   * @return true if zones are recorded
+   */
+  [[nodiscard]] bool is_enabled() const {
+    return is_enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Stop adding frames to the history while still draining the thread
+   * buffers, so a slow frame can be inspected
+   * @param is_paused true to keep the current history
+   */
+  void set_paused(const bool is_paused) { is_paused_ = is_paused; }
+
+  [[nodiscard]] bool is_paused() const { return is_paused_; }
+
+  /**
+   * @brief Name the calling thread in the overlay and in exported traces
+   * @param name thread name, e.g. "simulation"
+   */
+  void set_thread_name(std::string name);
+
+  /**
+   * @brief Collect the zones finished since the last call into a new frame
+   * @post The oldest frame is dropped once max_frame_count are kept
+   * @note Call from one thread only, normally the render loop
+   */
+  void end_frame();
+
+  /**
+   * @brief Get the collected frames
+   * @return Frames, oldest first
+   * @pre Called on the thread calling end_frame
+   */
+  [[nodiscard]] const std::deque<ProfileFrame> &get_frames() const {
+    return frames_;
+  }
+
+  /**
+   * @brief Get the names of every thread that recorded a zone
+   * @return Names indexed by ProfileZone::thread_index
+   */
+  [[nodiscard]] std::vector<std::string> get_thread_names() const;
+
+  /**
+   * @brief Get the number of zones dropped because a thread buffer was full
+   * @return Dropped zones since the profiler was created
+   */
+  [[nodiscard]] uint64_t get_dropped_zone_count() const;
+
+  /**
+   * @brief Drop every collected frame
+   */
+  void clear();
+
+  /**
+   * @brief Write the collected frames as a Chrome trace
+   *
+   * The file opens in chrome://tracing, Perfetto or Speedscope.
+   *
+   * @param path file to write
+   * @return error if the file can't be written
+   */
+  [[nodiscard]] Result<void, std::string>
+  write_chrome_trace(const std::filesystem::path &path) const;
+
+private:
+  friend class ProfileScope;
+
+  struct ThreadBuffer;
+
+  Profiler();
+  ~Profiler();
+
+  /**
+   * @brief Get the calling thread's buffer, registering it on first use
+   */
+  [[nodiscard]] ThreadBuffer &get_thread_buffer();
+
+  /**
+   * @brief Open a zone on the calling thread
+   * @return buffer to pass to end_zone
+   */
+  [[nodiscard]] ThreadBuffer *begin_zone();
+
+  /**
+   * @brief Close the innermost open zone on the calling thread
+   */
+  void end_zone(ThreadBuffer &thread_buffer, const std::string_view name,
+                const int64_t start_ticks,
+                const AllocationCounts &start_allocations);
+
+  std::atomic<bool> is_enabled_{false};
+  bool is_paused_{false};
+  const int64_t epoch_ticks_;
+  int64_t last_frame_end_ticks_;
+  AllocationCounts last_frame_end_allocations_;
+  std::deque<ProfileFrame> frames_;
+
+  /// Guards registering threads, buffers are never removed so zones can use
+  /// them without the lock
+  mutable std::mutex thread_buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+};
+
+/**
+ * @brief Records the time between construction and destruction as a zone
+ *
+ * Use through PROFILE_SCOPE rather than directly.
+ */
+class ProfileScope {
+public:
+  /**
+   * @param name zone name, must outlive the profiler, e.g. a literal or an
+   * entity_type_name constant
+   */
+  explicit ProfileScope(const std::string_view name) : name_(name) {
+    auto &profiler = Profiler::get();
+    if (profiler.is_enabled()) {
+      thread_buffer_ = profiler.begin_zone();
+      start_allocations_ = get_thread_allocation_counts();
+      start_ticks_ = profiler_now_ticks();
+    }
+  }
+
+  ~ProfileScope() {
+    if (thread_buffer_ != nullptr) {
+      Profiler::get().end_zone(*thread_buffer_, name_, start_ticks_,
+                               start_allocations_);
+    }
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  std::string_view name_;
+  Profiler::ThreadBuffer *thread_buffer_{nullptr};
+  int64_t start_ticks_{0};
+  AllocationCounts start_allocations_;
+};
+
+} // namespace utility
+
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+
+/// Time the rest of the enclosing scope as a zone called name
+#define PROFILE_SCOPE(name)                                                    \
+  const ::utility::ProfileScope PROFILE_SCOPE_CONCAT(profile_scope_,           \
+                                                     __LINE__) {               \
+    name                                                                       \
+  }
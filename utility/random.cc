@@ -0,0 +1,34 @@
+#include "utility/random.hh"
+#include <optional>
+
+namespace utility {
+namespace {
+struct SharedRng {
+  uint32_t seed{0U};
+  std::mt19937 generator;
+};
+
+std::optional<SharedRng> &get_maybe_shared_rng() {
+  static std::optional<SharedRng> maybe_shared_rng;
+  return maybe_shared_rng;
+}
+
+SharedRng &get_shared_rng() {
+  auto &maybe_shared_rng = get_maybe_shared_rng();
+  if (!maybe_shared_rng.has_value()) {
+    seed_rng(std::random_device{}());
+  }
+  return maybe_shared_rng.value();
+}
+} // namespace
+
+std::mt19937 &get_rng() { return get_shared_rng().generator; }
+
+void seed_rng(const uint32_t seed) {
+  get_maybe_shared_rng() =
+      SharedRng{.seed = seed, .generator = std::mt19937{seed}};
+}
+
+uint32_t get_rng_seed() { return get_shared_rng().seed; }
+
+} // namespace utility
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+namespace utility {
+
+/**
+ * @brief Get the random number generator shared by all game code
+ *
+ * Game code should draw every random number from this generator so a whole
+ * run can be reproduced from get_rng_seed(), e.g. when replaying recorded
+ * input. Until seed_rng is called the generator is seeded from
+ * std::random_device on first use.
+ *
+ * @return generator to pass to std distributions
+ * @note not thread safe, only use it from the thread running the simulation
+ */
+[[nodiscard]] std::mt19937 &get_rng();
+
+/**
+ * @brief Restart the shared generator from a seed
+ * @param seed seed to restart from, call before creating the game for the
+ * whole run to be reproducible
+ */
+void seed_rng(const uint32_t seed);
+
+/**
+ * @brief Get the seed the shared generator was last started from
+ * @return seed passed to the last seed_rng call, or the random seed picked on
+ * first use
+ */
+[[nodiscard]] uint32_t get_rng_seed();
+
+} // namespace utility
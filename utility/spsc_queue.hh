@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace utility {
+
+/**
+ * @brief Bounded lock-free queue between one producer and one consumer thread
+ *
+ * Elements live in a fixed ring so pushing and popping never allocate.
+ *
+ * @tparam T element type, must be default constructible
+ * @tparam Capacity maximum number of queued elements, a power of two
+ * @note Only safe with exactly one producer thread and one consumer thread
+ */
+template <typename T, std::size_t Capacity> class SpscQueue {
+  static_assert(Capacity > 0U && (Capacity & (Capacity - 1U)) == 0U,
+                "SpscQueue capacity must be a power of two");
+
+public:
+  SpscQueue() = default;
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  /**
+   * @brief Add an element to the back of the queue
+   * @param value element to add
+   * @return false if the queue is full, value is dropped in that case
+   * @pre Only called from the producer thread
+   */
+  [[nodiscard]] bool try_push(T value) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    slots_[tail & (Capacity - 1U)] = std::move(value);
+    tail_.store(tail + 1U, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove the element at the front of the queue
+   * @return oldest element, nullopt if the queue is empty
+   * @pre Only called from the consumer thread
+   */
+  [[nodiscard]] std::optional<T> try_pop() {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    std::optional<T> value{std::move(slots_[head & (Capacity - 1U)])};
+    head_.store(head + 1U, std::memory_order_release);
+    return value;
+  }
+
+  /// @return maximum number of queued elements
+  [[nodiscard]] static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+  std::array<T, Capacity> slots_{};
+  /// Indices only ever increase, wrapping is handled by masking
+  alignas(64) std::atomic<std::size_t> head_{0U};
+  alignas(64) std::atomic<std::size_t> tail_{0U};
+};
+
+} // namespace utility
@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utility/allocation_tracker.hh"
+#include "utility/profiler.hh"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace utility;
+
+namespace {
+/// Heap allocate without the compiler being allowed to elide it
+void allocate_bytes(const std::size_t size) {
+  auto *volatile bytes = new char[size];
+  delete[] bytes;
+}
+
+AllocationCounts
+find_zone_allocations(const ProfileFrame &frame, const std::string_view name) {
+  for (const auto &[zone_name, allocations] : get_allocations_by_zone(frame)) {
+    if (zone_name == name) {
+      return allocations;
+    }
+  }
+  return {};
+}
+} // namespace
+
+TEST_CASE("Allocations are counted per thread", "[allocation_tracker]") {
+  REQUIRE(are_allocation_hooks_linked());
+
+  const auto thread_start = get_thread_allocation_counts();
+  const auto process_start = get_process_allocation_counts();
+  allocate_bytes(100U);
+  allocate_bytes(28U);
+  const auto allocations = get_thread_allocation_counts() - thread_start;
+  CHECK(allocations.count == 2U);
+  CHECK(allocations.bytes == 128U);
+
+  AllocationCounts worker_allocations;
+  std::thread worker([&worker_allocations]() {
+    const auto start = get_thread_allocation_counts();
+    allocate_bytes(64U);
+    worker_allocations = get_thread_allocation_counts() - start;
+  });
+  worker.join();
+  // only the worker's own allocation, not those made on this thread
+  CHECK(worker_allocations.count == 1U);
+  CHECK(worker_allocations.bytes == 64U);
+  CHECK((get_process_allocation_counts() - process_start).count >= 3U);
+}
+
+TEST_CASE("Aligned allocations are counted", "[allocation_tracker]") {
+  struct alignas(64) CacheLine {
+    char bytes[64];
+  };
+  const auto start = get_thread_allocation_counts();
+  const auto cache_line = std::make_unique<CacheLine>();
+  CHECK(reinterpret_cast<std::uintptr_t>(cache_line.get()) % 64U == 0U);
+  CHECK((get_thread_allocation_counts() - start).count == 1U);
+}
+
+TEST_CASE("Allocations are attributed to the innermost profiler zone",
+          "[allocation_tracker]") {
+  auto &profiler = Profiler::get();
+  profiler.set_enabled(true);
+  profiler.end_frame();
+  profiler.clear();
+  {
+    PROFILE_SCOPE("outer");
+    allocate_bytes(10U);
+    {
+      PROFILE_SCOPE("inner");
+      allocate_bytes(20U);
+      allocate_bytes(20U);
+    }
+  }
+  profiler.end_frame();
+
+  const auto &frame = profiler.get_frames().back();
+  REQUIRE(frame.zones.size() == 2U);
+  // zones count everything nested in them
+  CHECK(frame.zones[0].name == "outer");
+  CHECK(frame.zones[0].allocations.count == 3U);
+  CHECK(frame.zones[0].allocations.bytes == 50U);
+
+  // but are attributed only their own
+  const auto inner = find_zone_allocations(frame, "inner");
+  CHECK(inner.count == 2U);
+  CHECK(inner.bytes == 40U);
+  const auto outer = find_zone_allocations(frame, "outer");
+  CHECK(outer.count == 1U);
+  CHECK(outer.bytes == 10U);
+  profiler.set_enabled(false);
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utility/profiler.hh"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace utility;
+
+namespace {
+/// Start every test from an empty, enabled profiler
+Profiler &reset_profiler() {
+  auto &profiler = Profiler::get();
+  profiler.set_enabled(true);
+  profiler.set_paused(false);
+  profiler.end_frame();
+  profiler.clear();
+  return profiler;
+}
+
+void record_nested_zones() {
+  PROFILE_SCOPE("outer");
+  {
+    PROFILE_SCOPE("first_inner");
+  }
+  {
+    PROFILE_SCOPE("second_inner");
+  }
+}
+} // namespace
+
+TEST_CASE("Zones are collected into frames with their nesting depth",
+          "[profiler]") {
+  auto &profiler = reset_profiler();
+  record_nested_zones();
+  profiler.end_frame();
+
+  REQUIRE(profiler.get_frames().size() == 1U);
+  const auto &frame = profiler.get_frames().back();
+  REQUIRE(frame.zones.size() == 3U);
+  // sorted by start time so the parent comes first
+  CHECK(frame.zones[0].name == "outer");
+  CHECK(frame.zones[0].depth == 0U);
+  CHECK(frame.zones[1].name == "first_inner");
+  CHECK(frame.zones[1].depth == 1U);
+  CHECK(frame.zones[2].name == "second_inner");
+  CHECK(frame.zones[2].depth == 1U);
+
+  for (const auto &zone : frame.zones) {
+    CHECK(zone.start_ns <= zone.end_ns);
+    CHECK(zone.start_ns >= frame.start_ns);
+    CHECK(zone.end_ns <= frame.end_ns);
+  }
+  CHECK(frame.zones[0].start_ns <= frame.zones[1].start_ns);
+  CHECK(frame.zones[2].end_ns <= frame.zones[0].end_ns);
+}
+
+TEST_CASE("Disabled profiler records nothing", "[profiler]") {
+  auto &profiler = reset_profiler();
+  profiler.set_enabled(false);
+  record_nested_zones();
+  profiler.end_frame();
+  CHECK(profiler.get_frames().empty());
+
+  // zones from while it was disabled don't show up later either
+  profiler.set_enabled(true);
+  profiler.end_frame();
+  REQUIRE(profiler.get_frames().size() == 1U);
+  CHECK(profiler.get_frames().back().zones.empty());
+}
+
+TEST_CASE("Paused profiler keeps its history", "[profiler]") {
+  auto &profiler = reset_profiler();
+  record_nested_zones();
+  profiler.end_frame();
+  profiler.set_paused(true);
+  record_nested_zones();
+  profiler.end_frame();
+  CHECK(profiler.get_frames().size() == 1U);
+
+  // zones recorded while paused were drained rather than held back
+  profiler.set_paused(false);
+  profiler.end_frame();
+  REQUIRE(profiler.get_frames().size() == 2U);
+  CHECK(profiler.get_frames().back().zones.empty());
+}
+
+TEST_CASE("Only the latest frames are kept", "[profiler]") {
+  auto &profiler = reset_profiler();
+  for (std::size_t frame = 0U; frame < Profiler::max_frame_count + 5U;
+       ++frame) {
+    profiler.end_frame();
+  }
+  CHECK(profiler.get_frames().size() == Profiler::max_frame_count);
+}
+
+TEST_CASE("Zones from other threads are tagged with their thread",
+          "[profiler]") {
+  auto &profiler = reset_profiler();
+  {
+    PROFILE_SCOPE("main_thread");
+  }
+  std::thread worker([&profiler]() {
+    profiler.set_thread_name("worker");
+    PROFILE_SCOPE("worker_thread");
+  });
+  worker.join();
+  profiler.end_frame();
+
+  const auto &zones = profiler.get_frames().back().zones;
+  REQUIRE(zones.size() == 2U);
+  CHECK(zones[0].thread_index != zones[1].thread_index);
+  const auto &worker_zone = zones[0].name == "worker_thread" ? zones[0]
+                                                             : zones[1];
+  CHECK(worker_zone.name == "worker_thread");
+  CHECK(profiler.get_thread_names().at(worker_zone.thread_index) == "worker");
+}
+
+TEST_CASE("Collected frames export as a Chrome trace", "[profiler]") {
+  auto &profiler = reset_profiler();
+  record_nested_zones();
+  profiler.end_frame();
+
+  const auto path =
+      std::filesystem::temp_directory_path() / "profiler_test_trace.json";
+  REQUIRE(profiler.write_chrome_trace(path).isOk());
+
+  std::ifstream file(path);
+  const std::string trace{std::istreambuf_iterator<char>(file),
+                          std::istreambuf_iterator<char>()};
+  CHECK(trace.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  CHECK(trace.find("\"name\":\"outer\"") != std::string::npos);
+  CHECK(trace.find("\"name\":\"second_inner\"") != std::string::npos);
+  CHECK(trace.find("\"ph\":\"X\"") != std::string::npos);
+  CHECK(trace.find("\"thread_name\"") != std::string::npos);
+  std::filesystem::remove(path);
+
+  CHECK(profiler.write_chrome_trace("/nonexistent_directory/trace.json")
+            .isErr());
+}
@@ -0,0 +1,29 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utility/random.hh"
+#include <vector>
+
+using namespace utility;
+
+namespace {
+std::vector<uint32_t> draw_numbers(const std::size_t count) {
+  std::uniform_int_distribution<uint32_t> distribution(0U, 1000U);
+  std::vector<uint32_t> numbers;
+  for (std::size_t index = 0U; index < count; ++index) {
+    numbers.push_back(distribution(get_rng()));
+  }
+  return numbers;
+}
+} // namespace
+
+TEST_CASE("Shared generator is reproducible from its seed", "[random]") {
+  seed_rng(1234U);
+  CHECK(get_rng_seed() == 1234U);
+  const auto first_run = draw_numbers(16U);
+
+  seed_rng(1234U);
+  CHECK(draw_numbers(16U) == first_run);
+
+  seed_rng(4321U);
+  CHECK(get_rng_seed() == 4321U);
+  CHECK(draw_numbers(16U) != first_run);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utility/spsc_queue.hh"
+#include <thread>
+
+using namespace utility;
+
+TEST_CASE("SPSC queue is first in first out", "[spsc_queue]") {
+  SpscQueue<int, 4> queue;
+
+  SECTION("Popping an empty queue returns nothing") {
+    CHECK_FALSE(queue.try_pop().has_value());
+  }
+
+  SECTION("Elements come out in the order they were pushed") {
+    CHECK(queue.try_push(1));
+    CHECK(queue.try_push(2));
+    CHECK(queue.try_pop() == 1);
+    CHECK(queue.try_push(3));
+    CHECK(queue.try_pop() == 2);
+    CHECK(queue.try_pop() == 3);
+    CHECK_FALSE(queue.try_pop().has_value());
+  }
+
+  SECTION("Pushing to a full queue fails until an element is popped") {
+    for (int value = 0; value < 4; ++value) {
+      CHECK(queue.try_push(value));
+    }
+    CHECK_FALSE(queue.try_push(4));
+    CHECK(queue.try_pop() == 0);
+    CHECK(queue.try_push(4));
+  }
+}
+
+TEST_CASE("SPSC queue delivers every element across threads",
+          "[spsc_queue]") {
+  constexpr int element_count = 100000;
+  SpscQueue<int, 64> queue;
+
+  std::thread producer([&queue]() {
+    for (int value = 0; value < element_count; ++value) {
+      while (!queue.try_push(value)) {
+      }
+    }
+  });
+
+  int expected_value = 0;
+  bool is_in_order = true;
+  while (expected_value != element_count) {
+    if (const auto maybe_value = queue.try_pop()) {
+      is_in_order &= maybe_value.value() == expected_value;
+      ++expected_value;
+    }
+  }
+  producer.join();
+  CHECK(is_in_order);
+}
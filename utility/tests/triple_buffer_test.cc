@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utility/triple_buffer.hh"
+#include <thread>
+
+using namespace utility;
+
+TEST_CASE("Triple buffer hands off the latest value", "[triple_buffer]") {
+  TripleBuffer<int> buffer;
+
+  SECTION("Nothing is read before a publish") {
+    CHECK_FALSE(buffer.update_read_buffer());
+    CHECK(buffer.get_read_buffer() == 0);
+  }
+
+  SECTION("Published values are read once") {
+    buffer.get_write_buffer() = 1;
+    buffer.publish();
+    CHECK(buffer.update_read_buffer());
+    CHECK(buffer.get_read_buffer() == 1);
+    CHECK_FALSE(buffer.update_read_buffer());
+    CHECK(buffer.get_read_buffer() == 1);
+  }
+
+  SECTION("Only the newest of several publishes is read") {
+    for (int value = 1; value <= 5; ++value) {
+      buffer.get_write_buffer() = value;
+      buffer.publish();
+    }
+    CHECK(buffer.update_read_buffer());
+    CHECK(buffer.get_read_buffer() == 5);
+  }
+
+  SECTION("The read buffer isn't touched by later writes") {
+    buffer.get_write_buffer() = 1;
+    buffer.publish();
+    CHECK(buffer.update_read_buffer());
+    for (int value = 2; value <= 4; ++value) {
+      buffer.get_write_buffer() = value;
+      buffer.publish();
+    }
+    CHECK(buffer.get_read_buffer() == 1);
+  }
+}
+
+TEST_CASE("Triple buffer values never go backwards across threads",
+          "[triple_buffer]") {
+  constexpr int last_value = 100000;
+  TripleBuffer<int> buffer;
+
+  std::thread producer([&buffer]() {
+    for (int value = 1; value <= last_value; ++value) {
+      buffer.get_write_buffer() = value;
+      buffer.publish();
+    }
+  });
+
+  int previous_value = 0;
+  bool is_monotonic = true;
+  while (previous_value != last_value) {
+    if (buffer.update_read_buffer()) {
+      is_monotonic &= buffer.get_read_buffer() > previous_value;
+      previous_value = buffer.get_read_buffer();
+    }
+  }
+  producer.join();
+  CHECK(is_monotonic);
+}
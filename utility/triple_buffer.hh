@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace utility {
+
+/**
+ * @brief Lock-free hand off of the latest value from one thread to another
+ *
+ * Three copies of T rotate between the producer, the consumer and a middle
+ * slot. The producer fills its copy and publishes it by swapping it with the
+ * middle slot, the consumer picks up the newest published copy by swapping
+ * its own with the middle slot. Neither side ever waits on the other, values
+ * published faster than they are consumed are overwritten.
+ *
+ * The copies are reused rather than reconstructed, so containers inside T
+ * keep their storage between publishes.
+ *
+ * @note Only safe with exactly one producer thread and one consumer thread
+ */
+template <typename T> class TripleBuffer {
+public:
+  TripleBuffer() = default;
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /**
+   * @brief Get the copy owned by the producer
+   * @return Copy to fill, holds whatever was in it three publishes ago
+   * @pre Only called from the producer thread
+   */
+  [[nodiscard]] T &get_write_buffer() { return buffers_[write_index_]; }
+
+  /**
+   * @brief Make the write buffer the newest value for the consumer
+   * @post get_write_buffer returns a different copy
+   * @pre Only called from the producer thread
+   */
+  void publish() {
+    const uint8_t previous_middle =
+        middle_.exchange(write_index_ | fresh_bit, std::memory_order_acq_rel);
+    write_index_ = previous_middle & index_mask;
+  }
+
+  /**
+   * @brief Swap in the newest published value if there is one
+   * @return true if a value was published since the last call
+   * @pre Only called from the consumer thread
+   */
+  bool update_read_buffer() {
+    if ((middle_.load(std::memory_order_relaxed) & fresh_bit) == 0U) {
+      return false;
+    }
+    const uint8_t previous_middle =
+        middle_.exchange(read_index_, std::memory_order_acq_rel);
+    read_index_ = previous_middle & index_mask;
+    return true;
+  }
+
+  /**
+   * @brief Get the copy owned by the consumer
+   * @return Newest value as of the last update_read_buffer call, a default
+   * constructed T before anything was published
+   * @pre Only called from the consumer thread
+   */
+  [[nodiscard]] const T &get_read_buffer() const {
+    return buffers_[read_index_];
+  }
+
+private:
+  static constexpr uint8_t index_mask{0b011U};
+  /// Set in the middle slot when it holds a value the consumer hasn't seen
+  static constexpr uint8_t fresh_bit{0b100U};
+
+  std::array<T, 3> buffers_{};
+  uint8_t write_index_{0U};
+  alignas(64) std::atomic<uint8_t> middle_{1U};
+  alignas(64) uint8_t read_index_{2U};
+};
+
+} // namespace utility
@@ -0,0 +1,78 @@
+#include "view/buffer_texture.hh"
+#include <GL/glew.h>
+#include <array>
+
+namespace view {
+
+BufferTexture::~BufferTexture() { release(); }
+
+BufferTexture::BufferTexture(BufferTexture &&other) noexcept
+    : buffer_id_(other.buffer_id_), texture_id_(other.texture_id_) {
+  other.buffer_id_ = 0U;
+  other.texture_id_ = 0U;
+}
+
+BufferTexture &BufferTexture::operator=(BufferTexture &&other) noexcept {
+  if (this != &other) {
+    release();
+    buffer_id_ = other.buffer_id_;
+    texture_id_ = other.texture_id_;
+    other.buffer_id_ = 0U;
+    other.texture_id_ = 0U;
+  }
+  return *this;
+}
+
+void BufferTexture::upload(const std::vector<Eigen::Vector4f> &texels) {
+  static_assert(sizeof(Eigen::Vector4f) == 4 * sizeof(float));
+  upload_bytes(texels.data(), texels.size() * sizeof(Eigen::Vector4f),
+               GL_RGBA32F);
+}
+
+void BufferTexture::upload(const std::vector<uint32_t> &texels) {
+  upload_bytes(texels.data(), texels.size() * sizeof(uint32_t), GL_R32UI);
+}
+
+void BufferTexture::bind(const uint32_t texture_unit) const {
+  glActiveTexture(GL_TEXTURE0 + texture_unit);
+  glBindTexture(GL_TEXTURE_BUFFER, texture_id_);
+  glActiveTexture(GL_TEXTURE0);
+}
+
+void BufferTexture::upload_bytes(const void *data, const std::size_t size_bytes,
+                                 const uint32_t internal_format) {
+  if (buffer_id_ == 0U) {
+    glGenBuffers(1, &buffer_id_);
+    glGenTextures(1, &texture_id_);
+  }
+
+  // zero sized buffer textures are an error on some drivers, keep one texel so
+  // the texture is always complete
+  static constexpr std::array<uint32_t, 4> empty_texel{};
+  glBindBuffer(GL_TEXTURE_BUFFER, buffer_id_);
+  if (size_bytes == 0U) {
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(empty_texel), empty_texel.data(),
+                 GL_STREAM_DRAW);
+  } else {
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(size_bytes), data,
+                 GL_STREAM_DRAW);
+  }
+  glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+  glBindTexture(GL_TEXTURE_BUFFER, texture_id_);
+  glTexBuffer(GL_TEXTURE_BUFFER, internal_format, buffer_id_);
+  glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+void BufferTexture::release() {
+  if (texture_id_ != 0U) {
+    glDeleteTextures(1, &texture_id_);
+    texture_id_ = 0U;
+  }
+  if (buffer_id_ != 0U) {
+    glDeleteBuffers(1, &buffer_id_);
+    buffer_id_ = 0U;
+  }
+}
+
+} // namespace view
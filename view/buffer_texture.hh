@@ -0,0 +1,44 @@
+#pragma once
+#include <Eigen/Dense>
+#include <cstdint>
+#include <vector>
+
+namespace view {
+
+/// Array of data readable from shaders through a samplerBuffer or
+/// usamplerBuffer with texelFetch
+///
+/// Unlike uniform arrays a buffer texture has no fixed size in the shader, so
+/// it suits data whose length changes every frame such as per-tile light
+/// lists. GPU objects are created lazily on the first upload so a
+/// BufferTexture can be constructed before the GL context exists.
+class BufferTexture {
+public:
+  BufferTexture() = default;
+  ~BufferTexture();
+
+  BufferTexture(const BufferTexture &) = delete;
+  BufferTexture &operator=(const BufferTexture &) = delete;
+  BufferTexture(BufferTexture &&other) noexcept;
+  BufferTexture &operator=(BufferTexture &&other) noexcept;
+
+  /// Replace the contents with one RGBA32F texel per element
+  void upload(const std::vector<Eigen::Vector4f> &texels);
+
+  /// Replace the contents with one R32UI texel per element
+  void upload(const std::vector<uint32_t> &texels);
+
+  /// Bind to a texture unit so a sampler uniform set to texture_unit reads it
+  /// @post the active texture unit is reset to 0
+  void bind(const uint32_t texture_unit) const;
+
+private:
+  void upload_bytes(const void *data, const std::size_t size_bytes,
+                    const uint32_t internal_format);
+  void release();
+
+  uint32_t buffer_id_{0U};
+  uint32_t texture_id_{0U};
+};
+
+} // namespace view
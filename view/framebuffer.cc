@@ -0,0 +1,76 @@
+#include "view/framebuffer.hh"
+#include <GL/glew.h>
+
+namespace view {
+
+Framebuffer::~Framebuffer() { release(); }
+
+Framebuffer::Framebuffer(Framebuffer &&other) noexcept
+    : framebuffer_id_(other.framebuffer_id_), texture_id_(other.texture_id_),
+      size_(other.size_) {
+  other.framebuffer_id_ = 0U;
+  other.texture_id_ = 0U;
+  other.size_ = {0, 0};
+}
+
+Framebuffer &Framebuffer::operator=(Framebuffer &&other) noexcept {
+  if (this != &other) {
+    release();
+    framebuffer_id_ = other.framebuffer_id_;
+    texture_id_ = other.texture_id_;
+    size_ = other.size_;
+    other.framebuffer_id_ = 0U;
+    other.texture_id_ = 0U;
+    other.size_ = {0, 0};
+  }
+  return *this;
+}
+
+void Framebuffer::resize(const Eigen::Vector2i size) {
+  if (size == size_ && framebuffer_id_ != 0U) {
+    return;
+  }
+  if (framebuffer_id_ == 0U) {
+    glGenFramebuffers(1, &framebuffer_id_);
+    glGenTextures(1, &texture_id_);
+  }
+  size_ = size;
+
+  GLint previous_texture{0};
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous_texture);
+  glBindTexture(GL_TEXTURE_2D, texture_id_);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.x(), size.y(), 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous_texture));
+
+  GLint previous_framebuffer{0};
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id_);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         texture_id_, 0);
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer));
+}
+
+void Framebuffer::bind_texture(const uint32_t texture_unit) const {
+  glActiveTexture(GL_TEXTURE0 + texture_unit);
+  glBindTexture(GL_TEXTURE_2D, texture_id_);
+  glActiveTexture(GL_TEXTURE0);
+}
+
+void Framebuffer::release() {
+  if (framebuffer_id_ != 0U) {
+    glDeleteFramebuffers(1, &framebuffer_id_);
+    framebuffer_id_ = 0U;
+  }
+  if (texture_id_ != 0U) {
+    glDeleteTextures(1, &texture_id_);
+    texture_id_ = 0U;
+  }
+  size_ = {0, 0};
+}
+
+} // namespace view
@@ -0,0 +1,48 @@
+#pragma once
+#include <Eigen/Dense>
+#include <cstdint>
+
+namespace view {
+class Screen;
+
+/// Offscreen color target which can be rendered into and then sampled as a
+/// texture
+///
+/// Used for results that are expensive to compute but rarely change, such as
+/// cached lightmaps. GPU objects are created by resize() so a Framebuffer can
+/// be constructed before the GL context exists.
+class Framebuffer {
+public:
+  Framebuffer() = default;
+  ~Framebuffer();
+
+  Framebuffer(const Framebuffer &) = delete;
+  Framebuffer &operator=(const Framebuffer &) = delete;
+  Framebuffer(Framebuffer &&other) noexcept;
+  Framebuffer &operator=(Framebuffer &&other) noexcept;
+
+  /// Allocate an RGBA8 color texture with linear filtering
+  /// @param[in] size width and height in texels
+  /// @note does nothing if the size is unchanged, otherwise the contents are
+  /// undefined until rendered into again
+  void resize(const Eigen::Vector2i size);
+
+  /// @return width and height in texels, zero before the first resize()
+  [[nodiscard]] Eigen::Vector2i get_size() const { return size_; }
+
+  /// Bind the color texture to a texture unit so a sampler2D uniform set to
+  /// texture_unit reads it
+  /// @post the active texture unit is reset to 0
+  void bind_texture(const uint32_t texture_unit) const;
+
+private:
+  friend class Screen;
+
+  void release();
+
+  uint32_t framebuffer_id_{0U};
+  uint32_t texture_id_{0U};
+  Eigen::Vector2i size_{0, 0};
+};
+
+} // namespace view
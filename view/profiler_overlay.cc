@@ -0,0 +1,218 @@
+#include "view/profiler_overlay.hh"
+#include "ThirdParty/imgui/imgui.h"
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace view {
+namespace {
+constexpr double ns_per_ms{1e6};
+
+/// Stable color per zone name so a zone is easy to follow between frames
+ImU32 get_zone_color(const std::string_view name) {
+  const auto hash = std::hash<std::string_view>{}(name);
+  const float hue = static_cast<float>(hash % 360U) / 360.f;
+  return ImColor::HSV(hue, 0.45f, 0.8f);
+}
+} // namespace
+
+ProfilerOverlay::ProfilerOverlay(std::filesystem::path trace_path)
+    : trace_path_(std::move(trace_path)) {}
+
+void ProfilerOverlay::draw() {
+  auto &profiler = utility::Profiler::get();
+  ImGui::SetNextWindowSize(ImVec2(720.f, 420.f), ImGuiCond_FirstUseEver);
+  if (!ImGui::Begin("Profiler")) {
+    ImGui::End();
+    return;
+  }
+
+  bool is_paused = profiler.is_paused();
+  if (ImGui::Checkbox("Pause", &is_paused)) {
+    profiler.set_paused(is_paused);
+    selected_frames_ago_ = 0;
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Save Chrome trace")) {
+    const auto result = profiler.write_chrome_trace(trace_path_);
+    export_message_ = result.isOk() ? "Saved " + trace_path_.string()
+                                    : result.unwrapErr();
+  }
+  ImGui::SameLine();
+  ImGui::TextUnformatted(export_message_.c_str());
+
+  const auto &frames = profiler.get_frames();
+  if (frames.empty()) {
+    ImGui::TextUnformatted("No frames collected yet");
+    ImGui::End();
+    return;
+  }
+
+  std::vector<float> frame_times_ms;
+  frame_times_ms.reserve(frames.size());
+  for (const auto &frame : frames) {
+    frame_times_ms.push_back(
+        static_cast<float>((frame.end_ns - frame.start_ns) / ns_per_ms));
+  }
+  // scaled to at least two 60 Hz frames so a steady game reads as steady
+  const float max_frame_time_ms =
+      std::max(33.3f, *std::ranges::max_element(frame_times_ms));
+  ImGui::PlotHistogram("##frame_times", frame_times_ms.data(),
+                       static_cast<int>(frame_times_ms.size()), 0,
+                       "frame time (ms)", 0.f, max_frame_time_ms,
+                       ImVec2(-1.f, 60.f));
+
+  if (profiler.is_paused()) {
+    ImGui::SliderInt("Frames ago", &selected_frames_ago_, 0,
+                     static_cast<int>(frames.size()) - 1);
+  } else {
+    selected_frames_ago_ = 0;
+  }
+  selected_frames_ago_ = std::clamp(selected_frames_ago_, 0,
+                                    static_cast<int>(frames.size()) - 1);
+  const auto &frame = frames[frames.size() - 1U -
+                             static_cast<std::size_t>(selected_frames_ago_)];
+  ImGui::Text("Frame %.2f ms, %zu zones, %llu zones dropped",
+              (frame.end_ns - frame.start_ns) / ns_per_ms, frame.zones.size(),
+              static_cast<unsigned long long>(
+                  profiler.get_dropped_zone_count()));
+  if (utility::are_allocation_hooks_linked()) {
+    ImGui::Text("%llu allocations, %.1f KiB",
+                static_cast<unsigned long long>(frame.allocations.count),
+                static_cast<double>(frame.allocations.bytes) / 1024.0);
+  }
+
+  draw_timeline(frame);
+  ImGui::Separator();
+  draw_zone_totals(frame);
+  ImGui::End();
+}
+
+void ProfilerOverlay::draw_timeline(const utility::ProfileFrame &frame) const {
+  const auto thread_names = utility::Profiler::get().get_thread_names();
+  auto *draw_list = ImGui::GetWindowDrawList();
+  const ImVec2 origin = ImGui::GetCursorScreenPos();
+  const float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+  const float row_height = ImGui::GetTextLineHeightWithSpacing();
+  const double px_per_ns =
+      width / static_cast<double>(std::max<int64_t>(
+                  frame.end_ns - frame.start_ns, 1));
+  const auto to_x = [&](const int64_t time_ns) {
+    const double x = (time_ns - frame.start_ns) * px_per_ns;
+    return origin.x + static_cast<float>(std::clamp(x, 0.0, double{width}));
+  };
+
+  // zones are sorted by thread so each lane is one contiguous run
+  float lane_top = origin.y;
+  auto zone_it = frame.zones.begin();
+  while (zone_it != frame.zones.end()) {
+    const uint32_t thread_index = zone_it->thread_index;
+    const std::string_view thread_name =
+        thread_index < thread_names.size()
+            ? std::string_view{thread_names[thread_index]}
+            : std::string_view{"thread"};
+    draw_list->AddText(ImVec2(origin.x, lane_top),
+                       ImGui::GetColorU32(ImGuiCol_Text), thread_name.data(),
+                       thread_name.data() + thread_name.size());
+    lane_top += row_height;
+
+    uint16_t max_depth = 0U;
+    for (; zone_it != frame.zones.end() &&
+           zone_it->thread_index == thread_index;
+         ++zone_it) {
+      const auto &zone = *zone_it;
+      max_depth = std::max(max_depth, zone.depth);
+      const ImVec2 top_left{to_x(zone.start_ns),
+                            lane_top + zone.depth * row_height};
+      const ImVec2 bottom_right{std::max(to_x(zone.end_ns), top_left.x + 1.f),
+                                top_left.y + row_height - 1.f};
+      draw_list->AddRectFilled(top_left, bottom_right,
+                               get_zone_color(zone.name));
+
+      const float text_width =
+          ImGui::CalcTextSize(zone.name.data(),
+                              zone.name.data() + zone.name.size())
+              .x;
+      if (bottom_right.x - top_left.x > text_width + 4.f) {
+        draw_list->AddText(ImVec2(top_left.x + 2.f, top_left.y),
+                           IM_COL32(0, 0, 0, 255), zone.name.data(),
+                           zone.name.data() + zone.name.size());
+      }
+      if (ImGui::IsMouseHoveringRect(top_left, bottom_right)) {
+        ImGui::SetTooltip("%.*s\n%.3f ms", static_cast<int>(zone.name.size()),
+                          zone.name.data(),
+                          (zone.end_ns - zone.start_ns) / ns_per_ms);
+      }
+    }
+    lane_top += (max_depth + 1U) * row_height;
+  }
+  ImGui::Dummy(ImVec2(width, lane_top - origin.y));
+}
+
+void ProfilerOverlay::draw_zone_totals(
+    const utility::ProfileFrame &frame) const {
+  struct ZoneTotal {
+    std::string_view name;
+    int64_t total_ns{0};
+    uint32_t count{0U};
+  };
+  std::vector<ZoneTotal> totals;
+  for (const auto &zone : frame.zones) {
+    const auto it = std::ranges::find(totals, zone.name, &ZoneTotal::name);
+    auto &total = it != totals.end()
+                      ? *it
+                      : totals.emplace_back(ZoneTotal{.name = zone.name});
+    total.total_ns += zone.end_ns - zone.start_ns;
+    ++total.count;
+  }
+  std::ranges::sort(totals, std::ranges::greater{}, &ZoneTotal::total_ns);
+  if (totals.size() > max_listed_zones) {
+    totals.resize(max_listed_zones);
+  }
+
+  const bool show_allocations = utility::are_allocation_hooks_linked();
+  const auto allocations_by_zone =
+      show_allocations
+          ? utility::get_allocations_by_zone(frame)
+          : std::vector<
+                std::pair<std::string_view, utility::AllocationCounts>>{};
+
+  ImGui::Columns(show_allocations ? 4 : 3, "zone_totals");
+  ImGui::TextUnformatted("Zone");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Total (ms)");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Calls");
+  ImGui::NextColumn();
+  if (show_allocations) {
+    ImGui::TextUnformatted("Allocations");
+    ImGui::NextColumn();
+  }
+  ImGui::Separator();
+  for (const auto &total : totals) {
+    ImGui::Text("%.*s", static_cast<int>(total.name.size()),
+                total.name.data());
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", total.total_ns / ns_per_ms);
+    ImGui::NextColumn();
+    ImGui::Text("%u", total.count);
+    ImGui::NextColumn();
+    if (show_allocations) {
+      // counts only the zone's own allocations, not those of nested zones
+      const auto it = std::ranges::find_if(
+          allocations_by_zone, [&](const auto &name_and_counts) {
+            return name_and_counts.first == total.name;
+          });
+      ImGui::Text("%llu", static_cast<unsigned long long>(
+                              it != allocations_by_zone.end()
+                                  ? it->second.count
+                                  : 0U));
+      ImGui::NextColumn();
+    }
+  }
+  ImGui::Columns(1);
+}
+
+} // namespace view
@@ -0,0 +1,51 @@
+#pragma once
+#include "utility/profiler.hh"
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace view {
+
+/**
+ * @brief ImGui window showing the frames collected by utility::Profiler
+ *
+ * Shows a histogram of recent frame times, a flame graph style timeline of
+ * one frame with a lane per thread, and the zones which took the most time in
+ * that frame. Pausing freezes the history so an older frame can be picked
+ * from the histogram, and the history can be saved as a Chrome trace.
+ */
+class ProfilerOverlay {
+public:
+  /**
+   * @param trace_path file written by the "Save Chrome trace" button
+   */
+  explicit ProfilerOverlay(
+      std::filesystem::path trace_path = "profile_trace.json");
+
+  /**
+   * @brief Draw the overlay window
+   * @pre Called between Screen::start_update and Screen::finish_update
+   */
+  void draw();
+
+private:
+  /// Zones listed in the totals table
+  static constexpr std::size_t max_listed_zones{12UL};
+
+  /**
+   * @brief Draw the lanes of zones of one frame
+   */
+  void draw_timeline(const utility::ProfileFrame &frame) const;
+
+  /**
+   * @brief Draw the zones with the most total time in one frame
+   */
+  void draw_zone_totals(const utility::ProfileFrame &frame) const;
+
+  std::filesystem::path trace_path_;
+  /// Frame shown while paused, counted back from the newest frame
+  int selected_frames_ago_{0};
+  std::string export_message_;
+};
+
+} // namespace view
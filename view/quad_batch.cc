@@ -0,0 +1,73 @@
+#include "view/quad_batch.hh"
+#include <GL/glew.h>
+#include <algorithm>
+
+namespace view {
+
+QuadBatch::~QuadBatch() { release_buffers(); }
+
+QuadBatch::QuadBatch(QuadBatch &&other) noexcept
+    : texture_groups_(std::move(other.texture_groups_)) {
+  other.texture_groups_.clear();
+}
+
+QuadBatch &QuadBatch::operator=(QuadBatch &&other) noexcept {
+  if (this != &other) {
+    release_buffers();
+    texture_groups_ = std::move(other.texture_groups_);
+    other.texture_groups_.clear();
+  }
+  return *this;
+}
+
+void QuadBatch::clear() {
+  for (auto &texture_group : texture_groups_) {
+    texture_group.vertices.clear();
+    texture_group.needs_upload = true;
+  }
+}
+
+void QuadBatch::add_quad(const Eigen::Vector2f bottom_left,
+                         const Eigen::Vector2f top_right,
+                         const Texture &texture) {
+  auto texture_group_it = std::ranges::find_if(
+      texture_groups_, [&texture](const TextureGroup &texture_group) {
+        return texture_group.texture == texture.texture_;
+      });
+  if (texture_group_it == texture_groups_.end()) {
+    texture_groups_.push_back(TextureGroup{.texture = texture.texture_});
+    texture_group_it = std::prev(texture_groups_.end());
+  }
+
+  // matches the vertex/uv ordering in Screen::draw_rectangle
+  const auto &bottom_left_uv = texture.bottom_left_uv_;
+  const auto &top_right_uv = texture.top_right_uv_;
+  auto &vertices = texture_group_it->vertices;
+  vertices.push_back(Vertex{bottom_left.x(), bottom_left.y(), top_right_uv.x(),
+                            top_right_uv.y()});
+  vertices.push_back(Vertex{bottom_left.x(), top_right.y(), top_right_uv.x(),
+                            bottom_left_uv.y()});
+  vertices.push_back(Vertex{top_right.x(), top_right.y(), bottom_left_uv.x(),
+                            bottom_left_uv.y()});
+  vertices.push_back(Vertex{top_right.x(), bottom_left.y(), bottom_left_uv.x(),
+                            top_right_uv.y()});
+  texture_group_it->needs_upload = true;
+}
+
+std::size_t QuadBatch::get_quad_count() const {
+  std::size_t quad_count{0UL};
+  for (const auto &texture_group : texture_groups_) {
+    quad_count += texture_group.vertices.size() / 4UL;
+  }
+  return quad_count;
+}
+
+void QuadBatch::release_buffers() {
+  for (auto &texture_group : texture_groups_) {
+    if (texture_group.buffer_id != 0U) {
+      glDeleteBuffers(1, &texture_group.buffer_id);
+      texture_group.buffer_id = 0U;
+    }
+  }
+}
+} // namespace view
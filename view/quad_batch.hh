@@ -0,0 +1,67 @@
+#pragma once
+#include "view/texture.hh"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace view {
+class Screen;
+
+/// A cached set of textured quads which can be drawn with one draw call per
+/// texture
+///
+/// Quads are stored in world coordinates and uploaded to the GPU the first time
+/// the batch is drawn after being modified, so drawing an unchanged batch only
+/// costs a handful of GL calls regardless of how many quads it holds. This is
+/// meant for geometry which rarely changes such as tile maps.
+class QuadBatch {
+public:
+  QuadBatch() = default;
+  ~QuadBatch();
+
+  QuadBatch(const QuadBatch &) = delete;
+  QuadBatch &operator=(const QuadBatch &) = delete;
+  QuadBatch(QuadBatch &&other) noexcept;
+  QuadBatch &operator=(QuadBatch &&other) noexcept;
+
+  /// Remove all quads from the batch
+  /// @note GPU buffers are kept around so they can be reused when the batch is
+  /// rebuilt
+  void clear();
+
+  /// Add a textured quad to the batch
+  /// @param[in] bottom_left bottom left corner of the quad in world coordinates
+  /// @param[in] top_right top right corner of the quad in world coordinates
+  /// @param[in] texture texture to draw on the quad, uses the same uv mapping as
+  /// Screen::draw_rectangle
+  void add_quad(const Eigen::Vector2f bottom_left,
+                const Eigen::Vector2f top_right, const Texture &texture);
+
+  /// @return number of quads currently in the batch
+  [[nodiscard]] std::size_t get_quad_count() const;
+
+private:
+  friend class Screen;
+
+  struct Vertex {
+    float x;
+    float y;
+    float u;
+    float v;
+  };
+
+  /// All of the quads which share a texture, drawn with a single draw call
+  struct TextureGroup {
+    std::shared_ptr<sf::Texture> texture;
+    std::vector<Vertex> vertices;
+    uint32_t buffer_id{0U};
+    bool needs_upload{true};
+  };
+
+  /// Delete GPU buffers owned by this batch
+  void release_buffers();
+
+  std::vector<TextureGroup> texture_groups_;
+};
+} // namespace view
@@ -0,0 +1,33 @@
+#include "view/render_snapshot.hh"
+
+namespace view {
+
+Result<void, std::string>
+RenderSnapshot::draw(Screen &screen,
+                     const Eigen::Vector2f &base_viewport_size) const {
+  if (maybe_viewport_center.has_value()) {
+    screen.set_viewport_center(maybe_viewport_center.value());
+  }
+  if (maybe_zoom_level.has_value()) {
+    screen.set_viewport_size(base_viewport_size / maybe_zoom_level.value());
+  }
+  for (const auto &rectangle : rectangles) {
+    if (rectangle.maybe_texture.has_value()) {
+      screen.draw_rectangle(rectangle.bottom_left, rectangle.top_right,
+                            rectangle.maybe_texture.value(),
+                            rectangle.z_level);
+    } else {
+      screen.draw_rectangle(rectangle.bottom_left, rectangle.top_right,
+                            rectangle.color, rectangle.z_level);
+    }
+  }
+  for (const auto &text : texts) {
+    screen.draw_text(text.location, text.font_size, text.text, text.color);
+  }
+  for (const auto &system_draw : system_draws) {
+    TRY_VOID(system_draw(screen));
+  }
+  return Ok();
+}
+
+} // namespace view
@@ -0,0 +1,73 @@
+#pragma once
+#include "utility/try.hh"
+#include "view/screen.hh"
+#include "view/texture.hh"
+#include <Eigen/Dense>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace view {
+
+/**
+ * @brief Copy of everything needed to draw one frame without the game state
+ *
+ * Filled on the simulation thread by GameState::record_render_snapshot and
+ * drawn on the render thread, so it only holds plain values: nothing in it
+ * points back into entities or components. Rectangles and text are drawn in
+ * the order they were recorded, exactly as the equivalent Screen calls would
+ * be, followed by the system draws.
+ */
+struct RenderSnapshot {
+  /// Arguments of one Screen::draw_rectangle call
+  struct Rectangle {
+    Eigen::Vector2f bottom_left;
+    Eigen::Vector2f top_right;
+    /// Texture to draw, nullopt draws a solid rectangle of color
+    std::optional<Texture> maybe_texture;
+    Color color;
+    float z_level;
+  };
+
+  /// Arguments of one Screen::draw_text call
+  struct Text {
+    Eigen::Vector2f location;
+    float font_size;
+    std::string text;
+    Color color;
+  };
+
+  /// Draw a system issues after every entity, e.g. a lighting overlay. It
+  /// holds copies of what it draws and may only touch GL state its system
+  /// doesn't use during updates
+  using SystemDraw = std::function<Result<void, std::string>(Screen &)>;
+
+  std::vector<Rectangle> rectangles;
+  std::vector<Text> texts;
+  std::vector<SystemDraw> system_draws;
+  /// Viewport center requested while recording, last one wins
+  std::optional<Eigen::Vector2f> maybe_viewport_center;
+  /// Zoom level requested while recording, last one wins, see
+  /// component::Zoom
+  std::optional<float> maybe_zoom_level;
+
+  /// Empty the snapshot, keeping its storage for the next frame
+  void clear() {
+    rectangles.clear();
+    texts.clear();
+    system_draws.clear();
+    maybe_viewport_center.reset();
+    maybe_zoom_level.reset();
+  }
+
+  /// Issue the recorded draw calls
+  /// @param[in] screen screen to draw to, between start_update and
+  /// finish_update
+  /// @param[in] base_viewport_size viewport size at zoom level 1
+  /// @return error from a system draw
+  [[nodiscard]] Result<void, std::string>
+  draw(Screen &screen, const Eigen::Vector2f &base_viewport_size) const;
+};
+
+} // namespace view
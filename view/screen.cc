@@ -1,7 +1,9 @@
 #include "view/screen.hh"
+#include "view/shader_cache.hh"
 #include "ThirdParty/imgui/imconfig.h"
 #include "ThirdParty/imgui/imgui-SFML.h"
 #include "ThirdParty/imgui/imgui.h"
+#include "ThirdParty/imgui/imgui_internal.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <SFML/Graphics/Sprite.hpp>
@@ -9,7 +11,10 @@
 #include <SFML/OpenGL.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/WindowStyle.hpp>
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 
 namespace view {
 namespace {
@@ -30,6 +35,11 @@ convert_mouse_button_enum(const sf::Mouse::Button mouse_button) {
     return Err(std::string("Unexpected mouse button, ButtonCount"));
   }
 }
+
+/// Sizes the font is rasterized at, text is scaled down from the closest
+/// larger size so small labels stay sharp without every label sampling the
+/// largest glyphs
+constexpr std::array<float, 4> font_atlas_sizes_px{16.f, 32.f, 64.f, 128.f};
 } // namespace
 
 Screen::Screen(const Eigen::Vector2f viewport_size_m,
@@ -56,11 +66,15 @@ Screen::Screen(const Eigen::Vector2f viewport_size_m,
   glDepthFunc(GL_LEQUAL);
 
   ImGuiIO &io = ImGui::GetIO();
-  fonts_.emplace_back(
-      io.Fonts->AddFontFromFileTTF("fonts/Roboto-Medium.ttf", 128));
+  for (const auto font_size_px : font_atlas_sizes_px) {
+    fonts_.emplace_back(
+        io.Fonts->AddFontFromFileTTF("fonts/Roboto-Medium.ttf", font_size_px));
+  }
   ImGui::SFML::UpdateFontTexture();
 }
 
+Screen::~Screen() { ShaderCache::get().shutdown(); }
+
 Eigen::Vector2f Screen::get_mouse_pos() const {
   ImVec2 pos = ImGui::GetMousePos();
   return {pos.x, pos.y};
@@ -74,6 +88,9 @@ void Screen::start_update() {
   ImGui::SetNextWindowBgAlpha(0.f);
   ImGui::Begin("Sample window"); // begin window
 
+  // swap in shaders whose hot reload finished compiling before anything draws
+  ShaderCache::get().poll_hot_reload();
+
   window_.clear();
   glClear(GL_DEPTH_BUFFER_BIT);
   const auto window_size = ImGui::GetWindowSize();
@@ -81,6 +98,8 @@ void Screen::start_update() {
 }
 
 void Screen::finish_update() {
+  flush_pending_rectangles();
+  flush_pending_text();
   ImGui::End(); // end window
   ImGui::SFML::Render(window_);
   window_.display();
@@ -89,59 +108,266 @@ void Screen::finish_update() {
 void Screen::draw_rectangle(const Eigen::Vector2f bottom_left,
                             const Eigen::Vector2f top_right, const Color color,
                             const float z_level) {
+  if (pending_texture_ != nullptr) {
+    flush_pending_rectangles();
+  }
+
   const auto absolute_bottom_left = window_pixels_from_game_m_ * bottom_left;
   const auto absolute_top_right = window_pixels_from_game_m_ * top_right;
-
-  glBegin(GL_QUADS);
-  glColor4f(color.r / 255.f, color.g / 255.f, color.b / 255.f, 1.);
-  glVertex3f(absolute_bottom_left.x(), absolute_bottom_left.y(), z_level);
-  glVertex3f(absolute_bottom_left.x(), absolute_top_right.y(), z_level);
-  glVertex3f(absolute_top_right.x(), absolute_top_right.y(), z_level);
-  glVertex3f(absolute_top_right.x(), absolute_bottom_left.y(), z_level);
-  glEnd();
+  const float r = color.r / 255.f;
+  const float g = color.g / 255.f;
+  const float b = color.b / 255.f;
+  pending_vertices_.push_back(PendingVertex{absolute_bottom_left.x(),
+                                            absolute_bottom_left.y(), z_level,
+                                            0.f, 0.f, r, g, b});
+  pending_vertices_.push_back(PendingVertex{absolute_bottom_left.x(),
+                                            absolute_top_right.y(), z_level,
+                                            0.f, 0.f, r, g, b});
+  pending_vertices_.push_back(PendingVertex{absolute_top_right.x(),
+                                            absolute_top_right.y(), z_level,
+                                            0.f, 0.f, r, g, b});
+  pending_vertices_.push_back(PendingVertex{absolute_top_right.x(),
+                                            absolute_bottom_left.y(), z_level,
+                                            0.f, 0.f, r, g, b});
 }
 
 void Screen::draw_rectangle(const Eigen::Vector2f bottom_left,
                             const Eigen::Vector2f top_right,
                             const Texture &texture, const float z_level) {
-  const auto t1 = std::chrono::high_resolution_clock::now();
+  if (pending_texture_ != texture.texture_.get()) {
+    flush_pending_rectangles();
+    pending_texture_ = texture.texture_.get();
+  }
+
   const auto absolute_bottom_left = window_pixels_from_game_m_ * bottom_left;
   const auto absolute_top_right = window_pixels_from_game_m_ * top_right;
+  const auto &bottom_left_uv = texture.bottom_left_uv_;
+  const auto &top_right_uv = texture.top_right_uv_;
+  pending_vertices_.push_back(PendingVertex{
+      absolute_bottom_left.x(), absolute_bottom_left.y(), z_level,
+      top_right_uv.x(), top_right_uv.y(), 1.f, 1.f, 1.f});
+  pending_vertices_.push_back(PendingVertex{
+      absolute_bottom_left.x(), absolute_top_right.y(), z_level,
+      top_right_uv.x(), bottom_left_uv.y(), 1.f, 1.f, 1.f});
+  pending_vertices_.push_back(PendingVertex{
+      absolute_top_right.x(), absolute_top_right.y(), z_level,
+      bottom_left_uv.x(), bottom_left_uv.y(), 1.f, 1.f, 1.f});
+  pending_vertices_.push_back(PendingVertex{
+      absolute_top_right.x(), absolute_bottom_left.y(), z_level,
+      bottom_left_uv.x(), top_right_uv.y(), 1.f, 1.f, 1.f});
+}
 
-  sf::Texture::bind(texture.texture_.get());
-  glColor4f(1.0, 1.0, 1.0, 1.0);
-  glBegin(GL_QUADS);
-  glTexCoord2f(texture.top_right_uv_.x(), texture.top_right_uv_.y());
-  glVertex3f(absolute_bottom_left.x(), absolute_bottom_left.y(), z_level);
-  glTexCoord2f(texture.top_right_uv_.x(), texture.bottom_left_uv_.y());
-  glVertex3f(absolute_bottom_left.x(), absolute_top_right.y(), z_level);
-  glTexCoord2f(texture.bottom_left_uv_.x(), texture.bottom_left_uv_.y());
-  glVertex3f(absolute_top_right.x(), absolute_top_right.y(), z_level);
-  glTexCoord2f(texture.bottom_left_uv_.x(), texture.top_right_uv_.y());
-  glVertex3f(absolute_top_right.x(), absolute_bottom_left.y(), z_level);
+void Screen::flush_pending_rectangles() {
+  submit_quads(pending_texture_, pending_vertices_);
+  pending_vertices_.clear();
+  pending_texture_ = nullptr;
+}
+
+void Screen::flush_pending_text() {
+  if (pending_text_vertices_.empty()) {
+    return;
+  }
+
+  // text is an overlay, it should never be hidden by sprites or darkened by
+  // the lighting pass
+  GLboolean depth_test_was_enabled = glIsEnabled(GL_DEPTH_TEST);
+  GLboolean blend_was_enabled = glIsEnabled(GL_BLEND);
+  GLint src_blend, dst_blend;
+  glGetIntegerv(GL_BLEND_SRC, &src_blend);
+  glGetIntegerv(GL_BLEND_DST, &dst_blend);
+  glDisable(GL_DEPTH_TEST);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  submit_quads(&ImGui::SFML::GetFontTexture(), pending_text_vertices_);
+  pending_text_vertices_.clear();
 
+  if (blend_was_enabled) {
+    glBlendFunc(src_blend, dst_blend);
+  } else {
+    glDisable(GL_BLEND);
+  }
+  if (depth_test_was_enabled) {
+    glEnable(GL_DEPTH_TEST);
+  }
+}
+
+void Screen::submit_quads(const sf::Texture *texture,
+                          const std::vector<PendingVertex> &vertices) {
+  if (vertices.empty()) {
+    return;
+  }
+
+  // callers may have bound a shader to set uniforms before a fullscreen pass,
+  // rectangles always use the fixed function pipeline
+  GLint current_program{0};
+  glGetIntegerv(GL_CURRENT_PROGRAM, &current_program);
+  if (current_program != 0) {
+    glUseProgram(0);
+  }
+
+  sf::Texture::bind(texture);
+  glBegin(GL_QUADS);
+  for (const auto &vertex : vertices) {
+    glColor4f(vertex.r, vertex.g, vertex.b, 1.f);
+    glTexCoord2f(vertex.u, vertex.v);
+    glVertex3f(vertex.x, vertex.y, vertex.z);
+  }
   glEnd();
   sf::Texture::bind(NULL);
-  const auto t2 = std::chrono::high_resolution_clock::now();
-  // std::cout
-  //     << "texture "
-  //     << std::chrono::duration_cast<std::chrono::microseconds>(t2 -
-  //     t1).count()
-  //     << std::endl;
+
+  if (current_program != 0) {
+    glUseProgram(static_cast<GLuint>(current_program));
+  }
+}
+
+void Screen::draw_quad_batch(QuadBatch &batch, const float z_level) {
+  flush_pending_rectangles();
+
+  // batches hold world coordinates, so apply the game to window transform on
+  // the GPU instead of transforming each vertex like draw_rectangle does
+  Eigen::Matrix4f window_pixels_from_game_m = Eigen::Matrix4f::Identity();
+  window_pixels_from_game_m.block<2, 2>(0, 0) =
+      window_pixels_from_game_m_.linear();
+  window_pixels_from_game_m.block<2, 1>(0, 3) =
+      window_pixels_from_game_m_.translation();
+  window_pixels_from_game_m(2, 3) = z_level;
+
+  glMatrixMode(GL_MODELVIEW);
+  glPushMatrix();
+  glMultMatrixf(window_pixels_from_game_m.data());
+  glColor4f(1.0, 1.0, 1.0, 1.0);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+  for (auto &texture_group : batch.texture_groups_) {
+    if (texture_group.vertices.empty()) {
+      continue;
+    }
+    if (texture_group.buffer_id == 0U) {
+      glGenBuffers(1, &texture_group.buffer_id);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, texture_group.buffer_id);
+    if (texture_group.needs_upload) {
+      glBufferData(GL_ARRAY_BUFFER,
+                   texture_group.vertices.size() * sizeof(QuadBatch::Vertex),
+                   texture_group.vertices.data(), GL_STATIC_DRAW);
+      texture_group.needs_upload = false;
+    }
+
+    sf::Texture::bind(texture_group.texture.get());
+    glVertexPointer(
+        2, GL_FLOAT, sizeof(QuadBatch::Vertex),
+        reinterpret_cast<const void *>(offsetof(QuadBatch::Vertex, x)));
+    glTexCoordPointer(
+        2, GL_FLOAT, sizeof(QuadBatch::Vertex),
+        reinterpret_cast<const void *>(offsetof(QuadBatch::Vertex, u)));
+    glDrawArrays(GL_QUADS, 0,
+                 static_cast<GLsizei>(texture_group.vertices.size()));
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  sf::Texture::bind(NULL);
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glPopMatrix();
 }
 
 void Screen::draw_text(const Eigen::Vector2f location, const float font_size,
                        const std::string_view text, const Color color) {
-  const auto absolute_location = window_pixels_from_game_m_ * location;
-  ImDrawList *draw_list = ImGui::GetWindowDrawList();
-  ImVec2 marker_min = ImVec2(absolute_location.x(), absolute_location.y());
-  window_.pushGLStates();
-  ImGui::PushFont(fonts_.front());
-  draw_list->AddText(ImGui::GetFont(), font_size, marker_min,
-                     IM_COL32(color.r, color.g, color.b, 255), text.data(),
-                     text.data() + text.size());
-  ImGui::PopFont();
-  window_.popGLStates();
+  scratch_text_mesh_.set_text(text, font_size);
+  draw_text(location, scratch_text_mesh_, color);
+}
+
+void Screen::draw_text(const Eigen::Vector2f location, TextMesh &text_mesh,
+                       const Color color) {
+  if (text_mesh.needs_layout_) {
+    layout_text(text_mesh);
+  }
+
+  const Eigen::Vector2f absolute_location =
+      window_pixels_from_game_m_ * location;
+  const float r = color.r / 255.f;
+  const float g = color.g / 255.f;
+  const float b = color.b / 255.f;
+  for (const auto &glyph : text_mesh.glyph_quads_) {
+    const Eigen::Vector2f top_left = absolute_location + glyph.top_left_px;
+    const Eigen::Vector2f bottom_right =
+        absolute_location + glyph.bottom_right_px;
+    pending_text_vertices_.push_back(
+        PendingVertex{top_left.x(), top_left.y(), 0.f, glyph.top_left_uv.x(),
+                      glyph.top_left_uv.y(), r, g, b});
+    pending_text_vertices_.push_back(PendingVertex{
+        top_left.x(), bottom_right.y(), 0.f, glyph.top_left_uv.x(),
+        glyph.bottom_right_uv.y(), r, g, b});
+    pending_text_vertices_.push_back(PendingVertex{
+        bottom_right.x(), bottom_right.y(), 0.f, glyph.bottom_right_uv.x(),
+        glyph.bottom_right_uv.y(), r, g, b});
+    pending_text_vertices_.push_back(PendingVertex{
+        bottom_right.x(), top_left.y(), 0.f, glyph.bottom_right_uv.x(),
+        glyph.top_left_uv.y(), r, g, b});
+  }
+}
+
+const ImFont *Screen::get_font_for_size(const float font_size) const {
+  for (const auto *font : fonts_) {
+    if (font->FontSize >= font_size) {
+      return font;
+    }
+  }
+  return fonts_.back();
+}
+
+void Screen::layout_text(TextMesh &text_mesh) const {
+  text_mesh.glyph_quads_.clear();
+  text_mesh.needs_layout_ = false;
+
+  const ImFont *font = get_font_for_size(text_mesh.font_size_px_);
+  const float scale = text_mesh.font_size_px_ / font->FontSize;
+  const float line_height = text_mesh.font_size_px_;
+
+  // same walk over the string as ImFont::RenderText, minus clipping and
+  // wrapping which no caller uses
+  Eigen::Vector2f cursor{0.f, 0.f};
+  float max_line_width{0.f};
+  const char *current = text_mesh.text_.data();
+  const char *const end = current + text_mesh.text_.size();
+  while (current < end) {
+    unsigned int codepoint = static_cast<unsigned char>(*current);
+    if (codepoint < 0x80) {
+      ++current;
+    } else {
+      current += ImTextCharFromUtf8(&codepoint, current, end);
+      if (codepoint == 0) {
+        break;
+      }
+    }
+
+    if (codepoint == '\n') {
+      max_line_width = std::max(max_line_width, cursor.x());
+      cursor = {0.f, cursor.y() + line_height};
+      continue;
+    }
+    if (codepoint == '\r') {
+      continue;
+    }
+
+    const ImFontGlyph *glyph = font->FindGlyph(static_cast<ImWchar>(codepoint));
+    if (glyph == nullptr) {
+      continue;
+    }
+    if (glyph->Visible) {
+      text_mesh.glyph_quads_.push_back(TextMesh::GlyphQuad{
+          cursor + scale * Eigen::Vector2f{glyph->X0, glyph->Y0},
+          cursor + scale * Eigen::Vector2f{glyph->X1, glyph->Y1},
+          {glyph->U0, glyph->V0},
+          {glyph->U1, glyph->V1}});
+    }
+    cursor.x() += glyph->AdvanceX * scale;
+  }
+
+  text_mesh.size_px_ = {std::max(max_line_width, cursor.x()),
+                        cursor.y() + line_height};
 }
 
 void Screen::begin_lighting_pass() {
@@ -163,6 +389,8 @@ void Screen::end_lighting_pass() {
 
 void Screen::draw_fullscreen_shader(const class Shader &shader,
                                     const float z_level) {
+  flush_pending_rectangles();
+
   // Save current OpenGL state
   GLboolean depth_test_was_enabled = glIsEnabled(GL_DEPTH_TEST);
   if (!depth_test_was_enabled) {
@@ -201,6 +429,8 @@ void Screen::draw_fullscreen_shader(const class Shader &shader,
 
 void Screen::draw_fullscreen_lighting_shader(const class Shader &shader,
                                              const float z_level) {
+  flush_pending_rectangles();
+
   // Save current OpenGL state
   GLboolean depth_test_was_enabled = glIsEnabled(GL_DEPTH_TEST);
   GLboolean blend_was_enabled = glIsEnabled(GL_BLEND);
@@ -253,6 +483,45 @@ void Screen::draw_fullscreen_lighting_shader(const class Shader &shader,
   }
 }
 
+void Screen::draw_fullscreen_shader_to_framebuffer(const Shader &shader,
+                                                   Framebuffer &framebuffer) {
+  flush_pending_rectangles();
+
+  // Save current OpenGL state
+  GLint previous_framebuffer{0};
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+  GLint previous_viewport[4];
+  glGetIntegerv(GL_VIEWPORT, previous_viewport);
+  GLboolean depth_test_was_enabled = glIsEnabled(GL_DEPTH_TEST);
+  GLboolean blend_was_enabled = glIsEnabled(GL_BLEND);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.framebuffer_id_);
+  glViewport(0, 0, framebuffer.size_.x(), framebuffer.size_.y());
+  glDisable(GL_DEPTH_TEST);
+  glDisable(GL_BLEND);
+
+  glUseProgram(shader.get_program_id());
+  glBegin(GL_QUADS);
+  glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+  glVertex3f(-1.0f, -1.0f, 0.0f);
+  glVertex3f(1.0f, -1.0f, 0.0f);
+  glVertex3f(1.0f, 1.0f, 0.0f);
+  glVertex3f(-1.0f, 1.0f, 0.0f);
+  glEnd();
+  glUseProgram(0);
+
+  // Restore OpenGL state
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer));
+  glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2],
+             previous_viewport[3]);
+  if (depth_test_was_enabled) {
+    glEnable(GL_DEPTH_TEST);
+  }
+  if (blend_was_enabled) {
+    glEnable(GL_BLEND);
+  }
+}
+
 void Screen::set_viewport_center(const Eigen::Vector2f new_center) {
   game_m_viewport_center_ = new_center;
 
@@ -315,6 +584,14 @@ Eigen::Vector2f Screen::get_actual_viewport_size() const {
                          std::abs(top_right_world.y() - bottom_left_world.y()));
 }
 
+Eigen::AlignedBox2f Screen::get_visible_bounds() const {
+  Eigen::AlignedBox2f visible_bounds;
+  visible_bounds.extend(game_m_from_window_pixels_ *
+                        Eigen::Vector2f{0.0f, 0.0f});
+  visible_bounds.extend(game_m_from_window_pixels_ * window_size_pixels_);
+  return visible_bounds;
+}
+
 Result<bool, std::string> Screen::poll_events_and_check_for_close() {
   sf::Event event;
   if (!window_.isOpen()) {
@@ -1,7 +1,10 @@
 #pragma once
 #include "ThirdParty/imgui/imgui.h"
 #include "utility/try.hh"
+#include "view/framebuffer.hh"
+#include "view/quad_batch.hh"
 #include "view/shader.hh"
+#include "view/text_mesh.hh"
 #include "view/texture.hh"
 #include <Eigen/Dense>
 #include <SFML/Graphics/RenderWindow.hpp>
@@ -64,6 +67,9 @@ class Screen {
 public:
   Screen(const Eigen::Vector2f viewport_size_m = {2.0f, 2.0f},
          const Eigen::Vector2f viewport_center = {.0f, .0f});
+  /// Releases the programs in the ShaderCache while the GL context still
+  /// exists
+  ~Screen();
   [[nodiscard]] Eigen::Vector2f get_mouse_pos() const;
   void start_update();
   void finish_update();
@@ -75,9 +81,26 @@ public:
                       const Eigen::Vector2f top_right, const Texture &texture,
                       const float z_level = 0);
 
+  /// Draw a string which is laid out from scratch on every call
+  /// @note prefer the TextMesh overload for text drawn every frame
   void draw_text(const Eigen::Vector2f location, const float font_size,
                  const std::string_view text, const Color color);
 
+  /// Draw cached text with its top left corner at location
+  /// @param[in] location top left corner of the text in game meters
+  /// @param[in] text_mesh text to draw, laid out first if its text or size
+  /// changed since it was last drawn
+  /// @param[in] color color of the text
+  /// @note text is drawn on top of everything else at the end of the frame
+  void draw_text(const Eigen::Vector2f location, TextMesh &text_mesh,
+                 const Color color);
+
+  /// Draw every quad in a batch, issuing one draw call per texture
+  /// @param[in] batch quads to draw, uploaded to the GPU first if they changed
+  /// since the last draw
+  /// @param[in] z_level depth to draw all of the quads at
+  void draw_quad_batch(QuadBatch &batch, const float z_level = 0);
+
   // Lighting system methods
   void begin_lighting_pass();
   void draw_light_mask(const Eigen::Vector2f bottom_left,
@@ -90,6 +113,15 @@ public:
   void draw_fullscreen_lighting_shader(const Shader &shader,
                                        const float z_level = 0);
 
+  /// Run a shader over every texel of an offscreen target
+  /// @param[in] shader shader to draw a fullscreen quad with, its uniforms
+  /// should already be set
+  /// @param[in,out] framebuffer target to overwrite, must have been resized
+  /// @note depth testing and blending are disabled while drawing and the
+  /// window remains the render target afterwards
+  void draw_fullscreen_shader_to_framebuffer(const Shader &shader,
+                                             Framebuffer &framebuffer);
+
   void set_viewport_center(const Eigen::Vector2f new_center);
 
   /**
@@ -121,12 +153,54 @@ public:
    */
   [[nodiscard]] Eigen::Vector2f get_actual_viewport_size() const;
 
+  /**
+   * @brief Get the region of the world currently covered by the window
+   * @return Axis aligned box in world coordinates matching the transform used
+   * by the draw calls
+   * @note Unlike get_viewport_center this reflects the transform in effect for
+   * this frame, viewport center changes only apply on the next start_update
+   */
+  [[nodiscard]] Eigen::AlignedBox2f get_visible_bounds() const;
+
   /// returns boolean indicating if the system is still running or an error
   [[nodiscard]] Result<bool, std::string> poll_events_and_check_for_close();
   [[nodiscard]] const std::vector<EventType> &get_events() const;
   void clear_events();
 
 private:
+  /// Rectangle vertex in window pixels waiting to be submitted
+  struct PendingVertex {
+    float x;
+    float y;
+    float z;
+    float u;
+    float v;
+    float r;
+    float g;
+    float b;
+  };
+
+  /// Submit all pending rectangles with a single texture bind and draw call
+  /// @note rectangles are queued until the texture changes or a draw which
+  /// doesn't go through draw_rectangle happens, so consecutive rectangles with
+  /// the same texture don't pay for a texture change each
+  void flush_pending_rectangles();
+
+  /// Submit all queued glyphs on top of the frame with one draw call
+  void flush_pending_text();
+
+  /// Draw vertices as quads with the fixed function pipeline
+  void submit_quads(const sf::Texture *texture,
+                    const std::vector<PendingVertex> &vertices);
+
+  /// Pick the atlas font to rasterize text of a given size from
+  /// @return smallest font at least as large as font_size, or the largest
+  /// font if none are
+  [[nodiscard]] const ImFont *get_font_for_size(const float font_size) const;
+
+  /// Compute glyph quads for the mesh's current text and size
+  void layout_text(TextMesh &text_mesh) const;
+
   void handle_resize(const Eigen::Vector2i new_size);
 
   Eigen::Vector2f get_window_size_pixels() const;
@@ -134,7 +208,16 @@ private:
   sf::RenderWindow window_;
   sf::Clock delta_clock_;
   std::vector<EventType> events_;
+
+  /// Texture shared by all pending rectangles, nullptr for solid colors
+  const sf::Texture *pending_texture_{nullptr};
+  std::vector<PendingVertex> pending_vertices_;
+  /// Glyphs queued this frame, all sampling the ImGui font atlas
+  std::vector<PendingVertex> pending_text_vertices_;
+  /// Same font rasterized at increasing sizes, sorted by size
   std::vector<ImFont *> fonts_;
+  /// Reused by the uncached draw_text overload to avoid allocating per call
+  TextMesh scratch_text_mesh_;
 
   /// Size of the full window in pixels
   Eigen::Vector2f window_size_pixels_;
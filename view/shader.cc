@@ -1,12 +1,46 @@
 #include "view/shader.hh"
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <GL/glew.h>
 #include <SFML/OpenGL.hpp>
 
 namespace view {
+namespace {
+/// Names interned by UniformId, shared by every thread and program
+struct UniformNameRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, uint32_t> indices_by_name;
+  /// Deque so references returned by UniformId::get_name stay valid
+  std::deque<std::string> names;
+};
+
+UniformNameRegistry& get_uniform_name_registry() {
+  static UniformNameRegistry registry;
+  return registry;
+}
+} // namespace
+
+UniformId::UniformId(const std::string_view name) {
+  auto& registry = get_uniform_name_registry();
+  std::lock_guard lock(registry.mutex);
+  const auto [it, inserted] = registry.indices_by_name.try_emplace(
+      std::string(name), static_cast<uint32_t>(registry.names.size()));
+  if (inserted) {
+    registry.names.emplace_back(name);
+  }
+  index_ = it->second;
+}
+
+const std::string& UniformId::get_name() const {
+  auto& registry = get_uniform_name_registry();
+  std::lock_guard lock(registry.mutex);
+  return registry.names[index_];
+}
 
 Result<std::unique_ptr<Shader>, std::string> Shader::from_files(const std::string& vertex_path,
                                                                   const std::string& fragment_path) {
@@ -37,38 +71,92 @@ Result<std::unique_ptr<Shader>, std::string> Shader::from_files(const std::strin
 
 Result<std::unique_ptr<Shader>, std::string> Shader::from_strings(const std::string& vertex_source,
                                                                     const std::string& fragment_source) {
+  return finish_compile(TRY(start_compile(vertex_source, fragment_source)));
+}
+
+Result<Shader::PendingProgram, std::string> Shader::start_compile(const std::string& vertex_source,
+                                                                  const std::string& fragment_source) {
   // Check if GLEW is initialized
   if (!glewIsSupported("GL_VERSION_2_0")) {
     return Err(std::string("OpenGL 2.0+ not supported or GLEW not initialized"));
   }
 
-  // Compile vertex shader
-  const auto vertex_shader_result = compile_shader(vertex_source, GL_VERTEX_SHADER);
-  if (vertex_shader_result.isErr()) {
-    return Err(std::string("Vertex shader compilation failed: ") + vertex_shader_result.unwrapErr());
+  PendingProgram pending_program;
+  pending_program.vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+  pending_program.fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+  pending_program.program = glCreateProgram();
+  if (pending_program.vertex_shader == 0 || pending_program.fragment_shader == 0 ||
+      pending_program.program == 0) {
+    glDeleteShader(pending_program.vertex_shader);
+    glDeleteShader(pending_program.fragment_shader);
+    glDeleteProgram(pending_program.program);
+    return Err(std::string("glCreateShader failed - OpenGL error"));
   }
-  const uint32_t vertex_shader = vertex_shader_result.unwrap();
 
-  // Compile fragment shader
-  const auto fragment_shader_result = compile_shader(fragment_source, GL_FRAGMENT_SHADER);
-  if (fragment_shader_result.isErr()) {
-    glDeleteShader(vertex_shader);  // Cleanup on failure
-    return Err(std::string("Fragment shader compilation failed: ") + fragment_shader_result.unwrapErr());
+  // Drivers compile and link in the background until a status is queried, so
+  // nothing here waits for the result
+  const char* vertex_source_cstr = vertex_source.c_str();
+  glShaderSource(pending_program.vertex_shader, 1, &vertex_source_cstr, nullptr);
+  glCompileShader(pending_program.vertex_shader);
+
+  const char* fragment_source_cstr = fragment_source.c_str();
+  glShaderSource(pending_program.fragment_shader, 1, &fragment_source_cstr, nullptr);
+  glCompileShader(pending_program.fragment_shader);
+
+  glAttachShader(pending_program.program, pending_program.vertex_shader);
+  glAttachShader(pending_program.program, pending_program.fragment_shader);
+  glLinkProgram(pending_program.program);
+
+  return Ok(pending_program);
+}
+
+bool Shader::is_compile_finished(const PendingProgram& pending_program) {
+#if defined(GL_COMPLETION_STATUS_KHR) && defined(GLEW_KHR_parallel_shader_compile)
+  if (GLEW_KHR_parallel_shader_compile) {
+    int32_t is_finished = GL_FALSE;
+    glGetProgramiv(pending_program.program, GL_COMPLETION_STATUS_KHR, &is_finished);
+    return is_finished == GL_TRUE;
   }
-  const uint32_t fragment_shader = fragment_shader_result.unwrap();
+#endif
+  return true;
+}
 
-  // Link program
-  const auto program_result = link_program(vertex_shader, fragment_shader);
+Result<std::unique_ptr<Shader>, std::string> Shader::finish_compile(const PendingProgram& pending_program) {
+  // Stages are flagged for deletion now and freed with the program
+  glDeleteShader(pending_program.vertex_shader);
+  glDeleteShader(pending_program.fragment_shader);
 
-  // Clean up individual shaders (no longer needed after linking)
-  glDeleteShader(vertex_shader);
-  glDeleteShader(fragment_shader);
+  const auto stage_result = [&]() -> Result<void, std::string> {
+    const auto vertex_result = check_compile_status(pending_program.vertex_shader, GL_VERTEX_SHADER);
+    if (vertex_result.isErr()) {
+      return Err(std::string("Vertex shader compilation failed: ") + vertex_result.unwrapErr());
+    }
+    const auto fragment_result = check_compile_status(pending_program.fragment_shader, GL_FRAGMENT_SHADER);
+    if (fragment_result.isErr()) {
+      return Err(std::string("Fragment shader compilation failed: ") + fragment_result.unwrapErr());
+    }
+    return Ok();
+  }();
+  if (stage_result.isErr()) {
+    glDeleteProgram(pending_program.program);
+    return Err(stage_result.unwrapErr());
+  }
 
-  if (program_result.isErr()) {
-    return Err(std::string("Shader program linking failed: ") + program_result.unwrapErr());
+  // Check linking status
+  int32_t success;
+  glGetProgramiv(pending_program.program, GL_LINK_STATUS, &success);
+  if (!success) {
+    char info_log[512];
+    glGetProgramInfoLog(pending_program.program, 512, nullptr, info_log);
+    glDeleteProgram(pending_program.program);
+    return Err(std::string("Shader program linking failed: Program linking error: ") + info_log);
   }
 
-  return Ok(std::unique_ptr<Shader>(new Shader(program_result.unwrap())));
+  // Detaching lets the flagged stages be freed now rather than with the program
+  glDetachShader(pending_program.program, pending_program.vertex_shader);
+  glDetachShader(pending_program.program, pending_program.fragment_shader);
+
+  return Ok(std::unique_ptr<Shader>(new Shader(pending_program.program)));
 }
 
 void Shader::use() const {
@@ -77,84 +165,139 @@ void Shader::use() const {
   }
 }
 
-void Shader::set_uniform(const std::string& name, float value) {
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    glUniform1f(location, value);
+void Shader::set_uniform(const UniformId& uniform, const float value) {
+  UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1 && update_uniform_value(slot, &value, sizeof(value))) {
+    use();
+    glUniform1f(slot.location, value);
   }
 }
 
-void Shader::set_uniform(const std::string& name, const Eigen::Vector2f& value) {
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    glUniform2f(location, value.x(), value.y());
+void Shader::set_uniform(const UniformId& uniform, const Eigen::Vector2f& value) {
+  UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1 && update_uniform_value(slot, value.data(), sizeof(value))) {
+    use();
+    glUniform2f(slot.location, value.x(), value.y());
   }
 }
 
-void Shader::set_uniform(const std::string& name, const Eigen::Vector3f& value) {
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    glUniform3f(location, value.x(), value.y(), value.z());
+void Shader::set_uniform(const UniformId& uniform, const Eigen::Vector3f& value) {
+  UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1 && update_uniform_value(slot, value.data(), sizeof(value))) {
+    use();
+    glUniform3f(slot.location, value.x(), value.y(), value.z());
   }
 }
 
-void Shader::set_uniform(const std::string& name, int32_t value) {
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    glUniform1i(location, value);
+void Shader::set_uniform(const UniformId& uniform, const int32_t value) {
+  UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1 && update_uniform_value(slot, &value, sizeof(value))) {
+    use();
+    glUniform1i(slot.location, value);
   }
 }
 
-void Shader::set_uniform_array(const std::string& name, const std::vector<Eigen::Vector2f>& values) {
+void Shader::set_uniform(const UniformId& uniform, const Eigen::Vector2i& value) {
+  UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1 && update_uniform_value(slot, value.data(), sizeof(value))) {
+    use();
+    glUniform2i(slot.location, value.x(), value.y());
+  }
+}
+
+void Shader::set_uniform(const std::string& name, const float value) {
+  set_uniform(get_uniform_id(name), value);
+}
+
+void Shader::set_uniform(const std::string& name, const Eigen::Vector2f& value) {
+  set_uniform(get_uniform_id(name), value);
+}
+
+void Shader::set_uniform(const std::string& name, const Eigen::Vector3f& value) {
+  set_uniform(get_uniform_id(name), value);
+}
+
+void Shader::set_uniform(const std::string& name, const int32_t value) {
+  set_uniform(get_uniform_id(name), value);
+}
+
+void Shader::set_uniform(const std::string& name, const Eigen::Vector2i& value) {
+  set_uniform(get_uniform_id(name), value);
+}
+
+// Eigen's fixed size vectors are plain float arrays, so spans of them upload
+// without repacking
+static_assert(sizeof(Eigen::Vector2f) == 2 * sizeof(float));
+static_assert(sizeof(Eigen::Vector3f) == 3 * sizeof(float));
+
+void Shader::set_uniform_array(const UniformId& uniform,
+                               const std::span<const Eigen::Vector2f> values) {
   if (values.empty()) return;
 
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    // Convert Eigen vectors to float array
-    std::vector<float> float_data;
-    float_data.reserve(values.size() * 2);
-    for (const auto& v : values) {
-      float_data.push_back(v.x());
-      float_data.push_back(v.y());
-    }
-    glUniform2fv(location, static_cast<int32_t>(values.size()), float_data.data());
+  const UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1) {
+    use();
+    glUniform2fv(slot.location, static_cast<int32_t>(values.size()), values.front().data());
   }
 }
 
-void Shader::set_uniform_array(const std::string& name, const std::vector<Eigen::Vector3f>& values) {
+void Shader::set_uniform_array(const UniformId& uniform,
+                               const std::span<const Eigen::Vector3f> values) {
   if (values.empty()) return;
 
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    // Convert Eigen vectors to float array
-    std::vector<float> float_data;
-    float_data.reserve(values.size() * 3);
-    for (const auto& v : values) {
-      float_data.push_back(v.x());
-      float_data.push_back(v.y());
-      float_data.push_back(v.z());
-    }
-    glUniform3fv(location, static_cast<int32_t>(values.size()), float_data.data());
+  const UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1) {
+    use();
+    glUniform3fv(slot.location, static_cast<int32_t>(values.size()), values.front().data());
   }
 }
 
-void Shader::set_uniform_array(const std::string& name, const std::vector<float>& values) {
+void Shader::set_uniform_array(const UniformId& uniform, const std::span<const float> values) {
   if (values.empty()) return;
 
-  use();
-  const int32_t location = get_uniform_location(name);
-  if (location != -1) {
-    glUniform1fv(location, static_cast<int32_t>(values.size()), values.data());
+  const UniformSlot& slot = get_uniform_slot(uniform);
+  if (slot.location != -1) {
+    use();
+    glUniform1fv(slot.location, static_cast<int32_t>(values.size()), values.data());
   }
 }
 
-Shader::Shader(Shader&& other) noexcept : program_id_(other.program_id_), uniform_cache_(std::move(other.uniform_cache_)) {
+void Shader::set_uniform_array(const std::string& name,
+                               const std::span<const Eigen::Vector2f> values) {
+  set_uniform_array(get_uniform_id(name), values);
+}
+
+void Shader::set_uniform_array(const std::string& name,
+                               const std::span<const Eigen::Vector3f> values) {
+  set_uniform_array(get_uniform_id(name), values);
+}
+
+void Shader::set_uniform_array(const std::string& name, const std::span<const float> values) {
+  set_uniform_array(get_uniform_id(name), values);
+}
+
+void Shader::bind_uniform_block(const UniformId& block, const uint32_t binding_point) {
+  const auto [it, inserted] =
+      uniform_block_bindings_.try_emplace(block.get_index(), binding_point);
+  if (!inserted && it->second == binding_point) {
+    return;
+  }
+  it->second = binding_point;
+
+  const GLuint block_index = glGetUniformBlockIndex(program_id_, block.get_name().c_str());
+  if (block_index == GL_INVALID_INDEX) {
+    std::cerr << "Warning: Uniform block '" << block.get_name() << "' not found in shader program"
+              << std::endl;
+    return;
+  }
+  glUniformBlockBinding(program_id_, block_index, binding_point);
+}
+
+Shader::Shader(Shader&& other) noexcept
+    : program_id_(other.program_id_),
+      uniform_slots_(std::move(other.uniform_slots_)),
+      uniform_ids_by_name_(std::move(other.uniform_ids_by_name_)),
+      uniform_block_bindings_(std::move(other.uniform_block_bindings_)) {
   other.program_id_ = 0;  // Mark other as invalid
 }
 
@@ -167,7 +310,9 @@ Shader& Shader::operator=(Shader&& other) noexcept {
 
     // Take ownership from other
     program_id_ = other.program_id_;
-    uniform_cache_ = std::move(other.uniform_cache_);
+    uniform_slots_ = std::move(other.uniform_slots_);
+    uniform_ids_by_name_ = std::move(other.uniform_ids_by_name_);
+    uniform_block_bindings_ = std::move(other.uniform_block_bindings_);
 
     // Mark other as invalid
     other.program_id_ = 0;
@@ -181,34 +326,42 @@ Shader::~Shader() {
   }
 }
 
-int32_t Shader::get_uniform_location(const std::string& name) {
-  // Check cache first
-  const auto it = uniform_cache_.find(name);
-  if (it != uniform_cache_.end()) {
-    return it->second;
+Shader::UniformSlot& Shader::get_uniform_slot(const UniformId& uniform) {
+  if (uniform.get_index() >= uniform_slots_.size()) {
+    uniform_slots_.resize(uniform.get_index() + 1);
   }
-
-  // Query OpenGL and cache result
-  const int32_t location = glGetUniformLocation(program_id_, name.c_str());
-  uniform_cache_[name] = location;
-
-  if (location == -1) {
-    std::cerr << "Warning: Uniform '" << name << "' not found in shader program" << std::endl;
+  UniformSlot& slot = uniform_slots_[uniform.get_index()];
+  if (slot.location != UniformSlot::unresolved_location) {
+    return slot;
   }
 
-  return location;
+  // Query OpenGL once per program and uniform
+  slot.location = glGetUniformLocation(program_id_, uniform.get_name().c_str());
+  if (slot.location == -1) {
+    std::cerr << "Warning: Uniform '" << uniform.get_name() << "' not found in shader program"
+              << std::endl;
+  }
+  return slot;
 }
 
-Result<uint32_t, std::string> Shader::compile_shader(const std::string& source, uint32_t shader_type) {
-  const uint32_t shader = glCreateShader(shader_type);
-  if (shader == 0) {
-    return Err(std::string("glCreateShader failed - OpenGL error"));
+const UniformId& Shader::get_uniform_id(const std::string& name) {
+  const auto it = uniform_ids_by_name_.find(name);
+  if (it != uniform_ids_by_name_.end()) {
+    return it->second;
   }
+  return uniform_ids_by_name_.emplace(name, UniformId{name}).first->second;
+}
 
-  const char* source_cstr = source.c_str();
-  glShaderSource(shader, 1, &source_cstr, nullptr);
-  glCompileShader(shader);
+bool Shader::update_uniform_value(UniformSlot& slot, const void* value, const std::size_t size) {
+  if (slot.value_size == size && std::memcmp(slot.value.data(), value, size) == 0) {
+    return false;
+  }
+  std::memcpy(slot.value.data(), value, size);
+  slot.value_size = static_cast<uint8_t>(size);
+  return true;
+}
 
+Result<void, std::string> Shader::check_compile_status(uint32_t shader, uint32_t shader_type) {
   // Check compilation status
   int32_t success;
   glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
@@ -216,35 +369,12 @@ Result<uint32_t, std::string> Shader::compile_shader(const std::string& source,
   if (!success) {
     char info_log[512];
     glGetShaderInfoLog(shader, 512, nullptr, info_log);
-    glDeleteShader(shader);
 
     const std::string shader_type_name = (shader_type == GL_VERTEX_SHADER) ? "vertex" : "fragment";
     return Err(std::string("Shader compilation error (") + shader_type_name + "): " + info_log);
   }
 
-  return Ok(shader);
-}
-
-Result<uint32_t, std::string> Shader::link_program(uint32_t vertex_shader, uint32_t fragment_shader) {
-  const uint32_t program = glCreateProgram();
-
-  glAttachShader(program, vertex_shader);
-  glAttachShader(program, fragment_shader);
-  glLinkProgram(program);
-
-  // Check linking status
-  int32_t success;
-  glGetProgramiv(program, GL_LINK_STATUS, &success);
-
-  if (!success) {
-    char info_log[512];
-    glGetProgramInfoLog(program, 512, nullptr, info_log);
-    glDeleteProgram(program);
-
-    return Err(std::string("Program linking error: ") + info_log);
-  }
-
-  return Ok(program);
+  return Ok();
 }
 
 } // namespace view
\ No newline at end of file
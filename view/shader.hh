@@ -2,19 +2,61 @@
 #include "utility/try.hh"
 #include <Eigen/Dense>
 #include <GL/glew.h>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace view {
+class ShaderCache;
+
+/**
+ * @brief Pre-resolved name of a shader uniform or uniform block
+ *
+ * Each name is interned to a small index when the UniformId is constructed, so
+ * setting a uniform through it is an array lookup instead of hashing a string.
+ * Construct them once, e.g. as static constants next to the code setting the
+ * uniforms. The same UniformId works with every Shader, including programs
+ * swapped in by a hot reload.
+ */
+class UniformId {
+public:
+  /**
+   * @brief Intern a uniform name
+   * @param name Uniform or uniform block name as written in the GLSL source
+   */
+  explicit UniformId(std::string_view name);
+
+  /**
+   * @brief Get the interned index, equal for equal names
+   * @return Index shared by every UniformId with this name
+   */
+  [[nodiscard]] uint32_t get_index() const { return index_; }
+
+  /**
+   * @brief Get the name this id was created from
+   * @return Uniform name
+   */
+  [[nodiscard]] const std::string& get_name() const;
+
+private:
+  uint32_t index_{0};
+};
 
 /**
  * @brief GLSL shader program wrapper with uniform management
  *
  * Provides a simple interface for loading, compiling, and using GLSL shaders.
  * Handles vertex and fragment shader compilation, linking, and uniform uploads.
+ *
+ * Uniforms set through a UniformId remember their last value, and setting the
+ * value a uniform already holds makes no GL calls. Prefer the UniformId
+ * overloads on per-frame paths; the string overloads look the name up first.
  */
 class Shader {
 public:
@@ -44,18 +86,40 @@ public:
 
   /**
    * @brief Set uniform values for shader parameters
+   * @note Values equal to the last one set for the uniform are skipped
    */
+  void set_uniform(const UniformId& uniform, float value);
+  void set_uniform(const UniformId& uniform, const Eigen::Vector2f& value);
+  void set_uniform(const UniformId& uniform, const Eigen::Vector3f& value);
+  void set_uniform(const UniformId& uniform, int32_t value);
+  void set_uniform(const UniformId& uniform, const Eigen::Vector2i& value);
+
   void set_uniform(const std::string& name, float value);
   void set_uniform(const std::string& name, const Eigen::Vector2f& value);
   void set_uniform(const std::string& name, const Eigen::Vector3f& value);
   void set_uniform(const std::string& name, int32_t value);
+  void set_uniform(const std::string& name, const Eigen::Vector2i& value);
 
   /**
-   * @brief Set array uniforms for multiple values (e.g. light data)
+   * @brief Set array uniforms for multiple values
+   * @note Arrays are uploaded straight from values and always sent; large or
+   * variable length arrays belong in a UniformBuffer or BufferTexture
    */
-  void set_uniform_array(const std::string& name, const std::vector<Eigen::Vector2f>& values);
-  void set_uniform_array(const std::string& name, const std::vector<Eigen::Vector3f>& values);
-  void set_uniform_array(const std::string& name, const std::vector<float>& values);
+  void set_uniform_array(const UniformId& uniform, std::span<const Eigen::Vector2f> values);
+  void set_uniform_array(const UniformId& uniform, std::span<const Eigen::Vector3f> values);
+  void set_uniform_array(const UniformId& uniform, std::span<const float> values);
+
+  void set_uniform_array(const std::string& name, std::span<const Eigen::Vector2f> values);
+  void set_uniform_array(const std::string& name, std::span<const Eigen::Vector3f> values);
+  void set_uniform_array(const std::string& name, std::span<const float> values);
+
+  /**
+   * @brief Read a uniform block from the UniformBuffer bound to a binding point
+   * @param block Name of the uniform block
+   * @param binding_point Binding point passed to UniformBuffer::bind
+   * @note Only calls GL when the binding changes
+   */
+  void bind_uniform_block(const UniformId& block, uint32_t binding_point);
 
   /**
    * @brief Check if shader is valid and ready to use
@@ -78,35 +142,94 @@ public:
   ~Shader();
 
 private:
+  friend class ShaderCache;
+
+  /**
+   * @brief GL objects of a program whose compile and link were issued but not
+   * yet checked
+   */
+  struct PendingProgram {
+    uint32_t vertex_shader{0};
+    uint32_t fragment_shader{0};
+    uint32_t program{0};
+  };
+
   explicit Shader(uint32_t program_id) : program_id_(program_id) {}
 
+  /**
+   * @brief Issue compilation and linking without waiting for the driver
+   * @param vertex_source Vertex shader GLSL source code
+   * @param fragment_source Fragment shader GLSL source code
+   * @return GL objects to pass to finish_compile, error if GL objects could
+   * not be created
+   */
+  [[nodiscard]] static Result<PendingProgram, std::string>
+  start_compile(const std::string& vertex_source, const std::string& fragment_source);
+
+  /**
+   * @brief Check whether the driver finished a program started with start_compile
+   * @param pending_program Program to check
+   * @return True if finish_compile won't block, always true without
+   * GL_KHR_parallel_shader_compile
+   */
+  [[nodiscard]] static bool is_compile_finished(const PendingProgram& pending_program);
+
+  /**
+   * @brief Check the results of start_compile and release the shader stages
+   * @param pending_program Program to finish, its GL objects are always
+   * released or owned by the result
+   * @return Linked shader on success, compile or link log on failure
+   */
+  [[nodiscard]] static Result<std::unique_ptr<Shader>, std::string>
+  finish_compile(const PendingProgram& pending_program);
+
+  /// Location and last value of a uniform, indexed by UniformId::get_index
+  struct UniformSlot {
+    static constexpr int32_t unresolved_location{-2};
+
+    int32_t location{unresolved_location};
+    /// Bytes of value holding the last value set, 0 before the first set
+    uint8_t value_size{0};
+    std::array<std::byte, 16> value{};
+  };
+
   uint32_t program_id_{0};
-  std::unordered_map<std::string, int32_t> uniform_cache_;
+  std::vector<UniformSlot> uniform_slots_;
+  std::unordered_map<std::string, UniformId> uniform_ids_by_name_;
+  std::unordered_map<uint32_t, uint32_t> uniform_block_bindings_;
 
   /**
-   * @brief Get cached uniform location
+   * @brief Get a uniform's slot, looking its location up on first use
+   * @param uniform Uniform to get
+   * @return Slot whose location is -1 if the program has no such uniform
+   */
+  UniformSlot& get_uniform_slot(const UniformId& uniform);
+
+  /**
+   * @brief Get the UniformId of a name, interning it on first use
    * @param name Uniform variable name
-   * @return OpenGL uniform location, -1 if not found
+   * @return Id for the name
    */
-  int32_t get_uniform_location(const std::string& name);
+  const UniformId& get_uniform_id(const std::string& name);
 
   /**
-   * @brief Compile a single shader stage
-   * @param source GLSL source code
-   * @param shader_type GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
-   * @return Compiled shader ID on success, error message on failure
+   * @brief Store a new value in a uniform's slot
+   * @param slot Slot of the uniform being set
+   * @param value Value bytes, at most 16
+   * @param size Number of bytes in value
+   * @return True if the value differs from the last one set, i.e. GL must be
+   * called
    */
-  [[nodiscard]] static Result<uint32_t, std::string>
-  compile_shader(const std::string& source, uint32_t shader_type);
+  static bool update_uniform_value(UniformSlot& slot, const void* value, std::size_t size);
 
   /**
-   * @brief Link vertex and fragment shaders into program
-   * @param vertex_shader Compiled vertex shader ID
-   * @param fragment_shader Compiled fragment shader ID
-   * @return Linked program ID on success, error message on failure
+   * @brief Get the compile log of a shader stage if it failed
+   * @param shader Compiled shader stage ID
+   * @param shader_type GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+   * @return Ok() if the stage compiled, error with the info log otherwise
    */
-  [[nodiscard]] static Result<uint32_t, std::string>
-  link_program(uint32_t vertex_shader, uint32_t fragment_shader);
+  [[nodiscard]] static Result<void, std::string>
+  check_compile_status(uint32_t shader, uint32_t shader_type);
 };
 
 } // namespace view
\ No newline at end of file
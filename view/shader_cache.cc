@@ -0,0 +1,325 @@
+#include "view/shader_cache.hh"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace view {
+namespace {
+struct PreprocessedFiles {
+  std::string vertex_source;
+  std::string fragment_source;
+  std::vector<std::filesystem::path> dependencies;
+};
+
+Result<PreprocessedFiles, std::string>
+preprocess_shader_files(const ShaderFiles &files) {
+  PreprocessedFiles preprocessed;
+  // each stage is expanded on its own so both can include the same helpers
+  std::vector<std::filesystem::path> fragment_dependencies;
+  preprocessed.vertex_source =
+      TRY(preprocess_shader_file(files.vertex_path, preprocessed.dependencies));
+  preprocessed.fragment_source =
+      TRY(preprocess_shader_file(files.fragment_path, fragment_dependencies));
+  for (auto &dependency : fragment_dependencies) {
+    if (std::ranges::find(preprocessed.dependencies, dependency) ==
+        preprocessed.dependencies.end()) {
+      preprocessed.dependencies.push_back(std::move(dependency));
+    }
+  }
+  return Ok(std::move(preprocessed));
+}
+
+bool are_same_files(const ShaderFiles &lhs, const ShaderFiles &rhs) {
+  return lhs.vertex_path == rhs.vertex_path &&
+         lhs.fragment_path == rhs.fragment_path;
+}
+} // namespace
+
+const std::optional<std::string> &ShaderHandle::get_maybe_reload_error() const {
+  static const std::optional<std::string> no_error;
+  return cached_shader_ ? cached_shader_->maybe_reload_error : no_error;
+}
+
+ShaderCache &ShaderCache::get() {
+  static ShaderCache shader_cache;
+  return shader_cache;
+}
+
+ShaderCache::~ShaderCache() { stop_watcher(); }
+
+Result<ShaderHandle, std::string> ShaderCache::load(const ShaderFiles &files) {
+  const auto preprocessed = TRY(preprocess_shader_files(files));
+  auto cached_shader = TRY(
+      get_or_compile(preprocessed.vertex_source, preprocessed.fragment_source));
+
+  {
+    // the write times are read now so edits made after loading are reloaded
+    std::lock_guard lock(mutex_);
+    const bool is_watched =
+        std::ranges::any_of(watched_shaders_, [&](const auto &watched_shader) {
+          return are_same_files(watched_shader.files, files) &&
+                 watched_shader.cached_shader.lock() == cached_shader;
+        });
+    if (!is_watched) {
+      watched_shaders_.push_back(WatchedShader{
+          .cached_shader = cached_shader,
+          .files = files,
+          .dependencies = preprocessed.dependencies,
+          .dependency_write_times = get_write_times(preprocessed.dependencies),
+          .source_hash = cached_shader->source_hash,
+      });
+    }
+  }
+
+  return Ok(ShaderHandle(std::move(cached_shader)));
+}
+
+Result<ShaderHandle, std::string>
+ShaderCache::load_from_strings(const std::string &vertex_source,
+                               const std::string &fragment_source) {
+  return Ok(ShaderHandle(TRY(get_or_compile(vertex_source, fragment_source))));
+}
+
+Result<void, std::string>
+ShaderCache::precompile(const std::vector<ShaderFiles> &shader_files) {
+  std::string errors;
+  for (const auto &files : shader_files) {
+    const auto result = load(files);
+    if (result.isErr()) {
+      errors += files.vertex_path.string() + " + " +
+                files.fragment_path.string() + ": " + result.unwrapErr() +
+                "\n";
+    }
+  }
+  if (!errors.empty()) {
+    return Err(std::string("Failed to precompile shaders:\n") + errors);
+  }
+  return Ok();
+}
+
+void ShaderCache::enable_hot_reload(const std::chrono::milliseconds poll_interval) {
+  {
+    std::lock_guard lock(mutex_);
+    poll_interval_ = poll_interval;
+  }
+  if (!watcher_.joinable()) {
+    watcher_ = std::thread([this]() { run_watcher(); });
+  }
+}
+
+void ShaderCache::poll_hot_reload() {
+  std::vector<PendingReload> pending_reloads;
+  {
+    std::lock_guard lock(mutex_);
+    pending_reloads.swap(pending_reloads_);
+  }
+
+  for (auto &pending_reload : pending_reloads) {
+    const auto cached_shader = pending_reload.cached_shader.lock();
+    if (!cached_shader) {
+      continue;
+    }
+    if (pending_reload.maybe_error.has_value()) {
+      std::cerr << "Shader hot reload failed: "
+                << pending_reload.maybe_error.value() << std::endl;
+      cached_shader->maybe_reload_error = std::move(pending_reload.maybe_error);
+      continue;
+    }
+
+    auto start_result = Shader::start_compile(pending_reload.vertex_source,
+                                              pending_reload.fragment_source);
+    if (start_result.isErr()) {
+      std::cerr << "Shader hot reload failed: " << start_result.unwrapErr()
+                << std::endl;
+      cached_shader->maybe_reload_error = start_result.unwrapErr();
+      continue;
+    }
+    in_flight_reloads_.push_back(InFlightReload{
+        .cached_shader = cached_shader,
+        .pending_program = start_result.unwrap(),
+        .source_hash = pending_reload.source_hash,
+    });
+  }
+
+  // finish reloads in the order they were started, later ones for the same
+  // program then win
+  std::erase_if(in_flight_reloads_, [this](const InFlightReload &reload) {
+    if (!Shader::is_compile_finished(reload.pending_program)) {
+      return false;
+    }
+    auto finish_result = Shader::finish_compile(reload.pending_program);
+    const auto cached_shader = reload.cached_shader.lock();
+    if (!cached_shader) {
+      return true;
+    }
+    if (finish_result.isErr()) {
+      std::cerr << "Shader hot reload failed: " << finish_result.unwrapErr()
+                << std::endl;
+      cached_shader->maybe_reload_error = finish_result.unwrapErr();
+      return true;
+    }
+    cached_shader->shader = std::move(finish_result).unwrap();
+    cached_shader->maybe_reload_error.reset();
+    rekey(cached_shader, reload.source_hash);
+    return true;
+  });
+}
+
+void ShaderCache::clear() {
+  std::erase_if(shaders_by_hash_, [](const auto &hash_and_shader) {
+    return hash_and_shader.second.use_count() == 1;
+  });
+  std::lock_guard lock(mutex_);
+  std::erase_if(watched_shaders_, [](const WatchedShader &watched_shader) {
+    return watched_shader.cached_shader.expired();
+  });
+}
+
+void ShaderCache::shutdown() {
+  stop_watcher();
+  {
+    std::lock_guard lock(mutex_);
+    watched_shaders_.clear();
+    pending_reloads_.clear();
+    // enable_hot_reload may start a new watcher afterwards
+    should_stop_ = false;
+  }
+
+  // finishing is the only way to release the GL objects of a reload
+  for (const auto &reload : in_flight_reloads_) {
+    [[maybe_unused]] const auto finish_result =
+        Shader::finish_compile(reload.pending_program);
+  }
+  in_flight_reloads_.clear();
+  // handles may outlive the context, so their programs are deleted now and
+  // the handles left pointing at nothing
+  for (auto &[source_hash, cached_shader] : shaders_by_hash_) {
+    cached_shader->shader.reset();
+  }
+  shaders_by_hash_.clear();
+}
+
+Result<std::shared_ptr<CachedShader>, std::string>
+ShaderCache::get_or_compile(const std::string &vertex_source,
+                            const std::string &fragment_source) {
+  const uint64_t source_hash =
+      hash_shader_sources(vertex_source, fragment_source);
+  if (const auto it = shaders_by_hash_.find(source_hash);
+      it != shaders_by_hash_.end()) {
+    return Ok(it->second);
+  }
+
+  auto shader_result = Shader::from_strings(vertex_source, fragment_source);
+  if (shader_result.isErr()) {
+    return Err(shader_result.unwrapErr());
+  }
+  auto cached_shader = std::make_shared<CachedShader>();
+  cached_shader->shader = std::move(shader_result).unwrap();
+  cached_shader->source_hash = source_hash;
+  shaders_by_hash_.emplace(source_hash, cached_shader);
+  return Ok(std::move(cached_shader));
+}
+
+void ShaderCache::rekey(const std::shared_ptr<CachedShader> &cached_shader,
+                        const uint64_t new_source_hash) {
+  if (const auto it = shaders_by_hash_.find(cached_shader->source_hash);
+      it != shaders_by_hash_.end() && it->second == cached_shader) {
+    shaders_by_hash_.erase(it);
+  }
+  cached_shader->source_hash = new_source_hash;
+  // another program may already hold this source, it keeps the key
+  shaders_by_hash_.emplace(new_source_hash, cached_shader);
+}
+
+void ShaderCache::run_watcher() {
+  std::unique_lock lock(mutex_);
+  while (!should_stop_) {
+    stop_requested_.wait_for(lock, poll_interval_,
+                             [this]() { return should_stop_; });
+    if (should_stop_) {
+      return;
+    }
+
+    // files are read on a copy with the lock released so loads on the GL
+    // thread never wait on the disk
+    auto watched_shaders = watched_shaders_;
+    lock.unlock();
+
+    std::vector<PendingReload> pending_reloads;
+    for (auto &watched_shader : watched_shaders) {
+      auto write_times = get_write_times(watched_shader.dependencies);
+      if (write_times == watched_shader.dependency_write_times) {
+        continue;
+      }
+      watched_shader.dependency_write_times = std::move(write_times);
+
+      PendingReload pending_reload{.cached_shader = watched_shader.cached_shader};
+      auto preprocess_result = preprocess_shader_files(watched_shader.files);
+      if (preprocess_result.isErr()) {
+        pending_reload.maybe_error = preprocess_result.unwrapErr();
+        pending_reloads.push_back(std::move(pending_reload));
+        continue;
+      }
+
+      auto preprocessed = std::move(preprocess_result).unwrap();
+      // includes may have been added or removed
+      watched_shader.dependency_write_times =
+          get_write_times(preprocessed.dependencies);
+      watched_shader.dependencies = std::move(preprocessed.dependencies);
+      const uint64_t source_hash = hash_shader_sources(
+          preprocessed.vertex_source, preprocessed.fragment_source);
+      if (source_hash == watched_shader.source_hash) {
+        continue;
+      }
+      watched_shader.source_hash = source_hash;
+      pending_reload.vertex_source = std::move(preprocessed.vertex_source);
+      pending_reload.fragment_source = std::move(preprocessed.fragment_source);
+      pending_reload.source_hash = source_hash;
+      pending_reloads.push_back(std::move(pending_reload));
+    }
+
+    lock.lock();
+    // load() and clear() may have changed the list meanwhile, so match the
+    // updated copies back by program and files
+    for (auto &watched_shader : watched_shaders_) {
+      const auto it = std::ranges::find_if(
+          watched_shaders, [&watched_shader](const WatchedShader &updated) {
+            return !updated.cached_shader.owner_before(
+                       watched_shader.cached_shader) &&
+                   !watched_shader.cached_shader.owner_before(
+                       updated.cached_shader) &&
+                   are_same_files(updated.files, watched_shader.files);
+          });
+      if (it != watched_shaders.end()) {
+        watched_shader = std::move(*it);
+      }
+    }
+    std::ranges::move(pending_reloads, std::back_inserter(pending_reloads_));
+  }
+}
+
+void ShaderCache::stop_watcher() {
+  {
+    std::lock_guard lock(mutex_);
+    should_stop_ = true;
+  }
+  stop_requested_.notify_one();
+  if (watcher_.joinable()) {
+    watcher_.join();
+  }
+}
+
+std::vector<std::filesystem::file_time_type>
+ShaderCache::get_write_times(const std::vector<std::filesystem::path> &paths) {
+  std::vector<std::filesystem::file_time_type> write_times;
+  write_times.reserve(paths.size());
+  for (const auto &path : paths) {
+    std::error_code error;
+    const auto write_time = std::filesystem::last_write_time(path, error);
+    write_times.push_back(error ? std::filesystem::file_time_type::min()
+                                : write_time);
+  }
+  return write_times;
+}
+
+} // namespace view
@@ -0,0 +1,258 @@
+#pragma once
+#include "utility/try.hh"
+#include "view/shader.hh"
+#include "view/shader_source.hh"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace view {
+
+/**
+ * @brief Program shared by every handle loaded from the same source
+ *
+ * Hot reload replaces shader in place so every handle sees the new program.
+ * Only touched on the thread owning the GL context.
+ */
+struct CachedShader {
+  std::unique_ptr<Shader> shader;
+  uint64_t source_hash{0};
+  /// Error from the last hot reload, the previous program is kept meanwhile
+  std::optional<std::string> maybe_reload_error;
+};
+
+/**
+ * @brief Shared reference to a program owned by the ShaderCache
+ *
+ * Handles are cheap to copy. Don't hold on to the Shader a handle points at
+ * across frames since hot reload may replace it; look it up again instead.
+ */
+class ShaderHandle {
+public:
+  ShaderHandle() = default;
+
+  /**
+   * @brief Get the current program
+   * @return Shader, nullptr for an empty handle
+   */
+  [[nodiscard]] Shader *get() const {
+    return cached_shader_ ? cached_shader_->shader.get() : nullptr;
+  }
+
+  Shader &operator*() const { return *get(); }
+  Shader *operator->() const { return get(); }
+
+  /**
+   * @brief Check if the handle refers to a usable program
+   * @return True if the program compiled and linked
+   */
+  [[nodiscard]] bool is_valid() const {
+    return get() != nullptr && get()->is_valid();
+  }
+
+  /**
+   * @brief Get the hash of the preprocessed source the program was built from
+   * @return Source hash, 0 for an empty handle
+   */
+  [[nodiscard]] uint64_t get_source_hash() const {
+    return cached_shader_ ? cached_shader_->source_hash : 0U;
+  }
+
+  /**
+   * @brief Get the error from the last failed hot reload of this program
+   * @return Compile or preprocessing error, std::nullopt if the last reload
+   * succeeded or there was none
+   */
+  [[nodiscard]] const std::optional<std::string> &
+  get_maybe_reload_error() const;
+
+private:
+  friend class ShaderCache;
+  explicit ShaderHandle(std::shared_ptr<CachedShader> cached_shader)
+      : cached_shader_(std::move(cached_shader)) {}
+
+  std::shared_ptr<CachedShader> cached_shader_;
+};
+
+/**
+ * @brief Process wide cache of compiled shader programs
+ *
+ * Programs are keyed by a hash of their preprocessed source (see
+ * preprocess_shader_file), so every user of the same shader shares one
+ * compiled program, even when loading it through different paths.
+ *
+ * Hot reload is optional: once enabled a background thread polls the files
+ * (and their includes) of every program loaded from disk and preprocesses
+ * changed ones. poll_hot_reload(), called once per frame on the GL thread,
+ * starts compiling them and swaps the new program in once the driver is done,
+ * so frames never wait on the compiler. A failed reload keeps the previous
+ * program and reports the error through the handle.
+ *
+ * @note Programs which were loaded from different files with identical
+ * contents share an entry, so reloading either file updates both users.
+ */
+class ShaderCache {
+public:
+  /**
+   * @brief Get the process wide cache
+   * @return Cache shared by every shader user
+   */
+  [[nodiscard]] static ShaderCache &get();
+
+  ShaderCache() = default;
+
+  /**
+   * @brief Stop the hot reload thread if it is running
+   * @note Doesn't release programs, by then the GL context is usually gone,
+   * call shutdown() first
+   */
+  ~ShaderCache();
+
+  ShaderCache(const ShaderCache &) = delete;
+  ShaderCache &operator=(const ShaderCache &) = delete;
+
+  /**
+   * @brief Get the program for a pair of shader files, compiling it if needed
+   * @param files Vertex and fragment shader paths
+   * @return Handle to the cached program, error if reading, preprocessing or
+   * compiling fails
+   * @pre Called on the thread owning the GL context
+   */
+  [[nodiscard]] Result<ShaderHandle, std::string>
+  load(const ShaderFiles &files);
+
+  /**
+   * @brief Get the program for in-memory sources, compiling it if needed
+   * @param vertex_source Vertex shader GLSL source code
+   * @param fragment_source Fragment shader GLSL source code
+   * @return Handle to the cached program, error if compiling fails
+   * @pre Called on the thread owning the GL context
+   */
+  [[nodiscard]] Result<ShaderHandle, std::string>
+  load_from_strings(const std::string &vertex_source,
+                    const std::string &fragment_source);
+
+  /**
+   * @brief Compile programs up front, e.g. at startup before the first frame
+   * @param shader_files Programs to compile
+   * @return Ok() if every program compiled, otherwise an error listing every
+   * failure
+   * @post Later load() calls for these files don't compile
+   */
+  [[nodiscard]] Result<void, std::string>
+  precompile(const std::vector<ShaderFiles> &shader_files);
+
+  /**
+   * @brief Start watching the files of every program loaded from disk
+   * @param poll_interval How often the background thread checks for changes
+   * @post Calling again only changes the poll interval
+   */
+  void enable_hot_reload(
+      std::chrono::milliseconds poll_interval = std::chrono::milliseconds{250});
+
+  /**
+   * @brief Start compiling changed programs and swap in finished ones
+   * @post Programs whose reload compiled are replaced for every handle
+   * @note Cheap when nothing changed, call once per frame on the GL thread
+   */
+  void poll_hot_reload();
+
+  /**
+   * @brief Drop every cached program not referenced by a handle
+   * @pre Called on the thread owning the GL context
+   */
+  void clear();
+
+  /**
+   * @brief Stop the hot reload thread and release every program, including
+   * ones still referenced by handles, which become invalid
+   * @pre Called on the thread owning the GL context while it still exists,
+   * the Screen does this when it is destroyed
+   * @post Loading again starts from an empty cache
+   */
+  void shutdown();
+
+private:
+  /// Program loaded from disk, owned by the watcher thread once registered
+  struct WatchedShader {
+    std::weak_ptr<CachedShader> cached_shader;
+    ShaderFiles files;
+    std::vector<std::filesystem::path> dependencies;
+    std::vector<std::filesystem::file_time_type> dependency_write_times;
+    uint64_t source_hash{0};
+  };
+
+  /// Changed sources handed from the watcher thread to poll_hot_reload
+  struct PendingReload {
+    std::weak_ptr<CachedShader> cached_shader;
+    std::string vertex_source;
+    std::string fragment_source;
+    uint64_t source_hash{0};
+    std::optional<std::string> maybe_error;
+  };
+
+  /// Reload whose program the driver may still be compiling
+  struct InFlightReload {
+    std::weak_ptr<CachedShader> cached_shader;
+    Shader::PendingProgram pending_program;
+    uint64_t source_hash{0};
+  };
+
+  /**
+   * @brief Find or compile the program for preprocessed sources
+   */
+  [[nodiscard]] Result<std::shared_ptr<CachedShader>, std::string>
+  get_or_compile(const std::string &vertex_source,
+                 const std::string &fragment_source);
+
+  /**
+   * @brief Point the hash lookup at a program whose source changed
+   */
+  void rekey(const std::shared_ptr<CachedShader> &cached_shader,
+             const uint64_t new_source_hash);
+
+  /**
+   * @brief Watcher thread body, polls watched files until stopped
+   */
+  void run_watcher();
+
+  /**
+   * @brief Ask the watcher thread to stop and wait for it
+   */
+  void stop_watcher();
+
+  /**
+   * @brief Read the write times of files, missing files get the minimum time
+   */
+  [[nodiscard]] static std::vector<std::filesystem::file_time_type>
+  get_write_times(const std::vector<std::filesystem::path> &paths);
+
+  /// Programs by source hash, only used on the GL thread
+  std::unordered_map<uint64_t, std::shared_ptr<CachedShader>>
+      shaders_by_hash_;
+
+  /// Reloads started by poll_hot_reload, only used on the GL thread
+  std::vector<InFlightReload> in_flight_reloads_;
+
+  /// Guards everything shared with the watcher thread below
+  std::mutex mutex_;
+  std::condition_variable stop_requested_;
+  std::vector<WatchedShader> watched_shaders_;
+  std::vector<PendingReload> pending_reloads_;
+  std::chrono::milliseconds poll_interval_{250};
+  bool should_stop_{false};
+
+  // started by enable_hot_reload and declared last so everything it uses is
+  // constructed first
+  std::thread watcher_;
+};
+
+} // namespace view
@@ -0,0 +1,91 @@
+#include "view/shader_source.hh"
+#include <algorithm>
+#include <fstream>
+
+namespace view {
+namespace {
+constexpr int max_include_depth{16};
+
+/// @return the quoted path of an #include line, empty if line isn't one
+std::string_view get_include_path(std::string_view line) {
+  const auto first = line.find_first_not_of(" \t");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  line.remove_prefix(first);
+  constexpr std::string_view directive = "#include";
+  if (!line.starts_with(directive)) {
+    return {};
+  }
+  line.remove_prefix(directive.size());
+  const auto open_quote = line.find('"');
+  const auto close_quote = line.find('"', open_quote + 1);
+  if (open_quote == std::string_view::npos ||
+      close_quote == std::string_view::npos) {
+    return {};
+  }
+  return line.substr(open_quote + 1, close_quote - open_quote - 1);
+}
+
+Result<void, std::string>
+append_preprocessed_file(const std::filesystem::path &path, const int depth,
+                         std::vector<std::filesystem::path> &dependencies,
+                         std::string &output) {
+  if (depth > max_include_depth) {
+    return Err(std::string("Shader includes nest too deeply at: ") +
+               path.string());
+  }
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return Err(std::string("Failed to open shader file: ") + path.string());
+  }
+  dependencies.push_back(path);
+
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto include_path = get_include_path(line);
+    if (include_path.empty()) {
+      output += line;
+      output += '\n';
+      continue;
+    }
+
+    const auto included_path =
+        (path.parent_path() / include_path).lexically_normal();
+    if (std::ranges::find(dependencies, included_path) != dependencies.end()) {
+      continue;
+    }
+    TRY_VOID(append_preprocessed_file(included_path, depth + 1, dependencies,
+                                      output));
+  }
+  return Ok();
+}
+} // namespace
+
+Result<std::string, std::string>
+preprocess_shader_file(const std::filesystem::path &path,
+                       std::vector<std::filesystem::path> &dependencies) {
+  std::string output;
+  TRY_VOID(append_preprocessed_file(path, 0, dependencies, output));
+  return Ok(std::move(output));
+}
+
+uint64_t hash_shader_sources(std::string_view vertex_source,
+                             std::string_view fragment_source) {
+  constexpr uint64_t fnv_offset_basis{14695981039346656037ULL};
+  constexpr uint64_t fnv_prime{1099511628211ULL};
+  uint64_t hash = fnv_offset_basis;
+  const auto hash_bytes = [&hash](std::string_view bytes) {
+    for (const char byte : bytes) {
+      hash ^= static_cast<uint8_t>(byte);
+      hash *= fnv_prime;
+    }
+  };
+  hash_bytes(vertex_source);
+  // separate the stages so moving text from one to the other changes the hash
+  hash_bytes(std::string_view{"\0", 1});
+  hash_bytes(fragment_source);
+  return hash;
+}
+
+} // namespace view
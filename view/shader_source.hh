@@ -0,0 +1,46 @@
+#pragma once
+#include "utility/try.hh"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace view {
+
+/**
+ * @brief Paths of the two stages of a shader program
+ */
+struct ShaderFiles {
+  std::filesystem::path vertex_path;   ///< Vertex shader file (.vert)
+  std::filesystem::path fragment_path; ///< Fragment shader file (.frag)
+};
+
+/**
+ * @brief Read a shader file and expand its #include directives
+ *
+ * A line of the form #include "relative/path.glsl" is replaced by the contents
+ * of that file, resolved relative to the including file and expanded
+ * recursively. Each file is only included once so shared helpers can be
+ * included from several places.
+ *
+ * @param path Shader file to read
+ * @param[out] dependencies Every file read, starting with path, appended in
+ * the order they were opened
+ * @return Expanded source, error if a file can't be read or includes nest too
+ * deeply
+ */
+[[nodiscard]] Result<std::string, std::string>
+preprocess_shader_file(const std::filesystem::path &path,
+                       std::vector<std::filesystem::path> &dependencies);
+
+/**
+ * @brief Hash the preprocessed sources of a program
+ * @param vertex_source Preprocessed vertex shader source
+ * @param fragment_source Preprocessed fragment shader source
+ * @return 64 bit FNV-1a hash, identical sources always hash equal
+ */
+[[nodiscard]] uint64_t hash_shader_sources(std::string_view vertex_source,
+                                           std::string_view fragment_source);
+
+} // namespace view
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "view/shader_source.hh"
+#include <filesystem>
+#include <fstream>
+
+using namespace view;
+
+namespace {
+std::filesystem::path make_temp_shader_directory(const std::string &name) {
+  const auto directory =
+      std::filesystem::temp_directory_path() / "shader_source_test" / name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+
+void write_file(const std::filesystem::path &path, const std::string &contents) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream file(path);
+  file << contents;
+}
+} // namespace
+
+TEST_CASE("Shader include expansion", "[shader_source]") {
+  const auto directory = make_temp_shader_directory("includes");
+  write_file(directory / "common" / "math.glsl", "float square(float x);\n");
+  write_file(directory / "common" / "light.glsl",
+             "#include \"math.glsl\"\nvec3 light();\n");
+
+  SECTION("Includes are expanded relative to the including file") {
+    write_file(directory / "shader.frag",
+               "#version 330 core\n#include \"common/light.glsl\"\nvoid main() {}\n");
+    std::vector<std::filesystem::path> dependencies;
+    const auto result =
+        preprocess_shader_file(directory / "shader.frag", dependencies);
+
+    REQUIRE(result.isOk());
+    CHECK(result.unwrap() == "#version 330 core\nfloat square(float x);\n"
+                             "vec3 light();\nvoid main() {}\n");
+    REQUIRE(dependencies.size() == 3);
+    CHECK(dependencies[0] == directory / "shader.frag");
+    CHECK(dependencies[1] == directory / "common" / "light.glsl");
+    CHECK(dependencies[2] == directory / "common" / "math.glsl");
+  }
+
+  SECTION("Each file is only included once") {
+    write_file(directory / "shader.frag",
+               "  #include \"common/math.glsl\"\n#include \"common/light.glsl\"\n");
+    std::vector<std::filesystem::path> dependencies;
+    const auto result =
+        preprocess_shader_file(directory / "shader.frag", dependencies);
+
+    REQUIRE(result.isOk());
+    CHECK(result.unwrap() == "float square(float x);\nvec3 light();\n");
+    CHECK(dependencies.size() == 3);
+  }
+
+  SECTION("Missing includes are reported") {
+    write_file(directory / "shader.frag", "#include \"missing.glsl\"\n");
+    std::vector<std::filesystem::path> dependencies;
+    const auto result =
+        preprocess_shader_file(directory / "shader.frag", dependencies);
+
+    REQUIRE(result.isErr());
+    CHECK(result.unwrapErr().find("missing.glsl") != std::string::npos);
+  }
+}
+
+TEST_CASE("Shader source hashing", "[shader_source]") {
+  CHECK(hash_shader_sources("vertex", "fragment") ==
+        hash_shader_sources("vertex", "fragment"));
+  CHECK(hash_shader_sources("vertex", "fragment") !=
+        hash_shader_sources("vertex", "fragment "));
+  // text moved between the stages is a different program
+  CHECK(hash_shader_sources("ab", "c") != hash_shader_sources("a", "bc"));
+}
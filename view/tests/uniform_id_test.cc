@@ -0,0 +1,15 @@
+#include <catch2/catch_test_macros.hpp>
+#include "view/shader.hh"
+
+using namespace view;
+
+TEST_CASE("Uniform ids are interned by name", "[shader]") {
+  const UniformId viewport_size{"uniform_id_test_viewport_size"};
+  const UniformId same_name{std::string("uniform_id_test_viewport_size")};
+  const UniformId other_name{"uniform_id_test_light_color"};
+
+  CHECK(viewport_size.get_index() == same_name.get_index());
+  CHECK(viewport_size.get_index() != other_name.get_index());
+  CHECK(viewport_size.get_name() == "uniform_id_test_viewport_size");
+  CHECK(other_name.get_name() == "uniform_id_test_light_color");
+}
@@ -0,0 +1,14 @@
+#include "view/text_mesh.hh"
+
+namespace view {
+
+void TextMesh::set_text(const std::string_view text, const float font_size_px) {
+  if (text == text_ && font_size_px == font_size_px_) {
+    return;
+  }
+  text_.assign(text);
+  font_size_px_ = font_size_px;
+  needs_layout_ = true;
+}
+
+} // namespace view
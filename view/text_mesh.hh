@@ -0,0 +1,51 @@
+#pragma once
+#include <Eigen/Dense>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace view {
+class Screen;
+
+/// Retained layout of a string of text
+///
+/// Holding on to a TextMesh between frames means the glyph layout is only
+/// recomputed when the string or the font size changes, drawing an unchanged
+/// mesh just copies its quads into the screen's text batch.
+class TextMesh {
+public:
+  /// Set the text to display
+  /// @param[in] text string to display, may contain newlines
+  /// @param[in] font_size_px height of a line of text in pixels
+  /// @post the mesh will be laid out again on the next draw if either the text
+  /// or size changed
+  void set_text(const std::string_view text, const float font_size_px);
+
+  /// @return text currently held by the mesh
+  [[nodiscard]] std::string_view get_text() const { return text_; }
+
+  /// @return font size the mesh is laid out for in pixels
+  [[nodiscard]] float get_font_size_px() const { return font_size_px_; }
+
+  /// @return size of the laid out text in pixels, zero until the mesh has been
+  /// drawn once
+  [[nodiscard]] Eigen::Vector2f get_size_px() const { return size_px_; }
+
+private:
+  friend class Screen;
+
+  /// Single glyph relative to the top left corner of the text
+  struct GlyphQuad {
+    Eigen::Vector2f top_left_px;
+    Eigen::Vector2f bottom_right_px;
+    Eigen::Vector2f top_left_uv;
+    Eigen::Vector2f bottom_right_uv;
+  };
+
+  std::string text_;
+  float font_size_px_{0.0f};
+  bool needs_layout_{true};
+  std::vector<GlyphQuad> glyph_quads_;
+  Eigen::Vector2f size_px_{0.0f, 0.0f};
+};
+} // namespace view
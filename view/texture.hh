@@ -6,6 +6,7 @@
 
 namespace view {
 class Screen;
+class QuadBatch;
 
 class Texture {
 public:
@@ -16,6 +17,7 @@ public:
 
 private:
   friend class Screen;
+  friend class QuadBatch;
   std::shared_ptr<sf::Texture> texture_;
   Eigen::Vector2f bottom_left_uv_;
   Eigen::Vector2f top_right_uv_;
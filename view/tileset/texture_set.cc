@@ -12,6 +12,14 @@ TextureSet::parse_texture_set(const std::filesystem::path path) {
   if (find_result != s_texture_set_cache.end()) {
     return Ok(&find_result->second);
   }
+  auto texture_set = TRY(parse_texture_set_uncached(path));
+  const auto [it, _] =
+      s_texture_set_cache.emplace(path.string(), std::move(texture_set));
+  return Ok(&it->second);
+}
+
+Result<TextureSet, std::string>
+TextureSet::parse_texture_set_uncached(const std::filesystem::path &path) {
   try {
     TextureSet texture_set;
     const auto node = YAML::LoadFile(path);
@@ -61,8 +69,7 @@ TextureSet::parse_texture_set(const std::filesystem::path path) {
         }
       }
     }
-    s_texture_set_cache.emplace(path.string(), texture_set);
-    return Ok(&s_texture_set_cache[path.string()]);
+    return Ok(std::move(texture_set));
   } catch (const std::runtime_error exception) {
     return Err(std::string(exception.what()));
   }
@@ -16,6 +16,14 @@ public:
   static Result<TextureSet *, std::string>
   parse_texture_set(const std::filesystem::path path);
 
+  /// Parse texture set from a file without looking it up in or adding it to
+  /// the cache
+  ///
+  /// @param[in] path yaml file describing a texture set
+  /// @return errors if yaml file doesn't exists or contains errors
+  static Result<TextureSet, std::string>
+  parse_texture_set_uncached(const std::filesystem::path &path);
+
   /// TODO: error
   std::vector<Texture>
   get_texture_sequence_by_name(const std::string_view sequence_name) const;
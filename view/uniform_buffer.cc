@@ -0,0 +1,61 @@
+#include "view/uniform_buffer.hh"
+#include <GL/glew.h>
+#include <cstring>
+
+namespace view {
+
+UniformBuffer::~UniformBuffer() { release(); }
+
+UniformBuffer::UniformBuffer(UniformBuffer &&other) noexcept
+    : contents_(std::move(other.contents_)), buffer_id_(other.buffer_id_) {
+  other.buffer_id_ = 0U;
+}
+
+UniformBuffer &UniformBuffer::operator=(UniformBuffer &&other) noexcept {
+  if (this != &other) {
+    release();
+    contents_ = std::move(other.contents_);
+    buffer_id_ = other.buffer_id_;
+    other.buffer_id_ = 0U;
+  }
+  return *this;
+}
+
+bool UniformBuffer::upload_bytes(const void *data, const std::size_t size_bytes) {
+  const bool is_same_size = buffer_id_ != 0U && contents_.size() == size_bytes;
+  if (is_same_size && std::memcmp(contents_.data(), data, size_bytes) == 0) {
+    return false;
+  }
+
+  if (buffer_id_ == 0U) {
+    glGenBuffers(1, &buffer_id_);
+  }
+  glBindBuffer(GL_UNIFORM_BUFFER, buffer_id_);
+  if (is_same_size) {
+    // keeps the allocation, the driver only copies the new contents
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(size_bytes),
+                    data);
+  } else {
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size_bytes), data,
+                 GL_DYNAMIC_DRAW);
+  }
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+  contents_.resize(size_bytes);
+  std::memcpy(contents_.data(), data, size_bytes);
+  return true;
+}
+
+void UniformBuffer::bind(const uint32_t binding_point) const {
+  glBindBufferBase(GL_UNIFORM_BUFFER, binding_point, buffer_id_);
+}
+
+void UniformBuffer::release() {
+  if (buffer_id_ != 0U) {
+    glDeleteBuffers(1, &buffer_id_);
+    buffer_id_ = 0U;
+  }
+  contents_.clear();
+}
+
+} // namespace view
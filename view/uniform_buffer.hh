@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace view {
+
+/// Block of uniforms stored in a GPU buffer (a uniform buffer object), read by
+/// shaders through a `layout(std140) uniform` block
+///
+/// One upload replaces every value in the block and binding another buffer
+/// switches all of them at once, so passes drawing with the same program
+/// keep one buffer each instead of setting uniforms one by one. Uploads
+/// matching the current contents are skipped. GPU objects are created lazily
+/// on the first upload so a UniformBuffer can be constructed before the GL
+/// context exists.
+///
+/// OpenGL 3.3 only guarantees blocks of 16 KiB, larger or unbounded arrays
+/// belong in a BufferTexture.
+class UniformBuffer {
+public:
+  UniformBuffer() = default;
+  ~UniformBuffer();
+
+  UniformBuffer(const UniformBuffer &) = delete;
+  UniformBuffer &operator=(const UniformBuffer &) = delete;
+  UniformBuffer(UniformBuffer &&other) noexcept;
+  UniformBuffer &operator=(UniformBuffer &&other) noexcept;
+
+  /// Replace the contents with a struct matching the std140 layout of a block
+  /// @return true if the contents changed and were sent to the GPU
+  template <typename Block> bool upload(const Block &block) {
+    static_assert(std::is_trivially_copyable_v<Block>);
+    return upload_bytes(&block, sizeof(Block));
+  }
+
+  /// Replace the contents with size_bytes bytes from data
+  /// @return true if the contents changed and were sent to the GPU
+  bool upload_bytes(const void *data, const std::size_t size_bytes);
+
+  /// Bind to a binding point so blocks bound there with
+  /// Shader::bind_uniform_block read it
+  void bind(const uint32_t binding_point) const;
+
+private:
+  void release();
+
+  /// Copy of the last upload, compared against to skip redundant uploads
+  std::vector<std::byte> contents_;
+  uint32_t buffer_id_{0U};
+};
+
+} // namespace view
@@ -12,7 +12,7 @@
 #include "wiz/components/health_bar.hh"
 #include "wiz/components/hit_hurt_boxes.hh"
 #include "wiz/map/map.hh"
-#include "wiz/pathfinding/pathfinder.hh"
+#include "wiz/pathfinding/flow_fields.hh"
 #include "wiz/player.hh"
 
 namespace wiz {
@@ -74,8 +74,8 @@ Result<void, std::string> Skeleton::update(const int64_t delta_time_ns) {
       duration_in_being_hit_ns_ = 0L;
     }
   } else {
-    // Use A* pathfinding to move towards player
-    TRY_VOID(follow_path_to_player(delta_time_ns));
+    // Follow the shared flow field towards the player
+    TRY_VOID(follow_path_to_player());
 
     if (direction_.x() > 0) {
       mode_ = CharacterMode::walking_right;
@@ -90,9 +90,7 @@ Result<void, std::string> Skeleton::update(const int64_t delta_time_ns) {
     position_ += direction_ * (static_cast<double>(delta_time_ns) / 1e9);
   }
 
-  for (const auto &component : components_) {
-    TRY_VOID(component->update(delta_time_ns));
-  }
+  TRY_VOID(update_components(delta_time_ns));
   return Ok();
 }
 
@@ -101,25 +99,8 @@ Eigen::Affine2f Skeleton::get_transform() const {
       position_, Eigen::Vector2f{0.07f, 0.1f});
 }
 
-Result<void, std::string> Skeleton::follow_path_to_player(const int64_t delta_time_ns) {
-  time_since_last_replan_ns_ += delta_time_ns;
-
-  // Get player position
-  auto player = TRY(game_state_.get_entity_pointer_by_type<Player>());
-
-  // Replan if we don't have a path or it's time to replan
-  if (!maybe_current_path_on_tiles_ || time_since_last_replan_ns_ > replan_delay_ns_) {
-    auto maybe_new_path = pathfinding::find_path(game_state_, position_, player->position, movement_type);
-    if (maybe_new_path.isOk()) {
-      maybe_current_path_on_tiles_ = std::move(maybe_new_path.unwrap());
-      time_since_last_replan_ns_ = 0L;
-    } else {
-      // If pathfinding fails, fall back to direct movement
-      direction_ = (player->position - position_).normalized() * speed_m_per_s_;
-      return Ok();
-    }
-  }
-
+Result<void, std::string> Skeleton::follow_path_to_player() {
+  const auto player = TRY(game_state_.get_entity_pointer_by_type<Player>());
   const auto map = TRY(game_state_.get_entity_pointer_by_type<Map>());
   const auto current_tile = map->get_tile_index_by_position(position_);
   const auto goal_tile = map->get_tile_index_by_position(player->position);
@@ -130,24 +111,17 @@ Result<void, std::string> Skeleton::follow_path_to_player(const int64_t delta_ti
     return Ok();
   }
 
-  // Check if we have a valid path
-  if (maybe_current_path_on_tiles_->size() < 2) {
+  // Every skeleton shares one flow field toward the player's tile
+  auto flow_fields = TRY(game_state_.get_entity_pointer_by_type<FlowFields>());
+  const auto maybe_next_tile =
+      TRY(flow_fields->get_next_tile(current_tile, goal_tile, movement_type));
+  if (!maybe_next_tile.has_value()) {
     direction_ = {0.f, 0.f};
     return Ok();
   }
 
-  // Remove completed waypoints
-  if (current_tile == maybe_current_path_on_tiles_->at(1)) {
-    maybe_current_path_on_tiles_->pop_front();
-    if (maybe_current_path_on_tiles_->size() < 2) {
-      direction_ = {0.f, 0.f};
-      return Ok();
-    }
-  }
-
-  // Move towards next waypoint
-  const auto next_tile = maybe_current_path_on_tiles_->at(1);
-  const auto next_position = map->get_tile_position_by_index(next_tile);
+  // Move towards next tile
+  const auto next_position = map->get_tile_position_by_index(*maybe_next_tile);
   direction_ = (next_position - position_).normalized().cast<float>() * speed_m_per_s_;
 
   return Ok();
@@ -3,8 +3,6 @@
 #include "wiz/character_mode.hh"
 #include "wiz/map/map.hh"
 #include <cstdint>
-#include <deque>
-#include <optional>
 
 namespace wiz {
 class Skeleton : public model::Entity {
@@ -49,11 +47,8 @@ private:
 
   // Pathfinding members
   float speed_m_per_s_{0.25f};
-  int64_t replan_delay_ns_{500'000'000L};
-  int64_t time_since_last_replan_ns_{0L};
-  std::optional<std::deque<Eigen::Vector2i>> maybe_current_path_on_tiles_;
 
   // Pathfinding methods
-  Result<void, std::string> follow_path_to_player(const int64_t delta_time_ns);
+  Result<void, std::string> follow_path_to_player();
 };
 } // namespace wiz
@@ -1,11 +1,12 @@
 #include "wiz/good_npcs/worker.hh"
 #include "geometry/rectangle_utils.hh"
 #include "model/game_state.hh"
+#include "utility/random.hh"
 #include "view/tileset/texture_set.hh"
 #include "wiz/components/character_animation_set.hh"
 #include "wiz/map/grass_tile.hh"
 #include "wiz/map/map.hh"
-#include "wiz/pathfinding/pathfinder.hh"
+#include "wiz/pathfinding/flow_fields.hh"
 #include <ranges>
 
 namespace wiz {
@@ -35,7 +36,7 @@ Result<void, std::string> Worker::init(const Eigen::Vector2f position) {
       10.f,
       10.f};
 
-  const auto random_result = dist(rng_);
+  const auto random_result = dist(utility::get_rng());
   if (random_result == 1) {
     // pass in order to stick with cyan
   } else if (random_result == 2) {
@@ -91,28 +92,7 @@ Result<void, std::string> Worker::init(const Eigen::Vector2f position) {
   return Ok();
 }
 
-Result<void, std::string> Worker::plan() {
-  const auto map = TRY(game_state_.get_entity_pointer_by_type<Map>());
-  const auto goal_position = map->get_tile_position_by_index(goal_tile_);
-
-  auto maybe_path = pathfinding::find_path(game_state_, position_, goal_position, movement_type);
-  if (maybe_path.isOk()) {
-    maybe_current_path_on_tiles_ = std::move(maybe_path.unwrap());
-  } else {
-    maybe_current_path_on_tiles_.reset();
-  }
-
-  return Ok();
-}
-
-Result<void, std::string> Worker::follow_path(const int64_t delta_time_ns) {
-  time_since_last_replan_ += delta_time_ns;
-  if (!maybe_current_path_on_tiles_ ||
-      time_since_last_replan_ > replan_delay_) {
-    TRY_VOID(plan());
-    time_since_last_replan_ = 0L;
-  }
-
+Result<void, std::string> Worker::follow_path() {
   const auto map = TRY(game_state_.get_entity_pointer_by_type<Map>());
   const auto current_position = map->get_tile_index_by_position(position_);
   const auto current_tile =
@@ -127,34 +107,27 @@ Result<void, std::string> Worker::follow_path(const int64_t delta_time_ns) {
     return Ok();
   }
 
-  if (maybe_current_path_on_tiles_->size() < 2) {
+  // every worker shares one flow field toward the goal
+  auto flow_fields = TRY(game_state_.get_entity_pointer_by_type<FlowFields>());
+  const auto maybe_next_tile = TRY(
+      flow_fields->get_next_tile(current_position, goal_tile_, movement_type));
+  if (!maybe_next_tile.has_value()) {
     direction_ = {0.f, 0.f};
     return Ok();
   }
 
-  if (current_position == maybe_current_path_on_tiles_->at(1)) {
-    maybe_current_path_on_tiles_->pop_front();
-    if (maybe_current_path_on_tiles_->size() < 2) {
-      direction_ = {0.f, 0.f};
-      return Ok();
-    }
-  }
-
-  const auto next_tile = maybe_current_path_on_tiles_->at(1);
-  const auto next_position = map->get_tile_position_by_index(next_tile);
+  const auto next_position = map->get_tile_position_by_index(*maybe_next_tile);
   direction_ = (next_position - position_).normalized().cast<float>() * speed_;
   return Ok();
 }
 
 Result<void, std::string> Worker::update(const int64_t delta_time_ns) {
-  TRY_VOID(follow_path(delta_time_ns));
+  TRY_VOID(follow_path());
   position_ += direction_ * (static_cast<double>(delta_time_ns) / 1e9);
 
   mode_ = CharacterMode::walking_right;
 
-  for (const auto &component : components_) {
-    TRY_VOID(component->update(delta_time_ns));
-  }
+  TRY_VOID(update_components(delta_time_ns));
   return Ok();
 }
 
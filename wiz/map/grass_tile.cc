@@ -2,6 +2,7 @@
 #include "components/collider.hh"
 #include "components/sprite.hh"
 #include "geometry/rectangle_utils.hh"
+#include "utility/random.hh"
 #include "view/tileset/texture_set.hh"
 #include "wiz/components/hit_hurt_boxes.hh"
 #include "wiz/player.hh"
@@ -13,8 +14,13 @@ namespace wiz {
 GrassTile::GrassTile(model::GameState &game_state)
     : model::Entity(game_state) {}
 
-Result<void, std::string> GrassTile::init(const Eigen::Vector2f position, const float size) {
+Result<void, std::string> GrassTile::init(const Eigen::Vector2f position,
+                                          const float size,
+                                          SetTileTextureFunc set_tile_texture,
+                                          FlowersChangedFunc on_flowers_changed) {
   position_ = position;
+  set_tile_texture_ = std::move(set_tile_texture);
+  on_flowers_changed_ = std::move(on_flowers_changed);
   const Eigen::Vector2f tile_size_vec{size * 0.5f, size * 0.5f};
   transform_ = geometry::make_rectangle_from_center_and_size(position_, tile_size_vec);
 
@@ -41,8 +47,7 @@ Result<void, std::string> GrassTile::init(const Eigen::Vector2f position, const
 
   const auto *texture_set = TRY(view::TextureSet::parse_texture_set(
       std::filesystem::path(texture_set_path)));
-  std::random_device dev;
-  std::mt19937 rng(dev());
+  auto &rng = utility::get_rng();
 
   const auto grass_texture_set =
       texture_set->get_texture_set_by_name(grass_texture_name);
@@ -63,11 +68,7 @@ Result<void, std::string> GrassTile::init(const Eigen::Vector2f position, const
   maybe_tree_texture_.emplace(
       texture_set->get_texture_set_by_name(tree_texture_name)[tree_dist(rng)]);
 
-  add_component<component::Sprite>([this]() {
-    return component::Sprite::SpriteInfo{
-        transform_, has_flowers_ ? maybe_flower_texture_.value()
-                                 : maybe_grass_texture_.value()};
-  });
+  TRY_VOID(set_tile_texture_(maybe_grass_texture_.value()));
 
   std::uniform_int_distribution<std::mt19937::result_type> has_tree_dist(0,
                                                                          100);
@@ -79,6 +80,7 @@ Result<void, std::string> GrassTile::init(const Eigen::Vector2f position, const
 }
 
 Result<void, std::string> GrassTile::update(const int64_t) {
+  const bool had_flowers = has_flowers_;
   if (has_player_) {
     has_flowers_ = true;
     has_player_ = false;
@@ -87,6 +89,12 @@ Result<void, std::string> GrassTile::update(const int64_t) {
     has_flowers_ = false;
     was_hit_ = false;
   }
+
+  if (has_flowers_ != had_flowers) {
+    TRY_VOID(set_tile_texture_(has_flowers_ ? maybe_flower_texture_.value()
+                                            : maybe_grass_texture_.value()));
+    on_flowers_changed_(has_flowers_);
+  }
   return Ok();
 }
 
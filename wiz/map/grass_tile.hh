@@ -1,13 +1,34 @@
 #pragma once
 #include "model/game_state.hh"
+#include "view/texture.hh"
+#include <functional>
 
 namespace wiz {
 class GrassTile : public model::Entity {
 public:
   static constexpr std::string_view entity_type_name = "wiz_grass_tile";
+
+  /// Callback used to hand the tile's current texture to the map's tile layer,
+  /// the tile doesn't draw itself
+  using SetTileTextureFunc =
+      std::function<Result<void, std::string>(const view::Texture &)>;
+
+  /// Callback used to tell the map the tile's flowers appeared or were
+  /// removed, called with the new flower state
+  using FlowersChangedFunc = std::function<void(bool)>;
+
   GrassTile(model::GameState &game_state);
 
-  Result<void, std::string> init(const Eigen::Vector2f position, const float size);
+  /// Initialize the grass tile
+  /// @param[in] position world coordinates for the center of the tile
+  /// @param[in] size side length of the tile
+  /// @param[in] set_tile_texture called with the grass texture during init and
+  /// again whenever the flower state changes
+  /// @param[in] on_flowers_changed called whenever the flower state changes
+  Result<void, std::string> init(const Eigen::Vector2f position,
+                                 const float size,
+                                 SetTileTextureFunc set_tile_texture,
+                                 FlowersChangedFunc on_flowers_changed);
 
   [[nodiscard]] virtual std::string_view get_entity_type_name() const {
     return entity_type_name;
@@ -32,6 +53,8 @@ private:
   std::optional<view::Texture> maybe_flower_texture_;
   std::optional<view::Texture> maybe_grass_texture_;
   std::optional<view::Texture> maybe_tree_texture_;
+  SetTileTextureFunc set_tile_texture_;
+  FlowersChangedFunc on_flowers_changed_;
   Eigen::Vector2f position_;
   Eigen::Affine2f transform_;
   bool has_tree_{false};
@@ -1,4 +1,5 @@
 #include "wiz/map/map.hh"
+#include "components/tile_layer.hh"
 #include "model/game_state.hh"
 #include "wiz/map/grass_tile.hh"
 #include "wiz/map/wall_tile.hh"
@@ -7,7 +8,10 @@
 
 namespace wiz {
 
-Map::Map(model::GameState &game_state) : model::Entity(game_state) {}
+Map::Map(model::GameState &game_state)
+    : model::Entity(game_state),
+      walkability_{algs::BitGrid{get_map_size()}, algs::BitGrid{get_map_size()},
+                   algs::BitGrid{get_map_size()}} {}
 
 Result<void, std::string> Map::init() {
   std::array<std::array<bool, map_size_x>, map_size_y> grid;
@@ -38,6 +42,16 @@ Result<void, std::string> Map::init() {
     rc_generator.print_map_ascii();
   }
 
+  const component::TileLayer::TileLayerParams tile_layer_params{
+      .origin_m = {0.0f, 0.0f},
+      .tile_size_m = tile_size,
+      .size_in_tiles = {static_cast<int32_t>(map_size_x),
+                        static_cast<int32_t>(map_size_y)},
+      .chunk_size_in_tiles = tile_layer_chunk_size,
+  };
+  grass_layer_ = add_component<component::TileLayer>(tile_layer_params);
+  wall_layer_ = add_component<component::TileLayer>(tile_layer_params);
+
   int wall_count = 0;
   int grass_count = 0;
 
@@ -45,22 +59,38 @@ Result<void, std::string> Map::init() {
     for (const auto j : std::ranges::views::iota(int64_t{0}, map_size_y)) {
       const Eigen::Vector2f position{static_cast<float>(i) * tile_size,
                                      static_cast<float>(j) * tile_size};
+      const Eigen::Vector2i tile_index{static_cast<int32_t>(i),
+                                       static_cast<int32_t>(j)};
 
       if (grid[i][j]) {
-        const auto entity = add_child_entity_and_init<WallTile>(position, tile_size);
+        const auto entity = add_child_entity_and_init<WallTile>(
+            position, tile_size,
+            [this, tile_index](const view::Texture &texture) {
+              return wall_layer_->set_tile(tile_index, texture);
+            });
         if (entity.isErr()) {
           return Err(std::string("Failed to create WallTile at position (") +
                      std::to_string(i) + ", " + std::to_string(j) + "): " + entity.unwrapErr());
         }
         map_tiles_[i][j] = entity.unwrap()->get_entity_id();
+        set_wall_tile_walkability(tile_index);
         wall_count++;
       } else {
-        const auto entity = add_child_entity_and_init<GrassTile>(position, tile_size);
+        const auto entity = add_child_entity_and_init<GrassTile>(
+            position, tile_size,
+            [this, tile_index](const view::Texture &texture) {
+              return grass_layer_->set_tile(tile_index, texture);
+            },
+            [this, tile_index](const bool has_flowers) {
+              set_grass_tile_walkability(tile_index, has_flowers);
+            });
         if (entity.isErr()) {
           return Err(std::string("Failed to create GrassTile at position (") +
                      std::to_string(i) + ", " + std::to_string(j) + "): " + entity.unwrapErr());
         }
         map_tiles_[i][j] = entity.unwrap()->get_entity_id();
+        set_grass_tile_walkability(tile_index,
+                                   entity.unwrap()->has_flowers());
         grass_count++;
       }
     }
@@ -102,48 +132,52 @@ Map::get_map_tile_entity_by_index(const Eigen::Vector2i tile_index) const {
   return Ok(map_tiles_[tile_index.x()][tile_index.y()]);
 }
 
-bool Map::is_walkable_tile(const Eigen::Vector2i tile_index,
-                           MapInteractionType interaction_type) const {
-  const auto maybe_tile_entity = get_map_tile_entity_by_index(tile_index);
-  if (maybe_tile_entity.isErr()) {
-    return false;
-  }
+void Map::set_grass_tile_walkability(const Eigen::Vector2i tile_index,
+                                     const bool has_flowers) {
+  set_tile_walkability(tile_index,
+                       MapInteractionType::walk_on_grass_and_flowers, true);
+  set_tile_walkability(tile_index, MapInteractionType::walk_only_on_grass,
+                       !has_flowers);
+  set_tile_walkability(tile_index, MapInteractionType::walk_only_on_flowers,
+                       has_flowers);
+}
 
-  // Check if it's a wall tile (not walkable)
-  const auto maybe_wall_tile =
-      game_state_.get_entity_pointer_by_id_as<WallTile>(
-          maybe_tile_entity.unwrap());
-  if (maybe_wall_tile.isOk()) {
-    // Wall tiles are never walkable
-    return false;
+void Map::set_wall_tile_walkability(const Eigen::Vector2i tile_index) {
+  for (auto &walkability : walkability_) {
+    walkability.set(tile_index, false);
   }
+}
 
-  // Check if it's a grass tile
-  const auto maybe_grass_tile =
-      game_state_.get_entity_pointer_by_id_as<GrassTile>(
-          maybe_tile_entity.unwrap());
-  if (maybe_grass_tile.isErr()) {
-    // Not a grass tile or wall tile, check for other walkable tile types
-    // For now, only grass tiles are walkable
-    // TODO: Add checks for other walkable tile types (like paths) here
-    return false;
+void Map::set_tile_walkability(const Eigen::Vector2i tile_index,
+                               MapInteractionType interaction_type,
+                               const bool is_walkable) {
+  const auto type_index = static_cast<std::size_t>(interaction_type);
+  if (!walkability_[type_index].set(tile_index, is_walkable)) {
+    return;
   }
+  auto &tile_changes = tile_changes_[type_index];
+  if (tile_changes.size() >= max_logged_tile_changes) {
+    tile_changes.clear();
+    first_logged_tile_change_versions_[type_index] =
+        walkability_versions_[type_index];
+  }
+  tile_changes.push_back(tile_index);
+  ++walkability_versions_[type_index];
+}
 
-  const auto* grass_tile = maybe_grass_tile.unwrap();
-
-  switch (interaction_type) {
-    case MapInteractionType::walk_on_grass_and_flowers:
-      // Can walk on grass regardless of flower state
-      return true;
-    case MapInteractionType::walk_only_on_grass:
-      // Can only walk on grass without flowers
-      return !grass_tile->has_flowers();
-    case MapInteractionType::walk_only_on_flowers:
-      // Can only walk on grass with flowers
-      return grass_tile->has_flowers();
-    default:
-      return false;
+std::optional<std::span<const Eigen::Vector2i>>
+Map::get_tile_changes_since(MapInteractionType interaction_type,
+                            const uint64_t version) const {
+  const auto type_index = static_cast<std::size_t>(interaction_type);
+  const uint64_t first_logged_version =
+      first_logged_tile_change_versions_[type_index];
+  if (version < first_logged_version ||
+      version > walkability_versions_[type_index]) {
+    return std::nullopt;
   }
+  const std::span<const Eigen::Vector2i> tile_changes{tile_changes_[type_index]};
+  return tile_changes.subspan(
+      static_cast<std::size_t>(version - first_logged_version));
 }
 
 bool Map::is_valid_tile_index(const Eigen::Vector2i tile_index) const {
@@ -1,8 +1,16 @@
 #pragma once
+#include "algs/bit_grid.hh"
 #include "model/entity_id.hh"
 #include "model/game_state.hh"
 #include "wiz/map/cellular_automata_generator.hh"
 #include "wiz/map/room_corridor_generator.hh"
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace component {
+class TileLayer;
+}
 
 namespace wiz {
 
@@ -29,6 +37,9 @@ enum class MapInteractionType {
   walk_only_on_flowers
 };
 
+/// Number of MapInteractionType values
+static constexpr std::size_t map_interaction_type_count{3UL};
+
 /**
  * @brief Main map entity that manages the game world grid and all tile entities.
  *
@@ -37,6 +48,8 @@ enum class MapInteractionType {
  * - Providing coordinate conversion between world positions and tile indices
  * - Offering tile lookup and validation methods for gameplay systems
  * - Serving as the parent entity for all map tiles
+ * - Drawing all tiles through cached grass and wall tile layers, tiles hand
+ *   their textures to the layers rather than drawing themselves
  *
  * The map internally decides which type of tile to place at each grid position
  * based on its generation logic, rather than accepting external tile type arrays.
@@ -105,12 +118,39 @@ public:
 
   /**
    * @brief Check if a tile allows movement based on interaction type.
+   *
+   * Reads a cached bit rather than looking up the tile entity, so it is cheap
+   * enough for pathfinding inner loops.
+   *
    * @param tile_index Grid coordinates to check
    * @param interaction_type The type of movement interaction to check
    * @return true if the tile allows the specified movement, false otherwise
    */
   [[nodiscard]] bool is_walkable_tile(const Eigen::Vector2i tile_index,
-                                      MapInteractionType interaction_type) const;
+                                      MapInteractionType interaction_type) const {
+    return get_walkability(interaction_type).get(tile_index);
+  }
+
+  /**
+   * @brief Get the walkability of every tile for an interaction type.
+   *
+   * Kept up to date by the tiles, pathfinders can read it directly.
+   *
+   * @param interaction_type The type of movement interaction
+   * @return One bit per tile, set where the tile allows that movement
+   */
+  [[nodiscard]] const algs::BitGrid &
+  get_walkability(MapInteractionType interaction_type) const {
+    return walkability_[static_cast<std::size_t>(interaction_type)];
+  }
+
+  /**
+   * @brief Get the size of the tile grid.
+   * @return Number of tiles along x and y
+   */
+  [[nodiscard]] static Eigen::Vector2i get_map_size() {
+    return {static_cast<int>(map_size_x), static_cast<int>(map_size_y)};
+  }
 
   /**
    * @brief Check if grid coordinates are within map bounds.
@@ -119,6 +159,37 @@ public:
    */
   [[nodiscard]] bool is_valid_tile_index(const Eigen::Vector2i tile_index) const;
 
+  /**
+   * @brief Get a counter which changes whenever walkability for an
+   * interaction type may have changed.
+   *
+   * Anything derived from walkability, like a flow field, can store this and
+   * rebuild once it no longer matches.
+   *
+   * @param interaction_type The type of movement interaction
+   * @return Current version of that interaction type's walkability
+   */
+  [[nodiscard]] uint64_t
+  get_walkability_version(MapInteractionType interaction_type) const {
+    return walkability_versions_[static_cast<std::size_t>(interaction_type)];
+  }
+
+  /**
+   * @brief Get the tiles whose walkability changed since a version.
+   *
+   * Each version step is one tile changing, so anything derived from
+   * walkability can repair just the affected tiles instead of rebuilding.
+   * Only the most recent changes are kept.
+   *
+   * @param interaction_type The type of movement interaction
+   * @param version Value of get_walkability_version() when last in sync
+   * @return Tiles in the order they changed, may repeat, or nullopt if
+   * changes since that version are no longer kept
+   */
+  [[nodiscard]] std::optional<std::span<const Eigen::Vector2i>>
+  get_tile_changes_since(MapInteractionType interaction_type,
+                         const uint64_t version) const;
+
   /**
    * @brief Check if a grass tile has flowers (legacy function).
    * @param tile_index Grid coordinates to check
@@ -129,10 +200,43 @@ public:
   get_map_tile_is_grass_and_has_flowers(const Eigen::Vector2i tile_index) const;
 
 private:
+  /// Set the walkability of a grass tile, called at creation and by the tile
+  /// whenever its flowers appear or are removed
+  void set_grass_tile_walkability(const Eigen::Vector2i tile_index,
+                                  const bool has_flowers);
+
+  /// Walls can't be walked on by anything
+  void set_wall_tile_walkability(const Eigen::Vector2i tile_index);
+
+  /// Update one walkability bit, bumping the version and logging the tile if
+  /// it changed
+  void set_tile_walkability(const Eigen::Vector2i tile_index,
+                            MapInteractionType interaction_type,
+                            const bool is_walkable);
+
   static constexpr int64_t map_size_x{30UL};
   static constexpr int64_t map_size_y{30UL};
   static constexpr float tile_size{0.2f};
 
+  /// Number of tiles along each side of a tile layer chunk
+  static constexpr uint32_t tile_layer_chunk_size{8U};
+
+  /// Changes logged per interaction type before the log is cleared, past
+  /// this many changes a rebuild is as cheap as a repair anyway
+  static constexpr std::size_t max_logged_tile_changes{256UL};
+
   std::array<std::array<model::EntityID, map_size_x>, map_size_y> map_tiles_;
+
+  std::array<algs::BitGrid, map_interaction_type_count> walkability_;
+  std::array<uint64_t, map_interaction_type_count> walkability_versions_{};
+  /// Tiles changed since the matching first logged version, in order
+  std::array<std::vector<Eigen::Vector2i>, map_interaction_type_count>
+      tile_changes_;
+  std::array<uint64_t, map_interaction_type_count>
+      first_logged_tile_change_versions_{};
+
+  /// Owned by components_, grass is drawn first then walls
+  component::TileLayer *grass_layer_{nullptr};
+  component::TileLayer *wall_layer_{nullptr};
 };
 } // namespace wiz
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <iostream>
 #include <random>
 #include <vector>
 
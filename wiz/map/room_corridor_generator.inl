@@ -10,16 +10,12 @@ RoomCorridorGenerator<MapSizeX, MapSizeY>::generate() {
   MapGrid grid;
   rooms_.clear();
 
-  std::cout << "Generating room-corridor map...\n";
-
   initialize_with_walls(grid);
   generate_rooms(grid);
   connect_rooms(grid);
   add_interior_walls(grid);
   ensure_border_walls(grid);
 
-  std::cout << "Generated " << rooms_.size() << " rooms\n";
-
   current_grid_ = grid;
   return grid;
 }
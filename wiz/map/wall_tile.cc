@@ -1,7 +1,7 @@
 #include "wiz/map/wall_tile.hh"
 #include "components/collider.hh"
-#include "components/sprite.hh"
 #include "geometry/rectangle_utils.hh"
+#include "utility/random.hh"
 #include "view/tileset/texture_set.hh"
 #include <random>
 
@@ -9,8 +9,9 @@ namespace wiz {
 
 WallTile::WallTile(model::GameState &game_state) : model::Entity(game_state) {}
 
-Result<void, std::string> WallTile::init(const Eigen::Vector2f position,
-                                         const float size) {
+Result<void, std::string>
+WallTile::init(const Eigen::Vector2f position, const float size,
+               const SetTileTextureFunc &set_tile_texture) {
   position_ = position;
   // Shrink wall tiles by epsilon to prevent touching adjacent walls from
   // triggering warnings
@@ -32,17 +33,11 @@ Result<void, std::string> WallTile::init(const Eigen::Vector2f position,
       texture_set->get_texture_set_by_name(stone_texture_name);
 
   // Use random stone texture variant
-  std::random_device dev;
-  std::mt19937 rng(dev());
+  auto &rng = utility::get_rng();
   std::uniform_int_distribution<std::mt19937::result_type> stone_dist(
       0, stone_texture_set.size() - 1);
-  maybe_stone_texture_.emplace(stone_texture_set[stone_dist(rng)]);
-
-  // Add sprite component for rendering
-  add_component<component::Sprite>([this]() {
-    return component::Sprite::SpriteInfo{transform_,
-                                         maybe_stone_texture_.value()};
-  });
+  // Walls never change so the texture is only handed to the tile layer once
+  TRY_VOID(set_tile_texture(stone_texture_set[stone_dist(rng)]));
 
   return Ok();
 }
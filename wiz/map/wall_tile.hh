@@ -1,5 +1,7 @@
 #pragma once
 #include "model/game_state.hh"
+#include "view/texture.hh"
+#include <functional>
 
 namespace wiz {
 
@@ -14,15 +16,23 @@ class WallTile : public model::Entity {
 public:
   static constexpr std::string_view entity_type_name = "wiz_wall_tile";
 
+  /// Callback used to hand the tile's texture to the map's tile layer, the
+  /// tile doesn't draw itself
+  using SetTileTextureFunc =
+      std::function<Result<void, std::string>(const view::Texture &)>;
+
   WallTile(model::GameState &game_state);
 
   /**
    * @brief Initialize the wall tile at the specified position.
    * @param position World coordinates for the center of this wall tile
    * @param size Size of the tile in world units
+   * @param set_tile_texture Called once with the chosen stone texture
    * @return Ok() on success, Err(message) if initialization fails
    */
-  Result<void, std::string> init(const Eigen::Vector2f position, const float size);
+  Result<void, std::string> init(const Eigen::Vector2f position,
+                                 const float size,
+                                 const SetTileTextureFunc &set_tile_texture);
 
   [[nodiscard]] virtual std::string_view get_entity_type_name() const {
     return entity_type_name;
@@ -30,15 +40,11 @@ public:
 
   [[nodiscard]] virtual Eigen::Affine2f get_transform() const;
 
-  /// Wall tiles are drawn above grass but below characters
-  [[nodiscard]] virtual uint8_t get_z_level() const { return 1; }
-
 private:
   static constexpr std::string_view texture_set_path{
       "sprites/wiz/map_textures/texture_set.yaml"};
   static constexpr std::string_view stone_texture_name{"stone"};
 
-  std::optional<view::Texture> maybe_stone_texture_;
   Eigen::Vector2f position_;
   Eigen::Affine2f transform_;
 };
@@ -6,6 +6,7 @@
 #include "wiz/good_npcs/worker.hh"
 #include "wiz/map/map.hh"
 #include "wiz/movable_stone.hh"
+#include "wiz/pathfinding/flow_fields.hh"
 #include "wiz/player.hh"
 #include "wiz/spawner.hh"
 
@@ -49,6 +50,7 @@ Result<void, std::string> WizModeManager::update(const int64_t delta_time_ns) {
 
 Result<void, std::string> WizModeManager::start_new_game() {
   TRY(add_child_entity_and_init<Map>());
+  TRY(add_child_entity<FlowFields>());
   TRY(add_child_entity_and_init<Player>());
   TRY(add_child_entity_and_init<MovableStone>(Eigen::Vector2f{1.0f, 1.0f}));
   TRY(add_child_entity_and_init<Spawner<Skeleton>>(
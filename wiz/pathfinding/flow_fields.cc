@@ -0,0 +1,77 @@
+#include "wiz/pathfinding/flow_fields.hh"
+#include <algorithm>
+
+namespace wiz {
+
+FlowFields::FlowFields(model::GameState &game_state)
+    : model::Entity(game_state) {}
+
+Result<std::optional<Eigen::Vector2i>, std::string>
+FlowFields::get_next_tile(const Eigen::Vector2i &tile,
+                          const Eigen::Vector2i &goal_tile,
+                          MapInteractionType movement_type) {
+  const auto *field = TRY(get_field(goal_tile, movement_type));
+  return Ok(field->get_maybe_next_cell(tile));
+}
+
+Result<const algs::FlowField *, std::string>
+FlowFields::get_field(const Eigen::Vector2i &goal_tile,
+                      MapInteractionType movement_type) {
+  const auto map = TRY(game_state_.get_entity_pointer_by_type<Map>());
+  const uint64_t walkability_version =
+      map->get_walkability_version(movement_type);
+  ++use_count_;
+
+  auto cached_field = std::find_if(
+      fields_.begin(), fields_.end(), [&](const CachedField &cached) {
+        return cached.goal_tile == goal_tile &&
+               cached.movement_type == movement_type;
+      });
+  const auto is_walkable = [&map, movement_type](const Eigen::Vector2i &tile) {
+    return map->is_walkable_tile(tile, movement_type);
+  };
+  if (cached_field != fields_.end()) {
+    cached_field->last_use = use_count_;
+    const algs::FlowField *field = &cached_field->field;
+    if (cached_field->walkability_version == walkability_version) {
+      return Ok(field);
+    }
+    const auto maybe_tile_changes = map->get_tile_changes_since(
+        movement_type, cached_field->walkability_version);
+    if (maybe_tile_changes.has_value()) {
+      cached_field->field.update_cells(*maybe_tile_changes, is_walkable);
+      cached_field->walkability_version = walkability_version;
+      ++repair_count_;
+      return Ok(field);
+    }
+  }
+
+  if (cached_field == fields_.end()) {
+    if (fields_.size() < max_cached_fields) {
+      fields_.push_back(CachedField{.goal_tile = goal_tile,
+                                    .movement_type = movement_type,
+                                    .walkability_version = 0UL,
+                                    .last_use = 0UL,
+                                    .field = algs::FlowField(
+                                        Map::get_map_size())});
+      cached_field = std::prev(fields_.end());
+    } else {
+      cached_field = std::min_element(
+          fields_.begin(), fields_.end(),
+          [](const CachedField &a, const CachedField &b) {
+            return a.last_use < b.last_use;
+          });
+    }
+  }
+
+  cached_field->goal_tile = goal_tile;
+  cached_field->movement_type = movement_type;
+  cached_field->walkability_version = walkability_version;
+  cached_field->last_use = use_count_;
+  cached_field->field.build(goal_tile, is_walkable);
+  ++build_count_;
+  const algs::FlowField *field = &cached_field->field;
+  return Ok(field);
+}
+
+} // namespace wiz
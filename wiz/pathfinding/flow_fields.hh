@@ -0,0 +1,80 @@
+#pragma once
+#include "algs/flow_field.hh"
+#include "model/game_state.hh"
+#include "wiz/map/map.hh"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace wiz {
+
+/**
+ * @brief Flow fields shared by every agent heading to the same goal.
+ *
+ * Keeps one algs::FlowField per (goal tile, MapInteractionType) and brings it
+ * up to date only when it is asked for after the map's walkability for that
+ * movement type changed. Fields are repaired from the map's log of changed
+ * tiles, which only revisits tiles whose cost changed, and rebuilt when the
+ * log no longer covers the change. Agents sample their next tile instead of
+ * each running A*, so agents already on their way pick up the repaired route
+ * without replanning.
+ */
+class FlowFields : public model::Entity {
+public:
+  static constexpr std::string_view entity_type_name = "wiz_flow_fields";
+
+  FlowFields(model::GameState &game_state);
+
+  [[nodiscard]] virtual std::string_view get_entity_type_name() const {
+    return entity_type_name;
+  };
+
+  /**
+   * @brief Get the tile to walk to next on the way to a goal.
+   *
+   * If the goal can't be reached this leads to the reachable tile closest to
+   * it, the same as pathfinding::find_path.
+   *
+   * @param tile Tile the agent is on
+   * @param goal_tile Tile the agent is heading to
+   * @param movement_type Type of tiles the agent can walk on
+   * @return Ok(next tile), Ok(nullopt) once there is nowhere closer to go, or
+   * Err(message) if there is no map
+   */
+  [[nodiscard]] Result<std::optional<Eigen::Vector2i>, std::string>
+  get_next_tile(const Eigen::Vector2i &tile, const Eigen::Vector2i &goal_tile,
+                MapInteractionType movement_type);
+
+  /**
+   * @return Number of fields built since this was created
+   */
+  [[nodiscard]] std::size_t get_build_count() const { return build_count_; }
+
+  /**
+   * @return Number of fields repaired from tile changes since this was created
+   */
+  [[nodiscard]] std::size_t get_repair_count() const { return repair_count_; }
+
+private:
+  /// Fields for goals nobody has asked about recently are dropped past this
+  static constexpr std::size_t max_cached_fields{8UL};
+
+  struct CachedField {
+    Eigen::Vector2i goal_tile;
+    MapInteractionType movement_type;
+    uint64_t walkability_version;
+    /// Value of use_count_ when last asked for, the lowest is replaced first
+    uint64_t last_use;
+    algs::FlowField field;
+  };
+
+  [[nodiscard]] Result<const algs::FlowField *, std::string>
+  get_field(const Eigen::Vector2i &goal_tile, MapInteractionType movement_type);
+
+  std::vector<CachedField> fields_;
+  uint64_t use_count_{0UL};
+  std::size_t build_count_{0UL};
+  std::size_t repair_count_{0UL};
+};
+
+} // namespace wiz
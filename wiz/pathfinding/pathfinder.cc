@@ -1,86 +1,100 @@
 #include "wiz/pathfinding/pathfinder.hh"
-#include "algs/a_star.hh"
+#include "algs/grid_a_star.hh"
+#include "algs/hierarchical_a_star.hh"
+#include "algs/jump_point_search.hh"
 #include "wiz/map/map.hh"
+#include <array>
+#include <optional>
 
 namespace wiz {
 namespace pathfinding {
+namespace {
+
+/// Abstract graph for one movement type along with the map it was built from
+struct HierarchicalGraph {
+  std::optional<model::EntityID> maybe_map_id;
+  uint64_t walkability_version{0UL};
+  algs::HierarchicalAStar hierarchical_a_star{Map::get_map_size()};
+};
+
+/// Bring a graph up to date with the map, rebuilding only the clusters of
+/// tiles which changed when the map still has the changes logged
+template <typename IsWalkableFunctor>
+void sync_graph(const Map &map, MapInteractionType movement_type,
+                const IsWalkableFunctor &is_walkable,
+                HierarchicalGraph &graph) {
+  const model::EntityID map_id = map.get_entity_id();
+  const uint64_t walkability_version =
+      map.get_walkability_version(movement_type);
+  if (graph.maybe_map_id == map_id &&
+      graph.walkability_version == walkability_version) {
+    return;
+  }
+  const auto maybe_tile_changes =
+      graph.maybe_map_id == map_id
+          ? map.get_tile_changes_since(movement_type,
+                                       graph.walkability_version)
+          : std::nullopt;
+  if (maybe_tile_changes.has_value()) {
+    graph.hierarchical_a_star.update_cells(*maybe_tile_changes, is_walkable);
+  } else {
+    graph.hierarchical_a_star.build(is_walkable);
+  }
+  graph.maybe_map_id = map_id;
+  graph.walkability_version = walkability_version;
+}
+
+} // namespace
 
 Result<std::deque<Eigen::Vector2i>, std::string> find_path(
     model::GameState& game_state,
     const Eigen::Vector2f& start_position,
     const Eigen::Vector2f& goal_position,
     MapInteractionType movement_type,
-    size_t max_nodes_to_explore) {
+    size_t max_nodes_to_explore,
+    PathfindingAlgorithm algorithm) {
 
   const auto map = TRY(game_state.get_entity_pointer_by_type<Map>());
   const auto start_tile = map->get_tile_index_by_position(start_position);
   const auto goal_tile = map->get_tile_index_by_position(goal_position);
 
-  auto distance_func = [](const Eigen::Vector2i &tile_a,
-                          const Eigen::Vector2i &tile_b) {
-    return (tile_a - tile_b).norm();
-  };
-
-  auto get_neighbors = [&map, movement_type](const Eigen::Vector2i &tile_index) {
-    std::array<Eigen::Vector2i, 4> side_neighbors_deltas{
-        Eigen::Vector2i{0, 1},  Eigen::Vector2i{0, -1}, Eigen::Vector2i{1, 0},
-        Eigen::Vector2i{-1, 0}
-    };
-
-    std::array<Eigen::Vector2i, 4> diagonal_neighbors_deltas{
-        Eigen::Vector2i{1, 1},  Eigen::Vector2i{-1, -1},
-        Eigen::Vector2i{-1, 1}, Eigen::Vector2i{1, -1}
-    };
-
-    algs::Neighbors<Eigen::Vector2i, 8> neighbors;
-
-    // Add cardinal direction neighbors
-    for (const auto &neighbor_delta : side_neighbors_deltas) {
-      const auto neighbor_tile_index = tile_index + neighbor_delta;
-      if (map->is_walkable_tile(neighbor_tile_index, movement_type)) {
-        neighbors.neighbor_array[neighbors.num_neighbors++] = neighbor_tile_index;
-      }
-    }
+  // the search state is sized to the whole map, so it is kept between calls
+  // rather than reallocated, one per thread since workers may plan in parallel
+  thread_local std::vector<Eigen::Vector2i> path;
 
-    // Add diagonal neighbors only if both adjacent cardinal directions are walkable
-    for (const auto &neighbor_delta : diagonal_neighbors_deltas) {
-      const auto neighbor_tile_index = tile_index + neighbor_delta;
-      const Eigen::Vector2i adjacent_side_tile1 = {neighbor_tile_index.x(), tile_index.y()};
-      const Eigen::Vector2i adjacent_side_tile2 = {tile_index.x(), neighbor_tile_index.y()};
-
-      uint8_t num_adjacent_side_tiles_included{0U};
-      for (size_t i = 0; i < neighbors.num_neighbors; ++i) {
-        const auto existing_neighbor = neighbors.neighbor_array[i];
-        if (adjacent_side_tile1 == existing_neighbor ||
-            adjacent_side_tile2 == existing_neighbor) {
-          num_adjacent_side_tiles_included++;
-        }
-      }
-
-      // Only allow diagonal movement if both adjacent cardinal directions are walkable
-      if (num_adjacent_side_tiles_included == 2 &&
-          map->is_walkable_tile(neighbor_tile_index, movement_type)) {
-        neighbors.neighbor_array[neighbors.num_neighbors++] = neighbor_tile_index;
-      }
-    }
-
-    return neighbors;
-  };
-
-  auto heuristic_function = [goal_tile](const Eigen::Vector2i &tile_index) {
-    return (tile_index - goal_tile).norm();
+  const auto is_walkable = [&map, movement_type](const Eigen::Vector2i &tile) {
+    return map->is_walkable_tile(tile, movement_type);
   };
 
-  std::optional<std::deque<Eigen::Vector2i>> maybe_path;
-  TRY_VOID(algs::a_star<Eigen::Vector2i, 8>(
-      distance_func, get_neighbors, heuristic_function, start_tile, goal_tile,
-      max_nodes_to_explore, maybe_path));
-
-  if (!maybe_path.has_value()) {
-    return Err(std::string("No path found from start to goal"));
+  switch (algorithm) {
+  case PathfindingAlgorithm::a_star: {
+    thread_local algs::GridAStar grid_a_star{Map::get_map_size()};
+    const auto get_neighbors = [&is_walkable](const Eigen::Vector2i &tile) {
+      return algs::get_grid_neighbors(tile, is_walkable);
+    };
+    TRY_VOID(grid_a_star.find_path(algs::GridStepCost{}, get_neighbors,
+                                   algs::OctileHeuristic{goal_tile},
+                                   start_tile, goal_tile, max_nodes_to_explore,
+                                   path));
+    break;
+  }
+  case PathfindingAlgorithm::jump_point_search: {
+    thread_local algs::JumpPointSearch jump_point_search{Map::get_map_size()};
+    TRY_VOID(jump_point_search.find_path(is_walkable, start_tile, goal_tile,
+                                         max_nodes_to_explore, path));
+    break;
+  }
+  case PathfindingAlgorithm::hierarchical: {
+    thread_local std::array<HierarchicalGraph, map_interaction_type_count>
+        graphs;
+    auto &graph = graphs[static_cast<std::size_t>(movement_type)];
+    sync_graph(*map, movement_type, is_walkable, graph);
+    TRY_VOID(graph.hierarchical_a_star.find_path(start_tile, goal_tile, path));
+    break;
+  }
   }
 
-  return Ok(std::move(maybe_path.value()));
+  return Ok(std::deque<Eigen::Vector2i>(path.begin(), path.end()));
 }
 
 } // namespace pathfinding
@@ -14,6 +14,21 @@ namespace wiz {
  */
 namespace pathfinding {
 
+/**
+ * @brief Search used by find_path, both find paths of the same cost but may
+ * pick different ones when several are equally cheap.
+ */
+enum class PathfindingAlgorithm {
+  /// algs::GridAStar, checks the fewest tiles on open maps
+  a_star,
+  /// algs::JumpPointSearch, expands far fewer nodes around walls but checks
+  /// more tiles while scanning
+  jump_point_search,
+  /// algs::HierarchicalAStar, precomputes an abstract graph per movement type
+  /// so long routes on large maps stay cheap, paths may be slightly longer
+  hierarchical
+};
+
 /**
  * @brief Calculates an A* path from start to goal position.
  *
@@ -21,7 +36,9 @@ namespace pathfinding {
  * @param start_position Starting position in world coordinates
  * @param goal_position Goal position in world coordinates
  * @param movement_type Type of tiles this entity can walk on
- * @param max_nodes_to_explore Maximum nodes to explore before giving up (default 500)
+ * @param max_nodes_to_explore Maximum nodes to explore before giving up (default 500),
+ *        jump point search only counts jump points, hierarchical search ignores it
+ * @param algorithm Search to use, plain A* by default
  * @return Ok(path) containing tile indices from start to goal, or Err(message) if no path found
  * @post If successful, returned path contains at least start tile
  * @post Path tiles are valid and walkable for the given movement type
@@ -31,7 +48,8 @@ Result<std::deque<Eigen::Vector2i>, std::string> find_path(
     const Eigen::Vector2f& start_position,
     const Eigen::Vector2f& goal_position,
     MapInteractionType movement_type,
-    size_t max_nodes_to_explore = 500);
+    size_t max_nodes_to_explore = 500,
+    PathfindingAlgorithm algorithm = PathfindingAlgorithm::a_star);
 
 } // namespace pathfinding
 } // namespace wiz
\ No newline at end of file
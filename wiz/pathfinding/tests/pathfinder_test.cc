@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algs/grid_a_star.hh"
+#include "model/game_state.hh"
+#include "wiz/map/grass_tile.hh"
+#include "wiz/map/map.hh"
+#include "wiz/pathfinding/pathfinder.hh"
+#include <algorithm>
+#include <deque>
+
+using namespace wiz;
+
+namespace {
+constexpr auto movement_type = MapInteractionType::walk_only_on_grass;
+
+
+float get_path_cost(const std::deque<Eigen::Vector2i> &path) {
+  float cost = 0.f;
+  for (std::size_t i = 1; i < path.size(); ++i) {
+    cost += algs::GridStepCost{}(path[i - 1], path[i]);
+  }
+  return cost;
+}
+
+Result<std::deque<Eigen::Vector2i>, std::string>
+find_tile_path(model::GameState &game_state, const Map &map,
+               const Eigen::Vector2i &start_tile,
+               const Eigen::Vector2i &goal_tile,
+               const pathfinding::PathfindingAlgorithm algorithm) {
+  // enough for plain A* to search the whole map
+  const auto max_nodes_to_explore =
+      static_cast<std::size_t>(Map::get_map_size().prod());
+  return pathfinding::find_path(game_state,
+                                map.get_tile_position_by_index(start_tile),
+                                map.get_tile_position_by_index(goal_tile),
+                                movement_type, max_nodes_to_explore, algorithm);
+}
+
+/// The hierarchical path is walkable and about as cheap as the A* one
+void check_matches_a_star(model::GameState &game_state, const Map &map,
+                          const Eigen::Vector2i &start_tile,
+                          const Eigen::Vector2i &goal_tile) {
+  const auto a_star_path =
+      find_tile_path(game_state, map, start_tile, goal_tile,
+                     pathfinding::PathfindingAlgorithm::a_star)
+          .unwrap();
+  const auto hierarchical_result =
+      find_tile_path(game_state, map, start_tile, goal_tile,
+                     pathfinding::PathfindingAlgorithm::hierarchical);
+  // hierarchical search fails rather than returning a partial path
+  const bool is_reachable = a_star_path.back() == goal_tile;
+  REQUIRE(hierarchical_result.isOk() == is_reachable);
+  if (!is_reachable) {
+    return;
+  }
+  const auto hierarchical_path = hierarchical_result.unwrap();
+  CHECK(hierarchical_path.front() == start_tile);
+  CHECK(hierarchical_path.back() == goal_tile);
+  for (const auto &tile : hierarchical_path) {
+    CHECK(map.is_walkable_tile(tile, movement_type));
+  }
+  CHECK(get_path_cost(hierarchical_path) >= get_path_cost(a_star_path) - 1e-3f);
+  CHECK(get_path_cost(hierarchical_path) <=
+        get_path_cost(a_star_path) * 1.5f + 4.f);
+}
+} // namespace
+
+TEST_CASE("Hierarchical paths follow tile changes", "[pathfinder]") {
+  model::GameState game_state;
+  const auto *map = game_state.add_entity_and_init<Map>().unwrap();
+
+  // the walkable tiles closest to opposite corners
+  std::vector<Eigen::Vector2i> walkable_tiles;
+  for (int y = 0; y < Map::get_map_size().y(); ++y) {
+    for (int x = 0; x < Map::get_map_size().x(); ++x) {
+      if (map->is_walkable_tile({x, y}, movement_type)) {
+        walkable_tiles.emplace_back(x, y);
+      }
+    }
+  }
+  REQUIRE(walkable_tiles.size() >= 2UL);
+  const Eigen::Vector2i start_tile = walkable_tiles.front();
+  const Eigen::Vector2i goal_tile = walkable_tiles.back();
+  check_matches_a_star(game_state, *map, start_tile, goal_tile);
+
+  // flowers growing on the middle of the A* path block it for this movement
+  // type, so the graph has to pick up the change
+  const auto a_star_path =
+      find_tile_path(game_state, *map, start_tile, goal_tile,
+                     pathfinding::PathfindingAlgorithm::a_star)
+          .unwrap();
+  REQUIRE(a_star_path.size() > 4UL);
+  const auto version_before = map->get_walkability_version(movement_type);
+  for (std::size_t i = a_star_path.size() / 3UL;
+       i < a_star_path.size() * 2UL / 3UL; ++i) {
+    const auto tile_id =
+        map->get_map_tile_entity_by_index(a_star_path[i]).unwrap();
+    auto *grass_tile =
+        game_state.get_entity_pointer_by_id_as<GrassTile>(tile_id).unwrap();
+    grass_tile->set_has_player();
+    REQUIRE(grass_tile->update(0L).isOk());
+    REQUIRE_FALSE(map->is_walkable_tile(a_star_path[i], movement_type));
+  }
+  REQUIRE(map->get_walkability_version(movement_type) != version_before);
+
+  check_matches_a_star(game_state, *map, start_tile, goal_tile);
+}
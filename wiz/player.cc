@@ -64,9 +64,7 @@ Result<void, std::string> Player::update(const int64_t delta_time_ns) {
     position += (y_direction_ + x_direction_).cast<float>().normalized() *
                 (static_cast<double>(delta_time_ns) / 1e9) * 0.5f;
   }
-  for (const auto &component : components_) {
-    TRY_VOID(component->update(delta_time_ns));
-  }
+  TRY_VOID(update_components(delta_time_ns));
   return Ok();
 }
 
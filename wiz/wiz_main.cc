@@ -4,7 +4,13 @@
 #include <chrono>
 #include <cstdlib>
 
-int main() {
+int main(int argc, char **argv) {
+  // parsed first since --seed has to apply before the game is created
+  const auto params_result = controller::parse_command_line(argc, argv);
+  if (params_result.isErr()) {
+    std::cerr << params_result.unwrapErr() << std::endl;
+    return EXIT_FAILURE;
+  }
   auto game_result = wiz::make_wiz_game();
   if (game_result.isErr()) {
     std::cerr << "Failed to initialize game with error: "
@@ -13,7 +19,7 @@ int main() {
   }
   controller::Controller controller(std::make_unique<view::Screen>(Eigen::Vector2f{2.5f, 2.5f}),
                                     std::move(game_result).unwrap());
-  const auto result = controller.run();
+  const auto result = controller.run(params_result.unwrap());
   if (result.isErr()) {
     std::cerr << "Application ended with error: " << result.unwrapErr()
               << std::endl;